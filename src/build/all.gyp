@@ -7,6 +7,7 @@
       'target_name': 'all',
       'type': 'none',
       'dependencies': [
+        '../packer/packer.gyp:*',
         '../samples/samples.gyp:*',
         '../test/test.gyp:*',
       ],
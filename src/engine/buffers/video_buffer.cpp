@@ -11,9 +11,14 @@ VideoBuffer::VideoBuffer(Engine *engine, Handle handle, Array type) {
   this->engine = engine;
   this->handle = handle;
   this->type = type;
+
+  // Register pointer in the memory manager
+  memoryHandle = REGISTER_POINTER(this);
 }
 
 VideoBuffer::~VideoBuffer() {
+  // Unregister pointer in the memory manager
+  UNREGISTER_POINTER(memoryHandle);
   engine->freeBuffer(this);
 }
 
@@ -5,6 +5,7 @@
 #define __VE_VIDEO_BUFFER_H__
 
 #include "engine/common.h"
+#include "engine/tools/pool_allocator.h"
 
 /** @file eeVideoBuffer.h */
 
@@ -47,8 +48,11 @@ enum VideoBufferStoreMethod {
 
     <b>Note:</b> Video Buffer objects must be created only
     through Engine::createVideoBuffer() calls.
+
+    Objects are allocated from the pool of the class, so engine creates and
+    frees them without heap fragmentation.
 */
-class VideoBuffer {
+class VideoBuffer : public PooledObject<VideoBuffer> {
 private:
   /**
       Engine class created this video buffer.
@@ -67,6 +71,9 @@ private:
   */
   Array type;
 
+  /** Handle of the buffer in the memory manager */
+  MemoryHandle memoryHandle;
+
 public:
   /**
       VideoBuffer constructor. Use Engine::createVideoBuffer() to create
@@ -79,7 +86,8 @@ public:
 
   /**
       VideoBuffer destructor. Calls Engine::freeVideoBuffer() function to
-      free allocated resources.
+      free allocated resources and unregisters the buffer in the memory
+      manager, so owner may delete it.
   */
   virtual ~VideoBuffer();
 
@@ -24,6 +24,7 @@ AbstractCamera::AbstractCamera(Engine *engine, ViewportState theViewport) {
 */
 void AbstractCamera::setViewport(ViewportState newViewport) {
   viewport = newViewport;
+  updateMatrices();
 }
 
 /**
@@ -37,4 +38,29 @@ Outcome AbstractCamera::apply() {
   return OK;
 }
 
+/**
+    Returns view matrix which is loaded to MODELVIEW matrix in apply().
+    @return View matrix of this camera.
+*/
+const Matrix4f &AbstractCamera::getViewMatrix() const {
+  return viewMatrix;
+}
+
+/**
+    Returns projection matrix which is loaded to PROJECTION matrix in apply().
+    @return Projection matrix of this camera.
+*/
+const Matrix4f &AbstractCamera::getProjectionMatrix() const {
+  return projectionMatrix;
+}
+
+/**
+    Recomputes view and projection matrices from camera parameters.
+    Both matrices are identity for abstract camera.
+*/
+void AbstractCamera::updateMatrices() {
+  viewMatrix = Matrix4f();
+  projectionMatrix = Matrix4f();
+}
+
 }
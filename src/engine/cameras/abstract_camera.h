@@ -5,6 +5,7 @@
 #define __VE_ABSTRACT_CAMERA_H__
 
 #include "engine/common.h"
+#include "engine/math/matrix4f.h"
 #include "engine/states/viewport_state.h"
 
 namespace ve {
@@ -12,8 +13,10 @@ namespace ve {
 class Engine;
 
 /**
-    Abstract camera class. It contains only one parameter - viewport
-    state that is set to the pipeline in apply().
+    Abstract camera class. It contains viewport state that is set to the
+    pipeline in apply() and keeps view and projection matrices on the CPU side,
+    so they may be used (e.g. for frustum culling) on any thread without
+    reading them back from the pipeline.
 */
 class AbstractCamera {
 protected:
@@ -23,6 +26,19 @@ protected:
   /** Viewport state of this camera. */
   ViewportState viewport;
 
+  /** View (modelview) matrix of this camera. */
+  Matrix4f viewMatrix;
+
+  /** Projection matrix of this camera. */
+  Matrix4f projectionMatrix;
+
+  /**
+      Recomputes view and projection matrices from camera parameters.
+      Derived classes call it whenever their parameters are changed.
+      Both matrices are identity by default.
+  */
+  virtual void updateMatrices();
+
 public:
   /**
       Constructor.
@@ -45,6 +61,18 @@ public:
       @return non-OK if engine error occurred.
   */
   virtual Outcome apply();
+
+  /**
+      Returns view matrix which is loaded to MODELVIEW matrix in apply().
+      @return View matrix of this camera.
+  */
+  const Matrix4f &getViewMatrix() const;
+
+  /**
+      Returns projection matrix which is loaded to PROJECTION matrix in apply().
+      @return Projection matrix of this camera.
+  */
+  const Matrix4f &getProjectionMatrix() const;
 };
 
 }
@@ -36,6 +36,16 @@ void Camera::norm() {
   up.norm();
   side = Maths::cross(up, look);
   side.norm();
+  updateMatrices();
+}
+
+void Camera::updateMatrices() {
+  float width = (float)viewport.width;
+  float height = (float)viewport.height;
+  float aspect = height > 0 ? width / height : 1.0f;
+
+  projectionMatrix = Matrix4f::getPerspectiveMatrix(fovy, aspect, zNear, zFar);
+  viewMatrix = Matrix4f::getLookAtMatrix(position, position + look, up);
 }
 
 Outcome Camera::apply() {
@@ -62,10 +72,12 @@ void Camera::setAngles(float newYaw, float newPitch, float newRoll) {
 
 void Camera::move(float offset) {
   position += offset * look;
+  updateMatrices();
 }
 
 void Camera::sideMove(float offset) {
   position += offset * side;
+  updateMatrices();
 }
 
 Vector3f Camera::getPosition() {
@@ -91,6 +103,7 @@ float Camera::getZFar() {
 /* Set functions */
 void Camera::setPosition(const Vector3f newPosition) {
   position = newPosition;
+  updateMatrices();
 }
 
 void Camera::setLook(const Vector3f newLook) {
@@ -105,14 +118,34 @@ void Camera::setUp(const Vector3f newUp) {
 
 void Camera::setZFar(float newZFar) {
   zFar = newZFar;
+  updateMatrices();
 }
 
 void Camera::setZNear(float newZNear) {
   zNear = newZNear;
+  updateMatrices();
 }
 
 void Camera::setFovy(float newFovy) {
   fovy = newFovy;
+  updateMatrices();
+}
+
+float Camera::getFovy() {
+  return fovy;
+}
+
+float Camera::getProjectedSize(const Vector3f &center, float radius) {
+  Vector3f direction = center - position;
+  float distance = sqrt(Maths::dot(direction, direction));
+
+  // Camera is inside the sphere
+  if (distance <= radius) {
+    return (float)viewport.height;
+  }
+
+  float halfAngle = (float)(fovy * Maths::PI / 360.0);
+  return viewport.height * radius / (distance * tan(halfAngle));
 }
 
 }
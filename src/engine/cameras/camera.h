@@ -60,6 +60,11 @@ protected:
   */
   void norm();
 
+  /**
+      Recomputes perspective projection and look-at view matrices.
+  */
+  virtual void updateMatrices();
+
 public:
   /**
       Constructor.
@@ -171,6 +176,21 @@ public:
       @param newFovy - New view angle of this camera.
   */
   void setFovy(float newFovy);
+
+  /**
+      Returns view angle of this camera.
+      @return View angle of this camera in degrees.
+  */
+  float getFovy();
+
+  /**
+      Estimates height in pixels which a sphere occupies on the screen
+      when it is seen through this camera.
+      @param center - Center of the sphere in world coordinates.
+      @param radius - Radius of the sphere.
+      @return Projected diameter of the sphere in pixels.
+  */
+  float getProjectedSize(const Vector3f &center, float radius);
 };
 
 }
@@ -18,6 +18,7 @@ OrthoCamera::OrthoCamera(Engine *engine, ViewportState theViewportState,
   bool identity, bool inverse) :AbstractCamera(engine, theViewportState) {
   this->identity = identity;
   this->inverse = inverse;
+  updateMatrices();
 }
 
 /**
@@ -59,6 +60,7 @@ Outcome OrthoCamera::apply() {
 */
 void OrthoCamera::setIdentityFlag(bool value) {
   identity = value;
+  updateMatrices();
 }
 
 /**
@@ -75,6 +77,7 @@ bool OrthoCamera::getIdentityFlag() {
 */
 void OrthoCamera::setInverseFlag(bool value) {
   inverse = value;
+  updateMatrices();
 }
 
 /**
@@ -85,4 +88,36 @@ bool OrthoCamera::getInverseFlag() {
   return inverse;
 }
 
+/**
+    Recomputes view matrix for current coordinate system. It is the same
+    matrix which apply() builds with scale() and translate() calls,
+    projection matrix is identity.
+*/
+void OrthoCamera::updateMatrices() {
+  float width = (float)viewport.width;
+  float height = (float)viewport.height;
+
+  projectionMatrix = Matrix4f();
+  viewMatrix = Matrix4f();
+
+  if (!identity && inverse && width > 0 && height > 0) {
+    viewMatrix[0][0] = 2.0f / width;
+    viewMatrix[1][1] = -2.0f / height;
+    viewMatrix[0][3] = -1.0f;
+    viewMatrix[1][3] = 1.0f;
+  }
+
+  if (identity && inverse) {
+    viewMatrix[0][0] = 2.0f;
+    viewMatrix[1][1] = -2.0f;
+    viewMatrix[0][3] = -1.0f;
+    viewMatrix[1][3] = 1.0f;
+  }
+
+  if (!identity && !inverse && width > 0 && height > 0) {
+    viewMatrix[0][0] = 2.0f / width;
+    viewMatrix[1][1] = 2.0f / height;
+  }
+}
+
 }
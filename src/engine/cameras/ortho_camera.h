@@ -33,6 +33,12 @@ private:
   bool identity;
   bool inverse;
 
+protected:
+  /**
+      Recomputes view matrix for current coordinate system, projection is identity.
+  */
+  virtual void updateMatrices();
+
 public:
   /**
       Constructor.
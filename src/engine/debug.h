@@ -9,18 +9,67 @@
 #define __WFILE__ StringTool::AsciiToWide(__FILE__)
 #define __WFUNCTION__ StringTool::AsciiToWide(__FUNCTION__)
 
-#define LOG_ERROR(description) Log::getInstance()->error(__WFILE__, __LINE__, __WFUNCTION__, std::wstring(description));
-
+/* Log levels for the preprocessor, they match LogLevel values */
+#define VE_LOG_LEVEL_DEBUG 0
+#define VE_LOG_LEVEL_INFO 1
+#define VE_LOG_LEVEL_WARNING 2
+#define VE_LOG_LEVEL_ERROR 3
+#define VE_LOG_LEVEL_NONE 4
+
+/* Sites below this level are not compiled, it may be set by the build */
+#ifndef VE_LOG_LEVEL
 #ifdef VE_DEBUG
+#define VE_LOG_LEVEL VE_LOG_LEVEL_DEBUG
+#else  // VE_DEBUG
+#define VE_LOG_LEVEL VE_LOG_LEVEL_INFO
+#endif // VE_DEBUG
+#endif // VE_LOG_LEVEL
+
+/*
+  Logs message with a static description of the call site. Message is
+  created only if its level passes the runtime threshold.
+*/
+#define LOG_AT(level, type, description) \
+{ \
+  static const LogSite __site = { __FILE__, __FUNCTION__, __LINE__, type }; \
+  if (Log::isEnabled(level)) \
+  { \
+    Log::getInstance()->write(__site, std::wstring(description)); \
+  } \
+}
+
+#if VE_LOG_LEVEL <= VE_LOG_LEVEL_ERROR
+#define LOG_ERROR(description) LOG_AT(LOG_LEVEL_ERROR, MESSAGE_FILE_ERROR, description)
+#else
+#define LOG_ERROR(description) {}
+#endif
+
+#if VE_LOG_LEVEL <= VE_LOG_LEVEL_WARNING
+#define LOG_WARNING(description) LOG_AT(LOG_LEVEL_WARNING, MESSAGE_WARNING, description)
+#else
+#define LOG_WARNING(description) {}
+#endif
+
+#if VE_LOG_LEVEL <= VE_LOG_LEVEL_INFO
+#define LOG_INFO(description) LOG_AT(LOG_LEVEL_INFO, MESSAGE_INFO, description)
+#else
+#define LOG_INFO(description) {}
+#endif
+
+#if VE_LOG_LEVEL <= VE_LOG_LEVEL_DEBUG
+#define DEBUG_INFO(description) LOG_AT(LOG_LEVEL_DEBUG, MESSAGE_DEBUG, description)
+#else
+#define DEBUG_INFO(description)
+#endif
 
-#define DEBUG_INFO(description) Log::getInstance()->debugInfo(StringTool::AsciiToWide(__FILE__), __LINE__, std::wstring(StringTool::AsciiToWide(__FUNCTION__)), std::wstring(description));
+#ifdef VE_DEBUG
 
 #define GL_CHECK(result) \
 { \
   GLenum error = glGetError(); \
   if (error != GL_NO_ERROR) \
   { \
-    Log::getInstance()->glError(__WFILE__, __LINE__, __WFUNCTION__, error); \
+    LOG_ERROR(Log::getInstance()->convertGLError(error)); \
     return result; \
   } \
 }
@@ -31,7 +80,6 @@
 
 #else  // VE_DEBUG
 
-#define DEBUG_INFO(description)
 #define GL_CHECK(result)
 #define GL_SAFE_CALL(call, result) call;
 
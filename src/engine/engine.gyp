@@ -80,6 +80,8 @@
         'events/key_event_source.h',
         'events/key_listener.cpp',
         'events/key_listener.h',
+        'events/layout_listener.cpp',
+        'events/layout_listener.h',
         'events/mouse_event.cpp',
         'events/mouse_event.h',
         'events/mouse_event_source.cpp',
@@ -108,20 +110,47 @@
         'fonts/win_font.h',
         'fonts/x_font.cpp',
         'fonts/x_font.h',
+        'io/buffered_input_stream.cpp',
+        'io/buffered_input_stream.h',
+        'io/buffered_output_stream.cpp',
+        'io/buffered_output_stream.h',
+        'io/byte_order.h',
+        'io/data_input_stream.cpp',
+        'io/data_input_stream.h',
         'io/data_ouput_stream.cpp',
         'io/data_ouput_stream.h', 
+        'io/directory_source.cpp',
+        'io/directory_source.h',
         'io/file.cpp',
         'io/file.h', 
         'io/file_input_stream.cpp',
         'io/file_input_stream.h', 
         'io/file_output_stream.cpp',
         'io/file_output_stream.h', 
+        'io/file_source.h',
         'io/input_stream.cpp',
         'io/input_stream.h', 
+        'io/io_listener.h',
+        'io/io_request.h',
+        'io/io_service.cpp',
+        'io/io_service.h',
+        'io/linux_io_ring.cpp',
+        'io/linux_io_ring.h',
+        'io/mapped_file_input_stream.cpp',
+        'io/mapped_file_input_stream.h',
+        'io/memory_input_stream.cpp',
+        'io/memory_input_stream.h',
         'io/output_stream.cpp',
         'io/output_stream.h', 
+        'io/pack_archive.cpp',
+        'io/pack_archive.h',
+        'io/pack_format.h',
+        'io/pack_writer.cpp',
+        'io/pack_writer.h',
         'io/text_writer.cpp',
         'io/text_writer.h',
+        'io/virtual_file_system.cpp',
+        'io/virtual_file_system.h',
         'loaders/3ds_loader.cpp',
         'loaders/3ds_loader.h',
         'loaders/bmp_loader.cpp',
@@ -134,14 +163,21 @@
         'loaders/tga_loader.h', 
         'loaders/texture_loader.cpp',
         'loaders/texture_loader.h',
+        'logs/async_log.cpp',
+        'logs/async_log.h',
         'logs/log.cpp',
         'logs/log.h',
+        'math/batch_transform.cpp',
+        'math/batch_transform.h',
         'math/bounding_box.cpp',
         'math/bounding_box.h', 
         'math/frustum.cpp',
         'math/frustum.h', 
+        'math/frustum_culler.cpp',
+        'math/frustum_culler.h',
         'math/maths.cpp',
         'math/maths.h', 
+        'math/math_kernel.h',
         'math/matrix3f.cpp',
         'math/matrix3f.h', 
         'math/matrix4f.cpp',
@@ -156,6 +192,8 @@
         'math/vector4f.h',
         'models/mesh.cpp',
         'models/mesh.h', 
+        'models/mesh_simplifier.cpp',
+        'models/mesh_simplifier.h',
         'models/model.cpp',
         'models/model.h',
         'models/model_interface.h',
@@ -169,6 +207,14 @@
         'shaders/shaders_ext.h', 
         'shaders/shaders_impl.cpp',
         'shaders/shaders_impl.h',
+        'spatial/bounding_volume_hierarchy.cpp',
+        'spatial/bounding_volume_hierarchy.h',
+        'spatial/hash_grid.cpp',
+        'spatial/hash_grid.h',
+        'spatial/loose_octree.cpp',
+        'spatial/loose_octree.h',
+        'spatial/spatial_index.cpp',
+        'spatial/spatial_index.h',
         'sprites/abstract_sprite.cpp',
         'sprites/abstract_sprite.h', 
         'sprites/animated_sprite.cpp',
@@ -195,6 +241,7 @@
         'states/gpu_state_manager.cpp',
         'states/gpu_state_manager.h',
         'states/matrix_state.h',
+        'states/scissor_state.h',
         'states/shaders_state.h',
         'states/textures_state.h',
         'states/viewport_state.cpp',
@@ -205,14 +252,30 @@
         'textures/mips_impl.h',
         'textures/texture.cpp',
         'textures/texture.h',
+        'textures/texture_atlas.cpp',
+        'textures/texture_atlas.h',
+        'tools/crc32.cpp',
+        'tools/crc32.h',
         'tools/dynamic_huffman_tree.cpp',
         'tools/dynamic_huffman_tree.h',
+        'tools/frame_allocator.cpp',
+        'tools/frame_allocator.h',
+        'tools/hash_map.h',
+        'tools/job.h',
+        'tools/job_system.cpp',
+        'tools/job_system.h',
         'tools/keys_codec.cpp',
         'tools/keys_codec.h',
         'tools/linux_timer.cpp',
         'tools/linux_timer.h',
         'tools/memory_manager.cpp',
         'tools/memory_manager.h',
+        'tools/mpmc_queue.h',
+        'tools/pool_allocator.cpp',
+        'tools/pool_allocator.h',
+        'tools/queue_waiters.cpp',
+        'tools/queue_waiters.h',
+        'tools/spsc_queue.h',
         'tools/string_tool.cpp',
         'tools/string_tool.h', 
         'tools/texture_tool.cpp',
@@ -222,6 +285,8 @@
         'tools/timer_factory.h',
         'tools/win_timer.cpp',
         'tools/win_timer.h',
+        'tools/work_stealing_deque.cpp',
+        'tools/work_stealing_deque.h',
         'ui/border.cpp',
         'ui/border.h',
         'ui/button.cpp',
@@ -257,9 +322,22 @@
         'ui/ui_container.cpp',
         'ui/ui_container.h',
         'ui/ui_control.cpp',
-        'ui/ui_control.h', 
+        'ui/ui_control.h',
+        'ui/ui_draw_list.cpp',
+        'ui/ui_draw_list.h', 
+        'windows/atomic.h',
+        'windows/condition_variable.cpp',
+        'windows/condition_variable.h',
         'windows/critical_section.cpp',
         'windows/critical_section.h',
+        'windows/event.cpp',
+        'windows/event.h',
+        'windows/mutex.cpp',
+        'windows/mutex.h',
+        'windows/read_write_lock.cpp',
+        'windows/read_write_lock.h',
+        'windows/semaphore.cpp',
+        'windows/semaphore.h',
         'windows/thread_factory.cpp',
         'windows/thread_factory.h',
         'windows/win_message_pump.cpp',
@@ -280,6 +358,8 @@
         'windows/xwindow_system.h',
         'zlib/zlib.cpp',
         'zlib/zlib.h', 
+        'zlib/zlib_compressor.cpp',
+        'zlib/zlib_compressor.h',
         'common.h',
         'consts.h',
         'debug.h',
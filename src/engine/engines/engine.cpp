@@ -11,9 +11,15 @@ Engine::Engine() {
 }
 
 Engine::~Engine() {
+  // Objects which are still registered were not released by their owners
+  MemoryManager::getInstance()->reportLeaks();
   logFileStream->close();
 }
 
+FrameAllocator &Engine::getFrameAllocator() {
+  return frameAllocator;
+}
+
 int Engine::getComponents(TextureFormat format) {
   switch (format) {
   case ALPHA16F:
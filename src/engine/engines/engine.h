@@ -21,6 +21,7 @@
 #include "engine/cameras/camera.h"
 #include "engine/cameras/ortho_camera.h"
 #include "engine/tools/memory_manager.h"
+#include "engine/tools/frame_allocator.h"
 #include "engine/sprites/simple_sprite.h"
 #include "engine/sprites/sprite.h"
 #include "engine/sprites/animated_sprite.h"
@@ -52,6 +53,12 @@ protected:
   */
   FileOutputStream *logFileStream;
 
+  /**
+      Allocator of temporary data which lives during the current and the next frame.
+      It is swapped in onSwapBuffers().
+  */
+  FrameAllocator frameAllocator;
+
 public:
   /**
       Default constructor. Creates MemoryManager object to
@@ -616,6 +623,12 @@ public:
     Callback that is called by WindowSystem when it swaps frame buffers.
   */
   virtual void onSwapBuffers() = 0;
+
+  /**
+    Returns allocator of per-frame temporary data.
+    @return Frame allocator of this engine.
+  */
+  FrameAllocator &getFrameAllocator();
 };
 
 }
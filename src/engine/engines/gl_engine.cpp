@@ -447,7 +447,6 @@ Texture* GLEngine::createTexture(TextureFormat format, int width, int height, Te
 
   Texture *newTexture = new Texture(this, desc, newHandle);
   CHECK_ALLOC_EX(newTexture, NULL);
-  REGISTER_POINTER(newTexture);
 
   GLIdToTexture[newHandle] = newTexture;
 
@@ -460,7 +459,6 @@ VideoBuffer* GLEngine::createVideoBuffer(Array type) {
   GL_SAFE_CALL(VBOFunctions->glGenBuffers(1, &newHandle), NULL);
   VideoBuffer *newVideoBuffer = new VideoBuffer(this, newHandle, type);
   CHECK_ALLOC_EX(newVideoBuffer, NULL);
-  REGISTER_POINTER(newVideoBuffer);
 
   GLIdToBuffer[newHandle] = newVideoBuffer;
 
@@ -978,6 +976,7 @@ uint GLEngine::getBatchesCount() {
 
 void GLEngine::onSwapBuffers() {
   batches = 0;
+  frameAllocator.swap();
 }
 
 }
@@ -0,0 +1,4 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include "events/layout_listener.h"
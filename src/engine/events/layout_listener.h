@@ -0,0 +1,35 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+#ifndef __VE_LAYOUT_LISTENER_H__
+#define __VE_LAYOUT_LISTENER_H__
+
+namespace ve {
+
+class AbstractSprite;
+
+/**
+    LayoutListener is an interface for objects which keep positions and sizes
+    of sprites, for example, to find sprites under the mouse or to redraw only
+    changed parts of the screen. It is registered via AbstractSprite::setLayoutListener()
+    and is notified when position, size or look of the sprite changes.
+*/
+class LayoutListener {
+public:
+  /**
+      Callback function that will be invoked when position or size of
+      the sprite is changed.
+      @param sprite - Sprite which was changed.
+  */
+  virtual void onLayoutChange(AbstractSprite *sprite) = 0;
+
+  /**
+      Callback function that will be invoked when the sprite should be
+      redrawn without change of position and size.
+      @param sprite - Sprite which was changed.
+  */
+  virtual void onContentChange(AbstractSprite *sprite) = 0;
+};
+
+}
+
+#endif // __VE_LAYOUT_LISTENER_H__
@@ -11,9 +11,14 @@ Font::Font(WindowSystem *owner, Engine *engine) {
   windowSystem = owner;
   this->engine = engine;
   cache = new FontCache();
+
+  // Register pointer in the memory manager
+  memoryHandle = REGISTER_POINTER(this);
 }
 
 Font::~Font() {
+  // Unregister pointer in the memory manager
+  UNREGISTER_POINTER(memoryHandle);
   delete cache;
   windowSystem->freeFont(this);
 }
@@ -22,6 +27,16 @@ Outcome Font::initialize(uint cacheSize) {
   return cache->initialize(engine, this, cacheSize);
 }
 
+Outcome Font::cacheString(std::wstring str) {
+  if (cache->needUpdate(str)) {
+    ASSERT(cache->beginCaching());
+    ASSERT(cache->processString(str));
+    ASSERT(cache->endCaching());
+  }
+
+  return OK;
+}
+
 uint Font::getTextWidth(std::string s) {
   return windowSystem->getTextWidth(this, s);
 }
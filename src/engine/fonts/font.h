@@ -52,6 +52,10 @@ protected:
   */
   FontCache *cache;
 
+private:
+  /** Handle of the font in the memory manager */
+  MemoryHandle memoryHandle;
+
 public:
   /**
       Font constructor. Create Font objects only through call
@@ -63,7 +67,8 @@ public:
 
   /**
       Font destructor. Calls WindowSystem::freeFont() function
-      to free allocated resource. Dispose FontCache object.
+      to free allocated resource. Dispose FontCache object and
+      unregisters the font in the memory manager.
   */
   virtual ~Font();
 
@@ -96,6 +101,16 @@ public:
   */
   virtual Outcome drawString(float x, float y, float z, std::wstring str) = 0;
 
+  /**
+      Puts symbols of the string into FontCache if they are not there yet.
+      It is called by drawString() and should be called before the string
+      quads are taken from the cache directly.
+      @param str - Unicode string to cache.
+      @return OK if all symbols are cached.
+      @return non-OK if engine's error occurred.
+  */
+  Outcome cacheString(std::wstring str);
+
   /**
       Renders symbol using OpenGL call list prepared by WindowSystem.
       No tranformations may be applied.
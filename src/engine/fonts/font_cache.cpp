@@ -203,14 +203,9 @@ Outcome FontCache::endCaching() {
   return OK;
 }
 
-Outcome FontCache::drawString(std::wstring str) {
-  GPUStateManager *stateManager = engine->getStateManager();
+void FontCache::getStringQuads(const std::wstring &str, std::vector<float> &vertices, std::vector<float> &texCoords) {
   int len = str.length();
 
-  if (len == 0) {
-    return OK;
-  }
-
   /*                                                               */
   /* We will draw string as a set of 'quad' primitives.            */
   /* In this case, for <len> quads there are (4 * len) verices     */
@@ -287,6 +282,17 @@ Outcome FontCache::drawString(std::wstring str) {
 
     xOffset = xOffset + symbolWidth;
   }
+}
+
+Outcome FontCache::drawString(std::wstring str) {
+  GPUStateManager *stateManager = engine->getStateManager();
+  int len = str.length();
+
+  if (len == 0) {
+    return OK;
+  }
+
+  getStringQuads(str, vertices, texCoords);
 
   stateManager->pushStates(ALPHA_TEST_STATE | TEXTURES_STATE | BUFFERS_STATE);
   TexturesState texturesState(cache, TextureEnvMode(MODULATE));
@@ -232,6 +232,18 @@ public:
   */
   Outcome drawString(std::wstring str);
 
+  /**
+      Computes quads of the string at (0, 0, 0) point like drawString() does,
+      so the string may be rendered together with other geometry.
+      Each symbol gets four vertices with three coordinates and four pairs
+      of texture coordinates in the cache-texture.
+      <b>Note:</b> String need to be cached before.
+      @param str - String to compute quads for.
+      @param vertices - Array to fill with vertex coordinates.
+      @param texCoords - Array to fill with texture coordinates.
+  */
+  void getStringQuads(const std::wstring &str, std::vector<float> &vertices, std::vector<float> &texCoords);
+
   /**
       Returns texture object which is used to cache symbols.
       @return Cache-texture.
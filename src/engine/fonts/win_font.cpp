@@ -40,11 +40,7 @@ HFONT WinFont::getHandle() {
 }
 
 Outcome WinFont::drawString(float x, float y, float z, std::wstring str) {
-  if (cache->needUpdate(str)) {
-    cache->beginCaching();
-    cache->processString(str);
-    cache->endCaching();
-  }
+  ASSERT(cacheString(str));
 
   ASSERT(engine->beginTransform());
   ASSERT(engine->translate(x, y, z));
@@ -21,11 +21,7 @@ XFont::~XFont() {
 }
 
 Outcome XFont::drawString(float x, float y, float z, std::wstring str) {
-  if (cache->needUpdate(str)) {
-    cache->beginCaching();
-    cache->processString(str);
-    cache->endCaching();
-  }
+  ASSERT(cacheString(str));
 
   ASSERT(engine->beginTransform());
   ASSERT(engine->translate(x, y, z));
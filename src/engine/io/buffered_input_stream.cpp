@@ -0,0 +1,130 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <string.h>
+
+#include "io/buffered_input_stream.h"
+
+namespace ve {
+
+BufferedInputStream::BufferedInputStream(InputStream *source, size_t bufferSize) {
+  this->source = source;
+  buffer.resize(bufferSize > 0 ? bufferSize : 1);
+  start = 0;
+  end = 0;
+  ended = source == NULL;
+}
+
+BufferedInputStream::~BufferedInputStream() {
+}
+
+bool BufferedInputStream::fill(size_t count) {
+  if (end - start >= count) {
+    return true;
+  }
+
+  if (ended) {
+    return false;
+  }
+
+  /* Unread bytes are moved to the beginning, so the rest of the buffer is free */
+  if (start != 0) {
+    memmove(&buffer[0], &buffer[start], end - start);
+    end -= start;
+    start = 0;
+  }
+
+  if (count > buffer.size()) {
+    buffer.resize(count);
+  }
+
+  while (end < count) {
+    int read = source->read((char*)&buffer[0], (int)end, (int)(buffer.size() - end));
+    if (read <= 0) {
+      ended = true;
+      return false;
+    }
+
+    end += read;
+  }
+
+  return true;
+}
+
+char BufferedInputStream::read() {
+  if (!fill(1)) {
+    return 0;
+  }
+
+  return (char)buffer[start++];
+}
+
+int BufferedInputStream::read(char* data, int offset, int count) {
+  if (count <= 0) {
+    return 0;
+  }
+
+  size_t copied = end - start < (size_t)count ? end - start : (size_t)count;
+  memcpy(data + offset, &buffer[start], copied);
+  start += copied;
+
+  while (copied < (size_t)count && !ended) {
+    size_t rest = count - copied;
+
+    /* Large reads bypass the buffer */
+    if (rest >= buffer.size()) {
+      int read = source->read(data, offset + (int)copied, (int)rest);
+      if (read <= 0) {
+        ended = true;
+        break;
+      }
+
+      copied += read;
+      continue;
+    }
+
+    fill(rest);
+    size_t length = end - start < rest ? end - start : rest;
+    memcpy(data + offset + copied, &buffer[start], length);
+    start += length;
+    copied += length;
+  }
+
+  return (int)copied;
+}
+
+bool BufferedInputStream::available() {
+  return fill(1);
+}
+
+void BufferedInputStream::close() {
+  start = 0;
+  end = 0;
+  ended = true;
+
+  if (source != NULL) {
+    source->close();
+  }
+}
+
+bool BufferedInputStream::readBytes(void *destination, size_t count) {
+  return read((char*)destination, 0, (int)count) == (int)count;
+}
+
+const uchar *BufferedInputStream::peek(size_t count) {
+  if (!fill(count)) {
+    return NULL;
+  }
+
+  return &buffer[start];
+}
+
+void BufferedInputStream::consume(size_t count) {
+  start += count < end - start ? count : end - start;
+}
+
+size_t BufferedInputStream::getBuffered() {
+  return end - start;
+}
+
+}
@@ -0,0 +1,134 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_BUFFERED_INPUT_STREAM_H__
+#define __VE_BUFFERED_INPUT_STREAM_H__
+
+#include <vector>
+
+#include "io/input_stream.h"
+
+namespace ve {
+
+/**
+    Input stream which reads another stream in large blocks. Byte and small
+    reads are served from the buffer, so the source is called once per block.
+    Reads which are larger than the buffer go to the source directly.
+
+    Parsers may look at the buffered data without copying: peek() returns
+    pointer to the next bytes and consume() moves past them.
+
+    Example:
+    @code
+    FileInputStream file("data.bin");
+    BufferedInputStream stream(&file);
+    const uchar *header = stream.peek(4);
+    if (header != NULL && header[0] == 'V') {
+      stream.consume(4);
+    }
+    @endcode
+*/
+class BufferedInputStream : public InputStream {
+private:
+  /** Stream to read data from, it is not owned */
+  InputStream *source;
+
+  /** Buffered data */
+  std::vector<uchar> buffer;
+
+  /** Range of unread data in the buffer */
+  size_t start;
+  size_t end;
+
+  /** Source has no more data */
+  bool ended;
+
+  /**
+      Reads source until at least count bytes are buffered.
+      @return 'true' if there are count bytes in the buffer.
+  */
+  bool fill(size_t count);
+
+  /**
+      Private copy-constructor.
+  */
+  BufferedInputStream(const BufferedInputStream &ref);
+
+  /**
+      Private operator =
+  */
+  BufferedInputStream &operator = (const BufferedInputStream &ref);
+
+public:
+  /**
+      Creates stream.
+      @param source - Stream to read data from, it is not deleted by this stream.
+      @param bufferSize - Size of blocks read from the source.
+  */
+  BufferedInputStream(InputStream *source, size_t bufferSize = 65536);
+
+  /**
+      Destructor. Source is not closed.
+  */
+  virtual ~BufferedInputStream();
+
+  /**
+      Reads exactly one byte from this input stream.
+      @return byte that was read from the stream or 0 at the end of the data.
+  */
+  virtual char read();
+
+  /**
+      Reads array of bytes from this stream.
+      @param data - Buffer pointer to write data.
+      @param offset - Offset in bytes to write array.
+      @param count - Number of bytes to read from the stream.
+      @return Number of read bytes (value from 0 to count).
+  */
+  virtual int read(char* data, int offset, int count);
+
+  /**
+      Checks if at least one more byte is available at this stream.
+      @return true if there is at least one byte to read.
+      @return false if there is no data to read.
+  */
+  virtual bool available();
+
+  /**
+      Drops buffered data and closes the source.
+  */
+  virtual void close();
+
+  /**
+      Reads exactly count bytes.
+      @param destination - Buffer for the data.
+      @param count - Number of bytes to read.
+      @return 'true' if bytes were read.
+      @return 'false' if the stream ended earlier.
+  */
+  bool readBytes(void *destination, size_t count);
+
+  /**
+      Returns pointer to the next count bytes without moving past them. Buffer
+      grows if count is larger than it. Pointer is valid until the next call.
+      @param count - Number of bytes to look at.
+      @return Pointer to the bytes or NULL if stream ends earlier.
+  */
+  const uchar *peek(size_t count);
+
+  /**
+      Moves past bytes which were returned by peek().
+      @param count - Number of bytes, it should not exceed getBuffered().
+  */
+  void consume(size_t count);
+
+  /**
+      Returns number of bytes which may be consumed without reading the source.
+      @return Number of buffered bytes.
+  */
+  size_t getBuffered();
+};
+
+}
+
+#endif // __VE_BUFFERED_INPUT_STREAM_H__
@@ -0,0 +1,74 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <string.h>
+
+#include "io/buffered_output_stream.h"
+
+namespace ve {
+
+BufferedOutputStream::BufferedOutputStream(OutputStream *target, size_t bufferSize) {
+  this->target = target;
+  buffer.resize(bufferSize > 0 ? bufferSize : 1);
+  used = 0;
+}
+
+BufferedOutputStream::~BufferedOutputStream() {
+  writeBuffer();
+}
+
+bool BufferedOutputStream::writeBuffer() {
+  if (used == 0 || target == NULL) {
+    return used == 0;
+  }
+
+  bool complete = target->write(&buffer[0], 0, (int)used) == (int)used;
+  used = 0;
+  return complete;
+}
+
+int BufferedOutputStream::write(char byte) {
+  if (used == buffer.size() && !writeBuffer()) {
+    return 0;
+  }
+
+  buffer[used++] = byte;
+  return 1;
+}
+
+int BufferedOutputStream::write(char* data, int offset, int count) {
+  if (count <= 0) {
+    return 0;
+  }
+
+  if (used + count > buffer.size()) {
+    writeBuffer();
+  }
+
+  /* Large writes bypass the buffer */
+  if ((size_t)count >= buffer.size()) {
+    return target != NULL ? target->write(data, offset, count) : 0;
+  }
+
+  memcpy(&buffer[used], data + offset, count);
+  used += count;
+  return count;
+}
+
+void BufferedOutputStream::flush() {
+  writeBuffer();
+
+  if (target != NULL) {
+    target->flush();
+  }
+}
+
+void BufferedOutputStream::close() {
+  writeBuffer();
+
+  if (target != NULL) {
+    target->close();
+  }
+}
+
+}
@@ -0,0 +1,88 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_BUFFERED_OUTPUT_STREAM_H__
+#define __VE_BUFFERED_OUTPUT_STREAM_H__
+
+#include <vector>
+
+#include "common.h"
+#include "io/output_stream.h"
+
+namespace ve {
+
+/**
+    Output stream which collects data and writes it to another stream in large
+    blocks. Writes which are larger than the buffer go to the target directly.
+    Data is written to the target by flush(), close() and the destructor.
+*/
+class BufferedOutputStream : public OutputStream {
+private:
+  /** Stream to write data to, it is not owned */
+  OutputStream *target;
+
+  /** Collected data */
+  std::vector<char> buffer;
+
+  /** Number of bytes in the buffer */
+  size_t used;
+
+  /**
+      Writes collected data to the target without flushing it.
+      @return 'false' if target did not take all data.
+  */
+  bool writeBuffer();
+
+  /**
+      Private copy-constructor.
+  */
+  BufferedOutputStream(const BufferedOutputStream &ref);
+
+  /**
+      Private operator =
+  */
+  BufferedOutputStream &operator = (const BufferedOutputStream &ref);
+
+public:
+  /**
+      Creates stream.
+      @param target - Stream to write data to, it is not deleted by this stream.
+      @param bufferSize - Size of blocks written to the target.
+  */
+  BufferedOutputStream(OutputStream *target, size_t bufferSize = 65536);
+
+  /**
+      Destructor. Collected data is written, target is not closed.
+  */
+  virtual ~BufferedOutputStream();
+
+  /**
+      Writes exactly one byte into this output stream.
+      @param byte - Byte value to write into this stream.
+      @return Number of written bytes (thus, one or zero)
+  */
+  virtual int write(char byte);
+
+  /**
+      Writes array of bytes into this stream.
+      @param data - Array pointer to read data from.
+      @param offset - Offset in bytes to start reading from array.
+      @param count - Number of bytes to write into this stream.
+      @return Number of written bytes (value from 0 to count).
+  */
+  virtual int write(char* data, int offset, int count);
+
+  /**
+      Writes collected data and flushes the target.
+  */
+  virtual void flush();
+
+  /**
+      Writes collected data and closes the target.
+  */
+  virtual void close();
+};
+
+}
+
+#endif // __VE_BUFFERED_OUTPUT_STREAM_H__
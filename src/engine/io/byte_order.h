@@ -0,0 +1,44 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_BYTE_ORDER_H__
+#define __VE_BYTE_ORDER_H__
+
+#include "common.h"
+
+namespace ve {
+
+/**
+    Order of bytes of multi-byte values in a stream.
+*/
+enum ByteOrder {
+  LITTLE_ENDIAN_ORDER = 0,  /*!< Least significant byte first, as on x86. */
+  BIG_ENDIAN_ORDER          /*!< Most significant byte first, as in PNG.  */
+};
+
+/**
+    Returns byte order of the machine.
+    @return Order of bytes in memory.
+*/
+inline ByteOrder getHostByteOrder() {
+  const ushort probe = 1;
+  return *(const uchar*)&probe == 1 ? LITTLE_ENDIAN_ORDER : BIG_ENDIAN_ORDER;
+}
+
+/**
+    Reverses bytes of 16-bit value.
+*/
+inline ushort swapBytes16(ushort value) {
+  return (ushort)((value >> 8) | (value << 8));
+}
+
+/**
+    Reverses bytes of 32-bit value.
+*/
+inline uint swapBytes32(uint value) {
+  return (value >> 24) | ((value >> 8) & 0x0000FF00) | ((value << 8) & 0x00FF0000) | (value << 24);
+}
+
+}
+
+#endif // __VE_BYTE_ORDER_H__
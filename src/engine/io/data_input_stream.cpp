@@ -0,0 +1,87 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <string.h>
+
+#include "io/data_input_stream.h"
+
+namespace ve {
+
+DataInputStream::DataInputStream(BufferedInputStream *stream, ByteOrder order) {
+  this->stream = stream;
+  setByteOrder(order);
+}
+
+void DataInputStream::setByteOrder(ByteOrder order) {
+  this->order = order;
+  swap = order != getHostByteOrder();
+}
+
+ByteOrder DataInputStream::getByteOrder() {
+  return order;
+}
+
+Outcome DataInputStream::readArray(void *values, size_t count, size_t size) {
+  CHECK_POINTER(stream);
+
+  uchar *destination = (uchar*)values;
+
+  while (count != 0) {
+    /* At least one value is buffered, all buffered values are taken at once */
+    const uchar *source = stream->peek(size);
+    ERROR_IF(source == NULL, L"Unexpected end of stream", IO_ERROR);
+
+    size_t available = stream->getBuffered() / size;
+    size_t n = count < available ? count : available;
+
+    if (!swap || size == 1) {
+      memcpy(destination, source, n * size);
+    } else {
+      for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < size; j++) {
+          destination[i * size + j] = source[i * size + size - 1 - j];
+        }
+      }
+    }
+
+    stream->consume(n * size);
+    destination += n * size;
+    count -= n;
+  }
+
+  return OK;
+}
+
+Outcome DataInputStream::readInt8(char &value) {
+  return readArray(&value, 1, 1);
+}
+
+Outcome DataInputStream::readInt16(short &value) {
+  return readArray(&value, 1, sizeof(value));
+}
+
+Outcome DataInputStream::readInt32(int &value) {
+  return readArray(&value, 1, sizeof(value));
+}
+
+Outcome DataInputStream::readFloat(float &value) {
+  return readArray(&value, 1, sizeof(value));
+}
+
+Outcome DataInputStream::readInt8Array(char *values, size_t count) {
+  return readArray(values, count, 1);
+}
+
+Outcome DataInputStream::readInt16Array(short *values, size_t count) {
+  return readArray(values, count, sizeof(short));
+}
+
+Outcome DataInputStream::readInt32Array(int *values, size_t count) {
+  return readArray(values, count, sizeof(int));
+}
+
+Outcome DataInputStream::readFloatArray(float *values, size_t count) {
+  return readArray(values, count, sizeof(float));
+}
+
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_DATA_INPUT_STREAM_H__
+#define __VE_DATA_INPUT_STREAM_H__
+
+#include "common.h"
+#include "io/byte_order.h"
+#include "io/buffered_input_stream.h"
+
+namespace ve {
+
+/**
+    Reads binary values from a buffered stream in the given byte order. Values
+    are converted directly from the buffer of the stream, arrays are copied in
+    blocks of buffered data.
+*/
+class DataInputStream {
+private:
+  /** Stream to read data from, it is not owned */
+  BufferedInputStream *stream;
+
+  /** Byte order of the data */
+  ByteOrder order;
+
+  /** Values are swapped because byte order differs from the machine */
+  bool swap;
+
+  /**
+      Reads array of values of the given size.
+  */
+  Outcome readArray(void *values, size_t count, size_t size);
+
+public:
+  /**
+      Creates reader.
+      @param stream - Stream to read data from, it is not deleted by the reader.
+      @param order - Byte order of the data.
+  */
+  DataInputStream(BufferedInputStream *stream, ByteOrder order = LITTLE_ENDIAN_ORDER);
+
+  /**
+      Sets byte order of the following values.
+      @param order - Byte order of the data.
+  */
+  void setByteOrder(ByteOrder order);
+
+  /**
+      Returns byte order of the data.
+      @return Byte order.
+  */
+  ByteOrder getByteOrder();
+
+  /**
+      Reads one value.
+      @param value - Read value.
+      @return OK if value was read.
+      @return IO_ERROR if stream ended.
+  */
+  Outcome readInt8(char &value);
+  Outcome readInt16(short &value);
+  Outcome readInt32(int &value);
+  Outcome readFloat(float &value);
+
+  /**
+      Reads array of values.
+      @param values - Array for the values.
+      @param count - Number of values.
+      @return OK if all values were read.
+      @return IO_ERROR if stream ended earlier.
+  */
+  Outcome readInt8Array(char *values, size_t count);
+  Outcome readInt16Array(short *values, size_t count);
+  Outcome readInt32Array(int *values, size_t count);
+  Outcome readFloatArray(float *values, size_t count);
+};
+
+}
+
+#endif // __VE_DATA_INPUT_STREAM_H__
@@ -0,0 +1,118 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <string.h>
+
+#include "io/data_ouput_stream.h"
+
+namespace ve {
+
+/* Number of bytes converted at once when byte order differs from the machine */
+static const size_t CONVERSION_BLOCK = 1024;
+
+DataOutputStream::DataOutputStream(OutputStream *stream, ByteOrder order) {
+  this->stream = stream;
+  setByteOrder(order);
+}
+
+void DataOutputStream::setByteOrder(ByteOrder order) {
+  this->order = order;
+  swap = order != getHostByteOrder();
+}
+
+ByteOrder DataOutputStream::getByteOrder() {
+  return order;
+}
+
+Outcome DataOutputStream::writeBytes(const void *data, size_t count) {
+  CHECK_POINTER(stream);
+
+  if (count == 0) {
+    return OK;
+  }
+
+  ERROR_IF(stream->write((char*)data, 0, (int)count) != (int)count, L"Stream write failed", IO_ERROR);
+  return OK;
+}
+
+Outcome DataOutputStream::writeArray(const void *values, size_t count, size_t size) {
+  if (!swap || size == 1) {
+    return writeBytes(values, count * size);
+  }
+
+  const uchar *source = (const uchar*)values;
+  uchar block[CONVERSION_BLOCK];
+  size_t perBlock = CONVERSION_BLOCK / size;
+
+  while (count != 0) {
+    size_t n = count < perBlock ? count : perBlock;
+
+    for (size_t i = 0; i < n; i++) {
+      for (size_t j = 0; j < size; j++) {
+        block[i * size + j] = source[i * size + size - 1 - j];
+      }
+    }
+
+    ASSERT(writeBytes(block, n * size));
+    source += n * size;
+    count -= n;
+  }
+
+  return OK;
+}
+
+Outcome DataOutputStream::writeInt8(char value) {
+  return writeBytes(&value, 1);
+}
+
+Outcome DataOutputStream::writeInt16(short value) {
+  ushort bits = (ushort)value;
+  if (swap) {
+    bits = swapBytes16(bits);
+  }
+
+  return writeBytes(&bits, sizeof(bits));
+}
+
+Outcome DataOutputStream::writeInt32(int value) {
+  uint bits = (uint)value;
+  if (swap) {
+    bits = swapBytes32(bits);
+  }
+
+  return writeBytes(&bits, sizeof(bits));
+}
+
+Outcome DataOutputStream::writeFloat(float value) {
+  uint bits;
+  memcpy(&bits, &value, sizeof(bits));
+  if (swap) {
+    bits = swapBytes32(bits);
+  }
+
+  return writeBytes(&bits, sizeof(bits));
+}
+
+Outcome DataOutputStream::writeInt8Array(const char *values, size_t count) {
+  return writeBytes(values, count);
+}
+
+Outcome DataOutputStream::writeInt16Array(const short *values, size_t count) {
+  return writeArray(values, count, sizeof(short));
+}
+
+Outcome DataOutputStream::writeInt32Array(const int *values, size_t count) {
+  return writeArray(values, count, sizeof(int));
+}
+
+Outcome DataOutputStream::writeFloatArray(const float *values, size_t count) {
+  return writeArray(values, count, sizeof(float));
+}
+
+void DataOutputStream::flush() {
+  if (stream != NULL) {
+    stream->flush();
+  }
+}
+
+}
@@ -0,0 +1,93 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_DATA_OUTPUT_STREAM_H__
+#define __VE_DATA_OUTPUT_STREAM_H__
+
+#include "common.h"
+#include "io/byte_order.h"
+#include "io/output_stream.h"
+
+namespace ve {
+
+/**
+    Writes binary values to an output stream in the given byte order. Arrays
+    are written with one call of the stream if byte order matches the machine,
+    otherwise they are converted in small blocks. Wrap the target into a
+    BufferedOutputStream if many single values are written.
+*/
+class DataOutputStream {
+private:
+  /** Stream to write data to, it is not owned */
+  OutputStream *stream;
+
+  /** Byte order of the data */
+  ByteOrder order;
+
+  /** Values are swapped because byte order differs from the machine */
+  bool swap;
+
+  /**
+      Writes bytes to the stream.
+      @return OK if all bytes were written.
+      @return IO_ERROR otherwise.
+  */
+  Outcome writeBytes(const void *data, size_t count);
+
+  /**
+      Writes array of 16- or 32-bit values.
+  */
+  Outcome writeArray(const void *values, size_t count, size_t size);
+
+public:
+  /**
+      Creates writer.
+      @param stream - Stream to write data to, it is not deleted by the writer.
+      @param order - Byte order of the data.
+  */
+  DataOutputStream(OutputStream *stream, ByteOrder order = LITTLE_ENDIAN_ORDER);
+
+  /**
+      Sets byte order of the following values.
+      @param order - Byte order of the data.
+  */
+  void setByteOrder(ByteOrder order);
+
+  /**
+      Returns byte order of the data.
+      @return Byte order.
+  */
+  ByteOrder getByteOrder();
+
+  /**
+      Writes one value.
+      @param value - Value to write.
+      @return OK if value was written.
+      @return IO_ERROR if stream error occurred.
+  */
+  Outcome writeInt8(char value);
+  Outcome writeInt16(short value);
+  Outcome writeInt32(int value);
+  Outcome writeFloat(float value);
+
+  /**
+      Writes array of values.
+      @param values - Values to write.
+      @param count - Number of values.
+      @return OK if values were written.
+      @return IO_ERROR if stream error occurred.
+  */
+  Outcome writeInt8Array(const char *values, size_t count);
+  Outcome writeInt16Array(const short *values, size_t count);
+  Outcome writeInt32Array(const int *values, size_t count);
+  Outcome writeFloatArray(const float *values, size_t count);
+
+  /**
+      Flushes the stream.
+  */
+  void flush();
+};
+
+}
+
+#endif // __VE_DATA_OUTPUT_STREAM_H__
@@ -0,0 +1,47 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <sys/stat.h>
+
+#include "common.h"
+#include "io/directory_source.h"
+#include "io/mapped_file_input_stream.h"
+#include "loaders/loader.h"
+
+namespace ve {
+
+DirectorySource::DirectorySource(const std::string &root) {
+  this->root = root;
+  if (!this->root.empty() && this->root[this->root.length() - 1] != '/' &&
+      this->root[this->root.length() - 1] != '\\') {
+    this->root += '/';
+  }
+}
+
+std::string DirectorySource::getNativePath(const std::string &path) {
+  return root + path;
+}
+
+bool DirectorySource::exists(const std::string &path) {
+  struct stat st;
+  return stat(getNativePath(path).c_str(), &st) == 0 && (st.st_mode & S_IFMT) == S_IFREG;
+}
+
+Outcome DirectorySource::read(const std::string &path, std::vector<uchar> &data) {
+  MappedFileInputStream file(getNativePath(path));
+  ERROR_IF(!file.isOpened(), L"File can not be opened: " + StringTool::AsciiToWide(path), IO_ERROR);
+
+  data.assign(file.getData(), file.getData() + file.getSize());
+  return OK;
+}
+
+Outcome DirectorySource::load(const std::string &path, Loader *loader) {
+  CHECK_POINTER(loader);
+
+  MappedFileInputStream file(getNativePath(path));
+  ERROR_IF(!file.isOpened(), L"File can not be opened: " + StringTool::AsciiToWide(path), IO_ERROR);
+
+  return loader->load(file.getData(), file.getSize());
+}
+
+}
@@ -0,0 +1,42 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_DIRECTORY_SOURCE_H__
+#define __VE_DIRECTORY_SOURCE_H__
+
+#include <string>
+
+#include "common.h"
+#include "io/file_source.h"
+
+namespace ve {
+
+/**
+    Loose files of a directory. Files are mapped into memory, so loaders parse
+    them in place.
+*/
+class DirectorySource : public FileSource {
+private:
+  /** Path of the directory with a trailing separator or empty string */
+  std::string root;
+
+  /**
+      Returns native path of the file.
+  */
+  std::string getNativePath(const std::string &path);
+
+public:
+  /**
+      Constructor.
+      @param root - Path of the directory, empty string means the current directory.
+  */
+  DirectorySource(const std::string &root);
+
+  virtual bool exists(const std::string &path);
+  virtual Outcome read(const std::string &path, std::vector<uchar> &data);
+  virtual Outcome load(const std::string &path, Loader *loader);
+};
+
+}
+
+#endif // __VE_DIRECTORY_SOURCE_H__
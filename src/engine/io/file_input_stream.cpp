@@ -6,7 +6,7 @@
 namespace ve {
 
 FileInputStream::FileInputStream(std::string path) {
-  file = fopen(path.c_str(), "r");
+  file = fopen(path.c_str(), "rb");
 }
 
 FileInputStream::FileInputStream(FILE* file) {
@@ -29,7 +29,7 @@ char FileInputStream::read() {
 
 int FileInputStream::read(char* data, int offset, int count) {
   if (file) {
-    return (int)fread(data, count, 1, file);
+    return (int)fread(data + offset, 1, count, file);
   }
 
   return 0;
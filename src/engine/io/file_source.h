@@ -0,0 +1,56 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_FILE_SOURCE_H__
+#define __VE_FILE_SOURCE_H__
+
+#include <string>
+#include <vector>
+
+#include "common.h"
+
+namespace ve {
+
+class Loader;
+
+/**
+    Source of files which is mounted into VirtualFileSystem, for example a
+    directory or a pack archive. Paths are relative to the source, they are
+    normalized by VirtualFileSystem::normalize().
+*/
+class FileSource {
+public:
+  /**
+      Destructor.
+  */
+  virtual ~FileSource() {}
+
+  /**
+      Checks if source contains the file.
+      @param path - Path of the file.
+      @return 'true' if file exists.
+  */
+  virtual bool exists(const std::string &path) = 0;
+
+  /**
+      Reads whole file.
+      @param path - Path of the file.
+      @param data - Content of the file.
+      @return OK if file was read.
+      @return IO_ERROR if file does not exist or can not be read.
+  */
+  virtual Outcome read(const std::string &path, std::vector<uchar> &data) = 0;
+
+  /**
+      Passes content of the file to the loader without copying if it is possible.
+      @param path - Path of the file.
+      @param loader - Loader which parses the file.
+      @return Result of the loader.
+      @return IO_ERROR if file does not exist or can not be read.
+  */
+  virtual Outcome load(const std::string &path, Loader *loader) = 0;
+};
+
+}
+
+#endif // __VE_FILE_SOURCE_H__
@@ -0,0 +1,31 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_IO_LISTENER_H__
+#define __VE_IO_LISTENER_H__
+
+#include "common.h"
+#include "io/io_request.h"
+
+namespace ve {
+
+/**
+    IOListener is an interface for receiving finished read requests of IOService.
+    Listeners are called from IOService::dispatch(), so they run on the thread
+    which dispatches requests (usually the render loop) and may upload the data
+    to the GPU.
+*/
+class IOListener {
+public:
+
+  /**
+      Callback function which is invoked once for every request when it is
+      completed, failed or cancelled. Request is deleted after the call.
+      @param request - Finished request, its status tells the result.
+  */
+  virtual void processIORequest(IORequest *request) = 0;
+};
+
+}
+
+#endif // __VE_IO_LISTENER_H__
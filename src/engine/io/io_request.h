@@ -0,0 +1,90 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_IO_REQUEST_H__
+#define __VE_IO_REQUEST_H__
+
+#include <string>
+#include <vector>
+
+#include "common.h"
+
+namespace ve {
+
+/**
+    Priority of a read request, queued requests of higher priority are started first.
+*/
+enum IOPriority {
+  IO_PRIORITY_HIGH = 0,   /*!< Data which is needed for the next frames.  */
+  IO_PRIORITY_NORMAL,     /*!< Regular streaming.                          */
+  IO_PRIORITY_LOW,        /*!< Prefetching.                                */
+  IO_PRIORITIES_COUNT
+};
+
+/**
+    State of a read request.
+*/
+enum IOStatus {
+  IO_QUEUED = 0,    /*!< Request waits for an I/O thread.                 */
+  IO_RUNNING,       /*!< Data is being read.                              */
+  IO_COMPLETED,     /*!< Data was read, it may be shorter at end of file. */
+  IO_FAILED,        /*!< File could not be opened or read.                */
+  IO_CANCELLED      /*!< Request was cancelled, data is empty.            */
+};
+
+/** Identifier of a read request, 0 is never used */
+typedef uint IORequestId;
+
+class IOListener;
+
+/**
+    Read request of IOService. Requests are created and deleted by the service,
+    listener receives the request when it is finished and may take the data
+    with swap().
+*/
+struct IORequest {
+  /** Identifier returned by IOService::read() */
+  IORequestId id;
+
+  /** Path of the file */
+  std::string path;
+
+  /** Offset of the data in the file */
+  size_t offset;
+
+  /** Number of bytes to read, 0 means up to the end of the file */
+  size_t length;
+
+  /** Priority of the request */
+  IOPriority priority;
+
+  /** Listener which is called when the request is finished */
+  IOListener *listener;
+
+  /** User data of the request */
+  void *context;
+
+  /** State of the request */
+  volatile IOStatus status;
+
+  /** Request should be cancelled when it is finished */
+  volatile int cancelled;
+
+  /** Read data */
+  std::vector<uchar> data;
+
+  /** Number of bytes read so far, it is used by backends */
+  size_t done;
+
+  /** File opened by the backend */
+#ifdef VE_WINDOWS
+  HANDLE file;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  int file;
+#endif // VE_LINUX
+};
+
+}
+
+#endif // __VE_IO_REQUEST_H__
@@ -0,0 +1,539 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <algorithm>
+#include <string.h>
+
+#ifdef VE_LINUX
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/eventfd.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // VE_LINUX
+
+#include "common.h"
+#include "io/io_service.h"
+#include "io/linux_io_ring.h"
+#include "windows/atomic.h"
+#include "windows/critical_section.h"
+#include "windows/semaphore.h"
+#include "windows/thread_factory.h"
+
+namespace ve {
+
+/* Maximal number of bytes read with one call */
+static const size_t READ_CHUNK = 1 << 30;
+
+IOService::IOService(uint threadsCount, uint queueDepth, bool ringAllowed) {
+  this->threadsCount = threadsCount != 0 ? threadsCount : 1;
+  this->queueDepth = queueDepth != 0 ? queueDepth : 1;
+  this->ringAllowed = ringAllowed;
+
+  lock = new CriticalSection();
+  nextId = 1;
+  running = 0;
+  activeThreads = 0;
+  wakeupSemaphore = new Semaphore();
+  wakingThreads = 0;
+
+#ifdef VE_LINUX
+  ioRing = NULL;
+  wakeupEvent = -1;
+#endif // VE_LINUX
+}
+
+IOService::~IOService() {
+  stop();
+
+  for (size_t i = 0; i < finished.size(); i++) {
+    delete finished[i];
+  }
+
+  delete wakeupSemaphore;
+  delete lock;
+}
+
+Outcome IOService::start() {
+  if (running) {
+    return OK;
+  }
+
+  running = 1;
+
+#ifdef VE_LINUX
+  /* Ring holds the reads and the poll of the wakeup event */
+  if (ringAllowed) {
+    LinuxIORing *ring = new LinuxIORing();
+    CHECK_ALLOC(ring);
+
+    if (ring->initialize(queueDepth + 2) == OK) {
+      wakeupEvent = eventfd(0, EFD_NONBLOCK);
+    }
+
+    /* Ring is published when the event is ready, wakeUp() may be called by other threads */
+    if (wakeupEvent < 0) {
+      DEBUG_INFO(L"io_uring is not available, thread pool is used");
+      delete ring;
+    } else {
+      memoryBarrier();
+      ioRing = ring;
+    }
+  }
+
+  if (ioRing != NULL) {
+    activeThreads = 1;
+    memoryBarrier();
+
+    if (ThreadFactory::getInstance()->spawn(ringEntry, this) != OK) {
+      activeThreads = 0;
+      running = 0;
+      closeRing();
+      return ERROR;
+    }
+
+    /* Requests which were queued before start */
+    wakeUp();
+    return OK;
+  }
+#endif // VE_LINUX
+
+  activeThreads = threadsCount;
+  memoryBarrier();
+
+  for (uint i = 0; i < threadsCount; i++) {
+    if (ThreadFactory::getInstance()->spawn(poolEntry, this) != OK) {
+      /* Threads which were started are stopped, others are not counted */
+      for (uint j = i; j < threadsCount; j++) {
+        atomicDecrement(&activeThreads);
+      }
+      stop();
+      return ERROR;
+    }
+  }
+
+  return OK;
+}
+
+void IOService::stop() {
+  if (!running) {
+    return;
+  }
+
+  lock->lock();
+  running = 0;
+
+  for (int priority = 0; priority < IO_PRIORITIES_COUNT; priority++) {
+    std::deque<IORequest*> &queue = queues[priority];
+    for (size_t i = 0; i < queue.size(); i++) {
+      queue[i]->status = IO_CANCELLED;
+      requests.erase(queue[i]->id);
+      finished.push_back(queue[i]);
+    }
+    queue.clear();
+  }
+
+  lock->unlock();
+  memoryBarrier();
+
+  /* Threads can not be joined, so their counter is awaited */
+  for (uint i = 0; i < threadsCount; i++) {
+    wakeUp();
+  }
+  while (activeThreads != 0) {
+    wakeUp();
+    yieldThread();
+  }
+
+#ifdef VE_LINUX
+  closeRing();
+#endif // VE_LINUX
+}
+
+#ifdef VE_LINUX
+void IOService::closeRing() {
+  if (ioRing == NULL) {
+    return;
+  }
+
+  /* Threads which queue requests may be in wakeUp(), later ones post the semaphore */
+  LinuxIORing *ring = ioRing;
+  ioRing = NULL;
+  memoryBarrier();
+  while (wakingThreads != 0) {
+    yieldThread();
+  }
+
+  delete ring;
+  close(wakeupEvent);
+  wakeupEvent = -1;
+}
+#endif // VE_LINUX
+
+IORequestId IOService::read(const std::string &path, size_t offset, size_t length, IOListener *listener,
+  IOPriority priority, void *context) {
+  IORequest *request = new IORequest();
+  request->path = path;
+  request->offset = offset;
+  request->length = length;
+  request->priority = priority >= IO_PRIORITY_HIGH && priority < IO_PRIORITIES_COUNT ? priority : IO_PRIORITY_LOW;
+  request->listener = listener;
+  request->context = context;
+  request->status = IO_QUEUED;
+  request->cancelled = 0;
+  request->done = 0;
+#ifdef VE_WINDOWS
+  request->file = INVALID_HANDLE_VALUE;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  request->file = -1;
+#endif // VE_LINUX
+
+  lock->lock();
+  request->id = nextId++;
+  if (nextId == 0) {
+    nextId = 1;
+  }
+  IORequestId id = request->id;
+  requests[id] = request;
+  queues[request->priority].push_back(request);
+  lock->unlock();
+
+  /* Semaphore of the pool counts requests which were queued before start() too */
+  wakeUp();
+
+  return id;
+}
+
+bool IOService::cancel(IORequestId id) {
+  lock->lock();
+
+  std::map<IORequestId, IORequest*>::iterator found = requests.find(id);
+  if (found == requests.end()) {
+    lock->unlock();
+    return false;
+  }
+
+  IORequest *request = found->second;
+  request->cancelled = 1;
+
+  /* Queued request is finished at once, running one is finished by its I/O thread */
+  if (request->status == IO_QUEUED) {
+    std::deque<IORequest*> &queue = queues[request->priority];
+    queue.erase(std::find(queue.begin(), queue.end(), request));
+    requests.erase(found);
+    request->status = IO_CANCELLED;
+    finished.push_back(request);
+  }
+
+  lock->unlock();
+  return true;
+}
+
+uint IOService::dispatch(uint limit) {
+  std::vector<IORequest*> ready;
+
+  lock->lock();
+  size_t count = limit != 0 && limit < finished.size() ? limit : finished.size();
+  ready.assign(finished.begin(), finished.begin() + count);
+  finished.erase(finished.begin(), finished.begin() + count);
+  lock->unlock();
+
+  /* Listeners are called without the lock, so they may queue and cancel requests */
+  for (size_t i = 0; i < ready.size(); i++) {
+    if (ready[i]->listener != NULL) {
+      ready[i]->listener->processIORequest(ready[i]);
+    }
+    delete ready[i];
+  }
+
+  return (uint)ready.size();
+}
+
+uint IOService::getPendingCount() {
+  lock->lock();
+  uint count = (uint)requests.size();
+  lock->unlock();
+  return count;
+}
+
+bool IOService::isRingUsed() {
+#ifdef VE_LINUX
+  return ioRing != NULL;
+#else
+  return false;
+#endif // VE_LINUX
+}
+
+unsigned long IOService::poolEntry(void *parameter) {
+  ((IOService*)parameter)->runPool();
+  return 0;
+}
+
+unsigned long IOService::ringEntry(void *parameter) {
+  ((IOService*)parameter)->runRing();
+  return 0;
+}
+
+IORequest *IOService::takeRequest() {
+  IORequest *request = NULL;
+
+  lock->lock();
+  for (int priority = 0; priority < IO_PRIORITIES_COUNT && request == NULL; priority++) {
+    if (!queues[priority].empty()) {
+      request = queues[priority].front();
+      queues[priority].pop_front();
+      request->status = IO_RUNNING;
+    }
+  }
+  lock->unlock();
+
+  return request;
+}
+
+bool IOService::openRequest(IORequest *request) {
+#ifdef VE_WINDOWS
+  request->file = CreateFileA(request->path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+    FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (request->file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+
+  if (request->length == 0) {
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(request->file, &size)) {
+      return false;
+    }
+    request->length = (size_t)size.QuadPart > request->offset ? (size_t)size.QuadPart - request->offset : 0;
+  }
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  request->file = open(request->path.c_str(), O_RDONLY);
+  if (request->file < 0) {
+    return false;
+  }
+
+  if (request->length == 0) {
+    struct stat info;
+    if (fstat(request->file, &info) != 0) {
+      return false;
+    }
+    request->length = (size_t)info.st_size > request->offset ? (size_t)info.st_size - request->offset : 0;
+  }
+#endif // VE_LINUX
+
+  request->data.resize(request->length);
+  return true;
+}
+
+bool IOService::readRequest(IORequest *request) {
+  while (request->done < request->length && !request->cancelled) {
+    size_t count = request->length - request->done;
+    if (count > READ_CHUNK) {
+      count = READ_CHUNK;
+    }
+
+#ifdef VE_WINDOWS
+    size_t position = request->offset + request->done;
+    OVERLAPPED overlapped;
+    memset(&overlapped, 0, sizeof(overlapped));
+    overlapped.Offset = (DWORD)position;
+    overlapped.OffsetHigh = (DWORD)((unsigned long long)position >> 32);
+
+    DWORD received = 0;
+    if (!ReadFile(request->file, &request->data[request->done], (DWORD)count, &received, &overlapped)) {
+      if (GetLastError() != ERROR_HANDLE_EOF) {
+        return false;
+      }
+    }
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+    ssize_t received = pread(request->file, &request->data[request->done], count,
+      (off_t)(request->offset + request->done));
+    if (received < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+#endif // VE_LINUX
+
+    /* File is shorter than requested */
+    if (received == 0) {
+      break;
+    }
+    request->done += received;
+  }
+
+  return true;
+}
+
+bool IOService::submitRequest(IORequest *request) {
+#ifdef VE_LINUX
+  size_t count = request->length - request->done;
+  if (count > READ_CHUNK) {
+    count = READ_CHUNK;
+  }
+
+  return ioRing->prepareRead(request->file, &request->data[request->done], (uint)count,
+    request->offset + request->done, request);
+#else
+  return false;
+#endif // VE_LINUX
+}
+
+void IOService::finish(IORequest *request, IOStatus status) {
+#ifdef VE_WINDOWS
+  if (request->file != INVALID_HANDLE_VALUE) {
+    CloseHandle(request->file);
+    request->file = INVALID_HANDLE_VALUE;
+  }
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  if (request->file >= 0) {
+    close(request->file);
+    request->file = -1;
+  }
+#endif // VE_LINUX
+
+  lock->lock();
+  if (request->cancelled) {
+    status = IO_CANCELLED;
+  }
+
+  if (status == IO_COMPLETED) {
+    request->data.resize(request->done);
+  } else {
+    std::vector<uchar>().swap(request->data);
+  }
+
+  request->status = status;
+  requests.erase(request->id);
+  finished.push_back(request);
+  lock->unlock();
+}
+
+void IOService::wakeUp() {
+#ifdef VE_WINDOWS
+  wakeupSemaphore->post();
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  /* Increment is a full barrier, so either stop() waits for this thread or the ring is NULL here */
+  atomicIncrement(&wakingThreads);
+  if (ioRing != NULL) {
+    uint64_t value = 1;
+    if (write(wakeupEvent, &value, sizeof(value)) < 0) {
+      /* Counter is full, so the thread is woken up anyway */
+    }
+  } else {
+    wakeupSemaphore->post();
+  }
+  atomicDecrement(&wakingThreads);
+#endif // VE_LINUX
+}
+
+void IOService::waitForRequests() {
+  wakeupSemaphore->wait();
+}
+
+void IOService::runPool() {
+  for (;;) {
+    waitForRequests();
+
+    /* Semaphore counts requests, but cancelled ones are removed, so the queue may be empty */
+    IORequest *request = takeRequest();
+    if (request == NULL) {
+      if (!running) {
+        break;
+      }
+      continue;
+    }
+
+    if (!openRequest(request)) {
+      finish(request, IO_FAILED);
+      continue;
+    }
+
+    finish(request, readRequest(request) ? IO_COMPLETED : IO_FAILED);
+  }
+
+  memoryBarrier();
+  atomicDecrement(&activeThreads);
+}
+
+void IOService::runRing() {
+#ifdef VE_LINUX
+  uint inFlight = 0;
+  bool pollArmed = false;
+
+  while (running || inFlight != 0) {
+    /* Poll of the wakeup event is the only completion without a request */
+    if (running && !pollArmed) {
+      pollArmed = ioRing->preparePoll(wakeupEvent, NULL);
+    }
+
+    while (running && inFlight < queueDepth) {
+      IORequest *request = takeRequest();
+      if (request == NULL) {
+        break;
+      }
+
+      if (!openRequest(request)) {
+        finish(request, IO_FAILED);
+      } else if (request->length == 0) {
+        finish(request, IO_COMPLETED);
+      } else if (!submitRequest(request)) {
+        finish(request, IO_FAILED);
+      } else {
+        inFlight++;
+      }
+    }
+
+    if (ioRing->submitAndWait(1) != OK) {
+      yieldThread();
+      continue;
+    }
+
+    void *userData;
+    int result;
+    while (ioRing->takeCompletion(userData, result)) {
+      if (userData == NULL) {
+        uint64_t value;
+        while (::read(wakeupEvent, &value, sizeof(value)) > 0) {
+        }
+        pollArmed = false;
+        continue;
+      }
+
+      IORequest *request = (IORequest*)userData;
+      if (result == -EINTR || result == -EAGAIN) {
+        result = 0;
+      } else if (result < 0) {
+        finish(request, IO_FAILED);
+        inFlight--;
+        continue;
+      } else if (result == 0) {
+        /* File is shorter than requested */
+        finish(request, IO_COMPLETED);
+        inFlight--;
+        continue;
+      }
+
+      request->done += result;
+      if (request->done == request->length || request->cancelled) {
+        finish(request, IO_COMPLETED);
+        inFlight--;
+      } else if (!submitRequest(request)) {
+        finish(request, IO_FAILED);
+        inFlight--;
+      }
+    }
+  }
+#endif // VE_LINUX
+
+  memoryBarrier();
+  atomicDecrement(&activeThreads);
+}
+
+}
@@ -0,0 +1,228 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_IO_SERVICE_H__
+#define __VE_IO_SERVICE_H__
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "common.h"
+#include "io/io_listener.h"
+#include "io/io_request.h"
+
+namespace ve {
+
+class CriticalSection;
+class LinuxIORing;
+class Semaphore;
+
+/**
+    Reads files asynchronously on dedicated I/O threads, so streaming of
+    textures and models does not block the render loop on disk.
+
+    read() queues a request and returns at once. Queued requests are started in
+    order of priority, requests of one priority are started in order of
+    arrival. Finished requests are collected and their listeners are called by
+    dispatch() on the thread which calls it, usually once per frame, so
+    listeners may create GPU resources from the data.
+
+    On Linux with io_uring (kernel 5.6 and newer) one I/O thread keeps up to
+    queueDepth reads in flight in the kernel. Otherwise a pool of threads
+    executes blocking positional reads (pread() on Linux, ReadFile() with an
+    offset on Windows).
+
+    Queued requests are cancelled immediately. Requests which are already
+    being read are finished with IO_CANCELLED and their data is dropped. Every
+    request reaches its listener exactly once.
+*/
+class IOService {
+private:
+  /** Number of threads of the pool */
+  uint threadsCount;
+
+  /** Maximal number of requests read at once */
+  uint queueDepth;
+
+  /** io_uring may be used */
+  bool ringAllowed;
+
+  /** Guards queues and lists of requests */
+  CriticalSection *lock;
+
+  /** Queued requests, one queue per priority */
+  std::deque<IORequest*> queues[IO_PRIORITIES_COUNT];
+
+  /** Queued and running requests */
+  std::map<IORequestId, IORequest*> requests;
+
+  /** Finished requests which were not dispatched */
+  std::vector<IORequest*> finished;
+
+  /** Identifier of the next request */
+  IORequestId nextId;
+
+  /** I/O threads should work */
+  volatile int running;
+
+  /** Number of I/O threads which did not finish */
+  volatile uint activeThreads;
+
+  /** Semaphore which counts queued requests for the pool */
+  Semaphore *wakeupSemaphore;
+
+  /** Number of threads inside wakeUp(), stop() does not close the ring while they are there */
+  volatile uint wakingThreads;
+
+#ifdef VE_LINUX
+  /** Ring of the I/O thread or NULL if the pool is used */
+  LinuxIORing * volatile ioRing;
+
+  /** Event which wakes the ring thread up */
+  int wakeupEvent;
+#endif // VE_LINUX
+
+  /**
+      Entry points of I/O threads.
+  */
+  static unsigned long poolEntry(void *parameter);
+  static unsigned long ringEntry(void *parameter);
+
+  /**
+      Loop of a pool thread.
+  */
+  void runPool();
+
+  /**
+      Loop of the ring thread.
+  */
+  void runRing();
+
+  /**
+      Takes queued request of the highest priority.
+      @return Request or NULL if there are no queued requests.
+  */
+  IORequest *takeRequest();
+
+  /**
+      Opens the file of the request and allocates memory for the data.
+      @return 'false' if file can not be opened.
+  */
+  bool openRequest(IORequest *request);
+
+  /**
+      Reads the data of the request with blocking calls.
+      @return 'false' if read failed.
+  */
+  bool readRequest(IORequest *request);
+
+  /**
+      Submits read of the rest of the data to the ring.
+  */
+  bool submitRequest(IORequest *request);
+
+  /**
+      Closes the file and passes the request to dispatch().
+  */
+  void finish(IORequest *request, IOStatus status);
+
+  /**
+      Wakes an I/O thread up. It may be called from any thread, also while stop() runs.
+  */
+  void wakeUp();
+
+  /**
+      Waits for queued requests.
+  */
+  void waitForRequests();
+
+#ifdef VE_LINUX
+  /**
+      Deletes the ring and closes the wakeup event after threads leave wakeUp().
+  */
+  void closeRing();
+#endif // VE_LINUX
+
+  /**
+      Private copy-constructor.
+  */
+  IOService(const IOService &ref);
+
+  /**
+      Private operator =
+  */
+  IOService &operator = (const IOService &ref);
+
+public:
+  /**
+      Constructor. I/O threads are started by start().
+      @param threadsCount - Number of threads if the pool is used.
+      @param queueDepth - Number of reads in flight if io_uring is used.
+      @param ringAllowed - 'false' forces the pool even if io_uring is available.
+  */
+  IOService(uint threadsCount = 2, uint queueDepth = 32, bool ringAllowed = true);
+
+  /**
+      Destructor. Stops I/O threads, requests which were not dispatched are
+      deleted without calling listeners.
+  */
+  ~IOService();
+
+  /**
+      Starts I/O threads.
+      @return OK if threads were started.
+      @return ERROR if OS error occurred.
+  */
+  Outcome start();
+
+  /**
+      Cancels queued requests and stops I/O threads after running reads are finished.
+  */
+  void stop();
+
+  /**
+      Queues read request. It may be called from any thread.
+      @param path - Path of the file.
+      @param offset - Offset of the data in the file.
+      @param length - Number of bytes to read, 0 reads up to the end of the file.
+      @param listener - Listener which receives the finished request.
+      @param priority - Priority of the request.
+      @param context - User data which is passed with the request.
+      @return Identifier of the request.
+  */
+  IORequestId read(const std::string &path, size_t offset, size_t length, IOListener *listener,
+    IOPriority priority = IO_PRIORITY_NORMAL, void *context = NULL);
+
+  /**
+      Cancels request. Listener still receives it with IO_CANCELLED status.
+      @param id - Identifier of the request.
+      @return 'true' if request was queued or running.
+      @return 'false' if it was already finished.
+  */
+  bool cancel(IORequestId id);
+
+  /**
+      Calls listeners of finished requests and deletes the requests.
+      @param limit - Maximal number of requests to dispatch, 0 dispatches all of them.
+      @return Number of dispatched requests.
+  */
+  uint dispatch(uint limit = 0);
+
+  /**
+      Returns number of requests which are queued or running.
+      @return Number of unfinished requests.
+  */
+  uint getPendingCount();
+
+  /**
+      Checks if requests are read with io_uring.
+      @return 'true' if io_uring is used, 'false' if the thread pool is used.
+  */
+  bool isRingUsed();
+};
+
+}
+
+#endif // __VE_IO_SERVICE_H__
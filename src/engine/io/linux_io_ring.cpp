@@ -0,0 +1,265 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifdef VE_LINUX
+
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+#if !defined(VE_NO_IO_URING) && defined(__NR_io_uring_setup)
+#define VE_IO_URING
+#include <linux/io_uring.h>
+#endif // VE_IO_URING
+
+#include "io/linux_io_ring.h"
+
+namespace ve {
+
+LinuxIORing::LinuxIORing() {
+  ring = -1;
+  sqRing = cqRing = sqes = cqes = NULL;
+  sqRingSize = cqRingSize = sqesSize = 0;
+  sqHead = sqTail = cqHead = cqTail = NULL;
+  sqArray = NULL;
+  sqMask = sqEntries = cqMask = 0;
+  toSubmit = 0;
+}
+
+LinuxIORing::~LinuxIORing() {
+  release();
+}
+
+#ifdef VE_IO_URING
+
+/* Kernel writes completions and reads submissions concurrently with the thread */
+static inline void memoryBarrier() {
+  __sync_synchronize();
+}
+
+Outcome LinuxIORing::initialize(uint entries) {
+  release();
+
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+
+  ring = (int)syscall(__NR_io_uring_setup, entries, &params);
+  if (ring < 0) {
+    ring = -1;
+    return ERROR;
+  }
+
+  /* Operations are checked, because the ring exists on kernels without IORING_OP_READ */
+  size_t probeSize = sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op);
+  std::vector<uchar> probeBuffer(probeSize);
+  struct io_uring_probe *probe = (struct io_uring_probe*)&probeBuffer[0];
+
+  if (syscall(__NR_io_uring_register, ring, IORING_REGISTER_PROBE, probe, 256) < 0 ||
+      probe->last_op < IORING_OP_READ ||
+      !(probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED) ||
+      !(probe->ops[IORING_OP_POLL_ADD].flags & IO_URING_OP_SUPPORTED)) {
+    release();
+    return ERROR;
+  }
+
+  sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint);
+  cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  if (params.features & IORING_FEAT_SINGLE_MMAP) {
+    sqRingSize = cqRingSize = sqRingSize > cqRingSize ? sqRingSize : cqRingSize;
+  }
+
+  sqRing = mmap(NULL, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQ_RING);
+  if (sqRing == MAP_FAILED) {
+    sqRing = NULL;
+    release();
+    return ERROR;
+  }
+
+  if (params.features & IORING_FEAT_SINGLE_MMAP) {
+    cqRing = sqRing;
+  } else {
+    cqRing = mmap(NULL, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_CQ_RING);
+    if (cqRing == MAP_FAILED) {
+      cqRing = NULL;
+      release();
+      return ERROR;
+    }
+  }
+
+  sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+  sqes = mmap(NULL, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    sqes = NULL;
+    release();
+    return ERROR;
+  }
+
+  uchar *sq = (uchar*)sqRing;
+  sqHead = (volatile uint*)(sq + params.sq_off.head);
+  sqTail = (volatile uint*)(sq + params.sq_off.tail);
+  sqMask = *(uint*)(sq + params.sq_off.ring_mask);
+  sqEntries = params.sq_entries;
+  sqArray = (uint*)(sq + params.sq_off.array);
+
+  uchar *cq = (uchar*)cqRing;
+  cqHead = (volatile uint*)(cq + params.cq_off.head);
+  cqTail = (volatile uint*)(cq + params.cq_off.tail);
+  cqMask = *(uint*)(cq + params.cq_off.ring_mask);
+  cqes = cq + params.cq_off.cqes;
+
+  toSubmit = 0;
+  return OK;
+}
+
+void LinuxIORing::release() {
+  if (sqes != NULL) {
+    munmap(sqes, sqesSize);
+  }
+  if (cqRing != NULL && cqRing != sqRing) {
+    munmap(cqRing, cqRingSize);
+  }
+  if (sqRing != NULL) {
+    munmap(sqRing, sqRingSize);
+  }
+  if (ring >= 0) {
+    close(ring);
+  }
+
+  ring = -1;
+  sqRing = cqRing = sqes = cqes = NULL;
+  sqHead = sqTail = cqHead = cqTail = NULL;
+  sqArray = NULL;
+  toSubmit = 0;
+}
+
+void *LinuxIORing::getEntry() {
+  if (ring < 0) {
+    return NULL;
+  }
+
+  uint tail = *sqTail;
+  memoryBarrier();
+  if (tail - *sqHead >= sqEntries) {
+    return NULL;
+  }
+
+  uint index = tail & sqMask;
+  struct io_uring_sqe *entry = (struct io_uring_sqe*)sqes + index;
+  memset(entry, 0, sizeof(*entry));
+  sqArray[index] = index;
+  return entry;
+}
+
+bool LinuxIORing::prepareRead(int file, void *buffer, uint count, size_t offset, void *userData) {
+  struct io_uring_sqe *entry = (struct io_uring_sqe*)getEntry();
+  if (entry == NULL) {
+    return false;
+  }
+
+  entry->opcode = IORING_OP_READ;
+  entry->fd = file;
+  entry->addr = (unsigned long)buffer;
+  entry->len = count;
+  entry->off = offset;
+  entry->user_data = (unsigned long)userData;
+
+  /* Entry is visible to the kernel only after the tail is moved */
+  memoryBarrier();
+  *sqTail = *sqTail + 1;
+  toSubmit++;
+  return true;
+}
+
+bool LinuxIORing::preparePoll(int file, void *userData) {
+  struct io_uring_sqe *entry = (struct io_uring_sqe*)getEntry();
+  if (entry == NULL) {
+    return false;
+  }
+
+  entry->opcode = IORING_OP_POLL_ADD;
+  entry->fd = file;
+  entry->poll_events = POLLIN;
+  entry->user_data = (unsigned long)userData;
+
+  memoryBarrier();
+  *sqTail = *sqTail + 1;
+  toSubmit++;
+  return true;
+}
+
+Outcome LinuxIORing::submitAndWait(uint minComplete) {
+  CHECK_POINTER(sqRing);
+
+  uint flags = minComplete != 0 ? IORING_ENTER_GETEVENTS : 0;
+  for (;;) {
+    long result = syscall(__NR_io_uring_enter, ring, toSubmit, minComplete, flags, NULL, 0);
+    if (result >= 0) {
+      toSubmit -= (uint)result < toSubmit ? (uint)result : toSubmit;
+      return OK;
+    }
+
+    /* Wait is interrupted by signals, it is simply repeated */
+    ERROR_IF(errno != EINTR, L"io_uring_enter() failed with code: " + StringTool::intToStr(errno), IO_ERROR);
+  }
+}
+
+bool LinuxIORing::takeCompletion(void *&userData, int &result) {
+  if (ring < 0) {
+    return false;
+  }
+
+  uint head = *cqHead;
+  memoryBarrier();
+  if (head == *cqTail) {
+    return false;
+  }
+
+  /* Completion is read before the slot is returned to the kernel */
+  memoryBarrier();
+  struct io_uring_cqe *completion = (struct io_uring_cqe*)cqes + (head & cqMask);
+  userData = (void*)(unsigned long)completion->user_data;
+  result = completion->res;
+
+  memoryBarrier();
+  *cqHead = head + 1;
+  return true;
+}
+
+#else
+
+Outcome LinuxIORing::initialize(uint entries) {
+  return ERROR;
+}
+
+void LinuxIORing::release() {
+}
+
+void *LinuxIORing::getEntry() {
+  return NULL;
+}
+
+bool LinuxIORing::prepareRead(int file, void *buffer, uint count, size_t offset, void *userData) {
+  return false;
+}
+
+bool LinuxIORing::preparePoll(int file, void *userData) {
+  return false;
+}
+
+Outcome LinuxIORing::submitAndWait(uint minComplete) {
+  return ERROR;
+}
+
+bool LinuxIORing::takeCompletion(void *&userData, int &result) {
+  return false;
+}
+
+#endif // VE_IO_URING
+
+}
+
+#endif // VE_LINUX
@@ -0,0 +1,135 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifdef VE_LINUX
+
+#ifndef __VE_LINUX_IO_RING_H__
+#define __VE_LINUX_IO_RING_H__
+
+#include "common.h"
+
+namespace ve {
+
+/**
+    Minimal wrapper of a Linux io_uring instance which is used by IOService.
+    Ring is set up with system calls directly, so liburing is not required.
+    Submission and completion queues are shared memory with the kernel:
+    entries are filled by prepare*() and passed to the kernel with one call
+    of submitAndWait(), completions are taken with takeCompletion().
+
+    The ring is not thread-safe, it is used by one I/O thread. It is available
+    on kernels with IORING_OP_READ and IORING_OP_POLL_ADD (5.6 and newer) and
+    may be disabled at build time with VE_NO_IO_URING.
+*/
+class LinuxIORing {
+private:
+  /** Descriptor of the ring or -1 */
+  int ring;
+
+  /** Mapped submission and completion rings, they may be one mapping */
+  void *sqRing;
+  size_t sqRingSize;
+  void *cqRing;
+  size_t cqRingSize;
+
+  /** Mapped array of submission entries */
+  void *sqes;
+  size_t sqesSize;
+
+  /** Fields of the submission ring */
+  volatile uint *sqHead;
+  volatile uint *sqTail;
+  uint sqMask;
+  uint sqEntries;
+  uint *sqArray;
+
+  /** Fields of the completion ring */
+  volatile uint *cqHead;
+  volatile uint *cqTail;
+  uint cqMask;
+  void *cqes;
+
+  /** Number of prepared entries which were not passed to the kernel */
+  uint toSubmit;
+
+  /**
+      Takes free submission entry.
+      @return Entry or NULL if submission ring is full.
+  */
+  void *getEntry();
+
+  /**
+      Private copy-constructor.
+  */
+  LinuxIORing(const LinuxIORing &ref);
+
+  /**
+      Private operator =
+  */
+  LinuxIORing &operator = (const LinuxIORing &ref);
+
+public:
+  /**
+      Constructor. Ring is created by initialize().
+  */
+  LinuxIORing();
+
+  /**
+      Destructor. Releases the ring.
+  */
+  ~LinuxIORing();
+
+  /**
+      Creates the ring.
+      @param entries - Size of the submission ring.
+      @return OK if ring was created.
+      @return ERROR if io_uring or required operations are not supported.
+  */
+  Outcome initialize(uint entries);
+
+  /**
+      Releases the ring, requests in flight are abandoned.
+  */
+  void release();
+
+  /**
+      Prepares read of the file.
+      @param file - Descriptor of the file.
+      @param buffer - Buffer for data.
+      @param count - Number of bytes to read.
+      @param offset - Offset in the file.
+      @param userData - Value returned with the completion.
+      @return 'false' if submission ring is full.
+  */
+  bool prepareRead(int file, void *buffer, uint count, size_t offset, void *userData);
+
+  /**
+      Prepares one-shot wait until the descriptor becomes readable.
+      @param file - Descriptor to wait for.
+      @param userData - Value returned with the completion.
+      @return 'false' if submission ring is full.
+  */
+  bool preparePoll(int file, void *userData);
+
+  /**
+      Passes prepared entries to the kernel and waits for completions.
+      @param minComplete - Number of completions to wait for, 0 does not wait.
+      @return OK if entries were submitted.
+      @return IO_ERROR if system call failed.
+  */
+  Outcome submitAndWait(uint minComplete);
+
+  /**
+      Takes one completion.
+      @param userData - Value of the prepared entry.
+      @param result - Result of the operation: number of bytes or negative error code.
+      @return 'false' if there are no completions.
+  */
+  bool takeCompletion(void *&userData, int &result);
+};
+
+}
+
+#endif // __VE_LINUX_IO_RING_H__
+
+#endif // VE_LINUX
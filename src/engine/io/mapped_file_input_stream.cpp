@@ -0,0 +1,158 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifdef VE_LINUX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // VE_LINUX
+
+#include "io/mapped_file_input_stream.h"
+
+namespace ve {
+
+#ifdef VE_LINUX
+static int getAdvice(FileAccess access) {
+  return access == RANDOM_ACCESS ? MADV_RANDOM : MADV_SEQUENTIAL;
+}
+#endif // VE_LINUX
+
+MappedFileInputStream::MappedFileInputStream(std::string path, FileAccess access) {
+  view = NULL;
+  viewSize = 0;
+  opened = false;
+
+#ifdef VE_WINDOWS
+  mapping = NULL;
+  DWORD flags = access == RANDOM_ACCESS ? FILE_FLAG_RANDOM_ACCESS : FILE_FLAG_SEQUENTIAL_SCAN;
+  file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, flags, NULL);
+
+  if (file == INVALID_HANDLE_VALUE) {
+    return;
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) {
+    LOG_WIN_ERROR();
+    close();
+    return;
+  }
+
+  opened = true;
+  if (size.QuadPart == 0) {
+    return;
+  }
+
+  mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping != NULL) {
+    view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  }
+
+  if (view == NULL) {
+    LOG_WIN_ERROR();
+    close();
+    return;
+  }
+
+  viewSize = (size_t)size.QuadPart;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  file = open(path.c_str(), O_RDONLY);
+
+  if (file < 0) {
+    return;
+  }
+
+  struct stat info;
+  if (fstat(file, &info) != 0) {
+    LOG_ERROR(L"fstat() failed with code: " + StringTool::intToStr(errno));
+    close();
+    return;
+  }
+
+  opened = true;
+  if (info.st_size == 0) {
+    return;
+  }
+
+  view = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+  if (view == MAP_FAILED) {
+    LOG_ERROR(L"mmap() failed with code: " + StringTool::intToStr(errno));
+    view = NULL;
+    close();
+    return;
+  }
+
+  viewSize = (size_t)info.st_size;
+  madvise(view, viewSize, getAdvice(access));
+#endif // VE_LINUX
+
+  setData(view, viewSize);
+}
+
+MappedFileInputStream::~MappedFileInputStream() {
+  close();
+}
+
+bool MappedFileInputStream::isOpened() {
+  return opened;
+}
+
+void MappedFileInputStream::advise(FileAccess access) {
+#ifdef VE_LINUX
+  if (view != NULL) {
+    madvise(view, viewSize, getAdvice(access));
+  }
+#endif // VE_LINUX
+}
+
+void MappedFileInputStream::willNeed(size_t offset, size_t count) {
+#ifdef VE_LINUX
+  if (view == NULL || offset >= viewSize) {
+    return;
+  }
+
+  /* Range of madvise() starts at a page boundary */
+  size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  size_t start = offset - offset % page;
+  size_t end = offset + count < viewSize ? offset + count : viewSize;
+  madvise((char*)view + start, end - start, MADV_WILLNEED);
+#endif // VE_LINUX
+}
+
+void MappedFileInputStream::close() {
+  MemoryInputStream::close();
+  opened = false;
+
+#ifdef VE_WINDOWS
+  if (view != NULL) {
+    UnmapViewOfFile(view);
+  }
+
+  if (mapping != NULL) {
+    CloseHandle(mapping);
+    mapping = NULL;
+  }
+
+  if (file != INVALID_HANDLE_VALUE) {
+    CloseHandle(file);
+    file = INVALID_HANDLE_VALUE;
+  }
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  if (view != NULL) {
+    munmap(view, viewSize);
+  }
+
+  if (file >= 0) {
+    ::close(file);
+    file = -1;
+  }
+#endif // VE_LINUX
+
+  view = NULL;
+  viewSize = 0;
+}
+
+}
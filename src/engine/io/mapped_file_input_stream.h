@@ -0,0 +1,102 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_MAPPED_FILE_INPUT_STREAM_H__
+#define __VE_MAPPED_FILE_INPUT_STREAM_H__
+
+#include <string>
+
+#include "io/memory_input_stream.h"
+
+namespace ve {
+
+/**
+    Expected order of reads, it is passed to the OS as a paging hint.
+*/
+enum FileAccess {
+  SEQUENTIAL_ACCESS = 0,  /*!< File is read from the beginning to the end, pages are read ahead. */
+  RANDOM_ACCESS           /*!< File is read in random places, pages are not read ahead.         */
+};
+
+/**
+    Input stream which maps the whole file into memory. Reads, seeks and spans
+    are served directly from the mapping, so there is no system call and no
+    copying per read, and loaders may parse the file in place.
+
+    On Linux the access hint is passed to madvise(), on Windows it selects
+    FILE_FLAG_SEQUENTIAL_SCAN or FILE_FLAG_RANDOM_ACCESS when the file is opened.
+*/
+class MappedFileInputStream : public MemoryInputStream {
+private:
+#ifdef VE_WINDOWS
+  /** Handle of the file */
+  HANDLE file;
+
+  /** Handle of the mapping object */
+  HANDLE mapping;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  /** Descriptor of the file */
+  int file;
+#endif // VE_LINUX
+
+  /** Address of the mapping or NULL */
+  void *view;
+
+  /** Size of the mapping */
+  size_t viewSize;
+
+  /** File was opened, it may be empty */
+  bool opened;
+
+  /**
+      Private copy-constructor.
+  */
+  MappedFileInputStream(const MappedFileInputStream &ref);
+
+  /**
+      Private operator =
+  */
+  MappedFileInputStream &operator = (const MappedFileInputStream &ref);
+
+public:
+  /**
+      Opens and maps the file. Use isOpened() to check the result.
+      @param path - Path to the file.
+      @param access - Expected order of reads.
+  */
+  MappedFileInputStream(std::string path, FileAccess access = SEQUENTIAL_ACCESS);
+
+  /**
+      Unmaps and closes the file.
+  */
+  virtual ~MappedFileInputStream();
+
+  /**
+      Checks whether the file was opened and mapped.
+      @return 'true' if data of the file is available.
+  */
+  bool isOpened();
+
+  /**
+      Changes the access hint for the whole mapping. It does nothing on Windows.
+      @param access - Expected order of reads.
+  */
+  void advise(FileAccess access);
+
+  /**
+      Asks OS to read the range of the file in advance. It does nothing on Windows.
+      @param offset - Offset of the range.
+      @param count - Size of the range in bytes.
+  */
+  void willNeed(size_t offset, size_t count);
+
+  /**
+      Unmaps and closes the file.
+  */
+  virtual void close();
+};
+
+}
+
+#endif // __VE_MAPPED_FILE_INPUT_STREAM_H__
@@ -0,0 +1,109 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <string.h>
+
+#include "io/memory_input_stream.h"
+
+namespace ve {
+
+MemoryInputStream::MemoryInputStream() {
+  setData(NULL, 0);
+}
+
+MemoryInputStream::MemoryInputStream(const void *data, size_t size) {
+  setData(data, size);
+}
+
+MemoryInputStream::~MemoryInputStream() {
+}
+
+void MemoryInputStream::setData(const void *data, size_t size) {
+  this->data = (const uchar*)data;
+  this->size = data != NULL ? size : 0;
+  position = 0;
+}
+
+char MemoryInputStream::read() {
+  if (position < size) {
+    return (char)data[position++];
+  }
+
+  return 0;
+}
+
+int MemoryInputStream::read(char* data, int offset, int count) {
+  if (count <= 0) {
+    return 0;
+  }
+
+  size_t length = (size_t)count < getRemaining() ? (size_t)count : getRemaining();
+  memcpy(data + offset, this->data + position, length);
+  position += length;
+  return (int)length;
+}
+
+bool MemoryInputStream::available() {
+  return position < size;
+}
+
+void MemoryInputStream::close() {
+  setData(NULL, 0);
+}
+
+bool MemoryInputStream::readBytes(void *destination, size_t count) {
+  const uchar *span = getSpan(count);
+
+  if (span == NULL) {
+    return false;
+  }
+
+  memcpy(destination, span, count);
+  return true;
+}
+
+const uchar *MemoryInputStream::getSpan(size_t count) {
+  if (count > getRemaining()) {
+    return NULL;
+  }
+
+  const uchar *span = data + position;
+  position += count;
+  return span;
+}
+
+bool MemoryInputStream::seek(size_t position) {
+  if (position > size) {
+    return false;
+  }
+
+  this->position = position;
+  return true;
+}
+
+bool MemoryInputStream::skip(size_t count) {
+  if (count > getRemaining()) {
+    return false;
+  }
+
+  position += count;
+  return true;
+}
+
+size_t MemoryInputStream::getPosition() {
+  return position;
+}
+
+size_t MemoryInputStream::getSize() {
+  return size;
+}
+
+size_t MemoryInputStream::getRemaining() {
+  return size - position;
+}
+
+const uchar *MemoryInputStream::getData() {
+  return data;
+}
+
+}
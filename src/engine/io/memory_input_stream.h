@@ -0,0 +1,137 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_MEMORY_INPUT_STREAM_H__
+#define __VE_MEMORY_INPUT_STREAM_H__
+
+#include "io/input_stream.h"
+
+namespace ve {
+
+/**
+    Input stream which reads data from a block of memory. Memory is not copied
+    and it should live while the stream is used. Besides the byte reads of
+    InputStream it allows seeking and taking spans of data without copying.
+*/
+class MemoryInputStream : public InputStream {
+private:
+  /** First byte of the data */
+  const uchar *data;
+
+  /** Size of the data in bytes */
+  size_t size;
+
+  /** Position of the next byte to read */
+  size_t position;
+
+protected:
+  /**
+      Replaces data of the stream and moves to its beginning.
+      @param data - First byte of the data.
+      @param size - Size of the data in bytes.
+  */
+  void setData(const void *data, size_t size);
+
+public:
+  /**
+      Creates empty stream.
+  */
+  MemoryInputStream();
+
+  /**
+      Creates stream over the memory block.
+      @param data - First byte of the data.
+      @param size - Size of the data in bytes.
+  */
+  MemoryInputStream(const void *data, size_t size);
+
+  /**
+      Destructor. Memory is not freed.
+  */
+  virtual ~MemoryInputStream();
+
+  /**
+      Reads exactly one byte from this input stream.
+      @return byte that was read from the stream or 0 at the end of the data.
+  */
+  virtual char read();
+
+  /**
+      Reads array of bytes from this stream.
+      @param data - Buffer pointer to write data.
+      @param offset - Offset in bytes to write array.
+      @param count - Number of bytes to read from the stream.
+      @return Number of read bytes (value from 0 to count).
+  */
+  virtual int read(char* data, int offset, int count);
+
+  /**
+      Checks if at least one more byte is available at this stream.
+      @return true if there is at least one byte to read.
+      @return false if there is no data to read.
+  */
+  virtual bool available();
+
+  /**
+      Closes this stream, no data is available after it.
+  */
+  virtual void close();
+
+  /**
+      Reads exactly count bytes. Nothing is read if there are less bytes.
+      @param destination - Buffer for the data.
+      @param count - Number of bytes to read.
+      @return 'true' if bytes were read.
+      @return 'false' if the stream ends earlier.
+  */
+  bool readBytes(void *destination, size_t count);
+
+  /**
+      Returns span of data at the current position and moves past it.
+      @param count - Size of the span in bytes.
+      @return Pointer to the first byte or NULL if the stream ends earlier.
+  */
+  const uchar *getSpan(size_t count);
+
+  /**
+      Moves to the position from the beginning of the data.
+      @param position - New position.
+      @return 'false' if position is beyond the end of the data.
+  */
+  bool seek(size_t position);
+
+  /**
+      Moves forward.
+      @param count - Number of bytes to skip.
+      @return 'false' if the stream ends earlier, position is not changed then.
+  */
+  bool skip(size_t count);
+
+  /**
+      Returns the current position.
+      @return Offset of the next byte from the beginning of the data.
+  */
+  size_t getPosition();
+
+  /**
+      Returns size of the data.
+      @return Size in bytes.
+  */
+  size_t getSize();
+
+  /**
+      Returns number of bytes after the current position.
+      @return Number of bytes which may be read.
+  */
+  size_t getRemaining();
+
+  /**
+      Returns all data of the stream.
+      @return Pointer to the first byte or NULL if stream is empty.
+  */
+  const uchar *getData();
+};
+
+}
+
+#endif // __VE_MEMORY_INPUT_STREAM_H__
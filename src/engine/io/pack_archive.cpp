@@ -0,0 +1,201 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include "common.h"
+#include "io/mapped_file_input_stream.h"
+#include "io/pack_archive.h"
+#include "loaders/loader.h"
+#include "tools/crc32.h"
+#include "zlib/zlib.h"
+
+namespace ve {
+
+/* Reads little-endian number */
+static inline uint readUint(const uchar *data) {
+  return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint)data[3] << 24);
+}
+
+PackArchive::PackArchive() {
+  file = NULL;
+  names = NULL;
+}
+
+PackArchive::~PackArchive() {
+  close();
+}
+
+Outcome PackArchive::open(const std::string &path) {
+  close();
+
+  file = new MappedFileInputStream(path, RANDOM_ACCESS);
+  CHECK_ALLOC(file);
+
+  if (!file->isOpened()) {
+    close();
+    FAIL(L"Pack archive can not be opened: " + StringTool::AsciiToWide(path), IO_ERROR);
+  }
+
+  const uchar *data = file->getData();
+  size_t size = file->getSize();
+
+  if (size < sizeof(PackHeader) + sizeof(PackFooter) || readUint(data) != PACK_MAGIC ||
+      readUint(data + sizeof(uint)) != PACK_VERSION) {
+    close();
+    FAIL(L"File is not a pack archive: " + StringTool::AsciiToWide(path), ERROR);
+  }
+
+  const uchar *footer = data + size - sizeof(PackFooter);
+  uint entriesCount = readUint(footer + 8);
+  size_t tocOffset = readUint(footer + 12);
+  size_t tocSize = readUint(footer + 16);
+  uint tocCRC = readUint(footer + 20);
+
+  /* Table must fit between the header and the footer and hold all entries */
+  if (readUint(footer) != PACK_MAGIC || tocOffset < sizeof(PackHeader) ||
+      tocOffset + tocSize > size - sizeof(PackFooter) || (size_t)entriesCount * sizeof(PackEntry) > tocSize ||
+      CRC32::compute(data + tocOffset, tocSize) != tocCRC) {
+    close();
+    FAIL(L"Table of contents of pack archive is corrupted: " + StringTool::AsciiToWide(path), ERROR);
+  }
+
+  const uchar *table = data + tocOffset;
+  size_t namesSize = tocSize - entriesCount * sizeof(PackEntry);
+  names = (const char*)table + entriesCount * sizeof(PackEntry);
+
+  entries.resize(entriesCount);
+  for (uint i = 0; i < entriesCount; i++) {
+    const uchar *source = table + i * sizeof(PackEntry);
+    PackEntry &entry = entries[i];
+    entry.nameOffset = readUint(source);
+    entry.offset = readUint(source + 4);
+    entry.storedSize = readUint(source + 8);
+    entry.size = readUint(source + 12);
+    entry.crc = readUint(source + 16);
+    uint packed = readUint(source + 20);
+    entry.nameLength = (ushort)(packed & 0xffff);
+    entry.flags = (ushort)(packed >> 16);
+
+    /* Stored entries are handed out from the mapping, so both sizes must match */
+    if ((size_t)entry.nameOffset + entry.nameLength > namesSize ||
+        (size_t)entry.offset + entry.storedSize > tocOffset ||
+        (!(entry.flags & PACK_ENTRY_DEFLATE) && entry.size != entry.storedSize)) {
+      close();
+      FAIL(L"Entry of pack archive is corrupted: " + StringTool::AsciiToWide(path), ERROR);
+    }
+  }
+
+  this->path = path;
+  return OK;
+}
+
+void PackArchive::close() {
+  if (file != NULL) {
+    file->close();
+    delete file;
+    file = NULL;
+  }
+
+  entries.clear();
+  names = NULL;
+  path.clear();
+}
+
+std::string PackArchive::getPath() {
+  return path;
+}
+
+uint PackArchive::getEntriesCount() {
+  return (uint)entries.size();
+}
+
+const PackEntry *PackArchive::getEntry(uint index) {
+  return index < entries.size() ? &entries[index] : NULL;
+}
+
+std::string PackArchive::getName(const PackEntry *entry) {
+  if (entry == NULL || names == NULL) {
+    return std::string();
+  }
+  return std::string(names + entry->nameOffset, entry->nameLength);
+}
+
+const PackEntry *PackArchive::find(const std::string &name) {
+  size_t low = 0;
+  size_t high = entries.size();
+
+  while (low < high) {
+    size_t middle = (low + high) / 2;
+    const PackEntry &entry = entries[middle];
+    int result = comparePackNames(names + entry.nameOffset, entry.nameLength, name.data(), name.length());
+
+    if (result == 0) {
+      return &entry;
+    } else if (result < 0) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+
+  return NULL;
+}
+
+const uchar *PackArchive::getData(const PackEntry *entry) {
+  if (entry == NULL || file == NULL) {
+    return NULL;
+  }
+  return file->getData() + entry->offset;
+}
+
+Outcome PackArchive::read(const PackEntry *entry, std::vector<uchar> &data) {
+  CHECK_POINTER(entry);
+  CHECK_POINTER(file);
+
+  const uchar *stored = getData(entry);
+
+  if (entry->flags & PACK_ENTRY_DEFLATE) {
+    /* Inflater takes its source as a vector */
+    std::vector<uchar> compressed(stored, stored + entry->storedSize);
+    ZLib zlib;
+    data.clear();
+    data.reserve(entry->size);
+    ASSERT(zlib.deflate(data, compressed, entry->size));
+  } else {
+    data.assign(stored, stored + entry->storedSize);
+  }
+
+  ERROR_IF(data.size() != entry->size || CRC32::compute(data.empty() ? NULL : &data[0], data.size()) != entry->crc,
+    L"Entry of pack archive is corrupted: " + StringTool::AsciiToWide(getName(entry)), ERROR);
+  return OK;
+}
+
+bool PackArchive::exists(const std::string &path) {
+  return find(path) != NULL;
+}
+
+Outcome PackArchive::read(const std::string &path, std::vector<uchar> &data) {
+  const PackEntry *entry = find(path);
+  ERROR_IF(entry == NULL, L"File is not found in pack archive: " + StringTool::AsciiToWide(path), IO_ERROR);
+  return read(entry, data);
+}
+
+Outcome PackArchive::load(const std::string &path, Loader *loader) {
+  CHECK_POINTER(loader);
+
+  const PackEntry *entry = find(path);
+  ERROR_IF(entry == NULL, L"File is not found in pack archive: " + StringTool::AsciiToWide(path), IO_ERROR);
+
+  /* Stored entry is parsed in place after its checksum is verified */
+  if (!(entry->flags & PACK_ENTRY_DEFLATE)) {
+    const uchar *stored = getData(entry);
+    ERROR_IF(CRC32::compute(stored, entry->storedSize) != entry->crc,
+      L"Entry of pack archive is corrupted: " + StringTool::AsciiToWide(path), ERROR);
+    return loader->load(stored, entry->storedSize);
+  }
+
+  std::vector<uchar> data;
+  ASSERT(read(entry, data));
+  return loader->load(data.empty() ? NULL : &data[0], data.size());
+}
+
+}
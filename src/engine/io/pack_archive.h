@@ -0,0 +1,133 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_PACK_ARCHIVE_H__
+#define __VE_PACK_ARCHIVE_H__
+
+#include <string>
+#include <vector>
+
+#include "common.h"
+#include "io/file_source.h"
+#include "io/pack_format.h"
+
+namespace ve {
+
+class MappedFileInputStream;
+
+/**
+    Read-only pack archive, see pack_format.h for the layout. The archive is
+    opened and mapped once, table of contents is searched with binary search,
+    so a file of the pack costs no open, stat or seek. Stored entries are
+    passed to loaders directly from the mapping. Deflated entries are inflated
+    into memory. Checksums of entries are verified in both cases.
+
+    Entries may also be read with IOService: data of an entry is storedSize
+    bytes at its offset in the file getPath().
+*/
+class PackArchive : public FileSource {
+private:
+  /** Path of the archive */
+  std::string path;
+
+  /** Mapping of the archive or NULL */
+  MappedFileInputStream *file;
+
+  /** Table of contents in byte order of the machine */
+  std::vector<PackEntry> entries;
+
+  /** Names of entries, they point into the mapping */
+  const char *names;
+
+  /**
+      Private copy-constructor.
+  */
+  PackArchive(const PackArchive &ref);
+
+  /**
+      Private operator =
+  */
+  PackArchive &operator = (const PackArchive &ref);
+
+public:
+  /**
+      Constructor. Archive is opened by open().
+  */
+  PackArchive();
+
+  /**
+      Destructor. Closes the archive.
+  */
+  virtual ~PackArchive();
+
+  /**
+      Opens archive and validates its table of contents.
+      @param path - Path of the archive.
+      @return OK if archive was opened.
+      @return IO_ERROR if file can not be opened.
+      @return ERROR if file is not a pack archive or it is corrupted.
+  */
+  Outcome open(const std::string &path);
+
+  /**
+      Closes archive, data pointers of entries become invalid.
+  */
+  void close();
+
+  /**
+      Returns path of the archive.
+      @return Path which was passed to open().
+  */
+  std::string getPath();
+
+  /**
+      Returns number of entries.
+      @return Number of entries.
+  */
+  uint getEntriesCount();
+
+  /**
+      Returns entry by index, entries are sorted by name.
+      @param index - Index of the entry.
+      @return Entry or NULL if index is out of range.
+  */
+  const PackEntry *getEntry(uint index);
+
+  /**
+      Returns name of the entry.
+      @param entry - Entry of this archive.
+      @return Name of the entry.
+  */
+  std::string getName(const PackEntry *entry);
+
+  /**
+      Finds entry by name.
+      @param name - Normalized name of the entry.
+      @return Entry or NULL if there is no such entry.
+  */
+  const PackEntry *find(const std::string &name);
+
+  /**
+      Returns data of the entry as it is stored in the archive.
+      @param entry - Entry of this archive.
+      @return Pointer into the mapping, storedSize bytes are available.
+  */
+  const uchar *getData(const PackEntry *entry);
+
+  /**
+      Reads original data of the entry, checksum of the data is verified.
+      @param entry - Entry of this archive.
+      @param data - Original data.
+      @return OK if data was read.
+      @return ERROR if entry is corrupted.
+  */
+  Outcome read(const PackEntry *entry, std::vector<uchar> &data);
+
+  virtual bool exists(const std::string &path);
+  virtual Outcome read(const std::string &path, std::vector<uchar> &data);
+  virtual Outcome load(const std::string &path, Loader *loader);
+};
+
+}
+
+#endif // __VE_PACK_ARCHIVE_H__
@@ -0,0 +1,92 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_PACK_FORMAT_H__
+#define __VE_PACK_FORMAT_H__
+
+#include <string.h>
+
+#include <string>
+
+#include "common.h"
+
+namespace ve {
+
+/*
+  Layout of a pack archive, all numbers are little-endian:
+
+    PackHeader                   at 0
+    data of entries              every entry starts at a multiple of PACK_ALIGNMENT
+    PackEntry[entriesCount]      table of contents, sorted by name
+    names                        names of entries, they are not terminated
+    PackFooter                   last bytes of the file
+
+  Archive is written in one pass, so the table of contents is at the end and
+  the footer points to it. Offsets are 32-bit, so archives are limited to 4 GB.
+*/
+
+/** "VPAK" */
+static const uint PACK_MAGIC = 0x4b415056;
+
+/** Version of the format */
+static const uint PACK_VERSION = 1;
+
+/** Alignment of entries in the archive */
+static const uint PACK_ALIGNMENT = 4096;
+
+/**
+    Flags of an entry.
+*/
+enum PackEntryFlag {
+  PACK_ENTRY_DEFLATE = 1  /*!< Entry is compressed into a zlib stream. */
+};
+
+#pragma pack(push, 1)
+
+#ifndef DOXYGEN
+
+typedef struct {
+  uint magic;
+  uint version;
+  uint alignment;
+  uint reserved;
+} PackHeader;
+
+typedef struct {
+  uint nameOffset;    // Offset of the name from the beginning of names
+  uint offset;        // Offset of the data in the archive
+  uint storedSize;    // Size of the data in the archive
+  uint size;          // Size of the original data
+  uint crc;           // CRC32 of the original data
+  ushort nameLength;
+  ushort flags;
+} PackEntry;
+
+typedef struct {
+  uint magic;
+  uint version;
+  uint entriesCount;
+  uint tocOffset;     // Offset of the first PackEntry
+  uint tocSize;       // Size of entries and names
+  uint tocCRC;        // CRC32 of entries and names
+} PackFooter;
+
+#endif // DOXYGEN
+
+#pragma pack(pop)
+
+/**
+    Compares names of entries byte by byte, entries of the table are sorted with it.
+    @return Negative, zero or positive value like strcmp().
+*/
+inline int comparePackNames(const char *a, size_t aLength, const char *b, size_t bLength) {
+  int result = memcmp(a, b, aLength < bLength ? aLength : bLength);
+  if (result != 0) {
+    return result;
+  }
+  return aLength < bLength ? -1 : (aLength > bLength ? 1 : 0);
+}
+
+}
+
+#endif // __VE_PACK_FORMAT_H__
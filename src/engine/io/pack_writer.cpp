@@ -0,0 +1,150 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <algorithm>
+
+#include "common.h"
+#include "io/pack_writer.h"
+#include "io/virtual_file_system.h"
+#include "tools/crc32.h"
+#include "zlib/zlib_compressor.h"
+
+namespace ve {
+
+/* Largest offset which fits into the table of contents */
+static const size_t PACK_SIZE_LIMIT = 0xffffffff;
+
+PackWriter::PackWriter(OutputStream *stream) : output(stream, LITTLE_ENDIAN_ORDER) {
+  position = 0;
+}
+
+Outcome PackWriter::writeBytes(const void *data, size_t size) {
+  ERROR_IF(position + size > PACK_SIZE_LIMIT, L"Pack archive exceeds 4 GB", IO_ERROR);
+  ASSERT(output.writeInt8Array((const char*)data, size));
+  position += size;
+  return OK;
+}
+
+Outcome PackWriter::writeUint(uint value) {
+  ERROR_IF(position + sizeof(value) > PACK_SIZE_LIMIT, L"Pack archive exceeds 4 GB", IO_ERROR);
+  ASSERT(output.writeInt32((int)value));
+  position += sizeof(value);
+  return OK;
+}
+
+Outcome PackWriter::pad(size_t alignment) {
+  static const char zeros[PACK_ALIGNMENT] = {0};
+
+  size_t count = (alignment - position % alignment) % alignment;
+  return writeBytes(zeros, count);
+}
+
+Outcome PackWriter::writeHeader() {
+  if (position != 0) {
+    return OK;
+  }
+
+  ASSERT(writeUint(PACK_MAGIC));
+  ASSERT(writeUint(PACK_VERSION));
+  ASSERT(writeUint(PACK_ALIGNMENT));
+  return writeUint(0);
+}
+
+Outcome PackWriter::add(const std::string &name, const uchar *data, size_t size, bool compress) {
+  NamedEntry named;
+  named.name = VirtualFileSystem::normalize(name);
+  ERROR_IF(named.name.empty(), L"Name of pack entry is empty", INVALID_VALUE);
+  ERROR_IF(named.name.length() > 0xffff, L"Name of pack entry is too long", INVALID_VALUE);
+  ERROR_IF(data == NULL && size != 0, L"Data of pack entry is NULL", INVALID_VALUE);
+
+  for (size_t i = 0; i < entries.size(); i++) {
+    ERROR_IF(entries[i].name == named.name, L"Pack entry is added twice: " + StringTool::AsciiToWide(named.name),
+      INVALID_VALUE);
+  }
+
+  ASSERT(writeHeader());
+  ASSERT(pad(PACK_ALIGNMENT));
+
+  PackEntry &entry = named.entry;
+  entry.offset = (uint)position;
+  entry.size = (uint)size;
+  entry.crc = CRC32::compute(data, size);
+  entry.nameLength = (ushort)named.name.length();
+  entry.nameOffset = 0;
+  entry.flags = 0;
+
+  /* Already compressed data like PNG is stored, so it is not inflated for nothing */
+  std::vector<uchar> compressed;
+  if (compress && size != 0) {
+    ZLibCompressor compressor;
+    ASSERT(compressor.compress(data, size, compressed));
+  }
+
+  if (!compressed.empty() && compressed.size() <= size - size / 8) {
+    entry.flags |= PACK_ENTRY_DEFLATE;
+    entry.storedSize = (uint)compressed.size();
+    ASSERT(writeBytes(&compressed[0], compressed.size()));
+  } else {
+    entry.storedSize = (uint)size;
+    ASSERT(writeBytes(data, size));
+  }
+
+  entries.push_back(named);
+  return OK;
+}
+
+Outcome PackWriter::finish() {
+  ASSERT(writeHeader());
+
+  std::sort(entries.begin(), entries.end());
+
+  /* Table is built in memory to compute its CRC */
+  std::vector<uchar> table;
+
+  uint nameOffset = 0;
+  for (size_t i = 0; i < entries.size(); i++) {
+    entries[i].entry.nameOffset = nameOffset;
+    nameOffset += entries[i].entry.nameLength;
+  }
+
+  for (size_t i = 0; i < entries.size(); i++) {
+    const PackEntry &entry = entries[i].entry;
+    uint values[] = {entry.nameOffset, entry.offset, entry.storedSize, entry.size, entry.crc,
+      (uint)entry.nameLength | ((uint)entry.flags << 16)};
+
+    for (size_t j = 0; j < sizeof(values) / sizeof(values[0]); j++) {
+      for (int byte = 0; byte < 4; byte++) {
+        table.push_back((uchar)(values[j] >> (byte * 8)));
+      }
+    }
+  }
+
+  for (size_t i = 0; i < entries.size(); i++) {
+    table.insert(table.end(), entries[i].name.begin(), entries[i].name.end());
+  }
+
+  uint tocOffset = (uint)position;
+  if (!table.empty()) {
+    ASSERT(writeBytes(&table[0], table.size()));
+  }
+
+  ASSERT(writeUint(PACK_MAGIC));
+  ASSERT(writeUint(PACK_VERSION));
+  ASSERT(writeUint((uint)entries.size()));
+  ASSERT(writeUint(tocOffset));
+  ASSERT(writeUint((uint)table.size()));
+  ASSERT(writeUint(CRC32::compute(table.empty() ? NULL : &table[0], table.size())));
+
+  output.flush();
+  return OK;
+}
+
+uint PackWriter::getEntriesCount() {
+  return (uint)entries.size();
+}
+
+size_t PackWriter::getSize() {
+  return position;
+}
+
+}
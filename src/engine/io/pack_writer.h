@@ -0,0 +1,106 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_PACK_WRITER_H__
+#define __VE_PACK_WRITER_H__
+
+#include <string>
+#include <vector>
+
+#include "common.h"
+#include "io/data_ouput_stream.h"
+#include "io/output_stream.h"
+#include "io/pack_format.h"
+
+namespace ve {
+
+/**
+    Writes pack archive into a stream in one pass: entries are written as they
+    are added, the table of contents is written by finish(). See pack_format.h
+    for the layout.
+*/
+class PackWriter {
+private:
+  /**
+      Entry and its name.
+  */
+  struct NamedEntry {
+    std::string name;
+    PackEntry entry;
+
+    bool operator < (const NamedEntry &other) const {
+      return comparePackNames(name.data(), name.length(), other.name.data(), other.name.length()) < 0;
+    }
+  };
+
+  /** Writer of little-endian values */
+  DataOutputStream output;
+
+  /** Number of bytes written */
+  size_t position;
+
+  /** Added entries */
+  std::vector<NamedEntry> entries;
+
+  /**
+      Writes header if nothing was written.
+  */
+  Outcome writeHeader();
+
+  /**
+      Writes zero bytes up to the next multiple of alignment.
+  */
+  Outcome pad(size_t alignment);
+
+  /**
+      Writes bytes and counts them.
+  */
+  Outcome writeBytes(const void *data, size_t size);
+
+  /**
+      Writes number and counts it.
+  */
+  Outcome writeUint(uint value);
+
+public:
+  /**
+      Creates writer.
+      @param stream - Stream for the archive, it is not deleted by the writer.
+  */
+  PackWriter(OutputStream *stream);
+
+  /**
+      Adds entry.
+      @param name - Name of the entry, it is normalized like paths of VirtualFileSystem.
+      @param data - Data of the entry.
+      @param size - Size of the data in bytes.
+      @param compress - Data is compressed if it becomes at least 1/8 smaller.
+      @return OK if entry was written.
+      @return INVALID_VALUE if name is empty or already added.
+      @return IO_ERROR if stream error occurred or archive exceeds 4 GB.
+  */
+  Outcome add(const std::string &name, const uchar *data, size_t size, bool compress);
+
+  /**
+      Writes table of contents and footer and flushes the stream.
+      @return OK if archive was finished.
+      @return IO_ERROR if stream error occurred.
+  */
+  Outcome finish();
+
+  /**
+      Returns number of added entries.
+      @return Number of entries.
+  */
+  uint getEntriesCount();
+
+  /**
+      Returns number of written bytes.
+      @return Size of the archive so far.
+  */
+  size_t getSize();
+};
+
+}
+
+#endif // __VE_PACK_WRITER_H__
@@ -2,6 +2,7 @@
 // All rights reserved.
 
 #include <cstdio>
+#include <cstring>
 
 #include "io/text_writer.h"
 
@@ -27,9 +28,15 @@ int TextWriter::printf(char *format, ...) {
 
   va_list args;
   va_start(args, format);
-  written = vsprintf(buffer, format, args);
+  written = vsnprintf(buffer, sizeof(buffer), format, args);
   va_end(args);
 
+  /* Long strings are truncated, some runtimes return -1 for them */
+  if (written < 0 || written >= (int)sizeof(buffer)) {
+    buffer[sizeof(buffer) - 1] = 0;
+    written = (int)strlen(buffer);
+  }
+
   return stream->write(buffer, 0, written);
 }
 
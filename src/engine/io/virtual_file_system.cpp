@@ -0,0 +1,137 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include "common.h"
+#include "io/directory_source.h"
+#include "io/pack_archive.h"
+#include "io/virtual_file_system.h"
+
+namespace ve {
+
+VirtualFileSystem::VirtualFileSystem() {
+}
+
+VirtualFileSystem::~VirtualFileSystem() {
+  for (size_t i = 0; i < mounts.size(); i++) {
+    delete mounts[i].source;
+  }
+}
+
+Outcome VirtualFileSystem::mount(const std::string &point, FileSource *source) {
+  CHECK_POINTER(source);
+
+  Mount mount;
+  mount.point = normalize(point);
+  mount.source = source;
+  mounts.push_back(mount);
+  return OK;
+}
+
+Outcome VirtualFileSystem::mountDirectory(const std::string &point, const std::string &directory) {
+  DirectorySource *source = new DirectorySource(directory);
+  CHECK_ALLOC(source);
+  return mount(point, source);
+}
+
+Outcome VirtualFileSystem::mountPack(const std::string &point, const std::string &path) {
+  PackArchive *archive = new PackArchive();
+  CHECK_ALLOC(archive);
+
+  Outcome result = archive->open(path);
+  if (result != OK) {
+    delete archive;
+    return result;
+  }
+  return mount(point, archive);
+}
+
+Outcome VirtualFileSystem::unmount(const std::string &point) {
+  std::string normalized = normalize(point);
+  bool found = false;
+
+  for (size_t i = mounts.size(); i > 0; i--) {
+    if (mounts[i - 1].point == normalized) {
+      delete mounts[i - 1].source;
+      mounts.erase(mounts.begin() + (i - 1));
+      found = true;
+    }
+  }
+
+  ERROR_IF(!found, L"Nothing is mounted at " + StringTool::AsciiToWide(point), INVALID_VALUE);
+  return OK;
+}
+
+FileSource *VirtualFileSystem::find(const std::string &path, std::string &relative) {
+  for (size_t i = mounts.size(); i > 0; i--) {
+    const Mount &mount = mounts[i - 1];
+    size_t length = mount.point.length();
+
+    /* Mount point must be a whole leading segment of the path */
+    if (length != 0) {
+      if (path.compare(0, length, mount.point) != 0 || path.length() <= length || path[length] != '/') {
+        continue;
+      }
+      relative = path.substr(length + 1);
+    } else {
+      relative = path;
+    }
+
+    if (mount.source->exists(relative)) {
+      return mount.source;
+    }
+  }
+
+  return NULL;
+}
+
+bool VirtualFileSystem::exists(const std::string &path) {
+  std::string relative;
+  return find(normalize(path), relative) != NULL;
+}
+
+Outcome VirtualFileSystem::read(const std::string &path, std::vector<uchar> &data) {
+  std::string relative;
+  FileSource *source = find(normalize(path), relative);
+  ERROR_IF(source == NULL, L"File is not found: " + StringTool::AsciiToWide(path), IO_ERROR);
+  return source->read(relative, data);
+}
+
+Outcome VirtualFileSystem::load(const std::string &path, Loader *loader) {
+  std::string relative;
+  FileSource *source = find(normalize(path), relative);
+  ERROR_IF(source == NULL, L"File is not found: " + StringTool::AsciiToWide(path), IO_ERROR);
+  return source->load(relative, loader);
+}
+
+std::string VirtualFileSystem::normalize(const std::string &path) {
+  std::vector<std::string> segments;
+  size_t start = 0;
+
+  while (start <= path.length()) {
+    size_t end = path.find_first_of("/\\", start);
+    if (end == std::string::npos) {
+      end = path.length();
+    }
+
+    std::string segment = path.substr(start, end - start);
+    if (segment == "..") {
+      if (!segments.empty()) {
+        segments.pop_back();
+      }
+    } else if (!segment.empty() && segment != ".") {
+      segments.push_back(segment);
+    }
+    start = end + 1;
+  }
+
+  std::string result;
+  for (size_t i = 0; i < segments.size(); i++) {
+    if (i != 0) {
+      result += '/';
+    }
+    result += segments[i];
+  }
+  return result;
+}
+
+}
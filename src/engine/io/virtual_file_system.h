@@ -0,0 +1,131 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_VIRTUAL_FILE_SYSTEM_H__
+#define __VE_VIRTUAL_FILE_SYSTEM_H__
+
+#include <string>
+#include <vector>
+
+#include "common.h"
+#include "io/file_source.h"
+
+namespace ve {
+
+/**
+    Virtual file system. Directories and pack archives are mounted at mount
+    points, a file is searched in the sources mounted last first, so a later
+    mount overrides files of earlier ones. Paths use '/' as a separator and
+    are case-sensitive.
+*/
+class VirtualFileSystem {
+private:
+  /** Mounted source */
+  struct Mount {
+    std::string point;
+    FileSource *source;
+  };
+
+  /** Mounts in the order they were added */
+  std::vector<Mount> mounts;
+
+  /**
+      Finds source which contains the file.
+      @param path - Normalized path of the file.
+      @param relative - Path of the file in the source.
+      @return Source or NULL if file is not found.
+  */
+  FileSource *find(const std::string &path, std::string &relative);
+
+  /**
+      Private copy-constructor.
+  */
+  VirtualFileSystem(const VirtualFileSystem &ref);
+
+  /**
+      Private operator =
+  */
+  VirtualFileSystem &operator = (const VirtualFileSystem &ref);
+
+public:
+  /**
+      Constructor.
+  */
+  VirtualFileSystem();
+
+  /**
+      Destructor. Deletes mounted sources.
+  */
+  ~VirtualFileSystem();
+
+  /**
+      Mounts a source, file system takes ownership of it.
+      @param point - Mount point, empty string is the root.
+      @param source - Source of files.
+      @return OK if source was mounted.
+  */
+  Outcome mount(const std::string &point, FileSource *source);
+
+  /**
+      Mounts a directory.
+      @param point - Mount point, empty string is the root.
+      @param directory - Native path of the directory.
+      @return OK if directory was mounted.
+  */
+  Outcome mountDirectory(const std::string &point, const std::string &directory);
+
+  /**
+      Opens and mounts a pack archive.
+      @param point - Mount point, empty string is the root.
+      @param path - Native path of the archive.
+      @return OK if archive was mounted.
+      @return Error of PackArchive::open() otherwise.
+  */
+  Outcome mountPack(const std::string &point, const std::string &path);
+
+  /**
+      Unmounts and deletes all sources mounted at the point.
+      @param point - Mount point.
+      @return OK if at least one source was unmounted.
+      @return INVALID_VALUE if nothing is mounted at the point.
+  */
+  Outcome unmount(const std::string &point);
+
+  /**
+      Checks if file exists.
+      @param path - Path of the file.
+      @return 'true' if file exists.
+  */
+  bool exists(const std::string &path);
+
+  /**
+      Reads whole file.
+      @param path - Path of the file.
+      @param data - Content of the file.
+      @return OK if file was read.
+      @return IO_ERROR if file is not found.
+  */
+  Outcome read(const std::string &path, std::vector<uchar> &data);
+
+  /**
+      Passes the file to the loader, sources avoid copying when it is possible.
+      @param path - Path of the file.
+      @param loader - Loader which parses the file.
+      @return Result of the loader.
+      @return IO_ERROR if file is not found.
+  */
+  Outcome load(const std::string &path, Loader *loader);
+
+  /**
+      Normalizes path: backslashes become slashes, empty and "." segments are
+      removed, ".." removes the previous segment. The result has no leading or
+      trailing slash.
+      @param path - Path.
+      @return Normalized path.
+  */
+  static std::string normalize(const std::string &path);
+};
+
+}
+
+#endif // __VE_VIRTUAL_FILE_SYSTEM_H__
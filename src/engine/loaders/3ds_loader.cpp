@@ -1,7 +1,6 @@
 // Copyright (c) 2017 The Smart Authors.
 // All rights reserved.
 
-#include <stdio.h>
 #include <vector>
 
 #include "common.h"
@@ -9,6 +8,13 @@
 
 namespace ve {
 
+/* Skips data of the chunk, reads after the end of the data fail like reads after the end of a file */
+static void skipChunk(MemoryInputStream &source, size_t count) {
+  if (!source.skip(count)) {
+    source.seek(source.getSize());
+  }
+}
+
 _3dsLoader::_3dsLoader() {
 }
 
@@ -22,13 +28,13 @@ Outcome _3dsLoader::freeMeshList() {
   return OK;
 }
 
-Outcome _3dsLoader::readName(FILE *source, std::string &name) {
+Outcome _3dsLoader::readName(MemoryInputStream &source, std::string &name) {
   char c = 0;
   name = "";
 
   do {
     /* Read one character from file stream */
-    ERROR_IF(fread(&c, sizeof(char), 1, source) != 1, L"readName failed", ERROR);
+    ERROR_IF(!source.readBytes(&c, sizeof(char)), L"readName failed", ERROR);
 
     if (c != 0) {
       name = name + c;
@@ -38,7 +44,7 @@ Outcome _3dsLoader::readName(FILE *source, std::string &name) {
   return OK;
 }
 
-Outcome _3dsLoader::readMesh(FILE *source, unsigned length) {
+Outcome _3dsLoader::readMesh(MemoryInputStream &source, unsigned length) {
   _3dsChunk chunk;
   uint i;
   _3dsVertexList vertexList;
@@ -54,15 +60,15 @@ Outcome _3dsLoader::readMesh(FILE *source, unsigned length) {
   Mesh *newMesh = new Mesh();
 
   while (length != 0) {
-    ERROR_IF(fread(&chunk, sizeof(chunk), 1, source) != 1, L"3ds loader failed to parse file", ERROR);
+    ERROR_IF(!source.readBytes(&chunk, sizeof(chunk)), L"3ds loader failed to parse file", ERROR);
 
     switch (chunk.type) {
     case TRI_RTEXL:
-      ERROR_IF(fread(&vertexList, sizeof(vertexList), 1, source) != 1, L"Failed to read vertex list", ERROR);
+      ERROR_IF(!source.readBytes(&vertexList, sizeof(vertexList)), L"Failed to read vertex list", ERROR);
       vertexData.clear();
 
       for (i = 0; i < vertexList.count; i++) {
-        ERROR_IF(fread(&vertex, sizeof(vertex), 1, source) != 1, L"Failed to read vertex", ERROR);
+        ERROR_IF(!source.readBytes(&vertex, sizeof(vertex)), L"Failed to read vertex", ERROR);
 
         vertexData.push_back(Vector3f(vertex.x, vertex.y, vertex.z));
       }
@@ -71,11 +77,11 @@ Outcome _3dsLoader::readMesh(FILE *source, unsigned length) {
       break;
 
     case TRI_FACEL1:
-      ERROR_IF(fread(&faceList, sizeof(faceList), 1, source) != 1, L"Failed to read face list", ERROR);
+      ERROR_IF(!source.readBytes(&faceList, sizeof(faceList)), L"Failed to read face list", ERROR);
       indexData.clear();
 
       for (i = 0; i < faceList.count; i++) {
-        ERROR_IF(fread(&face, sizeof(face), 1, source) != 1, L"Failed to read face", ERROR);
+        ERROR_IF(!source.readBytes(&face, sizeof(face)), L"Failed to read face", ERROR);
 
         indexData.push_back(face.a);
         indexData.push_back(face.b);
@@ -86,11 +92,11 @@ Outcome _3dsLoader::readMesh(FILE *source, unsigned length) {
       break;
 
     case TRI_TEXCOORD:
-      ERROR_IF(fread(&vertexCount, sizeof(vertexCount), 1, source) != 1, L"Failed to read vertex count", ERROR);
+      ERROR_IF(!source.readBytes(&vertexCount, sizeof(vertexCount)), L"Failed to read vertex count", ERROR);
       texData.clear();
 
       for (i = 0; i < vertexCount; i++) {
-        ERROR_IF(fread(&texCoord, sizeof(texCoord), 1, source) != 1, L"Failed to read texture coords", ERROR);
+        ERROR_IF(!source.readBytes(&texCoord, sizeof(texCoord)), L"Failed to read texture coords", ERROR);
         texData.push_back(Vector2f(texCoord.u, texCoord.v));
       }
 
@@ -98,12 +104,12 @@ Outcome _3dsLoader::readMesh(FILE *source, unsigned length) {
       break;
 
     case TRI_LOCAL:
-      ERROR_IF(fread(&localData, sizeof(localData), 1, source) != 1, L"Failed to load local chunk", ERROR);
+      ERROR_IF(!source.readBytes(&localData, sizeof(localData)), L"Failed to load local chunk", ERROR);
       newMesh->setCenter(Vector3f(localData.xCenter, localData.yCenter, localData.zCenter));
       break;
 
     default:
-      fseek(source, chunk.length - sizeof(chunk), SEEK_CUR);
+      skipChunk(source, chunk.length - sizeof(chunk));
     }
 
     length -= chunk.length;
@@ -116,34 +122,34 @@ Outcome _3dsLoader::readMesh(FILE *source, unsigned length) {
   return OK;
 }
 
-Outcome _3dsLoader::readLight(FILE *source, unsigned length) {
+Outcome _3dsLoader::readLight(MemoryInputStream &source, unsigned length) {
   _3dsLight light;
   _3dsChunk chunk;
   _3dsRGB rgb;
   _3dsTrueColor trueColor;
   _3dsSpot spot;
 
-  ERROR_IF(fread(&light, sizeof(light), 1, source) != 1, L"Failed to read light chunk", ERROR);
+  ERROR_IF(!source.readBytes(&light, sizeof(light)), L"Failed to read light chunk", ERROR);
   length -= sizeof(light);
 
   while (length != 0) {
-    ERROR_IF(fread(&chunk, sizeof(chunk), 1, source) != 1, L"Failed to read light data", ERROR);
+    ERROR_IF(!source.readBytes(&chunk, sizeof(chunk)), L"Failed to read light data", ERROR);
 
     switch (chunk.type) {
     case LIT_SPOT:
-      ERROR_IF(fread(&spot, sizeof(spot), 1, source) != 1, L"Failed to read spot data", ERROR);
+      ERROR_IF(!source.readBytes(&spot, sizeof(spot)), L"Failed to read spot data", ERROR);
       break;
 
     case COL_RGB:
-      ERROR_IF(fread(&rgb, sizeof(rgb), 1, source) != 1, L"Failed to read RGB data", ERROR);
+      ERROR_IF(!source.readBytes(&rgb, sizeof(rgb)), L"Failed to read RGB data", ERROR);
       break;
 
     case COL_TRU:
-      ERROR_IF(fread(&trueColor, sizeof(trueColor), 1, source) != 1, L"Failed to read true color data", ERROR);
+      ERROR_IF(!source.readBytes(&trueColor, sizeof(trueColor)), L"Failed to read true color data", ERROR);
       break;
 
     default:
-      fseek(source, chunk.length, SEEK_CUR);
+      skipChunk(source, chunk.length);
     }
 
     length -= chunk.length;
@@ -152,24 +158,24 @@ Outcome _3dsLoader::readLight(FILE *source, unsigned length) {
   return OK;
 }
 
-Outcome _3dsLoader::readCamera(FILE *source, unsigned length) {
+Outcome _3dsLoader::readCamera(MemoryInputStream &source, unsigned length) {
   _3dsCamera camera;
 
-  ERROR_IF(fread(&camera, sizeof(camera), 1, source) != 1, L"Failed to read camera chunk", ERROR);
+  ERROR_IF(!source.readBytes(&camera, sizeof(camera)), L"Failed to read camera chunk", ERROR);
   length = length - sizeof(camera);
 
   if (length > 0) {
-    fseek(source, length, SEEK_CUR);
+    skipChunk(source, length);
   }
 
   return OK;
 }
 
-Outcome _3dsLoader::readObject(FILE *source, unsigned length) {
+Outcome _3dsLoader::readObject(MemoryInputStream &source, unsigned length) {
   _3dsChunk chunk;
 
   while (length != 0) {
-    ERROR_IF(fread(&chunk, sizeof(chunk), 1, source) != 1, L"Failed to read object chunk", ERROR);
+    ERROR_IF(!source.readBytes(&chunk, sizeof(chunk)), L"Failed to read object chunk", ERROR);
 
     switch (chunk.type) {
     case OBJ_TRIMESH:
@@ -185,7 +191,7 @@ Outcome _3dsLoader::readObject(FILE *source, unsigned length) {
       break;
 
     default:
-      fseek(source, chunk.length - sizeof(chunk), SEEK_CUR);
+      skipChunk(source, chunk.length - sizeof(chunk));
       break;
     }
 
@@ -195,15 +201,15 @@ Outcome _3dsLoader::readObject(FILE *source, unsigned length) {
   return OK;
 }
 
-Outcome _3dsLoader::load(FILE* source, size_t offset) {
+Outcome _3dsLoader::load(const uchar *buffer, size_t size) {
   _3dsChunk chunk;
   std::string objName;
+  MemoryInputStream source(buffer, size);
 
-  CHECK_POINTER(source);
+  CHECK_POINTER(buffer);
   ASSERT(freeMeshList());
 
-  fseek(source, offset, SEEK_SET);
-  while (fread(&chunk, sizeof(chunk), 1, source) == 1) {
+  while (source.readBytes(&chunk, sizeof(chunk))) {
     switch (chunk.type) {
     case MAIN3DS:
       break;
@@ -212,7 +218,7 @@ Outcome _3dsLoader::load(FILE* source, size_t offset) {
       break;
 
     case KEYF3DS:
-      fseek(source, chunk.length - sizeof(chunk), SEEK_CUR);
+      skipChunk(source, chunk.length - sizeof(chunk));
       break;
 
       /* Edit section */
@@ -222,7 +228,7 @@ Outcome _3dsLoader::load(FILE* source, size_t offset) {
       break;
 
     default:
-      fseek(source, chunk.length - sizeof(chunk), SEEK_CUR);
+      skipChunk(source, chunk.length - sizeof(chunk));
     }
   }
 
@@ -7,6 +7,7 @@
 #include <string>
 
 #include "engine/models/model.h"
+#include "engine/io/memory_input_stream.h"
 #include "engine/loaders/loader.h"
 
 namespace ve {
@@ -205,7 +206,7 @@ private:
       @return OK if name was read.
       @return ERROR if error occurred.
   */
-  Outcome readName(FILE *source, std::string &name);
+  Outcome readName(MemoryInputStream &source, std::string &name);
 
   /**
       Reads Mesh object section from the 3ds file which is processed now.
@@ -214,7 +215,7 @@ private:
       @return OK if mesh data was read.
       @return ERROR if error occurred.
   */
-  Outcome readMesh(FILE *source, unsigned length);
+  Outcome readMesh(MemoryInputStream &source, unsigned length);
 
   /**
       Reads Light section from the 3ds file which is processed now.
@@ -223,7 +224,7 @@ private:
       @return OK if light section was read.
       @return ERROR if error occurred.
   */
-  Outcome readLight(FILE *source, unsigned length);
+  Outcome readLight(MemoryInputStream &source, unsigned length);
 
   /**
       Reads Camera section from the 3ds file which is processed now.
@@ -232,7 +233,7 @@ private:
       @return OK if camera data was read.
       @return ERROR if error occurred.
   */
-  Outcome readCamera(FILE *source, unsigned length);
+  Outcome readCamera(MemoryInputStream &source, unsigned length);
 
   /**
       Reads Object section from the 3ds file which is processed now.
@@ -241,7 +242,7 @@ private:
       @return OK if object section was read.
       @return ERROR if error occurred.
   */
-  Outcome readObject(FILE *source, unsigned length);
+  Outcome readObject(MemoryInputStream &source, unsigned length);
 
   /**
       Free memory which was allocated for meshes.
@@ -255,16 +256,17 @@ public:
   */
   _3dsLoader();
 
+  using Loader::load;
+
   /**
-      Loads 3ds file from specified file starting from specified offset in bytes.
-      Offset is usually 0, if 3ds file is read, for example. But for files which are
-      contained in some archive-style file it may be useful to use offset param.
-      @param source - File to read data from.
-      @param offset - Offset in bytes where 3ds file starts.
-      @return OK if 3ds image was read successfully.
-      @return non-OK in case of engine error.
+      Loads 3ds model from memory. Files are read by Loader::loadFromFile()
+      and Loader::load(FILE*, size_t), which pass their data to this function.
+      @param buffer - First byte of the 3ds file.
+      @param size - Size of the data in bytes.
+      @return OK if 3ds model was read successfully.
+      @return non-OK in case of engine error or corrupted data.
   */
-  virtual Outcome load(FILE* source, size_t offset);
+  virtual Outcome load(const uchar *buffer, size_t size);
 
   /**
       Returns the list of loaded mesh objects. It contains data which was read since the last
@@ -1,32 +1,30 @@
 // Copyright (c) 2017 The Smart Authors.
 // All rights reserved.
 
-#include <stdio.h>
-
 #include "common.h"
 #include "loaders/bmp_loader.h"
 #include "textures/texture.h"
+#include "io/memory_input_stream.h"
 
 namespace ve {
 
 BMPLoader::BMPLoader() {
 }
 
-Outcome BMPLoader::load(FILE* source, size_t offset) {
+Outcome BMPLoader::load(const uchar *buffer, size_t size) {
   BMPHeader header;
   BMPInfo info;
   size_t dataOffSet;
   int i, k;
-  char color[4];
+  MemoryInputStream source(buffer, size);
 
-  CHECK_POINTER(source);
-  fseek(source, offset, SEEK_SET);
-  fread(&header, 1, sizeof(BMPHeader), source);
+  CHECK_POINTER(buffer);
+  ERROR_IF(!source.readBytes(&header, sizeof(BMPHeader)), L"BMP header is truncated", ERROR);
 
   ERROR_IF(header.type[0] != 'B' || header.type[1] != 'M', L"There isn't BM signature in BMP file header", ERROR);
 
   dataOffSet = header.offset;
-  fread(&info, 1, sizeof(BMPInfo), source);
+  ERROR_IF(!source.readBytes(&info, sizeof(BMPInfo)), L"BMP info is truncated", ERROR);
 
   ERROR_IF(info.size != sizeof(BMPInfo), L"BMP file is corrupted", ERROR);
   ERROR_IF(info.planes != 1, L"More than one plane", ERROR);
@@ -36,12 +34,19 @@ Outcome BMPLoader::load(FILE* source, size_t offset) {
   width = info.width;
   height = info.height;
   components = info.bitCount / 8;
+
+  /* Pixels are converted directly from the source data */
+  const uchar *pixels = NULL;
+  if (source.seek(dataOffSet)) {
+    pixels = source.getSpan(width * height * components);
+  }
+  ERROR_IF(pixels == NULL, L"BMP file is truncated", ERROR);
+
   data.resize(width * height * components);
-  fseek(source, dataOffSet, SEEK_SET);
 
   for (i = 0; i < width * height; i++) {
-    fread(color, 1, components, source);
     k = i * components;
+    const uchar *color = pixels + k;
 
     if (components == 1)
       data[k] = color[0];
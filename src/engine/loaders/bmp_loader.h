@@ -51,16 +51,17 @@ public:
   */
   BMPLoader();
 
+  using Loader::load;
+
   /**
-      Loads BMP image from specified file starting from specified offset in bytes.
-      Offset is usually 0, if BMP file is read, for example. But for files which are
-      contained in some archive-style file it may be useful to use offset param.
-      @param source - File to read data from.
-      @param offset - Offset in bytes where BMP file starts.
+      Loads BMP image from memory. Files are read by Loader::loadFromFile()
+      and Loader::load(FILE*, size_t), which pass their data to this function.
+      @param buffer - First byte of the BMP file.
+      @param size - Size of the data in bytes.
       @return OK if BMP image was read successfully.
-      @return non-OK in case of engine error.
+      @return non-OK in case of engine error or corrupted data.
   */
-  virtual Outcome load(FILE *source, size_t offset);
+  virtual Outcome load(const uchar *buffer, size_t size);
 };
 
 }
@@ -2,9 +2,11 @@
 // All rights reserved.
 
 #include <stdio.h>
+#include <vector>
 
 #include "common.h"
 #include "loaders/loader.h"
+#include "io/mapped_file_input_stream.h"
 
 namespace ve {
 
@@ -12,18 +14,30 @@ Loader::Loader() {
 }
 
 Outcome Loader::loadFromFile(std::string fileName) {
-  FILE *source;
-  Outcome result;
-
-  source = fopen(fileName.c_str(), "rb");
-  ERROR_IF(source == 0, L"File not found - File name: " + StringTool::AsciiToWide(fileName), IO_ERROR);
-  result = load(source, 0);
-  fclose(source);
-  return result;
+  MappedFileInputStream source(fileName);
+
+  ERROR_IF(!source.isOpened(), L"File not found - File name: " + StringTool::AsciiToWide(fileName), IO_ERROR);
+  return load(source.getData(), source.getSize());
 }
 
 Outcome Loader::load(FILE* source, size_t offset) {
-  return OK;
+  CHECK_POINTER(source);
+
+  fseek(source, 0, SEEK_END);
+  long end = ftell(source);
+  ERROR_IF(end < 0 || (size_t)end < offset, L"Offset is beyond the end of the file", IO_ERROR);
+
+  std::vector<uchar> data(end - offset);
+  fseek(source, offset, SEEK_SET);
+  if (!data.empty()) {
+    ERROR_IF(fread(&data[0], data.size(), 1, source) != 1, L"Read error", IO_ERROR);
+  }
+
+  return load(data.empty() ? NULL : &data[0], data.size());
+}
+
+Outcome Loader::load(const uchar *, size_t) {
+  FAIL(L"Loading from memory is not supported", INVALID_OPERATION);
 }
 
 }
@@ -25,7 +25,8 @@ public:
   Loader();
 
   /**
-      Loads data from specified file.
+      Loads data from specified file. File is mapped into memory and parsed
+      in place.
       @return OK if loading succeeded.
       @return non-OK if engine error occurred or in case
       of corrupted file.
@@ -35,13 +36,24 @@ public:
   /**
       Loads data from specified file starting from specified offset in bytes.
       For files which are contained in some archive-style file it may be useful
-      to use offset param.
+      to use offset param. The rest of the file is read into memory and parsed
+      by load(buffer, size).
       @param source - File to read data from.
       @param offset - Offset in bytes where data starts.
-      @return OK if BMP image was read successfully.
+      @return OK if data was read successfully.
       @return non-OK in case of engine error.
   */
   virtual Outcome load(FILE* source, size_t offset);
+
+  /**
+      Loads data from memory, for example from a mapped file or an archive.
+      @param buffer - First byte of the data.
+      @param size - Size of the data in bytes.
+      @return OK if data was read successfully.
+      @return non-OK in case of engine error or corrupted data.
+      @return INVALID_OPERATION if the loader does not override this function.
+  */
+  virtual Outcome load(const uchar *buffer, size_t size);
 };
 
 }
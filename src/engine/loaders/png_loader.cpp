@@ -1,10 +1,12 @@
 // Copyright (c) 2017 The Smart Authors.
 // All rights reserved.
 
-#include <stdio.h>
+#include <string.h>
 
 #include "common.h"
 #include "loaders/png_loader.h"
+#include "io/memory_input_stream.h"
+#include "tools/crc32.h"
 
 namespace ve {
 
@@ -48,17 +50,15 @@ unsigned int PNGLoader::paethPredictor(unsigned char a, unsigned char b, unsigne
       return c;
 }
 
-Outcome PNGLoader::load(FILE *source, size_t offset) {
+Outcome PNGLoader::load(const uchar *buffer, size_t size) {
   PNGHeader header;
   PNGHeader rightHeader = { 137, 80, 78, 71, 13, 10, 26, 10 };
   PNGChunk chunk;
-  PNGCRC CRC;
   IHDRChunk IHDR;
   int filter;
-  fpos_t savePos;
+  MemoryInputStream source(buffer, size);
 
-  fseek(source, offset, SEEK_SET);
-  fread(&header, 1, sizeof(header), source);
+  ERROR_IF(!source.readBytes(&header, sizeof(header)), L"PNG header is truncated", ERROR);
   for (int i = 0; i < 8; i++) {
     ERROR_IF(rightHeader[i] != header[i], L"Wrong header of the file", ERROR);
   }
@@ -67,13 +67,26 @@ Outcome PNGLoader::load(FILE *source, size_t offset) {
 
   do {
     /* Read head of chunk and transform Words and LongInt types to most significent byte order */
-    fread(&chunk, 1, sizeof(PNGChunk), source);
+    ERROR_IF(!source.readBytes(&chunk, sizeof(PNGChunk)), L"PNG file is truncated", ERROR);
     reverseLongInt(&chunk.length);
     reverseLongInt(&chunk.type);
 
+    /* Chunk data and CRC are taken from the source without copying */
+    const uchar *chunkData = source.getSpan(chunk.length);
+    const uchar *chunkCRC = source.getSpan(sizeof(PNGCRC));
+    ERROR_IF(chunkData == NULL || chunkCRC == NULL, L"PNG file is truncated", ERROR);
+
+    /* CRC covers type and data of the chunk, type precedes the data in the buffer */
+    PNGCRC crc;
+    memcpy(&crc, chunkCRC, sizeof(PNGCRC));
+    reverseLongInt(&crc);
+    ERROR_IF(CRC32::compute(chunkData - sizeof(chunk.type), chunk.length + sizeof(chunk.type)) != crc,
+      L"Wrong CRC of PNG chunk", ERROR);
+
     switch (chunk.type) {
     case PNG_CHUNK_IHDR:
-      fread(&IHDR, 1, sizeof(IHDRChunk), source);
+      ERROR_IF(chunk.length < sizeof(IHDRChunk), L"Wrong IHDR chunk", ERROR);
+      memcpy(&IHDR, chunkData, sizeof(IHDRChunk));
       reverseLongInt(&IHDR.width);
       reverseLongInt(&IHDR.height);
       width = IHDR.width;
@@ -108,29 +121,12 @@ Outcome PNGLoader::load(FILE *source, size_t offset) {
       break;
 
     case PNG_CHUNK_IDAT:
-    {
-      fgetpos(source, &savePos);
-
-      uchar *buf = new uchar[chunk.length];
-      ERROR_IF(fread(buf, chunk.length, 1, source) != 1, L"Read error", IO_ERROR);
-
-      inflatedData.reserve(inflatedData.size() + chunk.length);
-      for (uint i = 0; i < chunk.length; i++) {
-        inflatedData.push_back(buf[i]);
-      }
-
-      delete[] buf;
-
-      fsetpos(source, &savePos);
-      fseek(source, chunk.length, SEEK_CUR);
+      inflatedData.insert(inflatedData.end(), chunkData, chunkData + chunk.length);
       break;
-    }
 
     default:
-      fseek(source, chunk.length, SEEK_CUR);
       break;
     }
-    fread(&CRC, 1, sizeof(PNGCRC), source);
   } while (chunk.type != PNG_CHUNK_IEND);
 
   /* Decompressed */
@@ -1,37 +1,40 @@
 // Copyright (c) 2017 The Smart Authors.
 // All rights reserved.
 
-#include <stdio.h>
-
 #include "common.h"
 #include "loaders/tga_loader.h"
+#include "io/memory_input_stream.h"
 
 namespace ve {
 
 TGALoader::TGALoader() {
 }
 
-Outcome TGALoader::load(FILE* source, size_t offset) {
+Outcome TGALoader::load(const uchar *buffer, size_t size) {
   TGAHeader header;
-  unsigned char color[4], mask;
+  unsigned char mask;
   int i, j, k;
+  MemoryInputStream source(buffer, size);
 
-  fseek(source, offset, SEEK_SET);
-  fread(&header, 1, sizeof(TGAHeader), source);
+  ERROR_IF(!source.readBytes(&header, sizeof(TGAHeader)), L"TGA header is truncated", ERROR);
   ERROR_IF(header.colorMapType != 0, L"There is color map which not supported", ERROR);
   ERROR_IF(header.imageType != TGA_TRUECOLOR && header.imageType != TGA_GRAYSCALE, L"Unsupported image type", ERROR);
   width = header.width;
   height = header.height;
   components = header.bitPerPixels / 8;
-  if (header.IDLength != 0) {
-    fseek(source, header.IDLength, SEEK_CUR);
-  }
+  ERROR_IF(components < 1 || components > 4, L"Unsupported pixel size", ERROR);
+  ERROR_IF(!source.skip(header.IDLength), L"TGA file is truncated", ERROR);
+
+  /* Pixels are converted directly from the source data */
+  const uchar *pixels = source.getSpan(width * height * components);
+  ERROR_IF(pixels == NULL, L"TGA file is truncated", ERROR);
+
   data.resize(width * height * components);
   // Mask = 0 then image starts in left bottom corner
   mask = header.imageDesc & 0x30;
   for (i = 0; i < height; i++) {
     for (j = 0; j < width; j++) {
-      fread(color, 1, components, source);
+      const uchar *color = pixels + (i * width + j) * components;
 
       if (mask != 0) {
         k = ((height - i - 1) * width + j) * components;
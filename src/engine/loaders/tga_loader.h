@@ -48,16 +48,17 @@ public:
   */
   TGALoader();
 
+  using Loader::load;
+
   /**
-      Loads TGA image from specified file starting from specified offset in bytes.
-      Offset is usually 0, if TGA file is read, for example. But for files which are
-      contained in some archive-style file it may be useful to use offset param.
-      @param source - File to read data from.
-      @param offset - Offset in bytes where TGA file starts.
+      Loads TGA image from memory. Files are read by Loader::loadFromFile()
+      and Loader::load(FILE*, size_t), which pass their data to this function.
+      @param buffer - First byte of the TGA file.
+      @param size - Size of the data in bytes.
       @return OK if TGA image was read successfully.
-      @return non-OK in case of engine error.
+      @return non-OK in case of engine error or corrupted data.
   */
-  virtual Outcome load(FILE* source, size_t offset);
+  virtual Outcome load(const uchar *buffer, size_t size);
 };
 
 }
@@ -0,0 +1,278 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include "common.h"
+#include "logs/async_log.h"
+#include "windows/atomic.h"
+#include "windows/critical_section.h"
+#include "windows/event.h"
+#include "windows/thread_factory.h"
+
+namespace ve {
+
+/* Maximal number of characters of the file and function names in a record */
+static const uint FILE_NAME_LENGTH = 96;
+static const uint FUNCTION_NAME_LENGTH = 64;
+
+/* Time the writer thread sleeps if there are no messages, in milliseconds */
+static const uint IDLE_TIMEOUT = 10;
+
+/* Copies at most limit - 1 characters and the terminating zero, returns number of copied characters */
+static uint copyText(wchar_t *destination, const std::wstring &source, uint limit) {
+  uint length = source.length() < limit - 1 ? source.length() : limit - 1;
+  source.copy(destination, length);
+  destination[length] = 0;
+  return length + 1;
+}
+
+void LogRecord::set(LogMessageType type, const std::wstring &file, int line, const std::wstring &function,
+  const std::wstring &message) {
+  this->type = type;
+  this->line = line;
+  site = NULL;
+
+  uint used = copyText(text, file, FILE_NAME_LENGTH);
+  functionOffset = (ushort)used;
+  used += copyText(text + used, function, FUNCTION_NAME_LENGTH);
+  messageOffset = (ushort)used;
+  copyText(text + used, message, LOG_RECORD_TEXT_LENGTH - used);
+}
+
+void LogRecord::set(const LogSite &site, const std::wstring &message) {
+  type = site.type;
+  line = site.line;
+  this->site = &site;
+
+  functionOffset = 0;
+  messageOffset = 0;
+  copyText(text, message, LOG_RECORD_TEXT_LENGTH);
+}
+
+AsyncLog::AsyncLog(Log *log, uint capacity, LogOverflowPolicy policy) {
+  this->log = log;
+  this->policy = policy;
+
+  this->capacity = 2;
+  while (this->capacity < capacity) {
+    this->capacity <<= 1;
+  }
+
+  ring = new Slot[this->capacity];
+  for (uint i = 0; i < this->capacity; i++) {
+    ring[i].sequence = i;
+  }
+
+  enqueuePos = 0;
+  dequeuePos = 0;
+  dropped = 0;
+  reportedDropped = 0;
+  running = 0;
+  finished = 1;
+  sleeping = 0;
+  wakeupEvent = new Event();
+}
+
+AsyncLog::~AsyncLog() {
+  stop();
+  delete[] ring;
+  delete wakeupEvent;
+}
+
+Outcome AsyncLog::start() {
+  CHECK_POINTER(log);
+
+  if (!finished) {
+    return OK;
+  }
+
+  running = 1;
+  finished = 0;
+  memoryBarrier();
+
+  Outcome result = ThreadFactory::getInstance()->spawn(threadEntry, this);
+  if (result != OK) {
+    running = 0;
+    finished = 1;
+  }
+
+  return result;
+}
+
+void AsyncLog::stop() {
+  if (finished) {
+    return;
+  }
+
+  running = 0;
+  memoryBarrier();
+
+  /* Thread can not be joined, so its last flag is awaited */
+  while (!finished) {
+    wakeUp();
+    yieldThread();
+  }
+}
+
+unsigned long AsyncLog::threadEntry(void *parameter) {
+  ((AsyncLog*)parameter)->run();
+  return 0;
+}
+
+void AsyncLog::run() {
+  while (running) {
+    if (writeBatch() == 0) {
+      waitForMessages();
+    }
+  }
+
+  /* Producers are stopped before the backend, so the rest of messages is written at once */
+  while (writeBatch() != 0) {
+  }
+
+  memoryBarrier();
+  finished = 1;
+}
+
+uint AsyncLog::writeBatch() {
+  uint count = 0;
+  uint mask = capacity - 1;
+
+  log->streamsLock->lock();
+
+  for (;;) {
+    Slot &slot = ring[dequeuePos & mask];
+    uint sequence = slot.sequence;
+    memoryBarrier();
+
+    if ((int)(sequence - (dequeuePos + 1)) < 0) {
+      break;
+    }
+
+    log->writeRecord(slot.record);
+
+    memoryBarrier();
+    slot.sequence = dequeuePos + capacity;
+    dequeuePos = dequeuePos + 1;
+    count++;
+  }
+
+  uint droppedNow = dropped;
+  if (droppedNow != reportedDropped) {
+    LogRecord record;
+    record.set(MESSAGE_WARNING, L"", 0, L"", StringTool::intToStr((int)(droppedNow - reportedDropped)) +
+      L" log messages were dropped");
+    log->writeRecord(record);
+    reportedDropped = droppedNow;
+    count++;
+  }
+
+  if (count != 0) {
+    log->flushStreams();
+  }
+
+  log->streamsLock->unlock();
+  return count;
+}
+
+void AsyncLog::waitForMessages() {
+  uint mask = capacity - 1;
+
+  sleeping = 1;
+  memoryBarrier();
+
+  /* Event stays signaled, so message which came after the check is not missed */
+  if ((int)(ring[dequeuePos & mask].sequence - (dequeuePos + 1)) < 0 && running) {
+    wakeupEvent->wait(IDLE_TIMEOUT);
+  }
+
+  sleeping = 0;
+}
+
+void AsyncLog::wakeUp() {
+  wakeupEvent->set();
+}
+
+AsyncLog::Slot *AsyncLog::claim(uint &position) {
+  uint mask = capacity - 1;
+  position = enqueuePos;
+
+  for (;;) {
+    Slot *slot = &ring[position & mask];
+    uint sequence = slot->sequence;
+    memoryBarrier();
+    int difference = (int)(sequence - position);
+
+    if (difference == 0) {
+      if (compareAndSwap(&enqueuePos, position, position + 1) == position) {
+        return slot;
+      }
+    } else if (difference < 0) {
+      /* Ring is full */
+      if (policy == LOG_DROP) {
+        atomicIncrement(&dropped);
+        return NULL;
+      }
+
+      wakeUp();
+      yieldThread();
+    }
+
+    position = enqueuePos;
+  }
+}
+
+void AsyncLog::publish(Slot *slot, uint position) {
+  memoryBarrier();
+  slot->sequence = position + 1;
+  memoryBarrier();
+
+  if (sleeping) {
+    wakeUp();
+  }
+}
+
+bool AsyncLog::push(LogMessageType type, const std::wstring &file, int line, const std::wstring &function,
+  const std::wstring &message) {
+  uint position;
+  Slot *slot = claim(position);
+
+  if (slot == NULL) {
+    return false;
+  }
+
+  slot->record.set(type, file, line, function, message);
+  publish(slot, position);
+  return true;
+}
+
+bool AsyncLog::push(const LogSite &site, const std::wstring &message) {
+  uint position;
+  Slot *slot = claim(position);
+
+  if (slot == NULL) {
+    return false;
+  }
+
+  slot->record.set(site, message);
+  publish(slot, position);
+  return true;
+}
+
+void AsyncLog::flush() {
+  uint target = enqueuePos;
+
+  while (!finished && (int)(dequeuePos - target) < 0) {
+    wakeUp();
+    yieldThread();
+  }
+}
+
+uint AsyncLog::getDroppedCount() {
+  return dropped;
+}
+
+uint AsyncLog::getCapacity() {
+  return capacity;
+}
+
+}
@@ -0,0 +1,251 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_ASYNC_LOG_H__
+#define __VE_ASYNC_LOG_H__
+
+#include <string>
+
+#include "engine/common.h"
+#include "engine/types.h"
+#include "engine/consts.h"
+#include "engine/logs/log.h"
+#include "engine/windows/atomic.h"
+
+namespace ve {
+
+class Event;
+
+/** Number of characters in the text of a log record */
+static const uint LOG_RECORD_TEXT_LENGTH = 256;
+
+/**
+    Fixed-size binary log record. Messages of logging macros refer to their
+    static call site and only the message text is copied. Other messages copy
+    file name, function name and message into one buffer one after another
+    with terminating zeros. Too long strings are truncated. Record is formatted
+    into text only when it is written.
+*/
+struct LogRecord {
+  /** Kind of the message */
+  LogMessageType type;
+
+  /** Line number or 0 */
+  int line;
+
+  /** Call site or NULL if names are stored in the text */
+  const LogSite *site;
+
+  /** Offsets of the function name and the message in the text buffer, file name starts at 0 */
+  ushort functionOffset;
+  ushort messageOffset;
+
+  /** File name, function name and message */
+  wchar_t text[LOG_RECORD_TEXT_LENGTH];
+
+  /**
+      Fills the record, strings are truncated to fit the buffer.
+  */
+  void set(LogMessageType type, const std::wstring &file, int line, const std::wstring &function,
+    const std::wstring &message);
+
+  /**
+      Fills the record with the message of the call site.
+  */
+  void set(const LogSite &site, const std::wstring &message);
+
+  /* Names are stored in the text only if there is no call site */
+  const wchar_t *getFile() const {
+    return text;
+  }
+
+  const wchar_t *getFunction() const {
+    return text + functionOffset;
+  }
+
+  const wchar_t *getMessage() const {
+    return text + messageOffset;
+  }
+};
+
+/**
+    Asynchronous backend of Log. Threads which log messages only copy a record
+    into a lock-free ring buffer with multiple producers and one consumer.
+    Background thread takes records in batches, formats them and writes them
+    to the streams of the log with one flush per batch, so a log call does not
+    wait for I/O.
+
+    Memory is bounded by the ring capacity. If the ring is full, the message is
+    dropped or the caller waits, depending on the overflow policy. Number of
+    dropped messages is reported to the log by the writer thread.
+
+    Ring is the bounded queue of Dmitry Vyukov: every slot has a sequence number
+    which tells producers and the consumer whose turn it is, and producers take
+    slots with one compare-and-swap.
+*/
+class AsyncLog {
+private:
+  /**
+      Slot of the ring.
+  */
+  struct Slot {
+    /** Position which may use the slot: pos for producer, pos + 1 for consumer */
+    volatile uint sequence;
+
+    /** Message */
+    LogRecord record;
+  };
+
+  /** Log which formats and writes records */
+  Log *log;
+
+  /** Ring buffer */
+  Slot *ring;
+
+  /** Number of slots, it is a power of two */
+  uint capacity;
+
+  /** Behaviour if the ring is full */
+  LogOverflowPolicy policy;
+
+  /** Padding which places counters at different cache lines */
+  char padding0[CACHE_LINE_SIZE];
+
+  /** Position of the next record for producers */
+  volatile uint enqueuePos;
+
+  char padding1[CACHE_LINE_SIZE - sizeof(uint)];
+
+  /** Position of the next record for the consumer */
+  volatile uint dequeuePos;
+
+  char padding2[CACHE_LINE_SIZE - sizeof(uint)];
+
+  /** Number of dropped messages */
+  volatile uint dropped;
+
+  /** Number of dropped messages which were reported */
+  uint reportedDropped;
+
+  /** Writer thread should work */
+  volatile int running;
+
+  /** Writer thread has finished */
+  volatile int finished;
+
+  /** Writer thread waits for messages */
+  volatile int sleeping;
+
+  /** Event which wakes writer thread up */
+  Event *wakeupEvent;
+
+  /**
+      Entry point of the writer thread.
+  */
+  static unsigned long threadEntry(void *parameter);
+
+  /**
+      Loop of the writer thread.
+  */
+  void run();
+
+  /**
+      Writes available records.
+      @return Number of written records.
+  */
+  uint writeBatch();
+
+  /**
+      Waits for new messages with timeout.
+  */
+  void waitForMessages();
+
+  /**
+      Wakes writer thread up if it sleeps.
+  */
+  void wakeUp();
+
+  /**
+      Takes free slot of the ring.
+      @param position - Position of the slot.
+      @return Slot to fill or NULL if message is dropped.
+  */
+  Slot *claim(uint &position);
+
+  /**
+      Passes filled slot to the writer thread.
+  */
+  void publish(Slot *slot, uint position);
+
+  /**
+      Private copy-constructor.
+  */
+  AsyncLog(const AsyncLog &ref);
+
+  /**
+      Private operator =
+  */
+  AsyncLog &operator = (const AsyncLog &ref);
+
+public:
+  /**
+      Constructor. Writer thread is started by start().
+      @param log - Log which writes records to its streams.
+      @param capacity - Number of records in the ring, it is rounded up to a power of two.
+      @param policy - Behaviour if the ring is full.
+  */
+  AsyncLog(Log *log, uint capacity, LogOverflowPolicy policy);
+
+  /**
+      Destructor. Stops the writer thread, all queued messages are written.
+  */
+  ~AsyncLog();
+
+  /**
+      Starts the writer thread.
+      @return OK if thread was started.
+      @return ERROR if OS error occurred.
+  */
+  Outcome start();
+
+  /**
+      Writes queued messages and stops the writer thread.
+  */
+  void stop();
+
+  /**
+      Queues message. It may be called from any thread.
+      @return 'true' if message was queued.
+      @return 'false' if it was dropped.
+  */
+  bool push(LogMessageType type, const std::wstring &file, int line, const std::wstring &function,
+    const std::wstring &message);
+
+  /**
+      Queues message of the call site. It may be called from any thread.
+      @return 'true' if message was queued.
+      @return 'false' if it was dropped.
+  */
+  bool push(const LogSite &site, const std::wstring &message);
+
+  /**
+      Waits until all messages queued before the call are written.
+  */
+  void flush();
+
+  /**
+      Returns number of dropped messages.
+      @return Number of messages dropped since start.
+  */
+  uint getDroppedCount();
+
+  /**
+      Returns number of records which the ring holds.
+      @return Capacity of the ring.
+  */
+  uint getCapacity();
+};
+
+}
+
+#endif // __VE_ASYNC_LOG_H__
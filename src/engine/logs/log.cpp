@@ -1,20 +1,37 @@
 // Copyright (c) 2017 The Smart Authors.
 // All rights reserved.
 
+#include <stdlib.h>
+
 #include "common.h"
 #include "logs/log.h"
+#include "logs/async_log.h"
+#include "windows/atomic.h"
+#include "windows/critical_section.h"
 
 namespace ve {
 
 Log* Log::instance = NULL;
 
+LogLevel Log::threshold = LOG_LEVEL_DEBUG;
+
+/* Writes queued messages before the process exits */
+static void drainLog() {
+  Log::getInstance()->disableAsync();
+}
+
 Log::Log() {
   errors = 0;
   warnings = 0;
+  asyncLog = NULL;
+  asyncUsers = 0;
+  streamsLock = new CriticalSection();
 }
 
 Log::~Log() {
+  disableAsync();
   clearStreams();
+  delete streamsLock;
 }
 
 Log* Log::getInstance() {
@@ -30,18 +47,24 @@ Log* Log::getInstance() {
     be sent to this stream as well as to any other stream that was attacjed to this log file.
 */
 void Log::addOutputStream(OutputStream *stream) {
+  streamsLock->lock();
   streams.push_back(new TextWriter(stream));
+  streamsLock->unlock();
 }
 
 /**
     Remove all the streams from this log.
 */
 void Log::clearStreams() {
+  flush();
+
+  streamsLock->lock();
   for (ve::uint i = 0; i < streams.size(); i++) {
     delete streams[i];
   }
 
   streams.clear();
+  streamsLock->unlock();
 }
 
 std::wstring Log::convertGLError(int code) {
@@ -67,66 +90,228 @@ std::wstring Log::convertGLError(int code) {
   }
 }
 
-void Log::info(std::wstring msg) {
-  for (uint i = 0; i < streams.size(); i++) {
-    streams[i]->printf("%ls\n", msg.c_str());
-    streams[i]->flush();
+void Log::put(LogMessageType type, const std::wstring &file, int line, const std::wstring &function,
+  const std::wstring &message) {
+  if (!isEnabled(getMessageLevel(type))) {
+    return;
+  }
+
+  AsyncLog *backend = acquireAsync();
+  if (backend != NULL) {
+    backend->push(type, file, line, function, message);
+  }
+  releaseAsync();
+
+  if (backend != NULL) {
+    return;
   }
+
+  LogRecord record;
+  record.set(type, file, line, function, message);
+  writeNow(record);
 }
 
-void Log::debugInfo(std::wstring file, int line, std::wstring function, std::wstring info) {
-  for (uint i = 0; i < streams.size(); i++) {
-    streams[i]->printf("DEBUG:  File %ls \n\tLine: %d \n\tFunction:%ls [%ls]\n", file.c_str(), line, function.c_str(), info.c_str());
-    streams[i]->flush();
+void Log::write(const LogSite &site, const std::wstring &message) {
+  AsyncLog *backend = acquireAsync();
+  if (backend != NULL) {
+    backend->push(site, message);
   }
+  releaseAsync();
+
+  if (backend != NULL) {
+    return;
+  }
+
+  LogRecord record;
+  record.set(site, message);
+  writeNow(record);
 }
 
-void Log::warning(std::wstring warning) {
+AsyncLog *Log::acquireAsync() {
+  /* Increment is a full barrier, so either disableAsync() sees the user or the user sees NULL */
+  atomicIncrement(&asyncUsers);
+  return asyncLog;
+}
+
+void Log::releaseAsync() {
+  atomicDecrement(&asyncUsers);
+}
+
+void Log::writeNow(const LogRecord &record) {
+  streamsLock->lock();
+  writeRecord(record);
+  flushStreams();
+  streamsLock->unlock();
+}
+
+void Log::writeRecord(const LogRecord &record) {
+  const wchar_t *file = record.getFile();
+  const wchar_t *function = record.getFunction();
+  const wchar_t *message = record.getMessage();
+  const LogSite *site = record.site;
+
   for (uint i = 0; i < streams.size(); i++) {
-    streams[i]->printf("WARNING: %ls\n", warning.c_str());
-    streams[i]->flush();
+    /* Names of call sites are narrow strings, they are never converted */
+    if (site != NULL && record.type == MESSAGE_DEBUG) {
+      streams[i]->printf("DEBUG:  File %s \n\tLine: %d \n\tFunction:%s [%ls]\n", site->file, record.line, site->function, message);
+      continue;
+    }
+
+    if (site != NULL && record.type == MESSAGE_FILE_ERROR) {
+      streams[i]->printf("ERROR:  File: %s \n\tLine: %d \n\tFunction:%s [%ls]\n", site->file, record.line, site->function, message);
+      continue;
+    }
+
+    switch (record.type) {
+    case MESSAGE_INFO:
+      streams[i]->printf("%ls\n", message);
+      break;
+    case MESSAGE_DEBUG:
+      streams[i]->printf("DEBUG:  File %ls \n\tLine: %d \n\tFunction:%ls [%ls]\n", file, record.line, function, message);
+      break;
+    case MESSAGE_WARNING:
+      streams[i]->printf("WARNING: %ls\n", message);
+      break;
+    case MESSAGE_ERROR:
+      streams[i]->printf("ERROR: %ls\n", message);
+      break;
+    case MESSAGE_FUNCTION_ERROR:
+      streams[i]->printf("ERROR: %ls [%ls]\n", function, message);
+      break;
+    case MESSAGE_LINE_ERROR:
+      streams[i]->printf("ERROR: Line: %d %ls [%ls]\n", record.line, function, message);
+      break;
+    case MESSAGE_FILE_ERROR:
+      streams[i]->printf("ERROR:  File: %ls \n\tLine: %d \n\tFunction:%ls [%ls]\n", file, record.line, function, message);
+      break;
+    }
+  }
+
+  if (record.type == MESSAGE_WARNING) {
+    warnings++;
+  } else if (record.type != MESSAGE_INFO && record.type != MESSAGE_DEBUG) {
+    errors++;
   }
-  warnings++;
 }
 
-void Log::error(std::wstring error) {
+void Log::flushStreams() {
   for (uint i = 0; i < streams.size(); i++) {
-    streams[i]->printf("ERROR: %ls\n", error.c_str());
     streams[i]->flush();
   }
-  errors++;
+}
+
+void Log::info(std::wstring msg) {
+  put(MESSAGE_INFO, L"", 0, L"", msg);
+}
+
+void Log::debugInfo(std::wstring file, int line, std::wstring function, std::wstring info) {
+  put(MESSAGE_DEBUG, file, line, function, info);
+}
+
+void Log::warning(std::wstring warning) {
+  put(MESSAGE_WARNING, L"", 0, L"", warning);
+}
+
+void Log::error(std::wstring error) {
+  put(MESSAGE_ERROR, L"", 0, L"", error);
 }
 
 void Log::error(std::wstring function, std::wstring error) {
-  for (uint i = 0; i < streams.size(); i++) {
-    streams[i]->printf("ERROR: %ls [%ls]\n", function.c_str(), error.c_str());
-    streams[i]->flush();
-  }
-  errors++;
+  put(MESSAGE_FUNCTION_ERROR, L"", 0, function, error);
 }
 
 void Log::error(int line, std::wstring function, std::wstring error) {
-  for (uint i = 0; i < streams.size(); i++) {
-    streams[i]->printf("ERROR: Line: %d %ls [%ls]\n", line, function.c_str(), error.c_str());
-    streams[i]->flush();
-  }
-  errors++;
+  put(MESSAGE_LINE_ERROR, L"", line, function, error);
 }
 
 void Log::error(std::wstring file, int line, std::wstring function, std::wstring error) {
-  for (uint i = 0; i < streams.size(); i++) {
-    streams[i]->printf("ERROR:  File: %ls \n\tLine: %d \n\tFunction:%ls [%ls]\n", file.c_str(), line, function.c_str(), error.c_str());
-    streams[i]->flush();
-  }
-  errors++;
+  put(MESSAGE_FILE_ERROR, file, line, function, error);
 }
 
 void Log::glError(std::wstring file, int line, std::wstring function, GLenum error) {
-  for (uint i = 0; i < streams.size(); i++) {
-    streams[i]->printf("ERROR:  File: %ls \n\tLine: %d \n\tFunction:%ls [%ls]\n", file.c_str(), line, function.c_str(), convertGLError(error).c_str());
-    streams[i]->flush();
+  put(MESSAGE_FILE_ERROR, file, line, function, convertGLError(error));
+}
+
+void Log::setLevel(LogLevel level) {
+  threshold = level;
+}
+
+LogLevel Log::getLevel() {
+  return threshold;
+}
+
+LogLevel Log::getMessageLevel(LogMessageType type) {
+  switch (type) {
+  case MESSAGE_DEBUG:
+    return LOG_LEVEL_DEBUG;
+  case MESSAGE_INFO:
+    return LOG_LEVEL_INFO;
+  case MESSAGE_WARNING:
+    return LOG_LEVEL_WARNING;
+  default:
+    return LOG_LEVEL_ERROR;
   }
-  errors++;
+}
+
+Outcome Log::enableAsync(uint capacity, LogOverflowPolicy policy) {
+  static bool drainRegistered = false;
+
+  disableAsync();
+
+  AsyncLog *backend = new AsyncLog(this, capacity, policy);
+  CHECK_ALLOC(backend);
+
+  Outcome result = backend->start();
+  if (result != OK) {
+    delete backend;
+    return result;
+  }
+
+  if (!drainRegistered) {
+    atexit(drainLog);
+    drainRegistered = true;
+  }
+
+  asyncLog = backend;
+  return OK;
+}
+
+void Log::disableAsync() {
+  if (asyncLog == NULL) {
+    return;
+  }
+
+  /* Messages logged by the writer thread itself go to the streams directly */
+  AsyncLog *backend = asyncLog;
+  asyncLog = NULL;
+  memoryBarrier();
+
+  /* Threads which took the pointer before finish their push(), the writer thread
+     is still running, so blocked producers get free slots */
+  while (asyncUsers != 0) {
+    yieldThread();
+  }
+
+  delete backend;
+}
+
+bool Log::isAsync() {
+  return asyncLog != NULL;
+}
+
+void Log::flush() {
+  AsyncLog *backend = acquireAsync();
+  if (backend != NULL) {
+    backend->flush();
+  }
+  releaseAsync();
+}
+
+uint Log::getDroppedCount() {
+  AsyncLog *backend = acquireAsync();
+  uint count = backend != NULL ? backend->getDroppedCount() : 0;
+  releaseAsync();
+  return count;
 }
 
 }
@@ -17,6 +17,61 @@
 
 namespace ve {
 
+class AsyncLog;
+class CriticalSection;
+struct LogRecord;
+
+/**
+    Kinds of log messages, they define how message is formatted.
+*/
+enum LogMessageType {
+  MESSAGE_INFO = 0,
+  MESSAGE_DEBUG,
+  MESSAGE_WARNING,
+  MESSAGE_ERROR,
+  MESSAGE_FUNCTION_ERROR,
+  MESSAGE_LINE_ERROR,
+  MESSAGE_FILE_ERROR
+};
+
+/**
+    Severity levels of messages. Messages below the threshold of the log are
+    skipped at runtime, messages below VE_LOG_LEVEL are removed at compile time.
+*/
+enum LogLevel {
+  LOG_LEVEL_DEBUG = 0,
+  LOG_LEVEL_INFO,
+  LOG_LEVEL_WARNING,
+  LOG_LEVEL_ERROR,
+  LOG_LEVEL_NONE
+};
+
+/**
+    Place in the code which logs messages. Logging macros create one static
+    site per call, so file and function names are not converted on every call.
+*/
+struct LogSite {
+  /** Source file name */
+  const char *file;
+
+  /** Function name */
+  const char *function;
+
+  /** Line number */
+  int line;
+
+  /** Kind of messages logged at this site */
+  LogMessageType type;
+};
+
+/**
+    What a thread does if the queue of the asynchronous log is full.
+*/
+enum LogOverflowPolicy {
+  LOG_DROP = 0,   /*!< Message is dropped and counted, caller never waits. */
+  LOG_BLOCK       /*!< Caller waits until the writer thread frees space.   */
+};
+
 /**
     Singleton class to manage log file, register errors,
     warnings and debug information.
@@ -32,6 +87,18 @@ private:
   /** Number of warnings */
   int warnings;
 
+  /** Lock of the streams, messages may come from several threads */
+  CriticalSection *streamsLock;
+
+  /** Asynchronous backend or NULL if messages are written by the calling thread */
+  AsyncLog * volatile asyncLog;
+
+  /** Number of threads which use the asynchronous backend, it is not deleted while they do */
+  volatile uint asyncUsers;
+
+  /** Messages below this level are skipped */
+  static LogLevel threshold;
+
   /** Instance of this class */
   static Log *instance;
 
@@ -41,6 +108,42 @@ private:
   */
   Log();
 
+  /**
+      Passes message to the asynchronous backend or writes it immediately.
+  */
+  void put(LogMessageType type, const std::wstring &file, int line, const std::wstring &function,
+    const std::wstring &message);
+
+  /**
+      Returns asynchronous backend and counts the caller as its user, so
+      disableAsync() does not delete the backend until releaseAsync() is called.
+      @return Backend or NULL if messages are written by the calling thread.
+  */
+  AsyncLog *acquireAsync();
+
+  /**
+      Stops counting the caller as a user of the asynchronous backend.
+  */
+  void releaseAsync();
+
+  /**
+      Writes record immediately with locked streams.
+  */
+  void writeNow(const LogRecord &record);
+
+  /**
+      Formats record and writes it to all streams. Streams should be locked
+      and they are not flushed.
+  */
+  void writeRecord(const LogRecord &record);
+
+  /**
+      Flushes all streams. Streams should be locked.
+  */
+  void flushStreams();
+
+  friend class AsyncLog;
+
 public:
   /**
       Log destructor. Log file is closed in this destructor.
@@ -130,6 +233,79 @@ public:
       @param error - OpenGL error code to place to this log file.
   */
   void glError(std::wstring file, int line, std::wstring function, GLenum error);
+
+  /**
+      Puts message logged at the site to the log file. It is called by the
+      logging macros, which check the level before the message is created.
+      @param site - Static description of the call site.
+      @param message - Text of the message.
+  */
+  void write(const LogSite &site, const std::wstring &message);
+
+  /**
+      Sets the runtime threshold. Messages below it are skipped, but sites
+      below VE_LOG_LEVEL are not compiled in at all.
+      @param level - Lowest level of written messages.
+  */
+  static void setLevel(LogLevel level);
+
+  /**
+      Returns the runtime threshold.
+      @return Lowest level of written messages.
+  */
+  static LogLevel getLevel();
+
+  /**
+      Checks whether messages of the level are written.
+      @param level - Level of the message.
+      @return 'true' if message should be created and logged.
+  */
+  static bool isEnabled(LogLevel level) {
+    return level >= threshold;
+  }
+
+  /**
+      Returns level of a kind of messages.
+      @param type - Kind of the message.
+      @return Severity of the message.
+  */
+  static LogLevel getMessageLevel(LogMessageType type);
+
+  /**
+      Moves formatting and writing of messages to a background thread. Log
+      calls only copy messages into a queue, so they do not wait for I/O.
+      Queued messages are written at exit or by disableAsync().
+      @param capacity - Number of messages the queue holds.
+      @param policy - What a thread does if the queue is full.
+      @return OK if writer thread was started.
+      @return ERROR if OS error occurred.
+  */
+  Outcome enableAsync(uint capacity = 1024, LogOverflowPolicy policy = LOG_DROP);
+
+  /**
+      Writes queued messages and stops the writer thread. Next messages are
+      written by the calling thread. Other threads may log messages during the
+      call, the backend is deleted after they finish passing messages to it.
+      It should not be called concurrently with enableAsync().
+  */
+  void disableAsync();
+
+  /**
+      Returns whether messages are written by a background thread.
+      @return 'true' if asynchronous backend is enabled.
+  */
+  bool isAsync();
+
+  /**
+      Waits until all queued messages are written.
+  */
+  void flush();
+
+  /**
+      Returns number of messages dropped because the queue was full.
+      @return Number of dropped messages or 0 if backend is not enabled.
+  */
+  uint getDroppedCount();
 };
 
 }
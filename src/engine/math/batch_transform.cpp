@@ -0,0 +1,245 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <math.h>
+
+#include "common.h"
+#include "math/batch_transform.h"
+
+namespace ve {
+
+/* Size in bytes of tightly packed 3D element */
+static const uint PACKED_STRIDE = 3 * sizeof(float);
+
+void BatchTransform::transformPoints(const Matrix4f &matrix, const float *input, uint inputStride,
+                                     float *output, uint outputStride, uint count) {
+  float rows[12];
+  getRows(matrix, true, rows);
+  transformAoS(rows, input, inputStride, output, outputStride, count, false);
+}
+
+void BatchTransform::transformPoints(const Matrix4f &matrix, const float *x, const float *y, const float *z,
+                                     float *outX, float *outY, float *outZ, uint count) {
+  float rows[12];
+  getRows(matrix, true, rows);
+  transformSoA(rows, x, y, z, outX, outY, outZ, count, false);
+}
+
+void BatchTransform::transformVectors(const Matrix4f &matrix, const float *input, uint inputStride,
+                                      float *output, uint outputStride, uint count) {
+  float rows[12];
+  getRows(matrix, false, rows);
+  transformAoS(rows, input, inputStride, output, outputStride, count, false);
+}
+
+Outcome BatchTransform::transformNormals(const Matrix4f &matrix, const float *input, uint inputStride,
+                                         float *output, uint outputStride, uint count, bool normalize) {
+  float rows[12];
+  if (!getNormalRows(matrix, rows)) {
+    return INVALID_OPERATION;
+  }
+
+  transformAoS(rows, input, inputStride, output, outputStride, count, normalize);
+  return OK;
+}
+
+Outcome BatchTransform::transformNormals(const Matrix4f &matrix, const float *x, const float *y, const float *z,
+                                         float *outX, float *outY, float *outZ, uint count, bool normalize) {
+  float rows[12];
+  if (!getNormalRows(matrix, rows)) {
+    return INVALID_OPERATION;
+  }
+
+  transformSoA(rows, x, y, z, outX, outY, outZ, count, normalize);
+  return OK;
+}
+
+void BatchTransform::multiplyMatrices(const Matrix4f &parent, const Matrix4f *local, Matrix4f *result, uint count) {
+#ifdef VE_SSE2
+  const float *p = parent.getRaw();
+  __m128 a[16];
+  for (int i = 0; i < 16; i++) {
+    a[i] = _mm_set1_ps(p[i]);
+  }
+
+  for (uint n = 0; n < count; n++) {
+    const float *b = local[n].getRaw();
+    float *r = result[n].getRaw();
+
+    // All rows of the child are loaded before anything is stored, so result may alias local
+    __m128 b0 = VE_LOAD_ROW(b);
+    __m128 b1 = VE_LOAD_ROW(b + 4);
+    __m128 b2 = VE_LOAD_ROW(b + 8);
+    __m128 b3 = VE_LOAD_ROW(b + 12);
+
+    for (int i = 0; i < 4; i++) {
+      __m128 sum = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[4 * i], b0), _mm_mul_ps(a[4 * i + 1], b1)),
+        _mm_add_ps(_mm_mul_ps(a[4 * i + 2], b2), _mm_mul_ps(a[4 * i + 3], b3)));
+      VE_STORE_ROW(r + 4 * i, sum);
+    }
+  }
+#else
+  float temp[16];
+  for (uint n = 0; n < count; n++) {
+    MathKernel::multiplyScalar(parent.getRaw(), local[n].getRaw(), temp);
+    result[n] = Matrix4f(temp);
+  }
+#endif // VE_SSE2
+}
+
+void BatchTransform::transformAoS(const float *rows, const float *input, uint inputStride,
+                                  float *output, uint outputStride, uint count, bool normalize) {
+  const char *source = (const char *)input;
+  char *destination = (char *)output;
+  if (inputStride == 0) {
+    inputStride = PACKED_STRIDE;
+  }
+  if (outputStride == 0) {
+    outputStride = PACKED_STRIDE;
+  }
+
+#ifdef VE_SSE2
+  // Columns of 3x4 matrix, so every element costs three broadcasts and three multiply-adds
+  __m128 c0 = _mm_setr_ps(rows[0], rows[4], rows[8], 0.0f);
+  __m128 c1 = _mm_setr_ps(rows[1], rows[5], rows[9], 0.0f);
+  __m128 c2 = _mm_setr_ps(rows[2], rows[6], rows[10], 0.0f);
+  __m128 c3 = _mm_setr_ps(rows[3], rows[7], rows[11], 0.0f);
+
+  for (uint i = 0; i < count; i++) {
+    const float *v = (const float *)source;
+    float *r = (float *)destination;
+
+    __m128 sum = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(v[0])), _mm_mul_ps(c1, _mm_set1_ps(v[1]))),
+      _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(v[2])), c3));
+
+    if (normalize) {
+      __m128 square = _mm_mul_ps(sum, sum);
+      __m128 length = _mm_add_ss(_mm_add_ss(square, _mm_shuffle_ps(square, square, _MM_SHUFFLE(1, 1, 1, 1))),
+        _mm_movehl_ps(square, square));
+      // Threshold is the same as in MathKernel::normalize()
+      if (_mm_cvtss_f32(length) >= 1e-6f) {
+        length = _mm_sqrt_ss(length);
+        sum = _mm_div_ps(sum, _mm_shuffle_ps(length, length, _MM_SHUFFLE(0, 0, 0, 0)));
+      }
+    }
+
+    _mm_storel_pi((__m64 *)r, sum);
+    _mm_store_ss(r + 2, _mm_movehl_ps(sum, sum));
+
+    source += inputStride;
+    destination += outputStride;
+  }
+#else
+  for (uint i = 0; i < count; i++) {
+    const float *v = (const float *)source;
+    float *r = (float *)destination;
+    float x = v[0], y = v[1], z = v[2];
+
+    r[0] = rows[0] * x + rows[1] * y + rows[2] * z + rows[3];
+    r[1] = rows[4] * x + rows[5] * y + rows[6] * z + rows[7];
+    r[2] = rows[8] * x + rows[9] * y + rows[10] * z + rows[11];
+
+    if (normalize) {
+      MathKernel::normalize(r, 3);
+    }
+
+    source += inputStride;
+    destination += outputStride;
+  }
+#endif // VE_SSE2
+}
+
+void BatchTransform::transformSoA(const float *rows, const float *x, const float *y, const float *z,
+                                  float *outX, float *outY, float *outZ, uint count, bool normalize) {
+  uint i = 0;
+
+#ifdef VE_SSE2
+  __m128 m[12];
+  for (int k = 0; k < 12; k++) {
+    m[k] = _mm_set1_ps(rows[k]);
+  }
+
+  // Four elements per iteration, the tail is processed by scalar code below
+  for (; i + 4 <= count; i += 4) {
+    __m128 vx = _mm_loadu_ps(x + i);
+    __m128 vy = _mm_loadu_ps(y + i);
+    __m128 vz = _mm_loadu_ps(z + i);
+
+    __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[0], vx), _mm_mul_ps(m[1], vy)),
+      _mm_add_ps(_mm_mul_ps(m[2], vz), m[3]));
+    __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[4], vx), _mm_mul_ps(m[5], vy)),
+      _mm_add_ps(_mm_mul_ps(m[6], vz), m[7]));
+    __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[8], vx), _mm_mul_ps(m[9], vy)),
+      _mm_add_ps(_mm_mul_ps(m[10], vz), m[11]));
+
+    if (normalize) {
+      __m128 square = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)), _mm_mul_ps(rz, rz));
+      // Near zero vectors are kept unchanged like in MathKernel::normalize()
+      __m128 nonZero = _mm_cmpge_ps(square, _mm_set1_ps(1e-6f));
+      __m128 scale = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(_mm_max_ps(square, _mm_set1_ps(1e-6f))));
+      scale = _mm_or_ps(_mm_and_ps(nonZero, scale), _mm_andnot_ps(nonZero, _mm_set1_ps(1.0f)));
+      rx = _mm_mul_ps(rx, scale);
+      ry = _mm_mul_ps(ry, scale);
+      rz = _mm_mul_ps(rz, scale);
+    }
+
+    _mm_storeu_ps(outX + i, rx);
+    _mm_storeu_ps(outY + i, ry);
+    _mm_storeu_ps(outZ + i, rz);
+  }
+#endif // VE_SSE2
+
+  for (; i < count; i++) {
+    float r[3];
+    r[0] = rows[0] * x[i] + rows[1] * y[i] + rows[2] * z[i] + rows[3];
+    r[1] = rows[4] * x[i] + rows[5] * y[i] + rows[6] * z[i] + rows[7];
+    r[2] = rows[8] * x[i] + rows[9] * y[i] + rows[10] * z[i] + rows[11];
+
+    if (normalize) {
+      MathKernel::normalize(r, 3);
+    }
+
+    outX[i] = r[0];
+    outY[i] = r[1];
+    outZ[i] = r[2];
+  }
+}
+
+void BatchTransform::getRows(const Matrix4f &matrix, bool translation, float *rows) {
+  const float *m = matrix.getRaw();
+  for (int i = 0; i < 12; i++) {
+    rows[i] = m[i];
+  }
+
+  if (!translation) {
+    rows[3] = rows[7] = rows[11] = 0.0f;
+  }
+}
+
+bool BatchTransform::getNormalRows(const Matrix4f &matrix, float *rows) {
+  const float *m = matrix.getRaw();
+  const float *r0 = m, *r1 = m + 4, *r2 = m + 8;
+
+  // Inverse transposed matrix is the cofactor matrix divided by determinant
+  float c[3][3];
+  MathKernel::cross3(r1, r2, c[0]);
+  MathKernel::cross3(r2, r0, c[1]);
+  MathKernel::cross3(r0, r1, c[2]);
+
+  float det = MathKernel::dot3(r0, c[0]);
+  if (det == 0.0f) {
+    return false;
+  }
+
+  float rDet = 1.0f / det;
+  for (int i = 0; i < 3; i++) {
+    rows[4 * i] = c[i][0] * rDet;
+    rows[4 * i + 1] = c[i][1] * rDet;
+    rows[4 * i + 2] = c[i][2] * rDet;
+    rows[4 * i + 3] = 0.0f;
+  }
+
+  return true;
+}
+
+}
@@ -0,0 +1,133 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_BATCH_TRANSFORM_H__
+#define __VE_BATCH_TRANSFORM_H__
+
+#include "engine/types.h"
+#include "engine/math/matrix4f.h"
+
+namespace ve {
+
+/**
+    Transforms arrays of points, normals and matrices by one matrix. These kernels
+    are intended for software skinning, sprite batching and culling where thousands
+    of elements are transformed every frame, so matrix is prepared only once
+    per call and no temporary objects are created.
+
+    Array of structures (AoS) functions take stride in bytes between consecutive
+    elements, 0 means tightly packed elements (3 floats), like in OpenGL vertex
+    arrays. Structure of arrays (SoA) functions take separate arrays of X, Y and Z
+    components. Output arrays may be the same as input ones.
+*/
+class BatchTransform {
+public:
+  /**
+      Transforms points (W = 1) by matrix, projective part is ignored.
+      @param matrix - Transformation matrix.
+      @param input - First point, 3 floats.
+      @param inputStride - Distance in bytes between points, 0 for packed points.
+      @param output - First resulting point, 3 floats.
+      @param outputStride - Distance in bytes between resulting points, 0 for packed points.
+      @param count - Number of points.
+  */
+  static void transformPoints(const Matrix4f &matrix, const float *input, uint inputStride,
+    float *output, uint outputStride, uint count);
+
+  /**
+      Transforms points (W = 1) stored as separate component arrays.
+      @param matrix - Transformation matrix.
+      @param x - X components of points.
+      @param y - Y components of points.
+      @param z - Z components of points.
+      @param outX - X components of resulting points.
+      @param outY - Y components of resulting points.
+      @param outZ - Z components of resulting points.
+      @param count - Number of points.
+  */
+  static void transformPoints(const Matrix4f &matrix, const float *x, const float *y, const float *z,
+    float *outX, float *outY, float *outZ, uint count);
+
+  /**
+      Transforms directions (W = 0) by matrix, translation is ignored.
+      @param matrix - Transformation matrix.
+      @param input - First direction, 3 floats.
+      @param inputStride - Distance in bytes between directions, 0 for packed ones.
+      @param output - First resulting direction, 3 floats.
+      @param outputStride - Distance in bytes between resulting directions, 0 for packed ones.
+      @param count - Number of directions.
+  */
+  static void transformVectors(const Matrix4f &matrix, const float *input, uint inputStride,
+    float *output, uint outputStride, uint count);
+
+  /**
+      Transforms normals by inverse transposed upper 3x3 part of the matrix,
+      so they stay perpendicular to surfaces under non-uniform scaling.
+      @param matrix - Transformation matrix of the surface.
+      @param input - First normal, 3 floats.
+      @param inputStride - Distance in bytes between normals, 0 for packed ones.
+      @param output - First resulting normal, 3 floats.
+      @param outputStride - Distance in bytes between resulting normals, 0 for packed ones.
+      @param count - Number of normals.
+      @param normalize - Normalize resulting normals or not.
+      @return OK if normals were transformed.
+      @return INVALID_OPERATION if matrix is singular.
+  */
+  static Outcome transformNormals(const Matrix4f &matrix, const float *input, uint inputStride,
+    float *output, uint outputStride, uint count, bool normalize);
+
+  /**
+      Transforms normals stored as separate component arrays. See the AoS version.
+      @param matrix - Transformation matrix of the surface.
+      @param x - X components of normals.
+      @param y - Y components of normals.
+      @param z - Z components of normals.
+      @param outX - X components of resulting normals.
+      @param outY - Y components of resulting normals.
+      @param outZ - Z components of resulting normals.
+      @param count - Number of normals.
+      @param normalize - Normalize resulting normals or not.
+      @return OK if normals were transformed.
+      @return INVALID_OPERATION if matrix is singular.
+  */
+  static Outcome transformNormals(const Matrix4f &matrix, const float *x, const float *y, const float *z,
+    float *outX, float *outY, float *outZ, uint count, bool normalize);
+
+  /**
+      Multiplies parent matrix on array of matrices: result[i] = parent * local[i].
+      It is used to get world matrices of children in a hierarchy.
+      @param parent - Parent matrix.
+      @param local - Array of child matrices.
+      @param result - Array of resulting matrices. It may be the same as local array.
+      @param count - Number of matrices.
+  */
+  static void multiplyMatrices(const Matrix4f &parent, const Matrix4f *local, Matrix4f *result, uint count);
+
+private:
+  /**
+      Transforms AoS elements by 3x4 matrix stored row by row.
+  */
+  static void transformAoS(const float *rows, const float *input, uint inputStride,
+    float *output, uint outputStride, uint count, bool normalize);
+
+  /**
+      Transforms SoA elements by 3x4 matrix stored row by row.
+  */
+  static void transformSoA(const float *rows, const float *x, const float *y, const float *z,
+    float *outX, float *outY, float *outZ, uint count, bool normalize);
+
+  /**
+      Copies upper 3x4 part of the matrix, translation is set to zero if it is not needed.
+  */
+  static void getRows(const Matrix4f &matrix, bool translation, float *rows);
+
+  /**
+      Computes inverse transposed upper 3x3 part of the matrix as 3x4 matrix with zero translation.
+      @return 'false' if matrix is singular.
+  */
+  static bool getNormalRows(const Matrix4f &matrix, float *rows);
+};
+
+}
+
+#endif // __VE_BATCH_TRANSFORM_H__
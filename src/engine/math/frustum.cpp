@@ -8,7 +8,11 @@
 namespace ve {
 
 Frustum::Frustum() {
-  update();
+  update(Matrix4f(), Matrix4f());
+}
+
+Frustum::Frustum(const Matrix4f &view, const Matrix4f &projection) {
+  update(view, projection);
 }
 
 void Frustum::update() {
@@ -26,6 +30,21 @@ void Frustum::update() {
   glGetFloatv(GL_MODELVIEW_MATRIX, clip);
   glPopMatrix();
 
+  setPlanes(clip);
+}
+
+void Frustum::update(const Matrix4f &view, const Matrix4f &projection) {
+  // Matrix4f is stored row by row, so transposed product has OpenGL layout
+  Matrix4f clip = projection * view;
+  clip.transpose();
+  setPlanes(clip.getRaw());
+}
+
+const Plane &Frustum::getPlane(int index) const {
+  return frustum[index];
+}
+
+void Frustum::setPlanes(const float *clip) {
   // Left clipping plane
   frustum[0].setCoeff(clip[3] + clip[0], clip[7] + clip[4], clip[11] + clip[8], clip[15] + clip[12]);
   // Right clipping plane
@@ -38,9 +57,13 @@ void Frustum::update() {
   frustum[4].setCoeff(clip[3] + clip[2], clip[7] + clip[6], clip[11] + clip[10], clip[15] + clip[14]);
   // Far clipping plane
   frustum[5].setCoeff(clip[3] - clip[2], clip[7] - clip[6], clip[11] - clip[10], clip[15] - clip[14]);
+
+  for (int i = 0; i < 6; i++) {
+    frustum[i].norm();
+  }
 }
 
-bool Frustum::isVisible(Vector3f point) {
+bool Frustum::isVisible(Vector3f point) const {
   int i;
 
   for (i = 0; i < 6; i++)
@@ -50,7 +73,7 @@ bool Frustum::isVisible(Vector3f point) {
   return true;
 }
 
-bool Frustum::isVisible(BoundingBox boundingBox) {
+bool Frustum::isVisible(BoundingBox boundingBox) const {
   Vector3f point[8];
   int i, j;
   bool flag;
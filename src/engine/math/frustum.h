@@ -7,47 +7,80 @@
 #include "consts.h"
 #include "types.h"
 #include "math/bounding_box.h"
+#include "math/matrix4f.h"
 #include "math/plane.h"
 
 namespace ve {
 
 /**
     Class for operations with camera's frustum (which consists of six planes).
-    <b>FIXME:</b>Need redesign.
+    Planes are normalized and their normals point inside the frustum, so
+    signed distance from a point to a plane is a dot product.
 */
 class Frustum {
 private:
   /**
-      Frustum planes.
+      Frustum planes: left, right, top, bottom, near and far.
   */
   Plane frustum[6];
 
+  /**
+      Extracts planes from combined projection * view matrix and normalizes them.
+      @param clip - Elements of the combined matrix in OpenGL (column by column) order.
+  */
+  void setPlanes(const float *clip);
+
 public:
   /**
-      Simple constructor.
+      Simple constructor. Sets frustum for identity view and projection
+      matrices, i.e. cube [-1, 1]. OpenGL is not used, so frustum may be created
+      on any thread.
   */
   Frustum();
 
   /**
-      <b>FIXME:</b>This function needs reimplementation, because it uses OpenGL functions.
-      It seems that Camera class should be added as parameter.
+      Constructor. Extracts planes from specified matrices.
+      @param view - View (modelview) matrix.
+      @param projection - Projection matrix.
+  */
+  Frustum(const Matrix4f &view, const Matrix4f &projection);
+
+  /**
+      Reads current modelview and projection matrices from OpenGL and extracts planes.
+      It stalls the pipeline and may be called only on the render thread, use
+      update(view, projection) with camera matrices instead.
   */
   void update();
 
+  /**
+      Extracts planes from specified matrices without OpenGL calls, so it
+      may be called on any thread.
+      @param view - View (modelview) matrix, e.g. AbstractCamera::getViewMatrix().
+      @param projection - Projection matrix, e.g. AbstractCamera::getProjectionMatrix().
+  */
+  void update(const Matrix4f &view, const Matrix4f &projection);
+
+  /**
+      Returns frustum plane.
+      @param index - Index of the plane from 0 to 5: left, right, top, bottom, near and far.
+      @return Normalized plane with normal pointing inside the frustum.
+  */
+  const Plane &getPlane(int index) const;
+
   /**
       Check if point is visible in this frustum.
       @param point - Point to check if it is inside this frustum.
       @return 'true' if it is inside and 'false' if not.
   */
-  bool isVisible(Vector3f point);
+  bool isVisible(Vector3f point) const;
 
   /**
-      Check if bounding box is visible in this forum.
+      Check if bounding box is visible in this frustum.
       @param boundingBox - Bounding box to check if it is inside frustum.
       It is considered that bounding box is inside this frustum if at least
       one point of this box is visible.
   */
-  bool isVisible(BoundingBox boundingBox);
+  bool isVisible(BoundingBox boundingBox) const;
 };
 
 }
@@ -0,0 +1,191 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <string.h>
+
+#include "common.h"
+#include "math/maths.h"
+#include "math/frustum_culler.h"
+
+namespace ve {
+
+FrustumCuller::FrustumCuller() {
+  coherency = true;
+  setFrustum(Frustum());
+}
+
+void FrustumCuller::setFrustum(const Frustum &frustum) {
+  for (int i = 0; i < 6; i++) {
+    const Plane &plane = frustum.getPlane(i);
+    for (int j = 0; j < 4; j++) {
+      planes[i][j] = plane[j];
+    }
+
+    planes[i][4] = Maths::abs(plane[0]);
+    planes[i][5] = Maths::abs(plane[1]);
+    planes[i][6] = Maths::abs(plane[2]);
+  }
+}
+
+void FrustumCuller::setCoherency(bool value) {
+  coherency = value;
+  planeCache.clear();
+}
+
+bool FrustumCuller::getCoherency() {
+  return coherency;
+}
+
+uint FrustumCuller::cullBoxes(const float *x, const float *y, const float *z,
+                              const float *extentX, const float *extentY, const float *extentZ,
+                              uint count, uint *indices) {
+  return cull(x, y, z, extentX, extentY, extentZ, NULL, count, indices, NULL);
+}
+
+uint FrustumCuller::cullBoxesMask(const float *x, const float *y, const float *z,
+                                  const float *extentX, const float *extentY, const float *extentZ,
+                                  uint count, uint *mask) {
+  return cull(x, y, z, extentX, extentY, extentZ, NULL, count, NULL, mask);
+}
+
+uint FrustumCuller::cullSpheres(const float *x, const float *y, const float *z, const float *radius,
+                                uint count, uint *indices) {
+  return cull(x, y, z, NULL, NULL, NULL, radius, count, indices, NULL);
+}
+
+uint FrustumCuller::cullSpheresMask(const float *x, const float *y, const float *z, const float *radius,
+                                    uint count, uint *mask) {
+  return cull(x, y, z, NULL, NULL, NULL, radius, count, NULL, mask);
+}
+
+uint FrustumCuller::cull(const float *x, const float *y, const float *z,
+                         const float *extentX, const float *extentY, const float *extentZ, const float *radius,
+                         uint count, uint *indices, uint *mask) {
+  if (mask != NULL) {
+    memset(mask, 0, ((count + 31) / 32) * sizeof(uint));
+  }
+
+  // One cache entry for every group of four volumes which are tested together
+  uint groups = (count + 3) / 4;
+  if (coherency && planeCache.size() != groups) {
+    planeCache.assign(groups, 0);
+  }
+
+  uint i = 0;
+  uint visible = 0;
+
+#ifdef VE_SSE2
+  __m128 plane[6][7];
+  for (int k = 0; k < 6; k++) {
+    for (int j = 0; j < 7; j++) {
+      plane[k][j] = _mm_set1_ps(planes[k][j]);
+    }
+  }
+
+  __m128 zero = _mm_setzero_ps();
+  unsigned char *cache = coherency && count > 0 ? &planeCache[0] : NULL;
+
+  for (; i + 4 <= count; i += 4) {
+    __m128 cx = _mm_loadu_ps(x + i);
+    __m128 cy = _mm_loadu_ps(y + i);
+    __m128 cz = _mm_loadu_ps(z + i);
+    __m128 ex, ey, ez;
+    if (radius == NULL) {
+      ex = _mm_loadu_ps(extentX + i);
+      ey = _mm_loadu_ps(extentY + i);
+      ez = _mm_loadu_ps(extentZ + i);
+    } else {
+      ex = _mm_loadu_ps(radius + i);
+      ey = ez = zero;
+    }
+
+    // Plane which rejected the whole group last time goes first
+    int first = cache != NULL ? cache[i >> 2] : 0;
+
+    int outside = 0;
+    for (int n = 0; n < 6 && outside != 15; n++) {
+      int k = n == 0 ? first : (n <= first ? n - 1 : n);
+
+      __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(plane[k][0], cx), _mm_mul_ps(plane[k][1], cy)),
+        _mm_add_ps(_mm_mul_ps(plane[k][2], cz), plane[k][3]));
+
+      // Projection of the box on the plane normal or sphere radius
+      __m128 projection;
+      if (radius == NULL) {
+        projection = _mm_add_ps(_mm_add_ps(_mm_mul_ps(plane[k][4], ex), _mm_mul_ps(plane[k][5], ey)),
+          _mm_mul_ps(plane[k][6], ez));
+      } else {
+        projection = ex;
+      }
+
+      outside |= _mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(distance, projection), zero));
+      if (outside == 15 && cache != NULL) {
+        cache[i >> 2] = (unsigned char)k;
+      }
+    }
+
+    int inside = ~outside & 15;
+    if (inside == 0) {
+      continue;
+    }
+
+    if (mask != NULL) {
+      mask[i >> 5] |= (uint)inside << (i & 31);
+    }
+
+    for (int lane = 0; lane < 4; lane++) {
+      if (inside & (1 << lane)) {
+        if (indices != NULL) {
+          indices[visible] = i + lane;
+        }
+        visible++;
+      }
+    }
+  }
+#endif // VE_SSE2
+
+  return cullScalar(x, y, z, extentX, extentY, extentZ, radius, i, count, indices, visible, mask);
+}
+
+uint FrustumCuller::cullScalar(const float *x, const float *y, const float *z,
+                               const float *extentX, const float *extentY, const float *extentZ, const float *radius,
+                               uint first, uint count, uint *indices, uint visible, uint *mask) {
+  for (uint i = first; i < count; i++) {
+    int start = coherency ? planeCache[i >> 2] : 0;
+    bool inside = true;
+
+    for (int n = 0; n < 6; n++) {
+      int k = n == 0 ? start : (n <= start ? n - 1 : n);
+      const float *plane = planes[k];
+
+      float distance = plane[0] * x[i] + plane[1] * y[i] + plane[2] * z[i] + plane[3];
+      float projection = radius != NULL ? radius[i] :
+        plane[4] * extentX[i] + plane[5] * extentY[i] + plane[6] * extentZ[i];
+
+      if (distance + projection < 0) {
+        if (coherency) {
+          planeCache[i >> 2] = (unsigned char)k;
+        }
+        inside = false;
+        break;
+      }
+    }
+
+    if (!inside) {
+      continue;
+    }
+
+    if (mask != NULL) {
+      mask[i >> 5] |= 1u << (i & 31);
+    }
+
+    if (indices != NULL) {
+      indices[visible] = i;
+    }
+    visible++;
+  }
+
+  return visible;
+}
+
+}
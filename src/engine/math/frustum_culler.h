@@ -0,0 +1,143 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_FRUSTUM_CULLER_H__
+#define __VE_FRUSTUM_CULLER_H__
+
+#include <vector>
+
+#include "engine/types.h"
+#include "engine/math/frustum.h"
+
+namespace ve {
+
+/**
+    Tests many bounding volumes against a frustum at once. Volumes are passed
+    as structure of arrays: separate arrays of center coordinates and of box half
+    extents (or sphere radii), four volumes are tested per SSE2 instruction.
+
+    Boxes are tested with p-vertex/n-vertex trick in center-extent form: for every
+    plane the box is projected on the plane normal, so only one distance is computed
+    instead of eight corners. Box is rejected if it is completely behind at least one
+    plane, so the test is conservative like Frustum::isVisible(BoundingBox).
+
+    When plane coherency is enabled, the culler remembers for every group of four
+    consecutive volumes the plane which rejected them last time and tests this plane
+    first on the next call. It works when the same arrays (same order and count) are
+    passed every frame and neighbour volumes in arrays are close in space, e.g. when
+    they are sorted by a spatial structure.
+*/
+class FrustumCuller {
+private:
+  /** Plane normals, distances and absolute values of normals: 7 floats per plane */
+  float planes[6][7];
+
+  /** Index of the plane which rejected the group of four volumes last time, for every group */
+  std::vector<unsigned char> planeCache;
+
+  /** Plane coherency flag */
+  bool coherency;
+
+  /**
+      Culls volumes and writes result as index list and/or bitmask.
+      Extents are NULL for spheres, radius is NULL for boxes.
+      @return Number of visible volumes.
+  */
+  uint cull(const float *x, const float *y, const float *z,
+    const float *extentX, const float *extentY, const float *extentZ, const float *radius,
+    uint count, uint *indices, uint *mask);
+
+  /**
+      Tests volumes from first to count - 1 one by one.
+  */
+  uint cullScalar(const float *x, const float *y, const float *z,
+    const float *extentX, const float *extentY, const float *extentZ, const float *radius,
+    uint first, uint count, uint *indices, uint visible, uint *mask);
+
+public:
+  /**
+      Constructor. Frustum is cube [-1, 1] until setFrustum() is called,
+      plane coherency is enabled.
+  */
+  FrustumCuller();
+
+  /**
+      Sets frustum to test volumes against.
+      @param frustum - Frustum with normalized planes.
+  */
+  void setFrustum(const Frustum &frustum);
+
+  /**
+      Enables or disables plane coherency cache. Cache is cleared in both cases.
+      @param value - 'true' to enable the cache.
+  */
+  void setCoherency(bool value);
+
+  /**
+      Returns if plane coherency cache is enabled.
+      @return 'true' if cache is enabled.
+  */
+  bool getCoherency();
+
+  /**
+      Tests axis aligned boxes and writes indices of visible ones.
+      @param x - X coordinates of box centers.
+      @param y - Y coordinates of box centers.
+      @param z - Z coordinates of box centers.
+      @param extentX - Half sizes of boxes along X axis.
+      @param extentY - Half sizes of boxes along Y axis.
+      @param extentZ - Half sizes of boxes along Z axis.
+      @param count - Number of boxes.
+      @param indices - Array of at least count elements to write indices of visible boxes to.
+      @return Number of visible boxes, i.e. number of written indices.
+  */
+  uint cullBoxes(const float *x, const float *y, const float *z,
+    const float *extentX, const float *extentY, const float *extentZ, uint count, uint *indices);
+
+  /**
+      Tests axis aligned boxes and writes visibility bitmask.
+      @param x - X coordinates of box centers.
+      @param y - Y coordinates of box centers.
+      @param z - Z coordinates of box centers.
+      @param extentX - Half sizes of boxes along X axis.
+      @param extentY - Half sizes of boxes along Y axis.
+      @param extentZ - Half sizes of boxes along Z axis.
+      @param count - Number of boxes.
+      @param mask - Array of (count + 31) / 32 elements, bit (i % 32) of element (i / 32)
+      is set if box i is visible.
+      @return Number of visible boxes.
+  */
+  uint cullBoxesMask(const float *x, const float *y, const float *z,
+    const float *extentX, const float *extentY, const float *extentZ, uint count, uint *mask);
+
+  /**
+      Tests spheres and writes indices of visible ones.
+      @param x - X coordinates of sphere centers.
+      @param y - Y coordinates of sphere centers.
+      @param z - Z coordinates of sphere centers.
+      @param radius - Radii of spheres.
+      @param count - Number of spheres.
+      @param indices - Array of at least count elements to write indices of visible spheres to.
+      @return Number of visible spheres, i.e. number of written indices.
+  */
+  uint cullSpheres(const float *x, const float *y, const float *z, const float *radius,
+    uint count, uint *indices);
+
+  /**
+      Tests spheres and writes visibility bitmask.
+      @param x - X coordinates of sphere centers.
+      @param y - Y coordinates of sphere centers.
+      @param z - Z coordinates of sphere centers.
+      @param radius - Radii of spheres.
+      @param count - Number of spheres.
+      @param mask - Array of (count + 31) / 32 elements, bit (i % 32) of element (i / 32)
+      is set if sphere i is visible.
+      @return Number of visible spheres.
+  */
+  uint cullSpheresMask(const float *x, const float *y, const float *z, const float *radius,
+    uint count, uint *mask);
+};
+
+}
+
+#endif // __VE_FRUSTUM_CULLER_H__
@@ -0,0 +1,453 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_MATH_KERNEL_H__
+#define __VE_MATH_KERNEL_H__
+
+#include <cmath>
+
+/*
+  SSE2 is used when compiler targets it (always true for x86-64) and it was not
+  disabled with VE_NO_SIMD. Aligned loads are used only on 64-bit targets where
+  heap allocations are 16-byte aligned, 32-bit MSVC also can not pass aligned
+  objects by value, so alignment is not forced there.
+*/
+#if !defined(VE_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define VE_SSE2
+#include <emmintrin.h>
+#endif // VE_SSE2
+
+#if defined(__x86_64__) || defined(_M_X64)
+#ifdef _MSC_VER
+#define VE_ALIGN16 __declspec(align(16))
+#else
+#define VE_ALIGN16 __attribute__((aligned(16)))
+#endif // _MSC_VER
+#define VE_ALIGNED_LOADS
+#else
+#define VE_ALIGN16
+#endif // __x86_64__ || _M_X64
+
+#ifdef VE_SSE2
+#ifdef VE_ALIGNED_LOADS
+#define VE_LOAD_ROW(p) _mm_load_ps(p)
+#define VE_STORE_ROW(p, v) _mm_store_ps(p, v)
+#else
+#define VE_LOAD_ROW(p) _mm_loadu_ps(p)
+#define VE_STORE_ROW(p, v) _mm_storeu_ps(p, v)
+#endif // VE_ALIGNED_LOADS
+#endif // VE_SSE2
+
+namespace ve {
+
+/**
+    Low level kernels for 4x4 matrices and 3D/4D vectors which are used by Matrix4f,
+    Vector3f and Vector4f. Matrices are 16 floats stored row by row and vectors are
+    multiplied as columns (translation is in the last column). Matrix arguments must be
+    16-byte aligned when VE_ALIGNED_LOADS is defined (Matrix4f guarantees it),
+    vector arguments may have any alignment.
+    Every operation has scalar version which is used when SSE2 is not available.
+*/
+class MathKernel {
+public:
+  /**
+      Checks if SSE2 versions of kernels are used.
+      @return 'true' if SSE2 is used and 'false' if scalar code is used.
+  */
+  static bool isAccelerated() {
+#ifdef VE_SSE2
+    return true;
+#else
+    return false;
+#endif // VE_SSE2
+  }
+
+  /**
+      Multiplies matrices: result = a * b. Result may not point to a or b.
+  */
+  static void multiply(const float *a, const float *b, float *result) {
+#ifdef VE_SSE2
+    __m128 b0 = VE_LOAD_ROW(b);
+    __m128 b1 = VE_LOAD_ROW(b + 4);
+    __m128 b2 = VE_LOAD_ROW(b + 8);
+    __m128 b3 = VE_LOAD_ROW(b + 12);
+
+    for (int i = 0; i < 4; i++) {
+      __m128 row = VE_LOAD_ROW(a + 4 * i);
+      __m128 sum = _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+      sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+      sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+      sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(3, 3, 3, 3)), b3));
+      VE_STORE_ROW(result + 4 * i, sum);
+    }
+#else
+    multiplyScalar(a, b, result);
+#endif // VE_SSE2
+  }
+
+  /**
+      Scalar version of multiply().
+  */
+  static void multiplyScalar(const float *a, const float *b, float *result) {
+    for (int i = 0; i < 4; i++) {
+      const float *row = a + 4 * i;
+      for (int j = 0; j < 4; j++) {
+        result[4 * i + j] = row[0] * b[j] + row[1] * b[4 + j] + row[2] * b[8 + j] + row[3] * b[12 + j];
+      }
+    }
+  }
+
+  /**
+      Transforms 4D vector: result = m * v. Result may point to v.
+  */
+  static void transform(const float *m, const float *v, float *result) {
+#ifdef VE_SSE2
+    __m128 vec = _mm_loadu_ps(v);
+    __m128 p0 = _mm_mul_ps(VE_LOAD_ROW(m), vec);
+    __m128 p1 = _mm_mul_ps(VE_LOAD_ROW(m + 4), vec);
+    __m128 p2 = _mm_mul_ps(VE_LOAD_ROW(m + 8), vec);
+    __m128 p3 = _mm_mul_ps(VE_LOAD_ROW(m + 12), vec);
+    _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+    _mm_storeu_ps(result, _mm_add_ps(_mm_add_ps(p0, p1), _mm_add_ps(p2, p3)));
+#else
+    transformScalar(m, v, result);
+#endif // VE_SSE2
+  }
+
+  /**
+      Scalar version of transform().
+  */
+  static void transformScalar(const float *m, const float *v, float *result) {
+    float x = v[0], y = v[1], z = v[2], w = v[3];
+    for (int i = 0; i < 4; i++) {
+      result[i] = m[4 * i] * x + m[4 * i + 1] * y + m[4 * i + 2] * z + m[4 * i + 3] * w;
+    }
+  }
+
+  /**
+      Transforms 3D point (W = 1) by affine matrix. Projective part is ignored.
+      Result may point to p.
+  */
+  static void transformPoint(const float *m, const float *p, float *result) {
+    float x = p[0], y = p[1], z = p[2];
+    result[0] = m[0] * x + m[1] * y + m[2] * z + m[3];
+    result[1] = m[4] * x + m[5] * y + m[6] * z + m[7];
+    result[2] = m[8] * x + m[9] * y + m[10] * z + m[11];
+  }
+
+  /**
+      Transforms 3D direction (W = 0) by matrix. Result may point to v.
+  */
+  static void transformVector(const float *m, const float *v, float *result) {
+    float x = v[0], y = v[1], z = v[2];
+    result[0] = m[0] * x + m[1] * y + m[2] * z;
+    result[1] = m[4] * x + m[5] * y + m[6] * z;
+    result[2] = m[8] * x + m[9] * y + m[10] * z;
+  }
+
+  /**
+      Transposes matrix. Result may point to m.
+  */
+  static void transpose(const float *m, float *result) {
+#ifdef VE_SSE2
+    __m128 r0 = VE_LOAD_ROW(m);
+    __m128 r1 = VE_LOAD_ROW(m + 4);
+    __m128 r2 = VE_LOAD_ROW(m + 8);
+    __m128 r3 = VE_LOAD_ROW(m + 12);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    VE_STORE_ROW(result, r0);
+    VE_STORE_ROW(result + 4, r1);
+    VE_STORE_ROW(result + 8, r2);
+    VE_STORE_ROW(result + 12, r3);
+#else
+    transposeScalar(m, result);
+#endif // VE_SSE2
+  }
+
+  /**
+      Scalar version of transpose().
+  */
+  static void transposeScalar(const float *m, float *result) {
+    float tmp[16];
+    for (int i = 0; i < 4; i++) {
+      for (int j = 0; j < 4; j++) {
+        tmp[4 * j + i] = m[4 * i + j];
+      }
+    }
+
+    for (int i = 0; i < 16; i++) {
+      result[i] = tmp[i];
+    }
+  }
+
+  /**
+      Inverts general matrix. Result may point to m.
+      @return 'false' if matrix is singular, result is not changed in this case.
+  */
+  static bool inverse(const float *m, float *result) {
+#ifdef VE_SSE2
+    // Block-wise inversion: M = | A B |, every block is 2x2 matrix stored in one register
+    //                           | C D |
+    __m128 r0 = VE_LOAD_ROW(m);
+    __m128 r1 = VE_LOAD_ROW(m + 4);
+    __m128 r2 = VE_LOAD_ROW(m + 8);
+    __m128 r3 = VE_LOAD_ROW(m + 12);
+
+    __m128 A = _mm_movelh_ps(r0, r1);
+    __m128 B = _mm_movehl_ps(r1, r0);
+    __m128 C = _mm_movelh_ps(r2, r3);
+    __m128 D = _mm_movehl_ps(r3, r2);
+
+    // Determinants of blocks (|A|, |B|, |C|, |D|)
+    __m128 detSub = _mm_sub_ps(
+      _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+      _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0))));
+    __m128 detA = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(0, 0, 0, 0));
+    __m128 detB = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(1, 1, 1, 1));
+    __m128 detC = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(2, 2, 2, 2));
+    __m128 detD = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(3, 3, 3, 3));
+
+    // Adjugates: X# = |D|A - B(D#C), W# = |A|D - C(A#B), Y# = |B|C - D(A#B)#, Z# = |C|B - A(D#C)#
+    __m128 D_C = adjMul2x2(D, C);
+    __m128 A_B = adjMul2x2(A, B);
+    __m128 X_ = _mm_sub_ps(_mm_mul_ps(detD, A), mul2x2(B, D_C));
+    __m128 W_ = _mm_sub_ps(_mm_mul_ps(detA, D), mul2x2(C, A_B));
+    __m128 Y_ = _mm_sub_ps(_mm_mul_ps(detB, C), mulAdj2x2(D, A_B));
+    __m128 Z_ = _mm_sub_ps(_mm_mul_ps(detC, B), mulAdj2x2(A, D_C));
+
+    // |M| = |A| |D| + |B| |C| - tr((A#B)(D#C))
+    __m128 tr = _mm_mul_ps(A_B, _mm_shuffle_ps(D_C, D_C, _MM_SHUFFLE(3, 1, 2, 0)));
+    tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(2, 3, 0, 1)));
+    tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(1, 0, 3, 2)));
+    __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+
+    if (_mm_cvtss_f32(detM) == 0.0f) {
+      return false;
+    }
+
+    __m128 rDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+    X_ = _mm_mul_ps(X_, rDetM);
+    Y_ = _mm_mul_ps(Y_, rDetM);
+    Z_ = _mm_mul_ps(Z_, rDetM);
+    W_ = _mm_mul_ps(W_, rDetM);
+
+    VE_STORE_ROW(result, _mm_shuffle_ps(X_, Y_, _MM_SHUFFLE(1, 3, 1, 3)));
+    VE_STORE_ROW(result + 4, _mm_shuffle_ps(X_, Y_, _MM_SHUFFLE(0, 2, 0, 2)));
+    VE_STORE_ROW(result + 8, _mm_shuffle_ps(Z_, W_, _MM_SHUFFLE(1, 3, 1, 3)));
+    VE_STORE_ROW(result + 12, _mm_shuffle_ps(Z_, W_, _MM_SHUFFLE(0, 2, 0, 2)));
+    return true;
+#else
+    return inverseScalar(m, result);
+#endif // VE_SSE2
+  }
+
+  /**
+      Scalar version of inverse().
+  */
+  static bool inverseScalar(const float *m, float *result) {
+    float inv[16];
+
+    inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+    inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+    inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+    inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+    inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+    inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+    inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+    inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+    inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+    inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+    inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+    inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+    inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+    inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+    inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+    inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+    float det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+    if (det == 0.0f) {
+      return false;
+    }
+
+    det = 1.0f / det;
+    for (int i = 0; i < 16; i++) {
+      result[i] = inv[i] * det;
+    }
+
+    return true;
+  }
+
+  /**
+      Inverts affine matrix (the last row is (0, 0, 0, 1)). Upper 3x3 part may
+      contain any non-singular linear transformation. Result may point to m.
+      @return 'false' if matrix is singular, result is not changed in this case.
+  */
+  static bool affineInverse(const float *m, float *result) {
+#ifdef VE_SSE2
+    __m128 r0 = VE_LOAD_ROW(m);
+    __m128 r1 = VE_LOAD_ROW(m + 4);
+    __m128 r2 = VE_LOAD_ROW(m + 8);
+
+    // Columns of the adjugate, W components are exactly zero
+    __m128 c0 = cross(r1, r2);
+    __m128 c1 = cross(r2, r0);
+    __m128 c2 = cross(r0, r1);
+
+    float det = _mm_cvtss_f32(dot3(r0, c0));
+    if (det == 0.0f) {
+      return false;
+    }
+
+    __m128 rDet = _mm_set1_ps(1.0f / det);
+    c0 = _mm_mul_ps(c0, rDet);
+    c1 = _mm_mul_ps(c1, rDet);
+    c2 = _mm_mul_ps(c2, rDet);
+
+    // Translation: -R^-1 * t, W component is set to 1
+    __m128 t = _mm_shuffle_ps(_mm_unpackhi_ps(r0, r1), r2, _MM_SHUFFLE(3, 3, 3, 2));
+    __m128 translation = _mm_add_ps(_mm_add_ps(
+      _mm_mul_ps(c0, _mm_shuffle_ps(t, t, _MM_SHUFFLE(0, 0, 0, 0))),
+      _mm_mul_ps(c1, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1)))),
+      _mm_mul_ps(c2, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2))));
+    translation = _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), translation);
+
+    _MM_TRANSPOSE4_PS(c0, c1, c2, translation);
+    VE_STORE_ROW(result, c0);
+    VE_STORE_ROW(result + 4, c1);
+    VE_STORE_ROW(result + 8, c2);
+    VE_STORE_ROW(result + 12, translation);
+    return true;
+#else
+    return affineInverseScalar(m, result);
+#endif // VE_SSE2
+  }
+
+  /**
+      Scalar version of affineInverse().
+  */
+  static bool affineInverseScalar(const float *m, float *result) {
+    float c0[3] = { m[5] * m[10] - m[6] * m[9], m[6] * m[8] - m[4] * m[10], m[4] * m[9] - m[5] * m[8] };
+    float c1[3] = { m[9] * m[2] - m[10] * m[1], m[10] * m[0] - m[8] * m[2], m[8] * m[1] - m[9] * m[0] };
+    float c2[3] = { m[1] * m[6] - m[2] * m[5], m[2] * m[4] - m[0] * m[6], m[0] * m[5] - m[1] * m[4] };
+    float det = m[0] * c0[0] + m[1] * c0[1] + m[2] * c0[2];
+
+    if (det == 0.0f) {
+      return false;
+    }
+
+    det = 1.0f / det;
+    float t[3] = { m[3], m[7], m[11] };
+    for (int i = 0; i < 3; i++) {
+      result[4 * i] = c0[i] * det;
+      result[4 * i + 1] = c1[i] * det;
+      result[4 * i + 2] = c2[i] * det;
+      result[4 * i + 3] = -(result[4 * i] * t[0] + result[4 * i + 1] * t[1] + result[4 * i + 2] * t[2]);
+    }
+
+    result[12] = result[13] = result[14] = 0.0f;
+    result[15] = 1.0f;
+    return true;
+  }
+
+  /**
+      Computes dot product of 3D vectors.
+  */
+  static float dot3(const float *a, const float *b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+  }
+
+  /**
+      Computes dot product of 4D vectors.
+  */
+  static float dot4(const float *a, const float *b) {
+#ifdef VE_SSE2
+    __m128 p = _mm_mul_ps(_mm_loadu_ps(a), _mm_loadu_ps(b));
+    p = _mm_add_ps(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 3, 0, 1)));
+    p = _mm_add_ss(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 0, 3, 2)));
+    return _mm_cvtss_f32(p);
+#else
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+#endif // VE_SSE2
+  }
+
+  /**
+      Computes cross product of 3D vectors. Result may point to a or b.
+  */
+  static void cross3(const float *a, const float *b, float *result) {
+    float x = a[1] * b[2] - a[2] * b[1];
+    float y = a[2] * b[0] - a[0] * b[2];
+    float z = a[0] * b[1] - a[1] * b[0];
+    result[0] = x;
+    result[1] = y;
+    result[2] = z;
+  }
+
+  /**
+      Normalizes vector of specified size (3 or 4) in place. Zero vectors are not changed.
+  */
+  static void normalize(float *v, int size) {
+#ifdef VE_SSE2
+    if (size == 4) {
+      __m128 vec = _mm_loadu_ps(v);
+      __m128 p = _mm_mul_ps(vec, vec);
+      p = _mm_add_ps(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 3, 0, 1)));
+      p = _mm_add_ps(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 0, 3, 2)));
+      if (_mm_cvtss_f32(p) >= 1e-6f) {
+        _mm_storeu_ps(v, _mm_div_ps(vec, _mm_sqrt_ps(p)));
+      }
+      return;
+    }
+#endif // VE_SSE2
+    float length = 0;
+    for (int i = 0; i < size; i++) {
+      length += v[i] * v[i];
+    }
+
+    if (length >= 1e-6f) {
+      length = sqrt(length);
+      for (int i = 0; i < size; i++) {
+        v[i] /= length;
+      }
+    }
+  }
+
+#ifdef VE_SSE2
+private:
+  /** 2x2 matrices product A * B, matrices are stored row by row in one register */
+  static __m128 mul2x2(__m128 a, __m128 b) {
+    return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+      _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+  }
+
+  /** 2x2 matrices product (A#) * B where A# is adjugate of A */
+  static __m128 adjMul2x2(__m128 a, __m128 b) {
+    return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+      _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+  }
+
+  /** 2x2 matrices product A * (B#) where B# is adjugate of B */
+  static __m128 mulAdj2x2(__m128 a, __m128 b) {
+    return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+      _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+  }
+
+  /** Cross product of XYZ parts, W of result is a.w * b.w - a.w * b.w = 0 */
+  static __m128 cross(__m128 a, __m128 b) {
+    __m128 a1 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 b1 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+    __m128 a2 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+    __m128 b2 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+    return _mm_sub_ps(_mm_mul_ps(a1, b1), _mm_mul_ps(a2, b2));
+  }
+
+  /** Dot product of XYZ parts in the lowest component */
+  static __m128 dot3(__m128 a, __m128 b) {
+    __m128 p = _mm_mul_ps(a, b);
+    return _mm_add_ss(_mm_add_ss(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1))), _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2)));
+  }
+#endif // VE_SSE2
+};
+
+}
+
+#endif // __VE_MATH_KERNEL_H__
@@ -14,6 +14,7 @@
 #include "engine/math/vector3f.h"
 #include "engine/math/vector4f.h"
 #include "engine/math/plane.h"
+#include "engine/math/math_kernel.h"
 
 namespace ve {
 
@@ -52,6 +53,20 @@ public:
     return Maths::max(Maths::max(a, b), c);
   }
 
+  /**
+      Returns minimum value for two numbers.
+  */
+  static int min(int a, int b) {
+    return a < b ? a : b;
+  }
+
+  /**
+      Returns minimum value for two numbers.
+  */
+  static float min(float a, float b) {
+    return a < b ? a : b;
+  }
+
   /**
       Returns absolute value of the float number.
       @param a - float value
@@ -110,8 +125,8 @@ public:
       @param b - Second vector
       @return Dot product of a and b vectors.
   */
-  static float dot(const Vector3f a, const Vector3f b) {
-    return (a[0] * b[0] + a[1] * b[1] + a[2] * b[2]);
+  static float dot(const Vector3f &a, const Vector3f &b) {
+    return MathKernel::dot3(a.getRaw(), b.getRaw());
   }
 
   /**
@@ -120,8 +135,8 @@ public:
       @param b - Second vector
       @return Dot product of a and b vectors.
   */
-  static float dot(const Vector4f a, const Vector4f b) {
-    return (a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3]);
+  static float dot(const Vector4f &a, const Vector4f &b) {
+    return MathKernel::dot4(a.getRaw(), b.getRaw());
   }
 
   /**
@@ -168,9 +183,10 @@ public:
       @param b - Second vector
       @return Cross product of a and b vectors.
   */
-  static Vector3f cross(const Vector3f a, const Vector3f b) {
-    return Vector3f(a[1] * b[2] - a[2] * b[1], -a[0] * b[2] + a[2] * b[0],
-      a[0] * b[1] - a[1] * b[0]);
+  static Vector3f cross(const Vector3f &a, const Vector3f &b) {
+    Vector3f result;
+    MathKernel::cross3(a.getRaw(), b.getRaw(), result.getRaw());
+    return result;
   }
 
   /**
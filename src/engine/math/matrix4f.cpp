@@ -5,6 +5,7 @@
 #include <math.h>
 
 #include "common.h"
+#include "math/maths.h"
 #include "math/matrix4f.h"
 
 namespace ve {
@@ -38,42 +39,28 @@ Matrix4f& Matrix4f::operator = (const Matrix4f &newMatrix) {
   return *this;
 }
 
-Vector4f Matrix4f::operator * (const Vector4f &a) {
+Vector4f Matrix4f::operator * (const Vector4f &a) const {
   Vector4f result;
-  int i;
-
-  for (i = 0; i < 4; i++) {
-    result[i] = m[i][0] * a[0] + m[i][1] * a[1] + m[i][2] * a[2] + m[i][3] * a[3];
-  }
-
+  MathKernel::transform(&m[0][0], a.getRaw(), result.getRaw());
   return result;
 }
 
-Matrix4f operator * (const Matrix4f &A, const Matrix4f &B) {
-  Matrix4f result;
-  int i, j, k;
-
-  for (i = 0; i < 4; i++) {
-    for (j = 0; j < 4; j++) {
-      result[i][j] = 0;
-
-      for (k = 0; k < 4; k++) {
-        result[i][j] = result[i][j] + A[i][k] * B[k][j];
-      }
-    }
-  }
-
+Vector3f Matrix4f::transformPoint(const Vector3f &point) const {
+  Vector3f result;
+  MathKernel::transformPoint(&m[0][0], point.getRaw(), result.getRaw());
   return result;
 }
 
-float* Matrix4f::operator[] (int index) {
-  ERROR_IF((index < 0) || (index > 3), L"Index is out of bounds", NULL);
-  return m[index];
+Vector3f Matrix4f::transformVector(const Vector3f &vector) const {
+  Vector3f result;
+  MathKernel::transformVector(&m[0][0], vector.getRaw(), result.getRaw());
+  return result;
 }
 
-const float* Matrix4f::operator[] (int index) const {
-  ERROR_IF((index < 0) || (index > 3), L"Index is out of bounds", NULL);
-  return m[index];
+Matrix4f operator * (const Matrix4f &A, const Matrix4f &B) {
+  Matrix4f result;
+  MathKernel::multiply(&A.m[0][0], &B.m[0][0], &result.m[0][0]);
+  return result;
 }
 
 void Matrix4f::scale(float factor) {
@@ -89,21 +76,27 @@ void Matrix4f::translate(const Vector4f &translation) {
 }
 
 void Matrix4f::transpose() {
-  int i, j;
-  float tmp;
+  MathKernel::transpose(&m[0][0], &m[0][0]);
+}
 
-  for (i = 0; i < 3; i++)
-    for (j = i + 1; j < 4; j++) {
-      tmp = m[i][j];
-      m[i][j] = m[j][i];
-      m[j][i] = tmp;
-    }
+Outcome Matrix4f::inverse() {
+  ERROR_IF(!MathKernel::inverse(&m[0][0], &m[0][0]), L"Matrix is singular", INVALID_OPERATION);
+  return OK;
+}
+
+Outcome Matrix4f::affineInverse() {
+  ERROR_IF(!MathKernel::affineInverse(&m[0][0], &m[0][0]), L"Matrix is singular", INVALID_OPERATION);
+  return OK;
 }
 
 float* Matrix4f::getRaw() {
   return &m[0][0];
 }
 
+const float* Matrix4f::getRaw() const {
+  return &m[0][0];
+}
+
 Matrix4f Matrix4f::xRotateMatrix(float angle) {
   Matrix4f result(1);
   float Cos = (float)cos(angle);
@@ -145,4 +138,37 @@ Matrix4f Matrix4f::getYawPitchRollMatrix(float yaw, float pitch, float roll) {
   return result;
 }
 
+Matrix4f Matrix4f::getPerspectiveMatrix(float fovy, float aspect, float zNear, float zFar) {
+  Matrix4f result(0.0f);
+  float f = (float)(1.0 / tan(fovy * Maths::PI / 360.0));
+
+  result[0][0] = f / aspect;
+  result[1][1] = f;
+  result[2][2] = (zFar + zNear) / (zNear - zFar);
+  result[2][3] = 2.0f * zFar * zNear / (zNear - zFar);
+  result[3][2] = -1.0f;
+  result[3][3] = 0.0f;
+  return result;
+}
+
+Matrix4f Matrix4f::getLookAtMatrix(const Vector3f &position, const Vector3f &target, const Vector3f &up) {
+  Matrix4f result;
+  Vector3f forward = target - position;
+  forward.norm();
+  Vector3f side = Maths::cross(forward, up);
+  side.norm();
+  Vector3f newUp = Maths::cross(side, forward);
+
+  for (int i = 0; i < 3; i++) {
+    result[0][i] = side[i];
+    result[1][i] = newUp[i];
+    result[2][i] = -forward[i];
+  }
+
+  result[0][3] = -Maths::dot(side, position);
+  result[1][3] = -Maths::dot(newUp, position);
+  result[2][3] = Maths::dot(forward, position);
+  return result;
+}
+
 }
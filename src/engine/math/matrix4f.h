@@ -5,17 +5,19 @@
 #define __VE_MATRIX4F_H__
 
 #include "engine/math/vector4f.h"
+#include "engine/math/math_kernel.h"
 
 namespace ve {
 
 /**
     4x4 matrix class which supports different operations.
-    Data is stored row by row in a single array.
+    Data is stored row by row in a single array which is 16-byte
+    aligned where it is possible, so SSE kernels may load rows directly.
 */
 class Matrix4f {
 private:
   /** Elements */
-  float m[4][4];
+  VE_ALIGN16 float m[4][4];
 
 public:
   /**
@@ -57,7 +59,21 @@ public:
       @param a - Vector to multiply this matrix on.
       @return (This matrix) * ('a' vector).
   */
-  Vector4f operator * (const Vector4f &a);
+  Vector4f operator * (const Vector4f &a) const;
+
+  /**
+      Transforms point (W = 1) by this matrix. Projective part is ignored.
+      @param point - Point to transform.
+      @return Transformed point.
+  */
+  Vector3f transformPoint(const Vector3f &point) const;
+
+  /**
+      Transforms direction (W = 0) by this matrix. Translation is ignored.
+      @param vector - Direction to transform.
+      @return Transformed direction.
+  */
+  Vector3f transformVector(const Vector3f &vector) const;
 
   /**
       Multiplies two 4x4 matrices.
@@ -72,14 +88,24 @@ public:
       @param index - Index of the row from 0 to 3.
       @return Pointer to row elements array (four elements in the row).
   */
-  float *operator[] (int index);
+  float *operator[] (int index) {
+#ifdef VE_DEBUG
+    ERROR_IF((index < 0) || (index > 3), L"Index is out of bounds", NULL);
+#endif // VE_DEBUG
+    return m[index];
+  }
 
   /**
       Returns row of this matrix.
-      @param index - Index of the row from 0 to 2.
-      @return Pointer to row elements array (three elements in the row).
+      @param index - Index of the row from 0 to 3.
+      @return Pointer to row elements array (four elements in the row).
   */
-  const float *operator[] (int index) const;
+  const float *operator[] (int index) const {
+#ifdef VE_DEBUG
+    ERROR_IF((index < 0) || (index > 3), L"Index is out of bounds", NULL);
+#endif // VE_DEBUG
+    return m[index];
+  }
 
   /**
       Scale (0, 0), (1, 1), (2, 2) elements on specified factor.
@@ -103,12 +129,33 @@ public:
   */
   void transpose();
 
+  /**
+      Inverts this matrix.
+      @return OK if matrix was inverted.
+      @return INVALID_OPERATION if matrix is singular, matrix is not changed in this case.
+  */
+  Outcome inverse();
+
+  /**
+      Inverts this matrix if it is affine, i.e. the last row is (0, 0, 0, 1).
+      It is cheaper than inverse().
+      @return OK if matrix was inverted.
+      @return INVALID_OPERATION if matrix is singular, matrix is not changed in this case.
+  */
+  Outcome affineInverse();
+
   /**
       Returns pointer to elements.
       @return pointer to 16 elements of this matrix, row by row.
   */
   float *getRaw();
 
+  /**
+      Returns pointer to elements.
+      @return pointer to 16 elements of this matrix, row by row.
+  */
+  const float *getRaw() const;
+
   /**
       Returns X-axis rotation matrix.
       @param angle - Angle of rotation
@@ -139,6 +186,25 @@ public:
       @see Euler angles.
   */
   static Matrix4f getYawPitchRollMatrix(float yaw, float pitch, float roll);
+
+  /**
+      Returns perspective projection matrix which is the same as gluPerspective() sets.
+      @param fovy - View angle in Y direction in degrees.
+      @param aspect - Ratio of width to height of the viewport.
+      @param zNear - Distance to the near clipping plane, must be positive.
+      @param zFar - Distance to the far clipping plane, must be positive.
+      @return Perspective projection matrix.
+  */
+  static Matrix4f getPerspectiveMatrix(float fovy, float aspect, float zNear, float zFar);
+
+  /**
+      Returns view matrix which is the same as gluLookAt() sets.
+      @param position - Position of the viewer.
+      @param target - Point the viewer looks at.
+      @param up - Direction of the 'up' vector.
+      @return View matrix.
+  */
+  static Matrix4f getLookAtMatrix(const Vector3f &position, const Vector3f &target, const Vector3f &up);
 };
 
 }
@@ -4,95 +4,86 @@
 #include <math.h>
 #include "math/maths.h"
 #include "math/vector3f.h"
+#include "math/math_kernel.h"
 #include "common.h"
 
 namespace ve {
 
 Vector3f::Vector3f() {
-  x = y = z = 0.0f;
+  v[0] = v[1] = v[2] = 0.0f;
 }
 
 Vector3f::Vector3f(const Vector3f &newValue) {
-  x = newValue.x;
-  y = newValue.y;
-  z = newValue.z;
+  v[0] = newValue.v[0];
+  v[1] = newValue.v[1];
+  v[2] = newValue.v[2];
 }
 
 Vector3f::Vector3f(float newX, float newY, float newZ) {
-  x = newX;
-  y = newY;
-  z = newZ;
+  v[0] = newX;
+  v[1] = newY;
+  v[2] = newZ;
 }
 
 Vector3f& Vector3f::operator = (const Vector3f &newValue) {
-  x = newValue.x;
-  y = newValue.y;
-  z = newValue.z;
+  v[0] = newValue.v[0];
+  v[1] = newValue.v[1];
+  v[2] = newValue.v[2];
   return *this;
 }
 
 float& Vector3f::operator[] (uint index) {
-  switch (index) {
-  case 0: return x;
-  case 1: return y;
-  case 2: return z;
-  default: EPIC_FAIL(L"Invalid Index");
+  if (index > 2) {
+    EPIC_FAIL(L"Invalid Index");
   }
+
+  return v[index];
 }
 
-//FIXME Move duplicated code to one method
 const float Vector3f::operator[] (uint index) const {
-  switch (index) {
-  case 0: return x;
-  case 1: return y;
-  case 2: return z;
-  default: EPIC_FAIL(L"Invalid Index");
+  if (index > 2) {
+    EPIC_FAIL(L"Invalid Index");
   }
+
+  return v[index];
 }
 
 Vector3f operator * (const Vector3f &A, float B) {
-  Vector3f result(A.x * B, A.y * B, A.z * B);
+  Vector3f result(A.v[0] * B, A.v[1] * B, A.v[2] * B);
   return result;
 }
 
 Vector3f operator * (float A, const Vector3f &B) {
-  Vector3f result(B.x * A, B.y * A, B.z * A);
+  Vector3f result(B.v[0] * A, B.v[1] * A, B.v[2] * A);
   return result;
 }
 
 Vector3f operator + (const Vector3f &A, const Vector3f &B) {
-  Vector3f result(A.x + B.x, A.y + B.y, A.z + B.z);
+  Vector3f result(A.v[0] + B.v[0], A.v[1] + B.v[1], A.v[2] + B.v[2]);
   return result;
 }
 
 Vector3f Vector3f::operator += (const Vector3f &A) {
-  x += A.x;
-  y += A.y;
-  z += A.z;
+  v[0] += A.v[0];
+  v[1] += A.v[1];
+  v[2] += A.v[2];
 
   return *this;
 }
 
 Vector3f operator - (const Vector3f &A, const Vector3f &B) {
-  Vector3f result(A.x - B.x, A.y - B.y, A.z - B.z);
+  Vector3f result(A.v[0] - B.v[0], A.v[1] - B.v[1], A.v[2] - B.v[2]);
   return result;
 }
 
 void Vector3f::norm() {
-  double l = x * x + y * y + z * z;
-
-  if (!Maths::equals(l, 0)) {
-    l = sqrt(l);
-    x /= l;
-    y /= l;
-    z /= l;
-  }
+  MathKernel::normalize(v, 3);
 }
 
 void Vector3f::set(float newX, float newY, float newZ) {
-  x = newX;
-  y = newY;
-  z = newZ;
+  v[0] = newX;
+  v[1] = newY;
+  v[2] = newZ;
 }
 
 }
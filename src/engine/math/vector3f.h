@@ -13,10 +13,8 @@ namespace ve {
 */
 class Vector3f {
 private:
-  /** Vector components */
-  float x;
-  float y;
-  float z;
+  /** Vector components: X, Y and Z */
+  float v[3];
 
 public:
   /**
@@ -77,6 +75,22 @@ public:
       @param newZ - Z component.
   */
   void set(float newX, float newY, float newZ);
+
+  /**
+      Returns pointer to components.
+      @return Pointer to X, Y and Z components.
+  */
+  float *getRaw() {
+    return v;
+  }
+
+  /**
+      Returns pointer to components.
+      @return Pointer to X, Y and Z components.
+  */
+  const float *getRaw() const {
+    return v;
+  }
 };
 
 }
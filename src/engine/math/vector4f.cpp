@@ -10,105 +10,83 @@
 namespace ve {
 
 Vector4f::Vector4f() {
-  x = y = z = 0.0f;
+  v[0] = v[1] = v[2] = 0.0f;
 }
 
 Vector4f::Vector4f(const Vector4f &newValue) {
-  x = newValue.x;
-  y = newValue.y;
-  z = newValue.z;
-  w = newValue.w;
+  v[0] = newValue.v[0];
+  v[1] = newValue.v[1];
+  v[2] = newValue.v[2];
+  v[3] = newValue.v[3];
 }
 
 Vector4f::Vector4f(const Vector3f &newValue, float newW) {
-  x = newValue[0];
-  y = newValue[1];
-  z = newValue[2];
-  w = newW;
+  v[0] = newValue[0];
+  v[1] = newValue[1];
+  v[2] = newValue[2];
+  v[3] = newW;
 }
 
 Vector4f::Vector4f(float newX, float newY, float newZ, float newW) {
-  x = newX;
-  y = newY;
-  z = newZ;
-  w = newW;
+  v[0] = newX;
+  v[1] = newY;
+  v[2] = newZ;
+  v[3] = newW;
 }
 
 Vector4f& Vector4f::operator = (const Vector4f &newValue) {
-  x = newValue.x;
-  y = newValue.y;
-  z = newValue.z;
-  w = newValue.w;
+  v[0] = newValue.v[0];
+  v[1] = newValue.v[1];
+  v[2] = newValue.v[2];
+  v[3] = newValue.v[3];
   return *this;
 }
 
 Vector4f& Vector4f::operator = (const Vector3f &newValue) {
-  x = newValue[0];
-  y = newValue[1];
-  z = newValue[2];
-  w = 1;
+  v[0] = newValue[0];
+  v[1] = newValue[1];
+  v[2] = newValue[2];
+  v[3] = 1;
   return *this;
 }
 
 float& Vector4f::operator[] (uint index) {
-  switch (index) {
-  case 0:
-    return x;
-  case 1:
-    return y;
-  case 2:
-    return z;
-  case 3:
-    return w;
-  default:
+  if (index > 3) {
     EPIC_FAIL(L"Invalid index");
   }
+
+  return v[index];
 }
 
 const float Vector4f::operator[] (uint index) const {
-  switch (index) {
-  case 0:
-    return x;
-  case 1:
-    return y;
-  case 2:
-    return z;
-  case 3:
-    return w;
-  default:
+  if (index > 3) {
     EPIC_FAIL(L"Invalid index");
   }
+
+  return v[index];
 }
 
 void Vector4f::norm() {
-  double l = x * x + y * y + z * z + w * w;
-
-  if (!Maths::equals(l, 0)) {
-    l = sqrt(l);
-    x /= l;
-    y /= l;
-    z /= l;
-    w /= l;
-  }
+  MathKernel::normalize(v, 4);
 }
 
 Vector4f operator * (Vector4f &A, float B) {
-  Vector4f result(A.x * B, A.y * B, A.z * B, A.w * B);
+  Vector4f result(A.v[0] * B, A.v[1] * B, A.v[2] * B, A.v[3] * B);
   return result;
 }
 
 Vector4f operator * (float A, Vector4f &B) {
-  Vector4f result(B.x * A, B.y * A, B.z * A, B.w * A);
+  Vector4f result(B.v[0] * A, B.v[1] * A, B.v[2] * A, B.v[3] * A);
   return result;
 }
 
 Vector4f operator + (Vector4f &A, Vector4f &B) {
-  Vector4f result(A.x + B.x, A.y + B.y, A.z + B.z, A.w + B.w);
+  Vector4f result(A.v[0] + B.v[0], A.v[1] + B.v[1], A.v[2] + B.v[2], A.v[3] + B.v[3]);
   return result;
 }
 
 Vector4f operator - (Vector4f &A, Vector4f &B) {
-  Vector4f result(A.x - B.x, A.y - B.y, A.z - B.z, A.w - B.w);
+  Vector4f result(A.v[0] - B.v[0], A.v[1] - B.v[1], A.v[2] - B.v[2], A.v[3] - B.v[3]);
   return result;
 }
 
@@ -120,10 +98,10 @@ Vector4f operator - (Vector4f &A, Vector4f &B) {
     @param newW - new value for W component.
 */
 void Vector4f::set(float newX, float newY, float newZ, float newW) {
-  x = newX;
-  y = newY;
-  z = newZ;
-  w = newW;
+  v[0] = newX;
+  v[1] = newY;
+  v[2] = newZ;
+  v[3] = newW;
 }
 
 }
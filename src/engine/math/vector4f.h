@@ -5,20 +5,18 @@
 #define __VE_VECTOR4F_H__
 
 #include "engine/math/vector3f.h"
+#include "engine/math/math_kernel.h"
 #include "engine/common.h"
 
 namespace ve {
 
 /**
-    4D Vector.
+    4D Vector. Components are 16-byte aligned where it is possible.
 */
 class Vector4f {
 private:
-  /** Vector components */
-  float x;
-  float y;
-  float z;
-  float w;
+  /** Vector components: X, Y, Z and W */
+  VE_ALIGN16 float v[4];
 
 public:
   /**
@@ -94,6 +92,22 @@ public:
       @param newW - new value for W component.
   */
   void set(float newX, float newY, float newZ, float newW);
+
+  /**
+      Returns pointer to components.
+      @return Pointer to X, Y, Z and W components.
+  */
+  float *getRaw() {
+    return v;
+  }
+
+  /**
+      Returns pointer to components.
+      @return Pointer to X, Y, Z and W components.
+  */
+  const float *getRaw() const {
+    return v;
+  }
 };
 
 }
@@ -2,6 +2,7 @@
 // All rights reserved.
 
 #include "models/mesh.h"
+#include "models/mesh_simplifier.h"
 
 namespace ve {
 
@@ -75,4 +76,18 @@ uint Mesh::getVertexCount() {
   return vertex.size();
 }
 
+Outcome Mesh::generateLODs(uint levels, float reduction) {
+  MeshSimplifier simplifier;
+  return simplifier.generateChain(vertex, index, levels, reduction, lodIndex);
+}
+
+uint Mesh::getLODCount() {
+  return lodIndex.size() + 1;
+}
+
+std::vector<unsigned short> Mesh::getLODIndexList(uint level) {
+  ERROR_IF(level > lodIndex.size(), L"Level is out of bounds", std::vector<unsigned short>());
+  return level == 0 ? index : lodIndex[level - 1];
+}
+
 }
@@ -38,6 +38,9 @@ private:
   /** Array of texture coordinates */
   std::vector<float> texCoord;
 
+  /** Simplified index arrays, from the most to the least detailed one */
+  std::vector<std::vector<unsigned short> > lodIndex;
+
 public:
   /**
       Default constructor.
@@ -103,6 +106,30 @@ public:
       @return number of vertex in this mesh.
   */
   uint getVertexCount();
+
+  /**
+      Generates levels of detail for this mesh. Every level keeps 'reduction' part
+      of faces of the previous level and refers to the same vertices, so
+      vertex and texture coordinates arrays are shared by all the levels.
+      @param levels - Number of simplified levels to generate.
+      @param reduction - Part of faces to keep on every next level, from 0 to 1.
+      @return OK if levels were generated.
+      @return non-OK if simplification failed.
+  */
+  Outcome generateLODs(uint levels, float reduction);
+
+  /**
+      Returns number of levels of detail including the full detail one.
+      @return Number of levels of detail.
+  */
+  uint getLODCount();
+
+  /**
+      Returns index data for a level of detail.
+      @param level - Level of detail from 0 (full detail) to getLODCount() - 1.
+      @return Array of unsigned short values.
+  */
+  std::vector<unsigned short> getLODIndexList(uint level);
 };
 
 }
@@ -0,0 +1,350 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <map>
+#include <queue>
+#include <algorithm>
+
+#include "models/mesh_simplifier.h"
+
+namespace ve {
+
+/** Default weight of border constraint planes */
+static const float DEFAULT_BORDER_WEIGHT = 1000.0f;
+
+void MeshSimplifier::Quadric::addPlane(double A, double B, double C, double D, double weight) {
+  a[0] += weight * A * A;
+  a[1] += weight * A * B;
+  a[2] += weight * A * C;
+  a[3] += weight * A * D;
+  a[4] += weight * B * B;
+  a[5] += weight * B * C;
+  a[6] += weight * B * D;
+  a[7] += weight * C * C;
+  a[8] += weight * C * D;
+  a[9] += weight * D * D;
+}
+
+void MeshSimplifier::Quadric::add(const Quadric &q) {
+  for (int i = 0; i < 10; i++) {
+    a[i] += q.a[i];
+  }
+}
+
+double MeshSimplifier::Quadric::evaluate(double x, double y, double z) const {
+  return a[0] * x * x + 2 * a[1] * x * y + 2 * a[2] * x * z + 2 * a[3] * x +
+    a[4] * y * y + 2 * a[5] * y * z + 2 * a[6] * y +
+    a[7] * z * z + 2 * a[8] * z +
+    a[9];
+}
+
+MeshSimplifier::MeshSimplifier() {
+  borderWeight = DEFAULT_BORDER_WEIGHT;
+}
+
+void MeshSimplifier::setBorderWeight(float weight) {
+  borderWeight = weight;
+}
+
+void MeshSimplifier::prepare() {
+  uint vertexCount = positions.size() / 3;
+  uint faceCount = faces.size() / 3;
+  std::map<std::pair<int, int>, int> edges;
+
+  quadrics.assign(vertexCount, Quadric());
+  vertexFaces.assign(vertexCount, std::vector<int>());
+  vertexRemoved.assign(vertexCount, false);
+  stamps.assign(vertexCount, 0);
+  faceRemoved.assign(faceCount, false);
+
+  for (uint f = 0; f < faceCount; f++) {
+    const int *v = &faces[3 * f];
+    const float *p0 = &positions[3 * v[0]];
+    const float *p1 = &positions[3 * v[1]];
+    const float *p2 = &positions[3 * v[2]];
+    double e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+    double e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+    double n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+    double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+    for (int k = 0; k < 3; k++) {
+      vertexFaces[v[k]].push_back(f);
+
+      // Every edge is counted once per adjacent face to find open borders
+      int a = v[k], b = v[(k + 1) % 3];
+      edges[std::make_pair(std::min(a, b), std::max(a, b))]++;
+    }
+
+    if (length <= 0) {
+      continue;
+    }
+
+    // Face plane weighted by face area
+    n[0] /= length;
+    n[1] /= length;
+    n[2] /= length;
+    double d = -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]);
+    for (int k = 0; k < 3; k++) {
+      quadrics[v[k]].addPlane(n[0], n[1], n[2], d, length * 0.5);
+    }
+  }
+
+  if (borderWeight <= 0) {
+    return;
+  }
+
+  // Border edges get a plane which is perpendicular to the face and goes through the edge
+  for (uint f = 0; f < faceCount; f++) {
+    const int *v = &faces[3 * f];
+
+    for (int k = 0; k < 3; k++) {
+      int a = v[k], b = v[(k + 1) % 3], c = v[(k + 2) % 3];
+      if (edges[std::make_pair(std::min(a, b), std::max(a, b))] != 1) {
+        continue;
+      }
+
+      const float *pa = &positions[3 * a];
+      const float *pb = &positions[3 * b];
+      const float *pc = &positions[3 * c];
+      double edge[3] = { pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2] };
+      double other[3] = { pc[0] - pa[0], pc[1] - pa[1], pc[2] - pa[2] };
+      double fn[3] = { edge[1] * other[2] - edge[2] * other[1], edge[2] * other[0] - edge[0] * other[2], edge[0] * other[1] - edge[1] * other[0] };
+      double n[3] = { edge[1] * fn[2] - edge[2] * fn[1], edge[2] * fn[0] - edge[0] * fn[2], edge[0] * fn[1] - edge[1] * fn[0] };
+      double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+      double edgeLength = edge[0] * edge[0] + edge[1] * edge[1] + edge[2] * edge[2];
+
+      if (length <= 0) {
+        continue;
+      }
+
+      n[0] /= length;
+      n[1] /= length;
+      n[2] /= length;
+      double d = -(n[0] * pa[0] + n[1] * pa[1] + n[2] * pa[2]);
+      quadrics[a].addPlane(n[0], n[1], n[2], d, borderWeight * edgeLength);
+      quadrics[b].addPlane(n[0], n[1], n[2], d, borderWeight * edgeLength);
+    }
+  }
+}
+
+MeshSimplifier::Collapse MeshSimplifier::evaluateEdge(int a, int b) {
+  Quadric q = quadrics[a];
+  q.add(quadrics[b]);
+
+  const float *pa = &positions[3 * a];
+  const float *pb = &positions[3 * b];
+  double costToA = q.evaluate(pa[0], pa[1], pa[2]);
+  double costToB = q.evaluate(pb[0], pb[1], pb[2]);
+
+  Collapse result;
+  if (costToB <= costToA) {
+    result.cost = costToB;
+    result.from = a;
+    result.to = b;
+  } else {
+    result.cost = costToA;
+    result.from = b;
+    result.to = a;
+  }
+
+  result.fromStamp = stamps[result.from];
+  result.toStamp = stamps[result.to];
+  return result;
+}
+
+bool MeshSimplifier::flipsFaces(int from, int to) {
+  const std::vector<int> &around = vertexFaces[from];
+  const float *target = &positions[3 * to];
+
+  for (uint i = 0; i < around.size(); i++) {
+    int f = around[i];
+    if (faceRemoved[f]) {
+      continue;
+    }
+
+    const int *v = &faces[3 * f];
+    if (v[0] == to || v[1] == to || v[2] == to) {
+      continue;
+    }
+
+    const float *p[3];
+    const float *q[3];
+    for (int k = 0; k < 3; k++) {
+      p[k] = &positions[3 * v[k]];
+      q[k] = (v[k] == from) ? target : p[k];
+    }
+
+    double n1[3], n2[3];
+    double a1[3] = { p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2] };
+    double b1[3] = { p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2] };
+    double a2[3] = { q[1][0] - q[0][0], q[1][1] - q[0][1], q[1][2] - q[0][2] };
+    double b2[3] = { q[2][0] - q[0][0], q[2][1] - q[0][1], q[2][2] - q[0][2] };
+    n1[0] = a1[1] * b1[2] - a1[2] * b1[1];
+    n1[1] = a1[2] * b1[0] - a1[0] * b1[2];
+    n1[2] = a1[0] * b1[1] - a1[1] * b1[0];
+    n2[0] = a2[1] * b2[2] - a2[2] * b2[1];
+    n2[1] = a2[2] * b2[0] - a2[0] * b2[2];
+    n2[2] = a2[0] * b2[1] - a2[1] * b2[0];
+
+    if (n1[0] * n2[0] + n1[1] * n2[1] + n1[2] * n2[2] <= 0) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+int MeshSimplifier::collapse(int from, int to) {
+  std::vector<int> &around = vertexFaces[from];
+  std::vector<int> &target = vertexFaces[to];
+  int removed = 0;
+
+  for (uint i = 0; i < around.size(); i++) {
+    int f = around[i];
+    if (faceRemoved[f]) {
+      continue;
+    }
+
+    int *v = &faces[3 * f];
+    if (v[0] == to || v[1] == to || v[2] == to) {
+      faceRemoved[f] = true;
+      removed++;
+      continue;
+    }
+
+    for (int k = 0; k < 3; k++) {
+      if (v[k] == from) {
+        v[k] = to;
+      }
+    }
+    target.push_back(f);
+  }
+
+  around.clear();
+  vertexRemoved[from] = true;
+  quadrics[to].add(quadrics[from]);
+  stamps[to]++;
+
+  // Drop references to removed faces
+  uint alive = 0;
+  for (uint i = 0; i < target.size(); i++) {
+    if (!faceRemoved[target[i]]) {
+      target[alive++] = target[i];
+    }
+  }
+  target.resize(alive);
+
+  return removed;
+}
+
+void MeshSimplifier::getNeighbours(int vertex, std::vector<int> &neighbours) {
+  const std::vector<int> &around = vertexFaces[vertex];
+
+  neighbours.clear();
+  for (uint i = 0; i < around.size(); i++) {
+    const int *v = &faces[3 * around[i]];
+    for (int k = 0; k < 3; k++) {
+      if (v[k] != vertex) {
+        neighbours.push_back(v[k]);
+      }
+    }
+  }
+
+  std::sort(neighbours.begin(), neighbours.end());
+  neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+}
+
+Outcome MeshSimplifier::simplify(const std::vector<float> &vertices, const std::vector<unsigned short> &indices,
+  uint targetFaces, std::vector<unsigned short> &result) {
+  ERROR_IF(indices.size() % 3 != 0, L"Indices do not describe triangle list", INVALID_VALUE);
+
+  uint faceCount = indices.size() / 3;
+  if (targetFaces >= faceCount) {
+    result = indices;
+    return OK;
+  }
+
+  positions = vertices;
+  faces.assign(indices.begin(), indices.end());
+  for (uint i = 0; i < faces.size(); i++) {
+    ERROR_IF((uint)faces[i] >= positions.size() / 3, L"Index is out of bounds", INVALID_VALUE);
+  }
+  prepare();
+
+  std::priority_queue<Collapse> queue;
+  for (uint f = 0; f < faceCount; f++) {
+    const int *v = &faces[3 * f];
+    for (int k = 0; k < 3; k++) {
+      // Inner edges are pushed once per adjacent face, duplicates are skipped as stale
+      queue.push(evaluateEdge(v[k], v[(k + 1) % 3]));
+    }
+  }
+
+  uint alive = faceCount;
+  std::vector<int> neighbours;
+
+  while (alive > targetFaces && !queue.empty()) {
+    Collapse candidate = queue.top();
+    queue.pop();
+
+    if (vertexRemoved[candidate.from] || vertexRemoved[candidate.to] ||
+      stamps[candidate.from] != candidate.fromStamp || stamps[candidate.to] != candidate.toStamp) {
+      continue;
+    }
+
+    if (flipsFaces(candidate.from, candidate.to)) {
+      continue;
+    }
+
+    alive -= collapse(candidate.from, candidate.to);
+
+    getNeighbours(candidate.to, neighbours);
+    for (uint i = 0; i < neighbours.size(); i++) {
+      queue.push(evaluateEdge(candidate.to, neighbours[i]));
+    }
+  }
+
+  result.clear();
+  result.reserve(3 * alive);
+  for (uint f = 0; f < faceCount; f++) {
+    if (!faceRemoved[f]) {
+      result.push_back(faces[3 * f]);
+      result.push_back(faces[3 * f + 1]);
+      result.push_back(faces[3 * f + 2]);
+    }
+  }
+
+  return OK;
+}
+
+Outcome MeshSimplifier::generateChain(const std::vector<float> &vertices, const std::vector<unsigned short> &indices,
+  uint levels, float reduction, std::vector<std::vector<unsigned short> > &chain) {
+  ERROR_IF(reduction <= 0.0f || reduction >= 1.0f, L"Reduction is out of (0, 1) range", INVALID_VALUE);
+
+  std::vector<unsigned short> previous = indices;
+  std::vector<unsigned short> next;
+
+  chain.clear();
+  for (uint level = 0; level < levels; level++) {
+    uint faceCount = previous.size() / 3;
+    uint target = (uint)(faceCount * reduction);
+
+    if (target == 0) {
+      break;
+    }
+
+    ASSERT(simplify(vertices, previous, target, next));
+
+    // Level could not be simplified any further
+    if (next.size() == previous.size()) {
+      break;
+    }
+
+    chain.push_back(next);
+    previous = next;
+  }
+
+  return OK;
+}
+
+}
@@ -0,0 +1,162 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_MESH_SIMPLIFIER_H__
+#define __VE_MESH_SIMPLIFIER_H__
+
+#include <vector>
+
+#include "engine/common.h"
+
+namespace ve {
+
+/**
+    Simplifies triangle meshes using quadric error metrics (Garland & Heckbert).
+    Edges are collapsed into one of their end points (half-edge collapse), so
+    simplified index lists refer to the vertices of the source mesh and every
+    level of detail may share the same vertex buffer. Open borders and texture
+    seams are preserved by additional constraint planes.
+*/
+class MeshSimplifier {
+private:
+  /**
+      Symmetric 4x4 matrix which accumulates squared distances to a set of planes.
+      Only upper triangle is stored.
+  */
+  struct Quadric {
+    double a[10];
+
+    /**
+        Default constructor. Zero quadric.
+    */
+    Quadric() {
+      memset(a, 0, sizeof(a));
+    }
+
+    /**
+        Adds quadric of plane A * x + B * y + C * z + D = 0 scaled on weight.
+    */
+    void addPlane(double A, double B, double C, double D, double weight);
+
+    /**
+        Adds another quadric to this one.
+    */
+    void add(const Quadric &q);
+
+    /**
+        Computes error of point (x, y, z) for this quadric.
+    */
+    double evaluate(double x, double y, double z) const;
+  };
+
+  /**
+      Candidate for collapse. Vertex 'from' is merged into vertex 'to'.
+      Stamps are used to skip candidates which became out of date.
+  */
+  struct Collapse {
+    double cost;
+    int from;
+    int to;
+    uint fromStamp;
+    uint toStamp;
+
+    bool operator < (const Collapse &other) const {
+      return cost > other.cost;
+    }
+  };
+
+  /** Vertex positions, 3 floats per vertex */
+  std::vector<float> positions;
+
+  /** Faces, 3 indices per face */
+  std::vector<int> faces;
+
+  /** Removed faces flags */
+  std::vector<bool> faceRemoved;
+
+  /** Removed vertices flags */
+  std::vector<bool> vertexRemoved;
+
+  /** Quadric per vertex */
+  std::vector<Quadric> quadrics;
+
+  /** Faces adjacent to each vertex */
+  std::vector<std::vector<int> > vertexFaces;
+
+  /** Modification counter per vertex */
+  std::vector<uint> stamps;
+
+  /** Weight of border constraint planes */
+  float borderWeight;
+
+  /**
+      Builds quadrics, adjacency and border constraints for the loaded mesh.
+  */
+  void prepare();
+
+  /**
+      Computes the cheapest collapse direction for the edge (a, b).
+  */
+  Collapse evaluateEdge(int a, int b);
+
+  /**
+      Checks if moving vertex 'from' into 'to' flips any of the faces around 'from'.
+  */
+  bool flipsFaces(int from, int to);
+
+  /**
+      Collapses vertex 'from' into 'to'.
+      @return Number of faces removed by this collapse.
+  */
+  int collapse(int from, int to);
+
+  /**
+      Collects distinct neighbours of a vertex.
+  */
+  void getNeighbours(int vertex, std::vector<int> &neighbours);
+
+public:
+  /**
+      Default constructor.
+  */
+  MeshSimplifier();
+
+  /**
+      Sets weight of border constraint planes. Large values keep open borders and
+      texture seams in place, zero lets them be simplified as any other edge.
+      @param weight - Weight of border planes relative to face planes.
+  */
+  void setBorderWeight(float weight);
+
+  /**
+      Simplifies mesh until number of faces drops to targetFaces or no more
+      edges may be collapsed without flipping faces.
+      @param vertices - Vertex coordinates, 3 floats per vertex.
+      @param indices - Source faces, 3 indices per face.
+      @param targetFaces - Desired number of faces.
+      @param result - Simplified faces which refer to the same vertices.
+      @return OK if simplification succeeded.
+      @return INVALID_VALUE if indices do not describe a triangle list.
+  */
+  Outcome simplify(const std::vector<float> &vertices, const std::vector<unsigned short> &indices,
+    uint targetFaces, std::vector<unsigned short> &result);
+
+  /**
+      Generates chain of simplified index lists. Every next level keeps 'reduction' part
+      of the faces of the previous one. Generation stops earlier if level could not be
+      simplified any further.
+      @param vertices - Vertex coordinates, 3 floats per vertex.
+      @param indices - Full detail faces, 3 indices per face.
+      @param levels - Number of levels to generate, excluding the full detail one.
+      @param reduction - Part of faces to keep on every next level, from 0 to 1.
+      @param chain - Generated index lists from the most to the least detailed one.
+      @return OK if generation succeeded.
+      @return INVALID_VALUE if reduction is out of (0, 1) range.
+  */
+  Outcome generateChain(const std::vector<float> &vertices, const std::vector<unsigned short> &indices,
+    uint levels, float reduction, std::vector<std::vector<unsigned short> > &chain);
+};
+
+}
+
+#endif // __VE_MESH_SIMPLIFIER_H__
@@ -4,20 +4,33 @@
 #include "models/model.h"
 #include "engines/engine.h"
 #include "math/maths.h"
+#include "cameras/camera.h"
 
 namespace ve {
 
+/** Projected size in pixels below which the first simplified level is used */
+static const float LOD_BASE_SCREEN_SIZE = 256.0f;
+
+/** Default margin around level boundaries */
+static const float LOD_DEFAULT_HYSTERESIS = 0.1f;
+
 Model::Model(Engine *engine) {
   this->engine = engine;
   indexVBO = 0;
   vertexVBO = 0;
   textureVBO = 0;
   normalVBO = 0;
+  lodHysteresis = LOD_DEFAULT_HYSTERESIS;
 }
 
 Outcome Model::renderMesh(uint index) {
-  ERROR_IF(index >= meshInfoList.size(), L"Index is out of bounds", ERROR);
-  MeshInfo info = meshInfoList[index];
+  return renderMesh(index, 0);
+}
+
+Outcome Model::renderMesh(uint index, uint level) {
+  ERROR_IF(index >= lodInfoList.size(), L"Index is out of bounds", ERROR);
+  ERROR_IF(level >= lodInfoList[index].levels.size(), L"Level is out of bounds", ERROR);
+  MeshInfo info = lodInfoList[index].levels[level];
 
   GPUStateManager *stateManager = engine->getStateManager();
 
@@ -29,6 +42,81 @@ Outcome Model::renderMesh(uint index) {
   return OK;
 }
 
+Outcome Model::renderMesh(uint index, Camera *camera, const Matrix4f &transform, uint &level) {
+  CHECK_POINTER(camera);
+  level = selectLOD(index, camera, transform, level);
+  return renderMesh(index, level);
+}
+
+Outcome Model::render(Camera *camera, const Matrix4f &transform, std::vector<uint> &levels) {
+  CHECK_POINTER(camera);
+
+  if (levels.size() < lodInfoList.size()) {
+    levels.resize(lodInfoList.size(), 0);
+  }
+
+  for (uint i = 0; i < lodInfoList.size(); i++) {
+    ASSERT(renderMesh(i, camera, transform, levels[i]));
+  }
+
+  return OK;
+}
+
+uint Model::selectLOD(uint index, Camera *camera, const Matrix4f &transform, uint current) {
+  ERROR_IF(index >= lodInfoList.size(), L"Index is out of bounds", 0);
+  const LODInfo &lod = lodInfoList[index];
+  uint last = lod.levels.size() - 1;
+
+  if (last == 0) {
+    return 0;
+  }
+
+  // Bounding sphere in world coordinates, radius is scaled by the largest axis scale
+  Matrix4f world = transform;
+  Vector4f center = world * Vector4f(lod.center, 1.0f);
+  float scale = 0;
+  for (int j = 0; j < 3; j++) {
+    scale = Maths::max(scale, world[0][j] * world[0][j] + world[1][j] * world[1][j] + world[2][j] * world[2][j]);
+  }
+
+  float size = camera->getProjectedSize(Vector3f(center[0], center[1], center[2]), lod.radius * sqrt(scale));
+  uint level = current < last ? current : last;
+
+  while (level > 0 && size > getLODScreenSize(level) * (1.0f + lodHysteresis)) {
+    level--;
+  }
+
+  while (level < last && size < getLODScreenSize(level + 1) * (1.0f - lodHysteresis)) {
+    level++;
+  }
+
+  return level;
+}
+
+float Model::getLODScreenSize(uint level) {
+  if (level > 0 && level <= lodScreenSizes.size()) {
+    return lodScreenSizes[level - 1];
+  }
+
+  return LOD_BASE_SCREEN_SIZE / (float)(1 << Maths::min((int)level - 1, 30));
+}
+
+void Model::setLODScreenSize(uint level, float size) {
+  if (level == 0) {
+    return;
+  }
+
+  while (lodScreenSizes.size() < level) {
+    lodScreenSizes.push_back(getLODScreenSize(lodScreenSizes.size() + 1));
+  }
+
+  lodScreenSizes[level - 1] = size;
+}
+
+void Model::setLODHysteresis(float value) {
+  lodHysteresis = value;
+}
+
 Outcome Model::generateNormalMap(std::vector<unsigned short> indices, std::vector<float> vertices, std::vector<float> &normals) {
   int i, j, k, len = indices.size() / 3;
   Vector3f vec1, vec2, norm;
@@ -69,11 +157,14 @@ Outcome Model::update(std::vector<Mesh*> meshList) {
   int len = meshList.size();
   std::vector<float> vertices;
   std::vector<unsigned short> indices;
+  std::vector<unsigned short> baseIndices;
   std::vector<float> texCoords;
   std::vector<float> normals;
   int indexOffset = 0;
 
   this->meshList.clear();
+  meshInfoList.clear();
+  lodInfoList.clear();
 
   for (int i = 0; i < len; i++) {
     this->meshList.push_back(*meshList[i]);
@@ -82,16 +173,47 @@ Outcome Model::update(std::vector<Mesh*> meshList) {
   }
 
   for (int i = 0; i < len; i++) {
-    std::vector<unsigned short> meshIndex = meshList[i]->getIndexList();
     std::vector<float> meshVertex = meshList[i]->getVertexList();
     std::vector<float> meshTexCoords = meshList[i]->getTextureCoordsList();
+    uint lodCount = meshList[i]->getLODCount();
+    LODInfo lod;
 
     indexOffset = vertices.size() / 3;
-    for (uint j = 0; j < meshIndex.size(); j++) {
-      indices.push_back(indexOffset + meshIndex[j]);
+
+    // All the levels refer to the same vertices, so they are appended one by one
+    for (uint level = 0; level < lodCount; level++) {
+      std::vector<unsigned short> meshIndex = meshList[i]->getLODIndexList(level);
+
+      lod.levels.push_back(MeshInfo(indices.size() * sizeof(unsigned short), meshIndex.size()));
+      for (uint j = 0; j < meshIndex.size(); j++) {
+        indices.push_back(indexOffset + meshIndex[j]);
+
+        if (level == 0) {
+          baseIndices.push_back(indexOffset + meshIndex[j]);
+        }
+      }
+    }
+
+    // Bounding sphere around the center of the mesh bounding box, mesh without a whole vertex keeps empty sphere
+    if (meshVertex.size() >= 3) {
+      Vector3f low(meshVertex[0], meshVertex[1], meshVertex[2]);
+      Vector3f high = low;
+      for (uint j = 0; j + 2 < meshVertex.size(); j += 3) {
+        for (uint k = 0; k < 3; k++) {
+          low[k] = Maths::min(low[k], meshVertex[j + k]);
+          high[k] = Maths::max(high[k], meshVertex[j + k]);
+        }
+      }
+
+      lod.center = 0.5f * (low + high);
+      for (uint j = 0; j + 2 < meshVertex.size(); j += 3) {
+        Vector3f offset = Vector3f(meshVertex[j], meshVertex[j + 1], meshVertex[j + 2]) - lod.center;
+        lod.radius = Maths::max(lod.radius, (float)sqrt(Maths::dot(offset, offset)));
+      }
     }
 
-    meshInfoList.push_back(MeshInfo(indexOffset, meshIndex.size()));
+    meshInfoList.push_back(lod.levels[0]);
+    lodInfoList.push_back(lod);
     vertices.insert(vertices.end(), meshVertex.begin(), meshVertex.end());
     texCoords.insert(texCoords.end(), meshTexCoords.begin(), meshTexCoords.end());
   }
@@ -109,7 +231,7 @@ Outcome Model::update(std::vector<Mesh*> meshList) {
   ASSERT(textureVBO->update(&texCoords[0], sizeof(float) * texCoords.size(), STATIC_DRAW));
 
   normals.resize(vertices.size());
-  ASSERT(generateNormalMap(indices, vertices, normals));
+  ASSERT(generateNormalMap(baseIndices, vertices, normals));
   ASSERT(normalVBO->update(&normals[0], sizeof(float) * normals.size(), STATIC_DRAW));
 
   buffersState.indices = BufferDesc(1, UNSIGNED_SHORT, 0, indexVBO, true);
@@ -131,5 +253,10 @@ uint Model::getMeshesCount() {
   return meshList.size();
 }
 
+uint Model::getLODCount(uint index) {
+  ERROR_IF(index >= lodInfoList.size(), L"Index is out of bounds", 0);
+  return lodInfoList[index].levels.size();
+}
+
 }
 
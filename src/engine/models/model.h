@@ -8,17 +8,24 @@
 #include "engine/engines/engine.h"
 #include "engine/visible_object.h"
 #include "engine/math/vector3f.h"
+#include "engine/math/matrix4f.h"
 #include "engine/buffers/video_buffer.h"
 #include "engine/models/mesh.h"
 #include "engine/states/buffer_state.h"
 
 namespace ve {
 
+class Camera;
+
 /**
     Represents 3D model data. Contains VBOs for model
     rendering and list meshes that are used for rendering.
     This is not a class for model rendering. It is used only
     for storing model-related data, not a model instance data.
+    Meshes with levels of detail (see Mesh::generateLODs()) keep all
+    the levels in the same VBOs and the level is chosen by projected
+    size of the mesh on the screen. Level which was chosen last time is
+    instance data too, so it is kept by the caller.
 */
 class Model :public VisibleObject {
 private:
@@ -53,6 +60,27 @@ private:
     }
   };
 
+  /**
+      Levels of detail of a mesh and its bounding sphere in the object-space.
+  */
+  struct LODInfo {
+    /** Location of every level in the index VBO, 0 - full detail */
+    std::vector<MeshInfo> levels;
+
+    /** Center of the bounding sphere */
+    Vector3f center;
+
+    /** Radius of the bounding sphere */
+    float radius;
+
+    /**
+        Default constructor
+    */
+    LODInfo() {
+      radius = 0;
+    }
+  };
+
   /** Engine which is used for rendering */
   Engine *engine;
 
@@ -74,6 +102,15 @@ private:
   /** Additional information about meshes layout in the index VBO */
   std::vector<MeshInfo> meshInfoList;
 
+  /** Levels of detail of every mesh */
+  std::vector<LODInfo> lodInfoList;
+
+  /** Projected sizes (in pixels) below which levels 1, 2, ... are used */
+  std::vector<float> lodScreenSizes;
+
+  /** Relative margin around LOD screen sizes to avoid popping */
+  float lodHysteresis;
+
   /** It is used to set buffers for rendering */
   BuffersState buffersState;
 
@@ -89,6 +126,13 @@ protected:
   */
   Outcome generateNormalMap(std::vector<unsigned short> indices, std::vector<float> vertices, std::vector<float> &normals);
 
+  /**
+      Returns projected size (in pixels) below which specified level of detail is used.
+      @param level - Level of detail from 1.
+      @return Projected size in pixels.
+  */
+  float getLODScreenSize(uint level);
+
 public:
   /**
       Default constructor.
@@ -104,6 +148,51 @@ public:
   */
   Outcome renderMesh(uint index);
 
+  /**
+      Renders specified level of detail of a mesh of this model.
+      @param index - Number of the mesh to render (from 0 to getMeshesCount() - 1).
+      @param level - Level of detail to render (from 0 to getLODCount(index) - 1).
+      @return OK if mesh was rendered successfully.
+      @return non-OK if engine error occurred.
+  */
+  Outcome renderMesh(uint index, uint level);
+
+  /**
+      Renders mesh of this model choosing level of detail by its projected size.
+      Transformation must be already applied to the modelview matrix by caller,
+      it is passed here only to locate the mesh in the world.
+      @param index - Number of the mesh to render (from 0 to getMeshesCount() - 1).
+      @param camera - Camera which is used for rendering.
+      @param transform - Object-to-world transformation of this model.
+      @param level - Level of the instance which was rendered last time, it is replaced by the new one.
+      @return OK if mesh was rendered successfully.
+      @return non-OK if engine error occurred.
+  */
+  Outcome renderMesh(uint index, Camera *camera, const Matrix4f &transform, uint &level);
+
+  /**
+      Renders all the meshes of this model choosing level of detail for each
+      of them by its projected size.
+      @param camera - Camera which is used for rendering.
+      @param transform - Object-to-world transformation of this model.
+      @param levels - Levels of the instance for every mesh which were rendered last time,
+        they are replaced by the new ones. Missing levels are added as 0.
+      @return OK if model was rendered successfully.
+      @return non-OK if engine error occurred.
+  */
+  Outcome render(Camera *camera, const Matrix4f &transform, std::vector<uint> &levels);
+
+  /**
+      Chooses level of detail for a mesh. Level is changed only when projected
+      size leaves hysteresis margin around the level boundary.
+      @param index - Number of the mesh (from 0 to getMeshesCount() - 1).
+      @param camera - Camera which is used for rendering.
+      @param transform - Object-to-world transformation of this model.
+      @param current - Level which the instance used last time.
+      @return Level of detail to render.
+  */
+  uint selectLOD(uint index, Camera *camera, const Matrix4f &transform, uint current = 0);
+
   /**
       Updates list of meshes for this model. Creates VBO for these meshes,
       load data, compute normals.
@@ -125,6 +214,29 @@ public:
       @return Center of a mesh.
   */
   Vector3f getMeshCenter(uint index);
+
+  /**
+      Returns number of levels of detail of a mesh.
+      @param index - Number of mesh.
+      @return Number of levels of detail, 1 if mesh has no simplified levels.
+  */
+  uint getLODCount(uint index);
+
+  /**
+      Sets projected size below which level of detail is used. By default every
+      next level starts at the half of the previous size, first one at 256 pixels.
+      @param level - Level of detail from 1.
+      @param size - Projected size of the mesh in pixels.
+  */
+  void setLODScreenSize(uint level, float size);
+
+  /**
+      Sets margin around level boundaries. Level changes to more detailed one
+      when projected size exceeds boundary * (1 + value) and to less detailed one
+      when it drops below boundary * (1 - value).
+      @param value - Relative margin, 0.1 by default.
+  */
+  void setLODHysteresis(float value);
 };
 
 }
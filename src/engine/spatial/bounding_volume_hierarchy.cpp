@@ -0,0 +1,605 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <algorithm>
+#include <float.h>
+
+#include "common.h"
+#include "math/maths.h"
+#include "spatial/bounding_volume_hierarchy.h"
+
+namespace ve {
+
+/* Number of bins along the split axis for SAH build */
+static const int SAH_BINS = 16;
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy() {
+  clear();
+}
+
+void BoundingVolumeHierarchy::clear() {
+  nodes.clear();
+  root = -1;
+  freeList = -1;
+  objectCount = 0;
+}
+
+int BoundingVolumeHierarchy::allocateNode() {
+  int index;
+
+  if (freeList != -1) {
+    index = freeList;
+    freeList = nodes[index].parent;
+  } else {
+    index = (int)nodes.size();
+    nodes.push_back(Node());
+  }
+
+  Node &node = nodes[index];
+  node.parent = -1;
+  node.child[0] = node.child[1] = -1;
+  node.object = NULL;
+  return index;
+}
+
+void BoundingVolumeHierarchy::freeNode(int index) {
+  nodes[index].object = NULL;
+  nodes[index].child[0] = nodes[index].child[1] = -2;
+  nodes[index].parent = freeList;
+  freeList = index;
+}
+
+Outcome BoundingVolumeHierarchy::build(const std::vector<VisibleObject *> &objects, std::vector<int> &proxies) {
+  for (uint i = 0; i < objects.size(); i++) {
+    CHECK_POINTER(objects[i]);
+  }
+
+  clear();
+  proxies.resize(objects.size());
+  if (objects.empty()) {
+    return OK;
+  }
+
+  nodes.reserve(2 * objects.size() - 1);
+  for (uint i = 0; i < objects.size(); i++) {
+    int leaf = allocateNode();
+    nodes[leaf].object = objects[i];
+    nodes[leaf].box = getBox(objects[i]->getBounds());
+    proxies[i] = leaf;
+  }
+
+  objectCount = (uint)objects.size();
+  std::vector<int> leaves(proxies);
+  root = buildSubtree(&leaves[0], (uint)leaves.size());
+  nodes[root].parent = -1;
+  return OK;
+}
+
+int BoundingVolumeHierarchy::buildSubtree(int *leaves, uint count) {
+  if (count == 1) {
+    return leaves[0];
+  }
+
+  // Bounds of leaf centroids, the split axis is the longest one
+  float low[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+  float high[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+  for (uint i = 0; i < count; i++) {
+    const Box &box = nodes[leaves[i]].box;
+    for (int k = 0; k < 3; k++) {
+      float center = box.min[k] + box.max[k];
+      low[k] = Maths::min(low[k], center);
+      high[k] = Maths::max(high[k], center);
+    }
+  }
+
+  int axis = 0;
+  for (int k = 1; k < 3; k++) {
+    if (high[k] - low[k] > high[axis] - low[axis]) {
+      axis = k;
+    }
+  }
+
+  uint middle = count / 2;
+  float extent = high[axis] - low[axis];
+
+  if (extent > 0) {
+    Box binBox[SAH_BINS];
+    uint binCount[SAH_BINS];
+    float scale = SAH_BINS * (1.0f - 1e-6f) / extent;
+
+    for (int b = 0; b < SAH_BINS; b++) {
+      binCount[b] = 0;
+    }
+
+    for (uint i = 0; i < count; i++) {
+      const Box &box = nodes[leaves[i]].box;
+      int b = (int)((box.min[axis] + box.max[axis] - low[axis]) * scale);
+      binBox[b] = binCount[b] == 0 ? box : merge(binBox[b], box);
+      binCount[b]++;
+    }
+
+    // Sweep from the right to get areas of right parts, then from the left to find the best split
+    float rightCost[SAH_BINS];
+    Box accumulated;
+    uint accumulatedCount = 0;
+    for (int b = SAH_BINS - 1; b > 0; b--) {
+      if (binCount[b] > 0) {
+        accumulated = accumulatedCount == 0 ? binBox[b] : merge(accumulated, binBox[b]);
+        accumulatedCount += binCount[b];
+      }
+      rightCost[b] = accumulatedCount > 0 ? getArea(accumulated) * accumulatedCount : 0.0f;
+    }
+
+    int bestSplit = -1;
+    float bestCost = FLT_MAX;
+    accumulatedCount = 0;
+    for (int b = 0; b < SAH_BINS - 1; b++) {
+      if (binCount[b] > 0) {
+        accumulated = accumulatedCount == 0 ? binBox[b] : merge(accumulated, binBox[b]);
+        accumulatedCount += binCount[b];
+      }
+
+      if (accumulatedCount == 0 || accumulatedCount == count) {
+        continue;
+      }
+
+      float cost = getArea(accumulated) * accumulatedCount + rightCost[b + 1];
+      if (cost < bestCost) {
+        bestCost = cost;
+        bestSplit = b;
+      }
+    }
+
+    if (bestSplit != -1) {
+      int *left = leaves;
+      int *right = leaves + count;
+      while (left < right) {
+        const Box &box = nodes[*left].box;
+        if ((int)((box.min[axis] + box.max[axis] - low[axis]) * scale) <= bestSplit) {
+          left++;
+        } else {
+          std::swap(*left, *--right);
+        }
+      }
+      middle = (uint)(left - leaves);
+    }
+  }
+
+  int child0 = buildSubtree(leaves, middle);
+  int child1 = buildSubtree(leaves + middle, count - middle);
+
+  int index = allocateNode();
+  Node &node = nodes[index];
+  node.child[0] = child0;
+  node.child[1] = child1;
+  node.box = merge(nodes[child0].box, nodes[child1].box);
+  nodes[child0].parent = index;
+  nodes[child1].parent = index;
+  return index;
+}
+
+int BoundingVolumeHierarchy::insert(VisibleObject *object) {
+  CHECK_POINTER_EX(object, -1);
+
+  int leaf = allocateNode();
+  nodes[leaf].object = object;
+  nodes[leaf].box = getBox(object->getBounds());
+  insertLeaf(leaf);
+  objectCount++;
+  return leaf;
+}
+
+Outcome BoundingVolumeHierarchy::remove(int proxy) {
+  ERROR_IF(getObject(proxy) == NULL, L"Invalid proxy", INVALID_VALUE);
+
+  removeLeaf(proxy);
+  freeNode(proxy);
+  objectCount--;
+  return OK;
+}
+
+Outcome BoundingVolumeHierarchy::update(int proxy) {
+  ERROR_IF(getObject(proxy) == NULL, L"Invalid proxy", INVALID_VALUE);
+
+  Box box = getBox(nodes[proxy].object->getBounds());
+  bool jumped = !overlaps(box, nodes[proxy].box);
+  nodes[proxy].box = box;
+
+  int parent = nodes[proxy].parent;
+  if (parent == -1 || contains(nodes[parent].box, box)) {
+    // Ancestors still contain the object, nothing to refit
+    return OK;
+  }
+
+  if (jumped) {
+    removeLeaf(proxy);
+    insertLeaf(proxy);
+  } else {
+    refitUpwards(parent);
+  }
+
+  return OK;
+}
+
+void BoundingVolumeHierarchy::refit() {
+  if (root != -1) {
+    refitSubtree(root);
+  }
+}
+
+void BoundingVolumeHierarchy::refitSubtree(int index) {
+  Node &node = nodes[index];
+
+  if (node.child[0] == -1) {
+    node.box = getBox(node.object->getBounds());
+    return;
+  }
+
+  refitSubtree(node.child[0]);
+  refitSubtree(node.child[1]);
+
+  // Node reference is still valid, refit does not allocate nodes
+  node.box = merge(nodes[node.child[0]].box, nodes[node.child[1]].box);
+  rotate(index);
+}
+
+void BoundingVolumeHierarchy::insertLeaf(int leaf) {
+  if (root == -1) {
+    root = leaf;
+    nodes[leaf].parent = -1;
+    return;
+  }
+
+  // Descend while it is cheaper to put the leaf into a child than next to the current node
+  Box leafBox = nodes[leaf].box;
+  int index = root;
+  while (!isLeaf(index)) {
+    const Node &node = nodes[index];
+    float area = getArea(node.box);
+    float combinedArea = getArea(merge(node.box, leafBox));
+
+    float cost = 2.0f * combinedArea;
+    float inheritanceCost = 2.0f * (combinedArea - area);
+
+    float childCost[2];
+    for (int i = 0; i < 2; i++) {
+      const Node &child = nodes[node.child[i]];
+      float mergedArea = getArea(merge(child.box, leafBox));
+      childCost[i] = (child.child[0] == -1 ? mergedArea : mergedArea - getArea(child.box)) + inheritanceCost;
+    }
+
+    if (cost < childCost[0] && cost < childCost[1]) {
+      break;
+    }
+
+    index = childCost[0] < childCost[1] ? node.child[0] : node.child[1];
+  }
+
+  int sibling = index;
+  int oldParent = nodes[sibling].parent;
+  int newParent = allocateNode();
+
+  nodes[newParent].parent = oldParent;
+  nodes[newParent].child[0] = sibling;
+  nodes[newParent].child[1] = leaf;
+  nodes[newParent].box = merge(leafBox, nodes[sibling].box);
+  nodes[sibling].parent = newParent;
+  nodes[leaf].parent = newParent;
+
+  if (oldParent == -1) {
+    root = newParent;
+  } else {
+    Node &parent = nodes[oldParent];
+    parent.child[parent.child[0] == sibling ? 0 : 1] = newParent;
+    refitUpwards(oldParent);
+  }
+}
+
+void BoundingVolumeHierarchy::removeLeaf(int leaf) {
+  if (leaf == root) {
+    root = -1;
+    return;
+  }
+
+  int parent = nodes[leaf].parent;
+  int grandParent = nodes[parent].parent;
+  int sibling = nodes[parent].child[nodes[parent].child[0] == leaf ? 1 : 0];
+
+  if (grandParent == -1) {
+    root = sibling;
+    nodes[sibling].parent = -1;
+  } else {
+    Node &node = nodes[grandParent];
+    node.child[node.child[0] == parent ? 0 : 1] = sibling;
+    nodes[sibling].parent = grandParent;
+    refitUpwards(grandParent);
+  }
+
+  freeNode(parent);
+  nodes[leaf].parent = -1;
+}
+
+void BoundingVolumeHierarchy::refitUpwards(int index) {
+  while (index != -1) {
+    Node &node = nodes[index];
+    node.box = merge(nodes[node.child[0]].box, nodes[node.child[1]].box);
+    rotate(index);
+    index = node.parent;
+  }
+}
+
+void BoundingVolumeHierarchy::rotate(int index) {
+  Node &node = nodes[index];
+  float bestGain = 0;
+  int bestChild = -1;
+  int bestGrandChild = -1;
+
+  // Swapping child 'c' with grandchild 'g' (a child of the other child 'o') changes only
+  // the box of 'o', so the gain is the difference of its surface areas
+  for (int c = 0; c < 2; c++) {
+    int other = node.child[1 - c];
+    if (isLeaf(other)) {
+      continue;
+    }
+
+    const Node &otherNode = nodes[other];
+    float area = getArea(otherNode.box);
+    for (int g = 0; g < 2; g++) {
+      Box rotated = merge(nodes[node.child[c]].box, nodes[otherNode.child[1 - g]].box);
+      float gain = area - getArea(rotated);
+      if (gain > bestGain) {
+        bestGain = gain;
+        bestChild = c;
+        bestGrandChild = g;
+      }
+    }
+  }
+
+  if (bestChild == -1) {
+    return;
+  }
+
+  int child = node.child[bestChild];
+  int other = node.child[1 - bestChild];
+  Node &otherNode = nodes[other];
+  int grandChild = otherNode.child[bestGrandChild];
+
+  node.child[bestChild] = grandChild;
+  nodes[grandChild].parent = index;
+  otherNode.child[bestGrandChild] = child;
+  nodes[child].parent = other;
+  otherNode.box = merge(nodes[otherNode.child[0]].box, nodes[otherNode.child[1]].box);
+}
+
+VisibleObject *BoundingVolumeHierarchy::getObject(int proxy) const {
+  if (proxy < 0 || proxy >= (int)nodes.size() || nodes[proxy].child[0] != -1) {
+    return NULL;
+  }
+
+  return nodes[proxy].object;
+}
+
+uint BoundingVolumeHierarchy::getObjectCount() const {
+  return objectCount;
+}
+
+uint BoundingVolumeHierarchy::getHeight() const {
+  return root == -1 ? 0 : getHeight(root);
+}
+
+uint BoundingVolumeHierarchy::getHeight(int index) const {
+  if (isLeaf(index)) {
+    return 1;
+  }
+
+  return 1 + (uint)Maths::max((int)getHeight(nodes[index].child[0]), (int)getHeight(nodes[index].child[1]));
+}
+
+float BoundingVolumeHierarchy::getCost() const {
+  if (root == -1) {
+    return 0;
+  }
+
+  float total = 0;
+  for (uint i = 0; i < nodes.size(); i++) {
+    if (nodes[i].child[0] >= 0) {
+      total += getArea(nodes[i].box);
+    }
+  }
+
+  float rootArea = getArea(nodes[root].box);
+  return rootArea > 0 ? total / rootArea : 0;
+}
+
+void BoundingVolumeHierarchy::collect(int index, std::vector<VisibleObject *> &result) const {
+  const Node &node = nodes[index];
+
+  if (node.child[0] == -1) {
+    result.push_back(node.object);
+    return;
+  }
+
+  collect(node.child[0], result);
+  collect(node.child[1], result);
+}
+
+void BoundingVolumeHierarchy::query(const Frustum &frustum, std::vector<VisibleObject *> &result) {
+  if (root == -1) {
+    return;
+  }
+
+  float planes[6][4];
+  getPlanes(frustum, planes);
+
+  stack.clear();
+  stack.push_back(root);
+
+  while (!stack.empty()) {
+    int index = stack.back();
+    stack.pop_back();
+    const Node &node = nodes[index];
+    Containment containment = classify(planes, node.box);
+
+    if (containment == OUTSIDE) {
+      continue;
+    }
+
+    if (containment == INSIDE || node.child[0] == -1) {
+      collect(index, result);
+    } else {
+      stack.push_back(node.child[0]);
+      stack.push_back(node.child[1]);
+    }
+  }
+}
+
+void BoundingVolumeHierarchy::query(const BoundingBox &box, std::vector<VisibleObject *> &result) {
+  if (root == -1) {
+    return;
+  }
+
+  Box queryBox = getBox(box);
+  stack.clear();
+  stack.push_back(root);
+
+  while (!stack.empty()) {
+    int index = stack.back();
+    stack.pop_back();
+    const Node &node = nodes[index];
+
+    if (!overlaps(node.box, queryBox)) {
+      continue;
+    }
+
+    if (node.child[0] == -1) {
+      result.push_back(node.object);
+    } else {
+      stack.push_back(node.child[0]);
+      stack.push_back(node.child[1]);
+    }
+  }
+}
+
+void BoundingVolumeHierarchy::query(const Vector3f &point, std::vector<VisibleObject *> &result) {
+  if (root == -1) {
+    return;
+  }
+
+  float position[3] = { point[0], point[1], point[2] };
+  stack.clear();
+  stack.push_back(root);
+
+  while (!stack.empty()) {
+    int index = stack.back();
+    stack.pop_back();
+    const Node &node = nodes[index];
+
+    if (!contains(node.box, position)) {
+      continue;
+    }
+
+    if (node.child[0] == -1) {
+      result.push_back(node.object);
+    } else {
+      stack.push_back(node.child[0]);
+      stack.push_back(node.child[1]);
+    }
+  }
+}
+
+void BoundingVolumeHierarchy::findNearest(const Vector3f &point, uint count, std::vector<VisibleObject *> &result) {
+  if (root == -1 || count == 0) {
+    return;
+  }
+
+  float position[3] = { point[0], point[1], point[2] };
+  std::vector<Candidate> heap;
+  heap.reserve(std::min(count, objectCount));
+
+  stack.clear();
+  stack.push_back(root);
+
+  while (!stack.empty()) {
+    int index = stack.back();
+    stack.pop_back();
+    const Node &node = nodes[index];
+
+    float distance = getSquaredDistance(node.box, position);
+    if (distance >= getWorstDistance(heap, count)) {
+      continue;
+    }
+
+    if (node.child[0] == -1) {
+      addCandidate(heap, count, distance, node.object);
+    } else {
+      // Child which is closer to the point is visited first, so the farther one is often skipped
+      int first = node.child[0], second = node.child[1];
+      if (getSquaredDistance(nodes[first].box, position) > getSquaredDistance(nodes[second].box, position)) {
+        std::swap(first, second);
+      }
+      stack.push_back(second);
+      stack.push_back(first);
+    }
+  }
+
+  appendSorted(heap, result);
+}
+
+VisibleObject *BoundingVolumeHierarchy::rayCast(const Vector3f &origin, const Vector3f &direction,
+                                                float maxDistance, float *distance) {
+  if (root == -1) {
+    return NULL;
+  }
+
+  float start[3], inverse[3];
+  for (int k = 0; k < 3; k++) {
+    start[k] = origin[k];
+    inverse[k] = direction[k] != 0 ? 1.0f / direction[k] : FLT_MAX;
+  }
+
+  VisibleObject *closest = NULL;
+  float closestDistance = maxDistance;
+
+  stack.clear();
+  stack.push_back(root);
+
+  while (!stack.empty()) {
+    int index = stack.back();
+    stack.pop_back();
+    const Node &node = nodes[index];
+
+    // The box is skipped if it is farther than the closest hit
+    float enter;
+    if (!intersects(node.box, start, inverse, closestDistance, enter)) {
+      continue;
+    }
+
+    if (node.child[0] == -1) {
+      closest = node.object;
+      closestDistance = enter;
+    } else {
+      // Child which is closer to the origin is visited first
+      int first = node.child[0], second = node.child[1];
+      float firstDistance = 0, secondDistance = 0;
+      for (int k = 0; k < 3; k++) {
+        float d0 = (nodes[first].box.min[k] + nodes[first].box.max[k]) * 0.5f - start[k];
+        float d1 = (nodes[second].box.min[k] + nodes[second].box.max[k]) * 0.5f - start[k];
+        firstDistance += d0 * d0;
+        secondDistance += d1 * d1;
+      }
+      if (firstDistance > secondDistance) {
+        std::swap(first, second);
+      }
+      stack.push_back(second);
+      stack.push_back(first);
+    }
+  }
+
+  if (closest != NULL && distance != NULL) {
+    *distance = closestDistance;
+  }
+
+  return closest;
+}
+
+}
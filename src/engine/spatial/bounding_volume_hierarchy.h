@@ -0,0 +1,235 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_BOUNDING_VOLUME_HIERARCHY_H__
+#define __VE_BOUNDING_VOLUME_HIERARCHY_H__
+
+#include <vector>
+
+#include "engine/spatial/spatial_index.h"
+
+namespace ve {
+
+/**
+    Dynamic bounding volume hierarchy over bounds of visible objects. It is a binary
+    tree of axis aligned boxes where every leaf keeps one object, so frustum, box and
+    ray queries visit only branches which may contain results instead of all objects.
+
+    The tree may be built at once with build() which uses binned surface area heuristic
+    (SAH), or objects may be inserted one by one: insert() descends to the sibling with
+    the smallest SAH cost. When objects move, update() or refit() recompute boxes and
+    apply tree rotations which swap a child and a grandchild if it reduces surface
+    area, so quality of the tree stays close to the built one.
+
+    Objects are identified by proxies which are returned by insert() and build().
+    Tree does not own objects and reads their bounds only in insert(), update(),
+    refit() and build(). See SpatialIndex for the common query interface.
+*/
+class BoundingVolumeHierarchy : public SpatialIndex {
+private:
+  /**
+      Tree node. Leaves have no children and keep objects, free nodes
+      are linked into the list with parent field.
+  */
+  struct Node {
+    Box box;
+    int parent;
+    int child[2];
+    VisibleObject *object;
+  };
+
+  /** Pool of nodes, proxies are indices of leaves in this pool */
+  std::vector<Node> nodes;
+
+  /** Index of the root node, -1 if tree is empty */
+  int root;
+
+  /** Index of the first free node, -1 if there are no free nodes */
+  int freeList;
+
+  /** Number of objects in the tree */
+  uint objectCount;
+
+  /** Traversal stack which is reused by queries to avoid allocations */
+  std::vector<int> stack;
+
+  /**
+      Takes node from the free list or adds new one to the pool.
+  */
+  int allocateNode();
+
+  /**
+      Returns node to the free list.
+  */
+  void freeNode(int index);
+
+  /**
+      Checks if node is a leaf.
+  */
+  bool isLeaf(int index) const {
+    return nodes[index].child[0] == -1;
+  }
+
+  /**
+      Inserts leaf next to the sibling which gives the smallest SAH cost.
+  */
+  void insertLeaf(int leaf);
+
+  /**
+      Removes leaf from the tree, the leaf node itself is not freed.
+  */
+  void removeLeaf(int leaf);
+
+  /**
+      Recomputes boxes and applies rotations from specified node up to the root.
+  */
+  void refitUpwards(int index);
+
+  /**
+      Recomputes boxes and applies rotations in the whole subtree.
+  */
+  void refitSubtree(int index);
+
+  /**
+      Swaps a child with a grandchild of the node if it reduces surface area.
+  */
+  void rotate(int index);
+
+  /**
+      Builds subtree over leaves with binned SAH.
+      @return Index of the subtree root.
+  */
+  int buildSubtree(int *leaves, uint count);
+
+  /**
+      Adds objects of all leaves of the subtree to the list.
+  */
+  void collect(int index, std::vector<VisibleObject *> &result) const;
+
+  /**
+      Returns height of the subtree.
+  */
+  uint getHeight(int index) const;
+
+public:
+  /**
+      Constructor. Creates empty tree.
+  */
+  BoundingVolumeHierarchy();
+
+  /**
+      Removes all objects from the tree.
+  */
+  virtual void clear();
+
+  /**
+      Rebuilds the tree from scratch over specified objects with binned SAH.
+      Objects which were in the tree before are removed.
+      @param objects - Objects to put into the tree.
+      @param proxies - Resulting proxies, proxies[i] identifies objects[i].
+      @return OK if tree was built.
+      @return NULL_POINTER if some object is NULL.
+  */
+  Outcome build(const std::vector<VisibleObject *> &objects, std::vector<int> &proxies);
+
+  /**
+      Inserts object into the tree.
+      @param object - Object to insert, its bounds are read at once.
+      @return Proxy of the object or -1 if object is NULL.
+  */
+  virtual int insert(VisibleObject *object);
+
+  /**
+      Removes object from the tree.
+      @param proxy - Proxy of the object.
+      @return OK if object was removed.
+      @return INVALID_VALUE if proxy is not valid.
+  */
+  virtual Outcome remove(int proxy);
+
+  /**
+      Reads new bounds of the object and updates the tree. Boxes of ancestors are
+      refitted and rotated, objects which jumped out of their old bounds are reinserted.
+      @param proxy - Proxy of the object.
+      @return OK if object was updated.
+      @return INVALID_VALUE if proxy is not valid.
+  */
+  virtual Outcome update(int proxy);
+
+  /**
+      Reads bounds of all objects and refits the whole tree bottom up with rotations.
+      It is cheaper than calling update() for every object if most of them moved.
+  */
+  void refit();
+
+  /**
+      Returns object by its proxy.
+      @param proxy - Proxy of the object.
+      @return Object or NULL if proxy is not valid.
+  */
+  virtual VisibleObject *getObject(int proxy) const;
+
+  /**
+      Returns number of objects in the tree.
+      @return Number of objects.
+  */
+  virtual uint getObjectCount() const;
+
+  /**
+      Returns height of the tree, 0 for empty tree.
+      @return Number of levels in the tree.
+  */
+  uint getHeight() const;
+
+  /**
+      Returns SAH cost of the tree: sum of surface areas of internal nodes
+      divided by the surface area of the root. Lower is better.
+      @return SAH cost of the tree.
+  */
+  float getCost() const;
+
+  /**
+      Finds objects which bounds intersect the frustum.
+      @param frustum - Frustum with normalized planes.
+      @param result - List to add found objects to, it is not cleared.
+  */
+  virtual void query(const Frustum &frustum, std::vector<VisibleObject *> &result);
+
+  /**
+      Finds objects which bounds overlap the box.
+      @param box - Box to test.
+      @param result - List to add found objects to, it is not cleared.
+  */
+  virtual void query(const BoundingBox &box, std::vector<VisibleObject *> &result);
+
+  /**
+      Finds objects which bounds contain the point.
+      @param point - Point to test.
+      @param result - List to add found objects to, it is not cleared.
+  */
+  virtual void query(const Vector3f &point, std::vector<VisibleObject *> &result);
+
+  /**
+      Finds objects which bounds are the nearest to the point. Nodes are visited
+      in order of distance to their boxes and skipped when they are farther than
+      the worst of already found objects.
+      @param point - Point to search around.
+      @param count - Number of objects to find.
+      @param result - List to add found objects to, the nearest goes first.
+  */
+  virtual void findNearest(const Vector3f &point, uint count, std::vector<VisibleObject *> &result);
+
+  /**
+      Finds the first object which bounds are hit by the ray.
+      @param origin - Origin of the ray.
+      @param direction - Direction of the ray.
+      @param maxDistance - Maximal distance along the ray in direction lengths.
+      @param distance - If not NULL, receives distance to the hit in direction lengths.
+      @return The closest object or NULL if ray does not hit anything.
+  */
+  virtual VisibleObject *rayCast(const Vector3f &origin, const Vector3f &direction, float maxDistance, float *distance);
+};
+
+}
+
+#endif // __VE_BOUNDING_VOLUME_HIERARCHY_H__
@@ -0,0 +1,620 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <algorithm>
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "math/maths.h"
+#include "spatial/hash_grid.h"
+
+namespace ve {
+
+/* Objects which overlap more cells are kept in the list of large objects */
+static const int MAX_OBJECT_CELLS = 64;
+
+/* Initial number of buckets in the hash table, it must be a power of two */
+static const uint INITIAL_TABLE_SIZE = 256;
+
+/* Cell coordinates are clamped to this value, so ranges do not overflow */
+static const int MAX_CELL_COORD = 1 << 28;
+
+HashGrid::HashGrid(float cellSize) {
+  this->cellSize = cellSize > 0 ? cellSize : 1.0f;
+  stamp = 0;
+  clear();
+}
+
+void HashGrid::clear() {
+  cells.clear();
+  table.assign(INITIAL_TABLE_SIZE, -1);
+  entries.clear();
+  largeObjects.clear();
+  freeList = -1;
+  objectCount = 0;
+  maxExtent = 0;
+  for (int k = 0; k < 3; k++) {
+    lowCell[k] = MAX_CELL_COORD;
+    highCell[k] = -MAX_CELL_COORD;
+  }
+}
+
+Outcome HashGrid::setCellSize(float cellSize) {
+  ERROR_IF(cellSize <= 0, L"Cell size must be positive", INVALID_VALUE);
+
+  this->cellSize = cellSize;
+
+  // Entries keep their indices, so proxies stay valid
+  cells.clear();
+  table.assign(INITIAL_TABLE_SIZE, -1);
+  largeObjects.clear();
+  maxExtent = 0;
+  for (int k = 0; k < 3; k++) {
+    lowCell[k] = MAX_CELL_COORD;
+    highCell[k] = -MAX_CELL_COORD;
+  }
+
+  for (uint i = 0; i < entries.size(); i++) {
+    if (entries[i].object != NULL) {
+      link(i);
+    }
+  }
+
+  return OK;
+}
+
+float HashGrid::getCellSize() const {
+  return cellSize;
+}
+
+uint HashGrid::getCellCount() const {
+  return (uint)cells.size();
+}
+
+int HashGrid::getCellCoord(float value) const {
+  float coord = (float)floor(value / cellSize);
+  return (int)Maths::max(Maths::min(coord, (float)MAX_CELL_COORD), (float)-MAX_CELL_COORD);
+}
+
+void HashGrid::getCellRange(const Box &box, int *low, int *high) const {
+  for (int k = 0; k < 3; k++) {
+    low[k] = getCellCoord(box.min[k]);
+    high[k] = getCellCoord(box.max[k]);
+  }
+}
+
+HashGrid::Box HashGrid::getCellBox(const Cell &cell) const {
+  Box box;
+
+  for (int k = 0; k < 3; k++) {
+    box.min[k] = cell.coords[k] * cellSize;
+    box.max[k] = (cell.coords[k] + 1) * cellSize;
+  }
+
+  return box;
+}
+
+uint HashGrid::hash(int x, int y, int z) {
+  return (uint)x * 73856093u ^ (uint)y * 19349663u ^ (uint)z * 83492791u;
+}
+
+int HashGrid::findCell(int x, int y, int z) const {
+  uint mask = (uint)table.size() - 1;
+
+  for (uint bucket = hash(x, y, z) & mask; ; bucket = (bucket + 1) & mask) {
+    int index = table[bucket];
+    if (index == -1) {
+      return -1;
+    }
+
+    const int *coords = cells[index].coords;
+    if (coords[0] == x && coords[1] == y && coords[2] == z) {
+      return index;
+    }
+  }
+}
+
+int HashGrid::getCell(int x, int y, int z) {
+  int index = findCell(x, y, z);
+  if (index != -1) {
+    return index;
+  }
+
+  // Table is kept at most half full, so probe sequences stay short
+  if ((cells.size() + 1) * 2 > table.size()) {
+    table.assign(table.size() * 2, -1);
+    uint mask = (uint)table.size() - 1;
+    for (uint i = 0; i < cells.size(); i++) {
+      uint bucket = hash(cells[i].coords[0], cells[i].coords[1], cells[i].coords[2]) & mask;
+      while (table[bucket] != -1) {
+        bucket = (bucket + 1) & mask;
+      }
+      table[bucket] = (int)i;
+    }
+  }
+
+  index = (int)cells.size();
+  cells.push_back(Cell());
+  cells[index].coords[0] = x;
+  cells[index].coords[1] = y;
+  cells[index].coords[2] = z;
+
+  uint mask = (uint)table.size() - 1;
+  uint bucket = hash(x, y, z) & mask;
+  while (table[bucket] != -1) {
+    bucket = (bucket + 1) & mask;
+  }
+  table[bucket] = index;
+
+  int coords[3] = { x, y, z };
+  for (int k = 0; k < 3; k++) {
+    lowCell[k] = Maths::min(lowCell[k], coords[k]);
+    highCell[k] = Maths::max(highCell[k], coords[k]);
+  }
+
+  return index;
+}
+
+void HashGrid::link(int entry) {
+  int low[3], high[3];
+  getCellRange(entries[entry].box, low, high);
+
+  float count = 1;
+  for (int k = 0; k < 3; k++) {
+    count *= (float)(high[k] - low[k] + 1);
+  }
+
+  entries[entry].large = count > MAX_OBJECT_CELLS;
+  if (entries[entry].large) {
+    largeObjects.push_back(entry);
+    return;
+  }
+
+  const Box &box = entries[entry].box;
+  for (int k = 0; k < 3; k++) {
+    maxExtent = Maths::max(maxExtent, box.max[k] - box.min[k]);
+  }
+
+  for (int x = low[0]; x <= high[0]; x++) {
+    for (int y = low[1]; y <= high[1]; y++) {
+      for (int z = low[2]; z <= high[2]; z++) {
+        cells[getCell(x, y, z)].objects.push_back(entry);
+      }
+    }
+  }
+}
+
+void HashGrid::unlink(int entry) {
+  if (entries[entry].large) {
+    std::vector<int>::iterator it = std::find(largeObjects.begin(), largeObjects.end(), entry);
+    *it = largeObjects.back();
+    largeObjects.pop_back();
+    return;
+  }
+
+  int low[3], high[3];
+  getCellRange(entries[entry].box, low, high);
+
+  for (int x = low[0]; x <= high[0]; x++) {
+    for (int y = low[1]; y <= high[1]; y++) {
+      for (int z = low[2]; z <= high[2]; z++) {
+        std::vector<int> &objects = cells[findCell(x, y, z)].objects;
+        std::vector<int>::iterator it = std::find(objects.begin(), objects.end(), entry);
+        *it = objects.back();
+        objects.pop_back();
+      }
+    }
+  }
+}
+
+int HashGrid::insert(VisibleObject *object) {
+  CHECK_POINTER_EX(object, -1);
+
+  int entry;
+  if (freeList != -1) {
+    entry = freeList;
+    freeList = entries[entry].next;
+  } else {
+    entry = (int)entries.size();
+    entries.push_back(Entry());
+  }
+
+  entries[entry].object = object;
+  entries[entry].box = getBox(object->getBounds());
+  entries[entry].stamp = 0;
+  link(entry);
+  objectCount++;
+  return entry;
+}
+
+Outcome HashGrid::remove(int proxy) {
+  ERROR_IF(getObject(proxy) == NULL, L"Invalid proxy", INVALID_VALUE);
+
+  unlink(proxy);
+  entries[proxy].object = NULL;
+  entries[proxy].next = freeList;
+  freeList = proxy;
+  objectCount--;
+  return OK;
+}
+
+Outcome HashGrid::update(int proxy) {
+  ERROR_IF(getObject(proxy) == NULL, L"Invalid proxy", INVALID_VALUE);
+
+  Entry &entry = entries[proxy];
+  Box box = getBox(entry.object->getBounds());
+
+  int oldLow[3], oldHigh[3], newLow[3], newHigh[3];
+  getCellRange(entry.box, oldLow, oldHigh);
+  getCellRange(box, newLow, newHigh);
+
+  // Most of updates are small moves which do not leave cells
+  bool moved = false;
+  for (int k = 0; k < 3; k++) {
+    moved = moved || oldLow[k] != newLow[k] || oldHigh[k] != newHigh[k];
+  }
+
+  if (moved) {
+    unlink(proxy);
+    entries[proxy].box = box;
+    link(proxy);
+  } else {
+    entry.box = box;
+  }
+
+  return OK;
+}
+
+VisibleObject *HashGrid::getObject(int proxy) const {
+  if (proxy < 0 || proxy >= (int)entries.size()) {
+    return NULL;
+  }
+
+  return entries[proxy].object;
+}
+
+uint HashGrid::getObjectCount() const {
+  return objectCount;
+}
+
+uint HashGrid::nextStamp() {
+  if (++stamp == 0) {
+    for (uint i = 0; i < entries.size(); i++) {
+      entries[i].stamp = 0;
+    }
+    stamp = 1;
+  }
+
+  return stamp;
+}
+
+void HashGrid::findCells(const Box &box) {
+  visited.clear();
+
+  int low[3], high[3];
+  getCellRange(box, low, high);
+
+  float volume = 1;
+  for (int k = 0; k < 3; k++) {
+    low[k] = Maths::max(low[k], lowCell[k]);
+    high[k] = Maths::min(high[k], highCell[k]);
+    if (low[k] > high[k]) {
+      return;
+    }
+    volume *= (float)(high[k] - low[k] + 1);
+  }
+
+  // Large ranges are cheaper to check against the list of existing cells
+  if (volume > (float)cells.size()) {
+    for (uint i = 0; i < cells.size(); i++) {
+      const int *coords = cells[i].coords;
+      if (coords[0] >= low[0] && coords[0] <= high[0] && coords[1] >= low[1] && coords[1] <= high[1] &&
+          coords[2] >= low[2] && coords[2] <= high[2]) {
+        visited.push_back(i);
+      }
+    }
+    return;
+  }
+
+  for (int x = low[0]; x <= high[0]; x++) {
+    for (int y = low[1]; y <= high[1]; y++) {
+      for (int z = low[2]; z <= high[2]; z++) {
+        int index = findCell(x, y, z);
+        if (index != -1) {
+          visited.push_back(index);
+        }
+      }
+    }
+  }
+}
+
+void HashGrid::query(const Vector3f &point, std::vector<VisibleObject *> &result) {
+  float position[3] = { point[0], point[1], point[2] };
+
+  for (uint i = 0; i < largeObjects.size(); i++) {
+    const Entry &entry = entries[largeObjects[i]];
+    if (contains(entry.box, position)) {
+      result.push_back(entry.object);
+    }
+  }
+
+  int index = findCell(getCellCoord(position[0]), getCellCoord(position[1]), getCellCoord(position[2]));
+  if (index == -1) {
+    return;
+  }
+
+  // Point is inside one cell, so objects can not repeat and stamps are not needed
+  const std::vector<int> &objects = cells[index].objects;
+  for (uint i = 0; i < objects.size(); i++) {
+    const Entry &entry = entries[objects[i]];
+    if (contains(entry.box, position)) {
+      result.push_back(entry.object);
+    }
+  }
+}
+
+void HashGrid::query(const BoundingBox &box, std::vector<VisibleObject *> &result) {
+  Box queryBox = getBox(box);
+  uint current = nextStamp();
+
+  for (uint i = 0; i < largeObjects.size(); i++) {
+    const Entry &entry = entries[largeObjects[i]];
+    if (overlaps(entry.box, queryBox)) {
+      result.push_back(entry.object);
+    }
+  }
+
+  findCells(queryBox);
+  for (uint c = 0; c < visited.size(); c++) {
+    const std::vector<int> &objects = cells[visited[c]].objects;
+    for (uint i = 0; i < objects.size(); i++) {
+      Entry &entry = entries[objects[i]];
+      if (entry.stamp == current) {
+        continue;
+      }
+
+      entry.stamp = current;
+      if (overlaps(entry.box, queryBox)) {
+        result.push_back(entry.object);
+      }
+    }
+  }
+}
+
+void HashGrid::query(const Frustum &frustum, std::vector<VisibleObject *> &result) {
+  float planes[6][4];
+  getPlanes(frustum, planes);
+  uint current = nextStamp();
+
+  for (uint i = 0; i < largeObjects.size(); i++) {
+    const Entry &entry = entries[largeObjects[i]];
+    if (classify(planes, entry.box) != OUTSIDE) {
+      result.push_back(entry.object);
+    }
+  }
+
+  // Plane test accepts objects near corners which are outside of the frustum bounds
+  Box bounds = getFrustumBox(frustum);
+  for (int k = 0; k < 3; k++) {
+    bounds.min[k] -= maxExtent;
+    bounds.max[k] += maxExtent;
+  }
+
+  findCells(bounds);
+  for (uint c = 0; c < visited.size(); c++) {
+    const Cell &cell = cells[visited[c]];
+    Containment containment = classify(planes, getCellBox(cell));
+    if (containment == OUTSIDE) {
+      continue;
+    }
+
+    for (uint i = 0; i < cell.objects.size(); i++) {
+      Entry &entry = entries[cell.objects[i]];
+      if (entry.stamp == current) {
+        continue;
+      }
+
+      // Objects which overlap a cell inside the frustum are visible without tests
+      entry.stamp = current;
+      if (containment == INSIDE || classify(planes, entry.box) != OUTSIDE) {
+        result.push_back(entry.object);
+      }
+    }
+  }
+}
+
+VisibleObject *HashGrid::rayCast(const Vector3f &origin, const Vector3f &direction,
+                                 float maxDistance, float *distance) {
+  float start[3], inverse[3];
+  for (int k = 0; k < 3; k++) {
+    start[k] = origin[k];
+    inverse[k] = direction[k] != 0 ? 1.0f / direction[k] : FLT_MAX;
+  }
+
+  VisibleObject *closest = NULL;
+  float closestDistance = maxDistance;
+  uint current = nextStamp();
+  float enter;
+
+  for (uint i = 0; i < largeObjects.size(); i++) {
+    const Entry &entry = entries[largeObjects[i]];
+    if (intersects(entry.box, start, inverse, closestDistance, enter)) {
+      closest = entry.object;
+      closestDistance = enter;
+    }
+  }
+
+  // Ray is clipped by bounds of existing cells
+  Box occupied;
+  for (int k = 0; k < 3; k++) {
+    occupied.min[k] = lowCell[k] * cellSize;
+    occupied.max[k] = (highCell[k] + 1) * cellSize;
+  }
+
+  if (!cells.empty() && intersects(occupied, start, inverse, closestDistance, enter)) {
+    float leave = closestDistance;
+    for (int k = 0; k < 3; k++) {
+      float t0 = (occupied.min[k] - start[k]) * inverse[k];
+      float t1 = (occupied.max[k] - start[k]) * inverse[k];
+      leave = Maths::min(leave, Maths::max(t0, t1));
+    }
+
+    // Cells along the ray are visited with 3D digital differential analyzer
+    int cell[3], step[3];
+    float next[3], delta[3];
+    for (int k = 0; k < 3; k++) {
+      cell[k] = Maths::max(Maths::min(getCellCoord(start[k] + direction[k] * enter), highCell[k]), lowCell[k]);
+      if (direction[k] > 0) {
+        step[k] = 1;
+        next[k] = ((cell[k] + 1) * cellSize - start[k]) * inverse[k];
+        delta[k] = cellSize * inverse[k];
+      } else if (direction[k] < 0) {
+        step[k] = -1;
+        next[k] = (cell[k] * cellSize - start[k]) * inverse[k];
+        delta[k] = -cellSize * inverse[k];
+      } else {
+        step[k] = 0;
+        next[k] = FLT_MAX;
+        delta[k] = FLT_MAX;
+      }
+    }
+
+    // Cells which are entered after the closest hit can not have closer hits
+    float position = enter;
+    while (position <= leave && position <= closestDistance) {
+      int index = findCell(cell[0], cell[1], cell[2]);
+      if (index != -1) {
+        const std::vector<int> &objects = cells[index].objects;
+        for (uint i = 0; i < objects.size(); i++) {
+          Entry &entry = entries[objects[i]];
+          if (entry.stamp == current) {
+            continue;
+          }
+
+          entry.stamp = current;
+          if (intersects(entry.box, start, inverse, closestDistance, enter)) {
+            closest = entry.object;
+            closestDistance = enter;
+          }
+        }
+      }
+
+      int axis = 0;
+      if (next[1] < next[axis]) {
+        axis = 1;
+      }
+      if (next[2] < next[axis]) {
+        axis = 2;
+      }
+
+      position = next[axis];
+      cell[axis] += step[axis];
+      next[axis] += delta[axis];
+      if (cell[axis] < lowCell[axis] || cell[axis] > highCell[axis]) {
+        break;
+      }
+    }
+  }
+
+  if (closest != NULL && distance != NULL) {
+    *distance = closestDistance;
+  }
+
+  return closest;
+}
+
+void HashGrid::findNearest(const Vector3f &point, uint count, std::vector<VisibleObject *> &result) {
+  if (objectCount == 0 || count == 0) {
+    return;
+  }
+
+  float position[3] = { point[0], point[1], point[2] };
+  std::vector<Candidate> heap;
+  heap.reserve(std::min(count, objectCount));
+  uint current = nextStamp();
+
+  for (uint i = 0; i < largeObjects.size(); i++) {
+    const Entry &entry = entries[largeObjects[i]];
+    addCandidate(heap, count, getSquaredDistance(entry.box, position), entry.object);
+  }
+
+  if (cells.empty()) {
+    appendSorted(heap, result);
+    return;
+  }
+
+  // Shells are cubes of cells around the cell of the point, the first one
+  // touches existing cells and the last one contains all of them
+  int center[3];
+  int firstShell = 0, lastShell = 0;
+  for (int k = 0; k < 3; k++) {
+    center[k] = getCellCoord(position[k]);
+    firstShell = Maths::max(firstShell, Maths::max(lowCell[k] - center[k], center[k] - highCell[k]));
+    lastShell = Maths::max(lastShell, Maths::max(center[k] - lowCell[k], highCell[k] - center[k]));
+  }
+
+  for (int shell = firstShell; shell <= lastShell; shell++) {
+    visited.clear();
+
+    int low[3], high[3];
+    float size = 1;
+    for (int k = 0; k < 3; k++) {
+      low[k] = Maths::max(center[k] - shell, lowCell[k]);
+      high[k] = Maths::min(center[k] + shell, highCell[k]);
+      size *= (float)(high[k] - low[k] + 1);
+    }
+
+    if (size > (float)cells.size()) {
+      // Sparse grid, existing cells of the shell are found in the list of cells
+      for (uint i = 0; i < cells.size(); i++) {
+        const int *coords = cells[i].coords;
+        int distance = Maths::max(abs(coords[0] - center[0]), abs(coords[1] - center[1]),
+          abs(coords[2] - center[2]));
+        if (distance == shell) {
+          visited.push_back(i);
+        }
+      }
+    } else {
+      for (int x = low[0]; x <= high[0]; x++) {
+        for (int y = low[1]; y <= high[1]; y++) {
+          bool side = abs(x - center[0]) == shell || abs(y - center[1]) == shell;
+          // Inner cells were visited by previous shells, only the caps are left there
+          int zStep = side || shell == 0 ? 1 : 2 * shell;
+          for (int z = center[2] - shell; z <= center[2] + shell; z += zStep) {
+            if (z < low[2] || z > high[2]) {
+              continue;
+            }
+            int index = findCell(x, y, z);
+            if (index != -1) {
+              visited.push_back(index);
+            }
+          }
+        }
+      }
+    }
+
+    for (uint c = 0; c < visited.size(); c++) {
+      const std::vector<int> &objects = cells[visited[c]].objects;
+      for (uint i = 0; i < objects.size(); i++) {
+        Entry &entry = entries[objects[i]];
+        if (entry.stamp != current) {
+          entry.stamp = current;
+          addCandidate(heap, count, getSquaredDistance(entry.box, position), entry.object);
+        }
+      }
+    }
+
+    // Objects which were not found yet are outside of the cube of visited
+    // cells, so they are at least 'shell' cells away from the point
+    float covered = shell * cellSize;
+    if (getWorstDistance(heap, count) <= covered * covered) {
+      break;
+    }
+  }
+
+  appendSorted(heap, result);
+}
+
+}
@@ -0,0 +1,206 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_HASH_GRID_H__
+#define __VE_HASH_GRID_H__
+
+#include <vector>
+
+#include "engine/spatial/spatial_index.h"
+
+namespace ve {
+
+/**
+    Sparse uniform grid over bounds of visible objects. Space is split into cubic
+    cells of the same size and only cells which have objects are stored in the hash
+    table, so the grid has no world bounds. Every object is registered in all cells
+    which its bounds overlap, objects which overlap too many cells are kept in the
+    separate list which is tested by every query.
+
+    The grid works best when cell size is close to the size of typical objects and
+    queries: then updates touch a few cells and queries test a few objects per cell.
+*/
+class HashGrid : public SpatialIndex {
+private:
+  /**
+      Grid cell with its integer coordinates.
+  */
+  struct Cell {
+    int coords[3];
+    std::vector<int> objects;
+  };
+
+  /**
+      Object slot, proxies are indices of slots. Free slots have no object and
+      are linked into the list with next field.
+  */
+  struct Entry {
+    VisibleObject *object;
+    Box box;
+    /** Objects which overlap too many cells are not registered in cells */
+    bool large;
+    /** Number of the last query which tested the object */
+    uint stamp;
+    int next;
+  };
+
+  float cellSize;
+
+  std::vector<Cell> cells;
+
+  /** Open addressing hash table of cell indices, -1 marks empty buckets */
+  std::vector<int> table;
+
+  std::vector<Entry> entries;
+
+  /** Objects which overlap too many cells */
+  std::vector<int> largeObjects;
+
+  /** Index of the first free entry, -1 if there are no free entries */
+  int freeList;
+
+  uint objectCount;
+
+  /** Maximal size of objects which are registered in cells */
+  float maxExtent;
+
+  /** Range of coordinates of all cells which were ever used */
+  int lowCell[3];
+  int highCell[3];
+
+  /** Number of the current query, objects with this stamp were already tested */
+  uint stamp;
+
+  /** Cells found by the current query, the list is reused to avoid allocations */
+  std::vector<int> visited;
+
+  /**
+      Converts coordinate to the index of the cell, clamped to avoid overflows.
+  */
+  int getCellCoord(float value) const;
+
+  /**
+      Finds range of cells which the box overlaps.
+  */
+  void getCellRange(const Box &box, int *low, int *high) const;
+
+  /**
+      Returns bounds of the cell.
+  */
+  Box getCellBox(const Cell &cell) const;
+
+  /**
+      Finds cell in the hash table.
+      @return Index of the cell or -1 if there is no such cell.
+  */
+  int findCell(int x, int y, int z) const;
+
+  /**
+      Finds cell in the hash table and adds it if there is no such cell.
+      @return Index of the cell.
+  */
+  int getCell(int x, int y, int z);
+
+  /**
+      Registers entry in cells which its box overlaps.
+  */
+  void link(int entry);
+
+  /**
+      Removes entry from cells which its box overlaps.
+  */
+  void unlink(int entry);
+
+  /**
+      Starts new query and returns its stamp.
+  */
+  uint nextStamp();
+
+  /**
+      Fills the visited list with existing cells which overlap the box.
+  */
+  void findCells(const Box &box);
+
+  /**
+      Returns hash of cell coordinates.
+  */
+  static uint hash(int x, int y, int z);
+
+public:
+  /**
+      Constructor. Creates empty grid.
+      @param cellSize - Edge length of cells.
+  */
+  HashGrid(float cellSize);
+
+  /**
+      Changes size of cells and registers all objects in new cells.
+      @param cellSize - Edge length of cells.
+      @return OK if size was changed.
+      @return INVALID_VALUE if size is not positive.
+  */
+  Outcome setCellSize(float cellSize);
+
+  /**
+      Returns size of cells.
+      @return Edge length of cells.
+  */
+  float getCellSize() const;
+
+  /**
+      Returns number of cells which were created.
+      @return Number of cells.
+  */
+  uint getCellCount() const;
+
+  virtual void clear();
+
+  virtual int insert(VisibleObject *object);
+
+  virtual Outcome remove(int proxy);
+
+  virtual Outcome update(int proxy);
+
+  virtual VisibleObject *getObject(int proxy) const;
+
+  virtual uint getObjectCount() const;
+
+  virtual void query(const Vector3f &point, std::vector<VisibleObject *> &result);
+
+  virtual void query(const BoundingBox &box, std::vector<VisibleObject *> &result);
+
+  /**
+      Finds objects which bounds intersect the frustum. Only cells inside bounds of
+      the frustum expanded by the size of the largest object are tested, so objects
+      which pass the plane test far from corners of the frustum are rejected.
+      @param frustum - Frustum with normalized planes.
+      @param result - List to add found objects to.
+  */
+  virtual void query(const Frustum &frustum, std::vector<VisibleObject *> &result);
+
+  /**
+      Finds the first object which bounds are hit by the ray. Cells are visited
+      along the ray one by one until the closest hit is found.
+      @param origin - Origin of the ray.
+      @param direction - Direction of the ray.
+      @param maxDistance - Maximal distance along the ray in direction lengths.
+      @param distance - If not NULL, receives distance to the hit in direction lengths.
+      @return The closest object or NULL if ray does not hit anything.
+  */
+  virtual VisibleObject *rayCast(const Vector3f &origin, const Vector3f &direction,
+    float maxDistance, float *distance);
+
+  /**
+      Finds objects which bounds are the nearest to the point. Cells are visited
+      in growing shells around the point until the found objects are closer than
+      the shell.
+      @param point - Point to search around.
+      @param count - Number of objects to find.
+      @param result - List to add found objects to, the nearest goes first.
+  */
+  virtual void findNearest(const Vector3f &point, uint count, std::vector<VisibleObject *> &result);
+};
+
+}
+
+#endif // __VE_HASH_GRID_H__
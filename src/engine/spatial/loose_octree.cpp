@@ -0,0 +1,429 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <algorithm>
+#include <float.h>
+
+#include "common.h"
+#include "math/maths.h"
+#include "spatial/loose_octree.h"
+
+namespace ve {
+
+/* Child of the node with its distance, used to visit the nearest children first */
+struct OctreeChild {
+  float distance;
+  int index;
+
+  bool operator < (const OctreeChild &other) const {
+    return distance > other.distance;
+  }
+};
+
+LooseOctree::LooseOctree(const BoundingBox &world, uint maxDepth) {
+  Box box = getBox(world);
+  worldSize = 0;
+  for (int k = 0; k < 3; k++) {
+    worldCenter[k] = (box.min[k] + box.max[k]) * 0.5f;
+    worldSize = Maths::max(worldSize, box.max[k] - box.min[k]);
+  }
+
+  if (worldSize <= 0) {
+    worldSize = 1.0f;
+  }
+
+  this->maxDepth = maxDepth;
+  clear();
+}
+
+void LooseOctree::clear() {
+  nodes.clear();
+  entries.clear();
+  freeList = -1;
+  objectCount = 0;
+  createNode(worldCenter, worldSize, -1, 0);
+}
+
+int LooseOctree::createNode(const float *center, float size, int parent, uint depth) {
+  int index = (int)nodes.size();
+  nodes.push_back(Node());
+
+  Node &node = nodes[index];
+  for (int k = 0; k < 3; k++) {
+    node.center[k] = center[k];
+    node.box.min[k] = center[k] - size;
+    node.box.max[k] = center[k] + size;
+  }
+  node.size = size;
+  node.parent = parent;
+  node.depth = depth;
+  node.count = 0;
+  for (int i = 0; i < 8; i++) {
+    node.child[i] = -1;
+  }
+
+  return index;
+}
+
+int LooseOctree::getNode(const Box &box) {
+  float center[3];
+  float extent = 0;
+  for (int k = 0; k < 3; k++) {
+    center[k] = (box.min[k] + box.max[k]) * 0.5f;
+    extent = Maths::max(extent, box.max[k] - box.min[k]);
+  }
+
+  // Objects with centers outside of the world stay in the root
+  for (int k = 0; k < 3; k++) {
+    if (Maths::abs(center[k] - worldCenter[k]) > worldSize * 0.5f) {
+      return 0;
+    }
+  }
+
+  // Descend while the object fits into the cube of a child, loose bounds of the
+  // child contain the object then because its center is inside the cube
+  int index = 0;
+  while (nodes[index].depth < maxDepth) {
+    const Node &node = nodes[index];
+    float childSize = node.size * 0.5f;
+    if (extent > childSize) {
+      break;
+    }
+
+    int octant = 0;
+    float childCenter[3];
+    for (int k = 0; k < 3; k++) {
+      if (center[k] >= node.center[k]) {
+        octant |= 1 << k;
+        childCenter[k] = node.center[k] + childSize * 0.5f;
+      } else {
+        childCenter[k] = node.center[k] - childSize * 0.5f;
+      }
+    }
+
+    int child = node.child[octant];
+    if (child == -1) {
+      // Node reference is invalidated by creation of the child
+      child = createNode(childCenter, childSize, index, node.depth + 1);
+      nodes[index].child[octant] = child;
+    }
+    index = child;
+  }
+
+  return index;
+}
+
+void LooseOctree::link(int entry, int node) {
+  std::vector<int> &objects = nodes[node].objects;
+  entries[entry].node = node;
+  entries[entry].slot = (int)objects.size();
+  objects.push_back(entry);
+
+  for (int index = node; index != -1; index = nodes[index].parent) {
+    nodes[index].count++;
+  }
+}
+
+void LooseOctree::unlink(int entry) {
+  int node = entries[entry].node;
+  std::vector<int> &objects = nodes[node].objects;
+  int slot = entries[entry].slot;
+
+  // The last object takes place of the removed one
+  int last = objects.back();
+  objects[slot] = last;
+  entries[last].slot = slot;
+  objects.pop_back();
+
+  for (int index = node; index != -1; index = nodes[index].parent) {
+    nodes[index].count--;
+  }
+}
+
+int LooseOctree::insert(VisibleObject *object) {
+  CHECK_POINTER_EX(object, -1);
+
+  int entry;
+  if (freeList != -1) {
+    entry = freeList;
+    freeList = entries[entry].slot;
+  } else {
+    entry = (int)entries.size();
+    entries.push_back(Entry());
+  }
+
+  entries[entry].object = object;
+  entries[entry].box = getBox(object->getBounds());
+  link(entry, getNode(entries[entry].box));
+  objectCount++;
+  return entry;
+}
+
+Outcome LooseOctree::remove(int proxy) {
+  ERROR_IF(getObject(proxy) == NULL, L"Invalid proxy", INVALID_VALUE);
+
+  unlink(proxy);
+  entries[proxy].object = NULL;
+  entries[proxy].node = -1;
+  entries[proxy].slot = freeList;
+  freeList = proxy;
+  objectCount--;
+  return OK;
+}
+
+Outcome LooseOctree::update(int proxy) {
+  ERROR_IF(getObject(proxy) == NULL, L"Invalid proxy", INVALID_VALUE);
+
+  Entry &entry = entries[proxy];
+  entry.box = getBox(entry.object->getBounds());
+
+  int node = getNode(entry.box);
+  if (node != entry.node) {
+    unlink(proxy);
+    link(proxy, node);
+  }
+
+  return OK;
+}
+
+VisibleObject *LooseOctree::getObject(int proxy) const {
+  if (proxy < 0 || proxy >= (int)entries.size() || entries[proxy].node == -1) {
+    return NULL;
+  }
+
+  return entries[proxy].object;
+}
+
+uint LooseOctree::getObjectCount() const {
+  return objectCount;
+}
+
+uint LooseOctree::getNodeCount() const {
+  return (uint)nodes.size();
+}
+
+uint LooseOctree::getMaxDepth() const {
+  return maxDepth;
+}
+
+void LooseOctree::collect(int index, std::vector<VisibleObject *> &result) const {
+  const Node &node = nodes[index];
+
+  for (uint i = 0; i < node.objects.size(); i++) {
+    result.push_back(entries[node.objects[i]].object);
+  }
+
+  for (int i = 0; i < 8; i++) {
+    if (node.child[i] != -1 && nodes[node.child[i]].count > 0) {
+      collect(node.child[i], result);
+    }
+  }
+}
+
+void LooseOctree::query(const Vector3f &point, std::vector<VisibleObject *> &result) {
+  float position[3] = { point[0], point[1], point[2] };
+  stack.clear();
+  stack.push_back(0);
+
+  while (!stack.empty()) {
+    int index = stack.back();
+    stack.pop_back();
+    const Node &node = nodes[index];
+
+    // The root keeps objects outside of the world, so its bounds are not tested
+    if (index != 0 && !contains(node.box, position)) {
+      continue;
+    }
+
+    for (uint i = 0; i < node.objects.size(); i++) {
+      const Entry &entry = entries[node.objects[i]];
+      if (contains(entry.box, position)) {
+        result.push_back(entry.object);
+      }
+    }
+
+    for (int i = 0; i < 8; i++) {
+      if (node.child[i] != -1 && nodes[node.child[i]].count > 0) {
+        stack.push_back(node.child[i]);
+      }
+    }
+  }
+}
+
+void LooseOctree::query(const BoundingBox &box, std::vector<VisibleObject *> &result) {
+  Box queryBox = getBox(box);
+  stack.clear();
+  stack.push_back(0);
+
+  while (!stack.empty()) {
+    int index = stack.back();
+    stack.pop_back();
+    const Node &node = nodes[index];
+
+    if (index != 0 && !overlaps(node.box, queryBox)) {
+      continue;
+    }
+
+    for (uint i = 0; i < node.objects.size(); i++) {
+      const Entry &entry = entries[node.objects[i]];
+      if (overlaps(entry.box, queryBox)) {
+        result.push_back(entry.object);
+      }
+    }
+
+    for (int i = 0; i < 8; i++) {
+      if (node.child[i] != -1 && nodes[node.child[i]].count > 0) {
+        stack.push_back(node.child[i]);
+      }
+    }
+  }
+}
+
+void LooseOctree::query(const Frustum &frustum, std::vector<VisibleObject *> &result) {
+  float planes[6][4];
+  getPlanes(frustum, planes);
+
+  stack.clear();
+  stack.push_back(0);
+
+  while (!stack.empty()) {
+    int index = stack.back();
+    stack.pop_back();
+    const Node &node = nodes[index];
+    Containment containment = index == 0 ? INTERSECTS : classify(planes, node.box);
+
+    if (containment == OUTSIDE) {
+      continue;
+    }
+
+    if (containment == INSIDE) {
+      collect(index, result);
+      continue;
+    }
+
+    for (uint i = 0; i < node.objects.size(); i++) {
+      const Entry &entry = entries[node.objects[i]];
+      if (classify(planes, entry.box) != OUTSIDE) {
+        result.push_back(entry.object);
+      }
+    }
+
+    for (int i = 0; i < 8; i++) {
+      if (node.child[i] != -1 && nodes[node.child[i]].count > 0) {
+        stack.push_back(node.child[i]);
+      }
+    }
+  }
+}
+
+VisibleObject *LooseOctree::rayCast(const Vector3f &origin, const Vector3f &direction,
+                                    float maxDistance, float *distance) {
+  float start[3], inverse[3];
+  for (int k = 0; k < 3; k++) {
+    start[k] = origin[k];
+    inverse[k] = direction[k] != 0 ? 1.0f / direction[k] : FLT_MAX;
+  }
+
+  VisibleObject *closest = NULL;
+  float closestDistance = maxDistance;
+
+  stack.clear();
+  stack.push_back(0);
+
+  while (!stack.empty()) {
+    int index = stack.back();
+    stack.pop_back();
+    const Node &node = nodes[index];
+
+    // The node is skipped if it is farther than the closest hit
+    float enter;
+    if (index != 0 && !intersects(node.box, start, inverse, closestDistance, enter)) {
+      continue;
+    }
+
+    for (uint i = 0; i < node.objects.size(); i++) {
+      const Entry &entry = entries[node.objects[i]];
+      if (intersects(entry.box, start, inverse, closestDistance, enter)) {
+        closest = entry.object;
+        closestDistance = enter;
+      }
+    }
+
+    // Children which are closer to the origin are visited first
+    OctreeChild children[8];
+    int childCount = 0;
+    for (int i = 0; i < 8; i++) {
+      int child = node.child[i];
+      if (child != -1 && nodes[child].count > 0 &&
+          intersects(nodes[child].box, start, inverse, closestDistance, enter)) {
+        children[childCount].distance = enter;
+        children[childCount].index = child;
+        childCount++;
+      }
+    }
+
+    std::sort(children, children + childCount);
+    for (int i = 0; i < childCount; i++) {
+      stack.push_back(children[i].index);
+    }
+  }
+
+  if (closest != NULL && distance != NULL) {
+    *distance = closestDistance;
+  }
+
+  return closest;
+}
+
+void LooseOctree::findNearest(const Vector3f &point, uint count, std::vector<VisibleObject *> &result) {
+  if (objectCount == 0 || count == 0) {
+    return;
+  }
+
+  float position[3] = { point[0], point[1], point[2] };
+  std::vector<Candidate> heap;
+  heap.reserve(std::min(count, objectCount));
+
+  stack.clear();
+  stack.push_back(0);
+
+  while (!stack.empty()) {
+    int index = stack.back();
+    stack.pop_back();
+    const Node &node = nodes[index];
+
+    if (index != 0 && getSquaredDistance(node.box, position) >= getWorstDistance(heap, count)) {
+      continue;
+    }
+
+    for (uint i = 0; i < node.objects.size(); i++) {
+      const Entry &entry = entries[node.objects[i]];
+      addCandidate(heap, count, getSquaredDistance(entry.box, position), entry.object);
+    }
+
+    // Children which are closer to the point are visited first
+    OctreeChild children[8];
+    int childCount = 0;
+    float worst = getWorstDistance(heap, count);
+    for (int i = 0; i < 8; i++) {
+      int child = node.child[i];
+      if (child != -1 && nodes[child].count > 0) {
+        float distance = getSquaredDistance(nodes[child].box, position);
+        if (distance < worst) {
+          children[childCount].distance = distance;
+          children[childCount].index = child;
+          childCount++;
+        }
+      }
+    }
+
+    std::sort(children, children + childCount);
+    for (int i = 0; i < childCount; i++) {
+      stack.push_back(children[i].index);
+    }
+  }
+
+  appendSorted(heap, result);
+}
+
+}
@@ -0,0 +1,145 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_LOOSE_OCTREE_H__
+#define __VE_LOOSE_OCTREE_H__
+
+#include <vector>
+
+#include "engine/spatial/spatial_index.h"
+
+namespace ve {
+
+/**
+    Loose octree over bounds of visible objects. Every node is a cube which is split
+    into eight children, and bounds of the node are twice larger than its cube, so
+    an object is stored in exactly one node: the deepest one which cube is not smaller
+    than the object and contains its center. Insertion, update and removal take time
+    proportional to the depth of the tree and never move other objects, so the
+    octree suits large worlds where most of objects are static.
+
+    Nodes are created on demand. Objects which centers are outside of the world are
+    kept in the root node and are tested by every query.
+*/
+class LooseOctree : public SpatialIndex {
+private:
+  /**
+      Tree node. Children which were never needed are -1.
+  */
+  struct Node {
+    /** Loose bounds of the node, twice larger than its cube */
+    Box box;
+    float center[3];
+    float size;
+    int parent;
+    int child[8];
+    uint depth;
+    /** Number of objects in the subtree, empty subtrees are skipped by queries */
+    uint count;
+    std::vector<int> objects;
+  };
+
+  /**
+      Object slot, proxies are indices of slots. Free slots have no node and
+      are linked into the list with slot field.
+  */
+  struct Entry {
+    VisibleObject *object;
+    Box box;
+    int node;
+    int slot;
+  };
+
+  std::vector<Node> nodes;
+
+  std::vector<Entry> entries;
+
+  /** Index of the first free entry, -1 if there are no free entries */
+  int freeList;
+
+  uint objectCount;
+
+  /** Center of the world cube */
+  float worldCenter[3];
+
+  /** Edge length of the world cube */
+  float worldSize;
+
+  uint maxDepth;
+
+  /** Traversal stack which is reused by queries to avoid allocations */
+  std::vector<int> stack;
+
+  /**
+      Adds node for the cube.
+      @return Index of the node.
+  */
+  int createNode(const float *center, float size, int parent, uint depth);
+
+  /**
+      Finds node where the box should be stored, creates missing nodes on the way.
+  */
+  int getNode(const Box &box);
+
+  /**
+      Adds entry to the list of node objects.
+  */
+  void link(int entry, int node);
+
+  /**
+      Removes entry from the list of its node objects.
+  */
+  void unlink(int entry);
+
+  /**
+      Adds objects of the whole subtree to the list.
+  */
+  void collect(int index, std::vector<VisibleObject *> &result) const;
+
+public:
+  /**
+      Constructor. Creates empty octree.
+      @param world - Bounds of the world, the octree uses the cube around it.
+      @param maxDepth - Maximal depth of nodes, the root is at depth 0.
+  */
+  LooseOctree(const BoundingBox &world, uint maxDepth = 8);
+
+  virtual void clear();
+
+  virtual int insert(VisibleObject *object);
+
+  virtual Outcome remove(int proxy);
+
+  virtual Outcome update(int proxy);
+
+  virtual VisibleObject *getObject(int proxy) const;
+
+  virtual uint getObjectCount() const;
+
+  /**
+      Returns number of nodes which were created.
+      @return Number of nodes.
+  */
+  uint getNodeCount() const;
+
+  /**
+      Returns maximal depth of nodes.
+      @return Maximal depth of nodes.
+  */
+  uint getMaxDepth() const;
+
+  virtual void query(const Vector3f &point, std::vector<VisibleObject *> &result);
+
+  virtual void query(const BoundingBox &box, std::vector<VisibleObject *> &result);
+
+  virtual void query(const Frustum &frustum, std::vector<VisibleObject *> &result);
+
+  virtual VisibleObject *rayCast(const Vector3f &origin, const Vector3f &direction,
+    float maxDistance, float *distance);
+
+  virtual void findNearest(const Vector3f &point, uint count, std::vector<VisibleObject *> &result);
+};
+
+}
+
+#endif // __VE_LOOSE_OCTREE_H__
@@ -0,0 +1,208 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <algorithm>
+#include <float.h>
+
+#include "common.h"
+#include "math/maths.h"
+#include "spatial/spatial_index.h"
+
+namespace ve {
+
+SpatialIndex::~SpatialIndex() {
+}
+
+SpatialIndex::Box SpatialIndex::getBox(const BoundingBox &bounds) {
+  Vector3f corner = bounds.getCorner();
+  Vector3f size = bounds.getSize();
+  Box box;
+
+  for (int k = 0; k < 3; k++) {
+    box.min[k] = Maths::min(corner[k], corner[k] + size[k]);
+    box.max[k] = Maths::max(corner[k], corner[k] + size[k]);
+  }
+
+  return box;
+}
+
+SpatialIndex::Box SpatialIndex::merge(const Box &a, const Box &b) {
+  Box box;
+
+  for (int k = 0; k < 3; k++) {
+    box.min[k] = Maths::min(a.min[k], b.min[k]);
+    box.max[k] = Maths::max(a.max[k], b.max[k]);
+  }
+
+  return box;
+}
+
+float SpatialIndex::getArea(const Box &box) {
+  float x = box.max[0] - box.min[0];
+  float y = box.max[1] - box.min[1];
+  float z = box.max[2] - box.min[2];
+  return x * y + y * z + z * x;
+}
+
+bool SpatialIndex::contains(const Box &a, const Box &b) {
+  for (int k = 0; k < 3; k++) {
+    if (b.min[k] < a.min[k] || b.max[k] > a.max[k]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool SpatialIndex::contains(const Box &box, const float *point) {
+  for (int k = 0; k < 3; k++) {
+    if (point[k] < box.min[k] || point[k] > box.max[k]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool SpatialIndex::overlaps(const Box &a, const Box &b) {
+  for (int k = 0; k < 3; k++) {
+    if (a.min[k] > b.max[k] || b.min[k] > a.max[k]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+float SpatialIndex::getSquaredDistance(const Box &box, const float *point) {
+  float distance = 0;
+
+  for (int k = 0; k < 3; k++) {
+    float delta = Maths::max(Maths::max(box.min[k] - point[k], point[k] - box.max[k]), 0.0f);
+    distance += delta * delta;
+  }
+
+  return distance;
+}
+
+bool SpatialIndex::intersects(const Box &box, const float *start, const float *inverse,
+                              float maxDistance, float &distance) {
+  float enter = 0, leave = maxDistance;
+
+  for (int k = 0; k < 3 && enter <= leave; k++) {
+    float t0 = (box.min[k] - start[k]) * inverse[k];
+    float t1 = (box.max[k] - start[k]) * inverse[k];
+    if (t0 > t1) {
+      std::swap(t0, t1);
+    }
+    enter = Maths::max(enter, t0);
+    leave = Maths::min(leave, t1);
+  }
+
+  distance = enter;
+  return enter <= leave;
+}
+
+void SpatialIndex::getPlanes(const Frustum &frustum, float planes[6][4]) {
+  for (int i = 0; i < 6; i++) {
+    const Plane &plane = frustum.getPlane(i);
+    for (int k = 0; k < 4; k++) {
+      planes[i][k] = plane[k];
+    }
+  }
+}
+
+SpatialIndex::Containment SpatialIndex::classify(const float planes[6][4], const Box &box) {
+  Containment result = INSIDE;
+
+  // Center-extent test: box is outside if it is behind any plane and
+  // it is inside if it is in front of all planes
+  for (int i = 0; i < 6; i++) {
+    const float *p = planes[i];
+    float distance = p[3], radius = 0;
+    for (int k = 0; k < 3; k++) {
+      distance += p[k] * (box.min[k] + box.max[k]) * 0.5f;
+      radius += Maths::abs(p[k]) * (box.max[k] - box.min[k]) * 0.5f;
+    }
+
+    if (distance + radius < 0) {
+      return OUTSIDE;
+    }
+
+    if (distance - radius < 0) {
+      result = INTERSECTS;
+    }
+  }
+
+  return result;
+}
+
+SpatialIndex::Box SpatialIndex::getFrustumBox(const Frustum &frustum) {
+  float planes[6][4];
+  getPlanes(frustum, planes);
+
+  Box box;
+  for (int k = 0; k < 3; k++) {
+    box.min[k] = FLT_MAX;
+    box.max[k] = -FLT_MAX;
+  }
+
+  // Every corner is an intersection of one of side planes (left or right), one of
+  // top and bottom planes and one of near and far planes
+  for (int corner = 0; corner < 8; corner++) {
+    const float *a = planes[corner & 1];
+    const float *b = planes[2 + ((corner >> 1) & 1)];
+    const float *c = planes[4 + ((corner >> 2) & 1)];
+
+    float bc[3] = { b[1] * c[2] - b[2] * c[1], b[2] * c[0] - b[0] * c[2], b[0] * c[1] - b[1] * c[0] };
+    float ca[3] = { c[1] * a[2] - c[2] * a[1], c[2] * a[0] - c[0] * a[2], c[0] * a[1] - c[1] * a[0] };
+    float ab[3] = { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+    float determinant = a[0] * bc[0] + a[1] * bc[1] + a[2] * bc[2];
+
+    if (Maths::abs(determinant) < 1e-12f) {
+      // Planes do not meet at a point, e.g. the frustum is infinite
+      for (int k = 0; k < 3; k++) {
+        box.min[k] = -FLT_MAX;
+        box.max[k] = FLT_MAX;
+      }
+      return box;
+    }
+
+    for (int k = 0; k < 3; k++) {
+      float point = -(a[3] * bc[k] + b[3] * ca[k] + c[3] * ab[k]) / determinant;
+      box.min[k] = Maths::min(box.min[k], point);
+      box.max[k] = Maths::max(box.max[k], point);
+    }
+  }
+
+  return box;
+}
+
+void SpatialIndex::addCandidate(std::vector<Candidate> &heap, uint count, float distance, VisibleObject *object) {
+  if (heap.size() >= count) {
+    if (count == 0 || distance >= heap.front().distance) {
+      return;
+    }
+    std::pop_heap(heap.begin(), heap.end());
+    heap.pop_back();
+  }
+
+  Candidate candidate;
+  candidate.distance = distance;
+  candidate.object = object;
+  heap.push_back(candidate);
+  std::push_heap(heap.begin(), heap.end());
+}
+
+float SpatialIndex::getWorstDistance(const std::vector<Candidate> &heap, uint count) {
+  return heap.size() < count ? FLT_MAX : heap.front().distance;
+}
+
+void SpatialIndex::appendSorted(std::vector<Candidate> &heap, std::vector<VisibleObject *> &result) {
+  std::sort_heap(heap.begin(), heap.end());
+  for (uint i = 0; i < heap.size(); i++) {
+    result.push_back(heap[i].object);
+  }
+}
+
+}
@@ -0,0 +1,224 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_SPATIAL_INDEX_H__
+#define __VE_SPATIAL_INDEX_H__
+
+#include <vector>
+
+#include "engine/types.h"
+#include "engine/visible_object.h"
+#include "engine/math/bounding_box.h"
+#include "engine/math/frustum.h"
+#include "engine/math/vector3f.h"
+
+namespace ve {
+
+/**
+    Base class for spatial structures over bounds of visible objects. All of them
+    have the same interface, so a scene may choose a structure which suits it best:
+    BoundingVolumeHierarchy for dynamic scenes, LooseOctree and HashGrid for large
+    static worlds.
+
+    Objects are identified by proxies which are returned by insert(). Structures do
+    not own objects and read their bounds only in insert() and update(). Queries add
+    found objects to the result list without clearing it.
+*/
+class SpatialIndex {
+protected:
+  /**
+      Axis aligned box stored as minimal and maximal corners.
+  */
+  struct Box {
+    float min[3];
+    float max[3];
+  };
+
+  /**
+      Object with its squared distance to the point of nearest neighbours search.
+  */
+  struct Candidate {
+    float distance;
+    VisibleObject *object;
+
+    bool operator < (const Candidate &other) const {
+      return distance < other.distance;
+    }
+  };
+
+  /** Result of box against frustum test. */
+  enum Containment {
+    OUTSIDE,
+    INTERSECTS,
+    INSIDE
+  };
+
+  /**
+      Converts bounding box of the object to min-max form.
+  */
+  static Box getBox(const BoundingBox &bounds);
+
+  /**
+      Returns box which contains both boxes.
+  */
+  static Box merge(const Box &a, const Box &b);
+
+  /**
+      Returns half of the surface area of the box.
+  */
+  static float getArea(const Box &box);
+
+  /**
+      Checks if the first box contains the second one.
+  */
+  static bool contains(const Box &a, const Box &b);
+
+  /**
+      Checks if the box contains the point.
+  */
+  static bool contains(const Box &box, const float *point);
+
+  /**
+      Checks if boxes overlap.
+  */
+  static bool overlaps(const Box &a, const Box &b);
+
+  /**
+      Returns squared distance from the point to the box, 0 if point is inside.
+  */
+  static float getSquaredDistance(const Box &box, const float *point);
+
+  /**
+      Intersects ray with the box using slab test.
+      @param start - Origin of the ray.
+      @param inverse - Inverted components of the ray direction.
+      @param maxDistance - Maximal distance along the ray.
+      @param distance - Receives distance to the entry point if ray hits the box.
+      @return 'true' if ray hits the box closer than maxDistance.
+  */
+  static bool intersects(const Box &box, const float *start, const float *inverse,
+    float maxDistance, float &distance);
+
+  /**
+      Copies frustum planes to array.
+  */
+  static void getPlanes(const Frustum &frustum, float planes[6][4]);
+
+  /**
+      Tests box against frustum planes.
+  */
+  static Containment classify(const float planes[6][4], const Box &box);
+
+  /**
+      Returns box which contains the frustum: it is built over eight corners
+      which are intersections of frustum planes.
+  */
+  static Box getFrustumBox(const Frustum &frustum);
+
+  /**
+      Adds object to the max-heap of k nearest candidates.
+  */
+  static void addCandidate(std::vector<Candidate> &heap, uint count, float distance, VisibleObject *object);
+
+  /**
+      Returns squared distance to the worst of k nearest candidates, or maximal
+      float value if less than k candidates were found.
+  */
+  static float getWorstDistance(const std::vector<Candidate> &heap, uint count);
+
+  /**
+      Sorts candidates by distance and adds them to result.
+  */
+  static void appendSorted(std::vector<Candidate> &heap, std::vector<VisibleObject *> &result);
+
+public:
+  /**
+      Destructor.
+  */
+  virtual ~SpatialIndex();
+
+  /**
+      Removes all objects.
+  */
+  virtual void clear() = 0;
+
+  /**
+      Inserts object.
+      @param object - Object to insert, its bounds are read at once.
+      @return Proxy of the object or -1 if object is NULL.
+  */
+  virtual int insert(VisibleObject *object) = 0;
+
+  /**
+      Removes object.
+      @param proxy - Proxy of the object.
+      @return OK if object was removed.
+      @return INVALID_VALUE if proxy is not valid.
+  */
+  virtual Outcome remove(int proxy) = 0;
+
+  /**
+      Reads new bounds of the object and updates the structure.
+      @param proxy - Proxy of the object.
+      @return OK if object was updated.
+      @return INVALID_VALUE if proxy is not valid.
+  */
+  virtual Outcome update(int proxy) = 0;
+
+  /**
+      Returns object by its proxy.
+      @param proxy - Proxy of the object.
+      @return Object or NULL if proxy is not valid.
+  */
+  virtual VisibleObject *getObject(int proxy) const = 0;
+
+  /**
+      Returns number of objects.
+      @return Number of objects.
+  */
+  virtual uint getObjectCount() const = 0;
+
+  /**
+      Finds objects which bounds contain the point.
+      @param point - Point to test.
+      @param result - List to add found objects to.
+  */
+  virtual void query(const Vector3f &point, std::vector<VisibleObject *> &result) = 0;
+
+  /**
+      Finds objects which bounds overlap the box.
+      @param box - Box to test.
+      @param result - List to add found objects to.
+  */
+  virtual void query(const BoundingBox &box, std::vector<VisibleObject *> &result) = 0;
+
+  /**
+      Finds objects which bounds intersect the frustum.
+      @param frustum - Frustum with normalized planes.
+      @param result - List to add found objects to.
+  */
+  virtual void query(const Frustum &frustum, std::vector<VisibleObject *> &result) = 0;
+
+  /**
+      Finds the first object which bounds are hit by the ray.
+      @param origin - Origin of the ray.
+      @param direction - Direction of the ray.
+      @param maxDistance - Maximal distance along the ray in direction lengths.
+      @param distance - If not NULL, receives distance to the hit in direction lengths.
+      @return The closest object or NULL if ray does not hit anything.
+  */
+  virtual VisibleObject *rayCast(const Vector3f &origin, const Vector3f &direction,
+    float maxDistance, float *distance) = 0;
+
+  /**
+      Finds objects which bounds are the nearest to the point.
+      @param point - Point to search around.
+      @param count - Number of objects to find.
+      @param result - List to add found objects to, the nearest goes first.
+  */
+  virtual void findNearest(const Vector3f &point, uint count, std::vector<VisibleObject *> &result) = 0;
+};
+
+}
+
+#endif // __VE_SPATIAL_INDEX_H__
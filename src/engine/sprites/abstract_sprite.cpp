@@ -2,6 +2,7 @@
 // All rights reserved.
 
 #include "sprites/abstract_sprite.h"
+#include "ui/ui_draw_list.h"
 
 namespace ve {
 
@@ -11,29 +12,33 @@ AbstractSprite::AbstractSprite(Engine *engine) {
   width = 0;
   height = 0;
   covered = false;
+  layoutListener = NULL;
 
   // Register pointer in the memory manager
-  REGISTER_POINTER(this);
+  memoryHandle = REGISTER_POINTER(this);
 }
 
 AbstractSprite::~AbstractSprite() {
   // Unregister pointer in the memory manager
-  UNREGISTER_POINTER(this);
+  UNREGISTER_POINTER(memoryHandle);
 }
 
 void AbstractSprite::setCovered(bool value) {
-  covered = value;
+  if (covered != value) {
+    covered = value;
+    invalidate();
+  }
 }
 
 Outcome AbstractSprite::processMouseEvent(MouseEvent *event) {
   CHECK_POINTER(event);
 
   if (event->getType() == MOUSE_ENTER) {
-    covered = true;
+    setCovered(true);
   }
 
   if (event->getType() == MOUSE_LEAVE) {
-    covered = false;
+    setCovered(false);
   }
 
   return OK;
@@ -44,30 +49,76 @@ Outcome AbstractSprite::processKeyEvent(KeyEvent *event) {
   return OK;
 }
 
+void AbstractSprite::notifyLayoutChange() {
+  if (layoutListener != NULL) {
+    layoutListener->onLayoutChange(this);
+  }
+}
+
 /* set functions */
 void AbstractSprite::setPosition(const Vector3f &newPosition) {
-  position = newPosition;
+  setPosition(newPosition[0], newPosition[1], newPosition[2]);
 }
 
 void AbstractSprite::setPosition(float x, float y, float z) {
-  position.set(x, y, z);
+  // Controls often set the same layout on every frame, listener is notified only about real changes
+  if (x != position[0] || y != position[1] || z != position[2]) {
+    position.set(x, y, z);
+    notifyLayoutChange();
+  }
 }
 
 void AbstractSprite::setPosition(float x, float y) {
-  position.set(x, y, position[2]);
+  setPosition(x, y, position[2]);
 }
 
 void AbstractSprite::setSize(float newWidth, float newHeight) {
-  width = newWidth;
-  height = newHeight;
+  if (newWidth != width || newHeight != height) {
+    width = newWidth;
+    height = newHeight;
+    notifyLayoutChange();
+  }
 }
 
 void AbstractSprite::setWidth(float newWidth) {
-  width = newWidth;
+  setSize(newWidth, height);
 }
 
 void AbstractSprite::setHeight(float newHeight) {
-  height = newHeight;
+  setSize(width, newHeight);
+}
+
+void AbstractSprite::setLayoutListener(LayoutListener *listener) {
+  layoutListener = listener;
+}
+
+void AbstractSprite::invalidate() {
+  if (layoutListener != NULL) {
+    layoutListener->onContentChange(this);
+  }
+}
+
+void AbstractSprite::setVisible(bool value) {
+  if (value != isVisible()) {
+    VisibleObject::setVisible(value);
+    invalidate();
+  }
+}
+
+void AbstractSprite::getDrawBounds(float &left, float &top, float &right, float &bottom) {
+  left = position[0];
+  top = position[1];
+  right = position[0] + width;
+  bottom = position[1] + height;
+}
+
+Outcome AbstractSprite::draw(UIDrawList *list) {
+  CHECK_POINTER(list);
+
+  if (isVisible()) {
+    list->addObject(this);
+  }
+  return OK;
 }
 
 /* get functions */
@@ -9,12 +9,14 @@
 #include "engine/math/vector3f.h"
 #include "engine/events/mouse_listener.h"
 #include "engine/events/key_listener.h"
+#include "engine/events/layout_listener.h"
 #include "engine/states/blend_state.h"
 #include "engine/states/alpha_test_state.h"
 
 namespace ve {
 
 class Engine;
+class UIDrawList;
 
 /**
     AbstractSprite is a base class for every sprite on a screen
@@ -49,6 +51,17 @@ private:
   /** Height of rectangular boundary */
   float height;
 
+  /** Handle of the sprite in the memory manager */
+  MemoryHandle memoryHandle;
+
+  /** Object which is notified when position or size is changed */
+  LayoutListener *layoutListener;
+
+  /**
+      Notifies layout listener about changed position or size.
+  */
+  void notifyLayoutChange();
+
 protected:
   /** Engine which created this sprite */
   Engine *engine;
@@ -193,6 +206,46 @@ public:
           @return 'true' if mouse is above this component and 'false' otherwise.
       */
   bool isCovered();
+
+  /**
+      Sets object which is notified when position or size of this sprite is
+      changed. Sprite has only one layout listener, usually it is its container.
+      @param listener - Layout listener or NULL to remove it.
+  */
+  void setLayoutListener(LayoutListener *listener);
+
+  /**
+      Notifies layout listener that look of the sprite was changed and it
+      should be redrawn. Controls call it when their properties change.
+  */
+  void invalidate();
+
+  /**
+      Sets visibility flag and invalidates the sprite.
+      @param value - 'true' to show the sprite, 'false' to hide it.
+  */
+  virtual void setVisible(bool value);
+
+  /**
+      Returns area which sprite covers when it is rendered, in coordinates of its
+      container. It is used to redraw only changed parts of the screen. By default
+      it is the rectangle of the sprite.
+      @param left - Receives left bound.
+      @param top - Receives top bound.
+      @param right - Receives right bound.
+      @param bottom - Receives bottom bound.
+  */
+  virtual void getDrawBounds(float &left, float &top, float &right, float &bottom);
+
+  /**
+      Appends geometry of the sprite to the draw list instead of rendering it.
+      By default sprite is added as an object which is rendered immediately,
+      sprites which consist of quads and text append them to be batched.
+      @param list - Draw list of the frame.
+      @return OK if geometry was appended.
+      @return non-OK if error occurred.
+  */
+  virtual Outcome draw(UIDrawList *list);
 };
 
 }
@@ -3,6 +3,7 @@
 
 #include "sprites/simple_sprite.h"
 #include "engines/engine.h"
+#include "ui/ui_draw_list.h"
 
 namespace ve {
 
@@ -72,4 +73,28 @@ Outcome SimpleSprite::render() {
   return OK;
 }
 
+Outcome SimpleSprite::draw(UIDrawList *list) {
+  CHECK_POINTER(list);
+
+  float width = getWidth();
+  float height = getHeight();
+
+  list->addRect(getX(), getY(), getZ(), width, height,
+    Vector4f(colorState.r, colorState.g, colorState.b, colorState.a));
+  list->pushTranslation(getX(), getY(), getZ());
+
+  if (border != NULL) {
+    border->setSize(width, height);
+    ASSERT(border->draw(list));
+  }
+
+  if (label != NULL) {
+    label->setSize(width, height);
+    ASSERT(label->draw(list));
+  }
+
+  list->popTranslation();
+  return OK;
+}
+
 }
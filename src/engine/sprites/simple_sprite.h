@@ -49,6 +49,14 @@ public:
   */
   virtual Outcome render();
 
+  /**
+      Appends area, border and label of the sprite to the draw list.
+      @param list - Draw list of the frame.
+      @return OK if geometry was appended.
+      @return non-OK if label can not be drawn.
+  */
+  virtual Outcome draw(UIDrawList *list);
+
   /**
       Sets border for this sprite.
       @param border - new Border object for this sprite.
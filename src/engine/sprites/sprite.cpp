@@ -7,6 +7,7 @@
 #include "engines/engine.h"
 #include "tools/texture_tool.h"
 #include "states/gpu_state_manager.h"
+#include "ui/ui_draw_list.h"
 
 namespace ve {
 
@@ -73,6 +74,38 @@ Outcome Sprite::render() {
   return OK;
 }
 
+Outcome Sprite::draw(UIDrawList *list) {
+  CHECK_POINTER(list);
+
+  if (isVisible() == false) {
+    return OK;
+  }
+
+  if (!blendState.isEnabled || !alphaTestState.isEnabled) {
+    return AbstractSprite::draw(list);
+  }
+
+  float w = getWidth();
+  float h = getHeight();
+  float vertices[] = { 0, h, 0,
+                        w, h, 0,
+                        w, 0, 0,
+                        0, 0, 0
+  };
+
+  /* Color filter is applied only if texture is modulated like in render() */
+  Vector4f color(1, 1, 1, 1);
+  if (texturesState.slots[0] == NULL || texturesState.texEnv[0].envMode == MODULATE) {
+    color = Vector4f(colorState.r, colorState.g, colorState.b, colorState.a);
+  }
+
+  list->pushTranslation(getX(), getY(), getZ());
+  list->addQuad(texturesState.slots[0], vertices, texCoord, color);
+  list->popTranslation();
+
+  return OK;
+}
+
 Outcome Sprite::setTexCoords(int index, Vector2f newTexCoord) {
   ERROR_IF(index < 0 || index >= 4, L"Index is out of bounds", ERROR);
   texCoord[index] = newTexCoord;
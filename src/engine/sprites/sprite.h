@@ -79,6 +79,14 @@ public:
   */
   virtual Outcome render();
 
+  /**
+      Appends quad of the sprite to the draw list. Sprites without transparency
+      are rendered immediately, because the list blends all geometry.
+      @param list - Draw list of the frame.
+      @return OK if quad was appended.
+  */
+  virtual Outcome draw(UIDrawList *list);
+
   /**
       Set texture coordinates for vertex specified
       by index.
@@ -15,6 +15,7 @@ namespace ve {
     uint stride;      //!< Distance between consequitive elements (or zero if they follow each other without gaps)
     void *data;       //!< Pointer to the data to set
     bool isVBO;       //!< Defines if data pointer points to Video Buffer ot just to an array in system memory
+    uint offset;      //!< Offset of the first element in the Video Buffer, it allows to interleave data in one buffer
 
 /**
   Buffer is disabled by default.
@@ -25,6 +26,7 @@ namespace ve {
       stride = 0;
       data = 0;
       isVBO = true;
+      offset = 0;
     }
 
     BufferDesc(uint components, Type type, uint stride, void* data, bool isVBO) {
@@ -33,6 +35,7 @@ namespace ve {
       this->stride = stride;
       this->data = data;
       this->isVBO = isVBO;
+      this->offset = 0;
     }
   };
 
@@ -45,6 +48,7 @@ namespace ve {
     BufferDesc vertices;
     BufferDesc texCoords;
     BufferDesc normals;
+    BufferDesc colors;
   };
 
 }
@@ -272,6 +272,42 @@ Outcome GLGPUStateManager::writeViewportState(ViewportState state) {
   return OK;
 }
 
+/* ********************************************** */
+/*                Scissor functions               */
+/* ********************************************** */
+
+/**
+    Returns scissor test state of the pipeline.
+    @return ScissorState object that contains current scissor rectangle.
+*/
+ScissorState GLGPUStateManager::readScissorState() {
+  ScissorState newState;
+  int values[4];
+
+  GL_SAFE_CALL(glGetIntegerv(GL_SCISSOR_BOX, values), ScissorState());
+  newState = ScissorState(values[0], values[1], values[2], values[3]);
+  newState.isEnabled = (glIsEnabled(GL_SCISSOR_TEST) == GL_TRUE);
+
+  return newState;
+}
+
+/**
+    Sets scissor test state.
+    @param state - Scissor state to set.
+    @return OK if operation succeeded.
+    @return ERROR if error occurred in renderer.
+*/
+Outcome GLGPUStateManager::writeScissorState(ScissorState state) {
+  if (state.isEnabled) {
+    glEnable(GL_SCISSOR_TEST);
+    GL_SAFE_CALL(glScissor(state.x, state.y, state.width, state.height), ERROR);
+  } else {
+    glDisable(GL_SCISSOR_TEST);
+  }
+
+  return OK;
+}
+
 /* ********************************************** */
 /*                 Color functions                */
 /* ********************************************** */
@@ -579,14 +615,8 @@ BuffersState GLGPUStateManager::readBuffersState() {
   /* Vertex buffer */
   if (glIsEnabled(GL_VERTEX_ARRAY)) {
     glGetPointerv(GL_VERTEX_ARRAY_POINTER, &buffersState.vertices.data);
-
-    if (buffersState.vertices.data == NULL) {
-      buffersState.vertices.isVBO = true;
-      glGetIntegerv(GL_VERTEX_ARRAY_BUFFER_BINDING, &id);
-      buffersState.vertices.data = engine->getBufferById(id);
-    } else {
-      buffersState.vertices.isVBO = false;
-    }
+    glGetIntegerv(GL_VERTEX_ARRAY_BUFFER_BINDING, &id);
+    readBufferSource(buffersState.vertices, id);
 
     glGetIntegerv(GL_VERTEX_ARRAY_SIZE, &size);
     glGetIntegerv(GL_VERTEX_ARRAY_TYPE, &type);
@@ -602,14 +632,8 @@ BuffersState GLGPUStateManager::readBuffersState() {
   /* Texture Coordinates */
   if (glIsEnabled(GL_TEXTURE_COORD_ARRAY)) {
     glGetPointerv(GL_TEXTURE_COORD_ARRAY_POINTER, &buffersState.texCoords.data);
-
-    if (buffersState.texCoords.data == NULL) {
-      buffersState.texCoords.isVBO = true;
-      glGetIntegerv(GL_TEXTURE_COORD_ARRAY_BUFFER_BINDING, &id);
-      buffersState.texCoords.data = engine->getBufferById(id);
-    } else {
-      buffersState.texCoords.isVBO = false;
-    }
+    glGetIntegerv(GL_TEXTURE_COORD_ARRAY_BUFFER_BINDING, &id);
+    readBufferSource(buffersState.texCoords, id);
 
     glGetIntegerv(GL_TEXTURE_COORD_ARRAY_SIZE, &size);
     glGetIntegerv(GL_TEXTURE_COORD_ARRAY_TYPE, &type);
@@ -625,14 +649,8 @@ BuffersState GLGPUStateManager::readBuffersState() {
   /* Normals */
   if (glIsEnabled(GL_NORMAL_ARRAY)) {
     glGetPointerv(GL_NORMAL_ARRAY_POINTER, &buffersState.normals.data);
-
-    if (buffersState.normals.data == NULL) {
-      buffersState.normals.isVBO = true;
-      glGetIntegerv(GL_NORMAL_ARRAY_BUFFER_BINDING, &id);
-      buffersState.normals.data = engine->getBufferById(id);
-    } else {
-      buffersState.normals.isVBO = false;
-    }
+    glGetIntegerv(GL_NORMAL_ARRAY_BUFFER_BINDING, &id);
+    readBufferSource(buffersState.normals, id);
 
     glGetIntegerv(GL_NORMAL_ARRAY_TYPE, &type);
     glGetIntegerv(GL_NORMAL_ARRAY_STRIDE, &stride);
@@ -643,9 +661,55 @@ BuffersState GLGPUStateManager::readBuffersState() {
     buffersState.normals.data = NULL;
   }
 
+  /* Colors */
+  if (glIsEnabled(GL_COLOR_ARRAY)) {
+    glGetPointerv(GL_COLOR_ARRAY_POINTER, &buffersState.colors.data);
+    glGetIntegerv(GL_COLOR_ARRAY_BUFFER_BINDING, &id);
+    readBufferSource(buffersState.colors, id);
+
+    glGetIntegerv(GL_COLOR_ARRAY_SIZE, &size);
+    glGetIntegerv(GL_COLOR_ARRAY_TYPE, &type);
+    glGetIntegerv(GL_COLOR_ARRAY_STRIDE, &stride);
+
+    buffersState.colors.components = size;
+    buffersState.colors.type = static_cast<Type>(convertGLEnum(type));
+    buffersState.colors.stride = stride;
+  } else {
+    buffersState.colors.data = NULL;
+  }
+
   return buffersState;
 }
 
+/**
+    Fills source of the buffer data which was read from the pipeline.
+    If video buffer is bound then pointer is an offset in it.
+*/
+void GLGPUStateManager::readBufferSource(BufferDesc &desc, GLint id) {
+  if (id == 0) {
+    desc.isVBO = false;
+    desc.offset = 0;
+  } else {
+    desc.isVBO = true;
+    desc.offset = (uint)reinterpret_cast<size_t>(desc.data);
+    desc.data = engine->getBufferById(id);
+  }
+}
+
+/**
+    Binds video buffer of the array if it is used.
+    @return Pointer which should be passed to gl*Pointer() functions.
+*/
+const GLvoid *GLGPUStateManager::bindBufferSource(const BufferDesc &desc) {
+  if (!desc.isVBO) {
+    return desc.data;
+  }
+
+  VideoBuffer *buffer = (VideoBuffer*)desc.data;
+  VBOFunctions->glBindBuffer(GL_ARRAY_BUFFER, buffer->getHandle());
+  return reinterpret_cast<const GLvoid *>((size_t)desc.offset);
+}
+
 /**
     Sets buffers and their parameters.
     @param state - Structure that contains buffers and their parameters
@@ -653,12 +717,12 @@ BuffersState GLGPUStateManager::readBuffersState() {
     @return non-OK in case of error.
 */
 Outcome GLGPUStateManager::writeBuffersState(BuffersState state) {
-  BufferDesc &desc = state.indices;
+  BufferDesc *desc = &state.indices;
 
   /* Index array */
-  if (desc.data != NULL) {
-    if (desc.isVBO) {
-      VideoBuffer *buffer = (VideoBuffer*)desc.data;
+  if (desc->data != NULL) {
+    if (desc->isVBO) {
+      VideoBuffer *buffer = (VideoBuffer*)desc->data;
       GL_SAFE_CALL(VBOFunctions->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer->getHandle()), ERROR);
     }
   } else {
@@ -666,48 +730,45 @@ Outcome GLGPUStateManager::writeBuffersState(BuffersState state) {
   }
 
   /* Vertex array */
-  desc = state.vertices;
-  if (desc.data != NULL) {
-    if (desc.isVBO) {
-      VideoBuffer *buffer = (VideoBuffer*)desc.data;
-      GL_SAFE_CALL(VBOFunctions->glBindBuffer(GL_ARRAY_BUFFER, buffer->getHandle()), ERROR);
-    }
-
+  desc = &state.vertices;
+  if (desc->data != NULL) {
     GL_SAFE_CALL(glEnableClientState(GL_VERTEX_ARRAY), ERROR);
-    GL_SAFE_CALL(glVertexPointer(desc.components, convertToGLEnum(TYPE_TABLE, desc.type), desc.stride, (desc.isVBO) ? 0 : desc.data), ERROR);
+    GL_SAFE_CALL(glVertexPointer(desc->components, convertToGLEnum(TYPE_TABLE, desc->type), desc->stride,
+      bindBufferSource(*desc)), ERROR);
   } else {
     GL_SAFE_CALL(glDisableClientState(GL_VERTEX_ARRAY), ERROR);
   }
 
   /* Texture coordinates */
-  desc = state.texCoords;
-  if (desc.data != NULL) {
-    if (desc.isVBO) {
-      VideoBuffer *buffer = (VideoBuffer*)desc.data;
-      GL_SAFE_CALL(VBOFunctions->glBindBuffer(GL_ARRAY_BUFFER, buffer->getHandle()), ERROR);
-    }
-
+  desc = &state.texCoords;
+  if (desc->data != NULL) {
     GL_SAFE_CALL(glEnableClientState(GL_TEXTURE_COORD_ARRAY), ERROR);
-    GL_SAFE_CALL(glTexCoordPointer(desc.components, convertToGLEnum(TYPE_TABLE, desc.type),
-      desc.stride, (desc.isVBO) ? 0 : desc.data), ERROR);
+    GL_SAFE_CALL(glTexCoordPointer(desc->components, convertToGLEnum(TYPE_TABLE, desc->type),
+      desc->stride, bindBufferSource(*desc)), ERROR);
   } else {
     GL_SAFE_CALL(glDisableClientState(GL_TEXTURE_COORD_ARRAY), ERROR);
   }
 
   /* Normals */
-  desc = state.normals;
-  if (desc.data != NULL) {
-    if (desc.isVBO) {
-      VideoBuffer *buffer = (VideoBuffer*)desc.data;
-      GL_SAFE_CALL(VBOFunctions->glBindBuffer(GL_ARRAY_BUFFER, buffer->getHandle()), ERROR);
-    }
-
+  desc = &state.normals;
+  if (desc->data != NULL) {
     GL_SAFE_CALL(glEnableClientState(GL_NORMAL_ARRAY), ERROR);
-    GL_SAFE_CALL(glNormalPointer(convertToGLEnum(TYPE_TABLE, desc.type), desc.stride, (desc.isVBO) ? 0 : desc.data), ERROR);
+    GL_SAFE_CALL(glNormalPointer(convertToGLEnum(TYPE_TABLE, desc->type), desc->stride,
+      bindBufferSource(*desc)), ERROR);
   } else {
     GL_SAFE_CALL(glDisableClientState(GL_NORMAL_ARRAY), ERROR);
   }
 
+  /* Colors */
+  desc = &state.colors;
+  if (desc->data != NULL) {
+    GL_SAFE_CALL(glEnableClientState(GL_COLOR_ARRAY), ERROR);
+    GL_SAFE_CALL(glColorPointer(desc->components, convertToGLEnum(TYPE_TABLE, desc->type), desc->stride,
+      bindBufferSource(*desc)), ERROR);
+  } else {
+    GL_SAFE_CALL(glDisableClientState(GL_COLOR_ARRAY), ERROR);
+  }
+
   GL_SAFE_CALL(VBOFunctions->glBindBuffer(GL_ARRAY_BUFFER, 0), ERROR);
 
   return OK;
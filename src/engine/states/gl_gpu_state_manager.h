@@ -58,6 +58,20 @@ private:
   */
   TextureSampler getTextureSampler(GLenum target);
 
+  /**
+      Fills source of the buffer data read from the pipeline.
+      @param desc - Buffer description with the pointer returned by OpenGL.
+      @param id - Video buffer bound to the array or 0.
+  */
+  void readBufferSource(BufferDesc &desc, GLint id);
+
+  /**
+      Binds video buffer of the array if it is used.
+      @param desc - Buffer description.
+      @return Pointer or offset which should be passed to gl*Pointer() functions.
+  */
+  const GLvoid *bindBufferSource(const BufferDesc &desc);
+
   /**
     Returns texture environment mode from the current texture slot.
     @return texture environment mode from the current texture slot.
@@ -163,6 +177,24 @@ private:
   */
   virtual Outcome writeViewportState(ViewportState state);
 
+  /* ********************************************** */
+  /*                Scissor functions               */
+  /* ********************************************** */
+
+  /**
+      Returns scissor test state of the pipeline.
+      @return ScissorState object that contains current scissor rectangle.
+  */
+  virtual ScissorState readScissorState();
+
+  /**
+      Sets scissor test state.
+      @param state - Scissor state to set.
+      @return OK if operation succeeded.
+      @return ERROR if error occurred in renderer.
+  */
+  virtual Outcome writeScissorState(ScissorState state);
+
   /* ********************************************** */
   /*                 Color functions                */
   /* ********************************************** */
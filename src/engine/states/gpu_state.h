@@ -5,6 +5,7 @@
 #define __VE_GPU_STATE_H__
 
 #include "engine/states/viewport_state.h"
+#include "engine/states/scissor_state.h"
 #include "engine/states/blend_state.h"
 #include "engine/states/color_state.h"
 #include "engine/states/alpha_test_state.h"
@@ -27,6 +28,11 @@ public:
   */
   ViewportState viewportState;
 
+  /**
+      Scissor test state.
+  */
+  ScissorState scissorState;
+
   /**
       Blending stage state.
   */
@@ -108,6 +108,25 @@ Outcome GPUStateDumper::dumpViewportState(ViewportState &viewportState, TextWrit
   return OK;
 }
 
+/**
+    Writes HTML tags for scissor test state.
+    @param scissorState - Scissor test state to dump.
+    @param writer - TextWriter to send data into.
+    @return OK if operation succeeded.
+    @return non-OK if fails.
+*/
+Outcome GPUStateDumper::dumpScissorState(ScissorState &scissorState, TextWriter *writer) {
+  writer->printf("<table border=\"1\" width=\"200\">");
+  writer->printf("<tr><td colspan=\"2\" bgcolor=#AAAAAA align=\"center\">Scissor test</td>");
+  writer->printf("<tr><td>Enabled</td><td align=\"center\">%s</td></tr>", (scissorState.isEnabled) ? "Yes" : "No");
+  writer->printf("<tr><td>X</td><td align=\"center\">%d</td></tr>", scissorState.x);
+  writer->printf("<tr><td>Y</td><td align=\"center\">%d</td></tr>", scissorState.y);
+  writer->printf("<tr><td>Width</td><td align=\"center\">%d</td></tr>", scissorState.width);
+  writer->printf("<tr><td>Height</td><td align=\"center\">%d</td></tr>", scissorState.height);
+  writer->printf("</table>");
+  return OK;
+}
+
 /**
     Writes HTML tags for blend stage state.
     @param blendState - Blend stage state to dump.
@@ -229,6 +248,8 @@ Outcome GPUStateDumper::dumpState(GPUState *state, OutputStream *stream) {
   ASSERT(dumpHeader(writer));
   ASSERT(dumpViewportState(state->viewportState, writer));
   writer->printf("<br>");
+  ASSERT(dumpScissorState(state->scissorState, writer));
+  writer->printf("<br>");
   ASSERT(dumpBlendState(state->blendState, writer));
   writer->printf("<br>");
   ASSERT(dumpColorState(state->colorState, writer));
@@ -41,6 +41,15 @@ protected:
   */
   Outcome dumpViewportState(ViewportState &viewportState, TextWriter *writer);
 
+  /**
+      Writes HTML tags for scissor test state.
+      @param scissorState - Scissor test state to dump.
+      @param writer - TextWriter to send data into.
+      @return OK if operation succeeded.
+      @return non-OK if fails.
+  */
+  Outcome dumpScissorState(ScissorState &scissorState, TextWriter *writer);
+
   /**
       Writes HTML tags for blend stage state.
       @param blendState - Blend stage state to dump.
@@ -19,6 +19,7 @@ GPUStateManager::GPUStateManager() {
 */
 void GPUStateManager::readState() {
   state.viewportState = readViewportState();
+  state.scissorState = readScissorState();
   state.colorState = readColorState();
   state.blendState = readBlendState();
   state.alphaTestState = readAlphaTestState();
@@ -35,6 +36,7 @@ void GPUStateManager::readState() {
 GPUState* GPUStateManager::getState() {
   GPUState *newState = new GPUState();
   newState->viewportState = getViewportState();
+  newState->scissorState = getScissorState();
   newState->colorState = getColorState();
   newState->blendState = getBlendState();
   newState->alphaTestState = getAlphaTestState();
@@ -87,6 +89,10 @@ void GPUStateManager::pushStates(ve::uint flags) {
     texturesStack.push(getTexturesState());
   }
 
+  if (flags & SCISSOR_STATE) {
+    scissorStack.push(getScissorState());
+  }
+
   /* Transform states */
   if (flags & VIEWPORT_STATE) {
     viewportStack.push(getViewportState());
@@ -142,6 +148,11 @@ void GPUStateManager::popStates(ve::uint flags) {
     texturesStack.pop();
   }
 
+  if (flags & SCISSOR_STATE) {
+    setScissorState(scissorStack.top());
+    scissorStack.pop();
+  }
+
   /* Transform states */
   if (flags & VIEWPORT_STATE) {
     setViewportState(viewportStack.top());
@@ -245,6 +256,29 @@ Outcome GPUStateManager::setViewportState(ViewportState state) {
   return writeViewportState(state);
 }
 
+/* ********************************************** */
+/*                Scissor functions               */
+/* ********************************************** */
+
+/**
+    Returns scissor test state of the pipeline.
+    @return ScissorState object that contains current scissor rectangle.
+*/
+ScissorState GPUStateManager::getScissorState() {
+  return state.scissorState;
+}
+
+/**
+    Sets scissor test state.
+    @param state - Scissor state to set.
+    @return OK if operation succeeded.
+    @return ERROR if error occurred in renderer.
+*/
+Outcome GPUStateManager::setScissorState(ScissorState state) {
+  this->state.scissorState = state;
+  return writeScissorState(state);
+}
+
 /* ********************************************** */
 /*                 Color functions                */
 /* ********************************************** */
@@ -34,8 +34,11 @@ enum PipelineState {
   /* Shaders */
   SHADERS_STATE = 256,
 
+  /* Rasterizer states */
+  SCISSOR_STATE = 512,
+
   /* Group of the states */
-  RASTERIZER_STATE = ALPHA_TEST_STATE | DEPTH_TEST_STATE | BLEND_STATE | COLOR_STATE | TEXTURES_STATE,
+  RASTERIZER_STATE = ALPHA_TEST_STATE | DEPTH_TEST_STATE | BLEND_STATE | COLOR_STATE | TEXTURES_STATE | SCISSOR_STATE,
   TRANSFORM_STATE = VIEWPORT_STATE | MATRIX_STATE,
   INPUT_ASSEMBLER_STATE = BUFFERS_STATE,
 
@@ -55,6 +58,7 @@ private:
   std::stack<DepthTestState> depthStack;
   std::stack<BlendState> blendStack;
   std::stack<ViewportState> viewportStack;
+  std::stack<ScissorState> scissorStack;
   std::stack<ColorState> colorStack;
   std::stack<MatrixState> matrixStack;
   std::stack<TexturesState> texturesStack;
@@ -145,6 +149,24 @@ protected:
   */
   virtual Outcome writeViewportState(ViewportState state) = 0;
 
+  /* ********************************************** */
+  /*                Scissor functions               */
+  /* ********************************************** */
+
+  /**
+      Returns scissor test state of the pipeline.
+      @return ScissorState object that contains current scissor rectangle.
+  */
+  virtual ScissorState readScissorState() = 0;
+
+  /**
+      Sets scissor test state.
+      @param state - Scissor state to set.
+      @return OK if operation succeeded.
+      @return ERROR if error occurred in renderer.
+  */
+  virtual Outcome writeScissorState(ScissorState state) = 0;
+
   /* ********************************************** */
   /*                 Color functions                */
   /* ********************************************** */
@@ -337,6 +359,24 @@ public:
   */
   virtual Outcome setViewportState(ViewportState state);
 
+  /* ********************************************** */
+  /*                Scissor functions               */
+  /* ********************************************** */
+
+  /**
+      Returns scissor test state of the pipeline.
+      @return ScissorState object that contains current scissor rectangle.
+  */
+  virtual ScissorState getScissorState();
+
+  /**
+      Sets scissor test state.
+      @param state - Scissor state to set.
+      @return OK if operation succeeded.
+      @return ERROR if error occurred in renderer.
+  */
+  virtual Outcome setScissorState(ScissorState state);
+
   /* ********************************************** */
   /*                 Color functions                */
   /* ********************************************** */
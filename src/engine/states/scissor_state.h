@@ -0,0 +1,50 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_SCISSOR_STATE_H__
+#define __VE_SCISSOR_STATE_H__
+
+namespace ve {
+
+/**
+    Represents scissor test state: pixels outside of the rectangle are not drawn.
+    Rectangle is set in window coordinates, (0, 0) is the left-bottom corner.
+*/
+struct ScissorState {
+  /**
+      'true' if test is enabled and 'false' if not.
+  */
+  bool isEnabled;
+
+  int x;
+  int y;
+  int width;
+  int height;
+
+  /**
+      Default constructor. Scissor test is disabled.
+  */
+  ScissorState() {
+    isEnabled = false;
+    x = y = width = height = 0;
+  }
+
+  /**
+      Scissor test is enabled for the given rectangle.
+      @param theX - X coordinate of the left-bottom corner of the rectangle.
+      @param theY - Y coordinate of the left-bottom corner of the rectangle.
+      @param theWidth - Width of the rectangle.
+      @param theHeight - Height of the rectangle.
+  */
+  ScissorState(int theX, int theY, int theWidth, int theHeight) {
+    isEnabled = true;
+    x = theX;
+    y = theY;
+    width = theWidth;
+    height = theHeight;
+  }
+};
+
+}
+
+#endif // __VE_SCISSOR_STATE_H__
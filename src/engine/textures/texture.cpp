@@ -16,9 +16,14 @@ Texture::Texture(Engine *engine, TextureDesc desc, Handle handle) {
   this->handle = handle;
   this->desc = desc;
   memset(&desc, 0, sizeof(desc));
+
+  // Register pointer in the memory manager
+  memoryHandle = REGISTER_POINTER(this);
 }
 
 Texture::~Texture() {
+  // Unregister pointer in the memory manager
+  UNREGISTER_POINTER(memoryHandle);
   engine->freeTexture(this);
 }
 
@@ -10,6 +10,7 @@ using namespace std;
 
 #include "engine/common.h"
 #include "engine/math/vector4f.h"
+#include "engine/tools/pool_allocator.h"
 
 namespace ve {
 
@@ -180,8 +181,11 @@ struct TextureEnvMode {
     stores texture and it used to bind it to the graphic pipeline.
 
     <b>Note:</b> Create Texture objects only through Engine::createTexture() function.
+
+    Objects are allocated from the pool of the class, so engine creates and
+    frees them without heap fragmentation.
 */
-class Texture {
+class Texture : public PooledObject<Texture> {
 protected:
   /** Engine that created this texture object. */
   Engine *engine;
@@ -193,6 +197,9 @@ private:
   /** Handle which is used in Engine class to store instance-specific data. */
   Handle handle;
 
+  /** Handle of the texture in the memory manager */
+  MemoryHandle memoryHandle;
+
 public:
   /**
       Texture constructor.
@@ -207,7 +214,8 @@ public:
   Texture(Engine *engine, TextureDesc desc, Handle handle);
 
   /**
-      Destructor. Frees allocated video memory using Engine::freeTexture() function.
+      Destructor. Frees allocated video memory using Engine::freeTexture() function
+      and unregisters the texture in the memory manager, so owner may delete it.
   */
   virtual ~Texture();
 
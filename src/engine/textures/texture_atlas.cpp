@@ -0,0 +1,103 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <string.h>
+
+#include "common.h"
+#include "textures/texture_atlas.h"
+#include "engines/engine.h"
+
+namespace ve {
+
+/* Images are separated by this number of pixels to avoid filtering artifacts */
+static const int ATLAS_PADDING = 1;
+
+/* Size of the white square */
+static const int WHITE_SIZE = 4;
+
+TextureAtlas::TextureAtlas(Engine *engine, int size) {
+  this->engine = engine;
+  this->size = size;
+  texture = NULL;
+  shelfX = 0;
+  shelfY = 0;
+  shelfHeight = 0;
+  changed = false;
+}
+
+TextureAtlas::~TextureAtlas() {
+  delete texture;
+}
+
+Outcome TextureAtlas::initialize() {
+  CHECK_POINTER(engine);
+  ERROR_IF(size < WHITE_SIZE, L"Atlas is too small", INVALID_VALUE);
+
+  pixels.assign(size * size * 4, 0);
+  texture = engine->createTexture(RGBA8, size, size, RGBA8, &pixels[0], false);
+  CHECK_POINTER(texture);
+
+  std::vector<uchar> white(WHITE_SIZE * WHITE_SIZE * 4, 255);
+  AtlasRegion region;
+  ASSERT(addImage(WHITE_SIZE, WHITE_SIZE, &white[0], region));
+
+  /* Solid geometry samples the middle of the square, so neighbours never leak in */
+  whiteRegion.u0 = whiteRegion.u1 = (region.u0 + region.u1) / 2;
+  whiteRegion.v0 = whiteRegion.v1 = (region.v0 + region.v1) / 2;
+
+  return update();
+}
+
+Outcome TextureAtlas::addImage(int width, int height, const uchar *data, AtlasRegion &region) {
+  CHECK_POINTER(data);
+  ERROR_IF(width <= 0 || height <= 0, L"Invalid image size", INVALID_VALUE);
+
+  if (shelfX + width > size) {
+    shelfX = 0;
+    shelfY += shelfHeight + ATLAS_PADDING;
+    shelfHeight = 0;
+  }
+
+  if (shelfX + width > size || shelfY + height > size) {
+    LOG_ERROR(L"There is no space in the atlas");
+    return OUT_OF_MEMORY;
+  }
+
+  for (int row = 0; row < height; row++) {
+    memcpy(&pixels[((shelfY + row) * size + shelfX) * 4], data + row * width * 4, width * 4);
+  }
+
+  region.u0 = (float)shelfX / size;
+  region.v0 = (float)shelfY / size;
+  region.u1 = (float)(shelfX + width) / size;
+  region.v1 = (float)(shelfY + height) / size;
+
+  shelfX += width + ATLAS_PADDING;
+  if (height > shelfHeight) {
+    shelfHeight = height;
+  }
+
+  changed = true;
+  return OK;
+}
+
+Outcome TextureAtlas::update() {
+  CHECK_POINTER(texture);
+
+  if (changed) {
+    ASSERT(engine->updateTexture(texture, RGBA8, &pixels[0]));
+    changed = false;
+  }
+
+  return OK;
+}
+
+const AtlasRegion &TextureAtlas::getWhiteRegion() const {
+  return whiteRegion;
+}
+
+Texture *TextureAtlas::getTexture() {
+  return texture;
+}
+
+}
@@ -0,0 +1,130 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_TEXTURE_ATLAS_H__
+#define __VE_TEXTURE_ATLAS_H__
+
+#include <vector>
+
+#include "engine/common.h"
+#include "engine/textures/texture.h"
+
+namespace ve {
+
+class Engine;
+
+/**
+    Place of an image in the atlas. Texture coordinates (u0, v0) correspond
+    to the first row and the first column of the image.
+*/
+struct AtlasRegion {
+  float u0;
+  float v0;
+  float u1;
+  float v1;
+
+  AtlasRegion() {
+    u0 = v0 = u1 = v1 = 0;
+  }
+};
+
+/**
+    TextureAtlas packs small RGBA8 images into one texture, so geometry which uses
+    different images may be rendered in one batch. Images are placed in rows
+    (shelves) and separated with one pixel of padding. Pixels are kept in system
+    memory and the texture is uploaded by update() once after a series of changes.
+
+    The first region of the atlas is a white square, it is used to render solid
+    geometry with the same texture as images.
+*/
+class TextureAtlas {
+private:
+  /** Engine which creates the texture */
+  Engine *engine;
+
+  /** Texture with the images */
+  Texture *texture;
+
+  /** Width and height of the texture */
+  int size;
+
+  /** Copy of texture pixels, four bytes per pixel */
+  std::vector<uchar> pixels;
+
+  /** Position of the free space in the current shelf */
+  int shelfX;
+  int shelfY;
+
+  /** Height of the highest image in the current shelf */
+  int shelfHeight;
+
+  /** Pixels were changed after the last upload */
+  bool changed;
+
+  /** Region with white pixels */
+  AtlasRegion whiteRegion;
+
+  /**
+      Private copy-constructor.
+  */
+  TextureAtlas(const TextureAtlas &ref);
+
+  /**
+      Private operator =
+  */
+  TextureAtlas &operator = (const TextureAtlas &ref);
+
+public:
+  /**
+      Constructor. Texture is created by initialize().
+      @param engine - Engine which creates the texture.
+      @param size - Width and height of the texture, it should be a power of two.
+  */
+  TextureAtlas(Engine *engine, int size = 512);
+
+  /**
+      Destructor. Frees the texture.
+  */
+  ~TextureAtlas();
+
+  /**
+      Creates the texture and reserves white region.
+      @return OK if texture was created.
+      @return non-OK if engine error occurred.
+  */
+  Outcome initialize();
+
+  /**
+      Copies image to the atlas.
+      @param width - Width of the image.
+      @param height - Height of the image.
+      @param data - RGBA8 pixels of the image, rows follow each other.
+      @param region - Place of the image in the atlas.
+      @return OK if image was added.
+      @return OUT_OF_MEMORY if there is no space for the image.
+  */
+  Outcome addImage(int width, int height, const uchar *data, AtlasRegion &region);
+
+  /**
+      Uploads changed pixels to the texture.
+      @return OK if texture is up-to-date.
+      @return non-OK if engine error occurred.
+  */
+  Outcome update();
+
+  /**
+      Returns region with white pixels.
+      @return Region to render solid geometry.
+  */
+  const AtlasRegion &getWhiteRegion() const;
+
+  /**
+      Returns texture of the atlas.
+      @return Texture or NULL if atlas is not initialized.
+  */
+  Texture *getTexture();
+};
+
+}
+
+#endif // __VE_TEXTURE_ATLAS_H__
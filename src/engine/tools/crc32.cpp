@@ -0,0 +1,329 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include "tools/crc32.h"
+#include "windows/atomic.h"
+
+/*
+  PCLMULQDQ path is compiled for x86 targets unless VE_NO_SIMD is defined. GCC
+  compiles it with a function target attribute, so the rest of the engine does
+  not require -mpclmul and the path is selected only if the processor has it.
+*/
+#if !defined(VE_NO_SIMD) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define VE_CRC32_PCLMUL
+#ifdef _MSC_VER
+#include <intrin.h>
+#define VE_TARGET_PCLMUL
+#else
+#include <cpuid.h>
+#define VE_TARGET_PCLMUL __attribute__((target("sse2,pclmul")))
+#endif // _MSC_VER
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#endif // VE_CRC32_PCLMUL
+
+namespace ve {
+
+/* Reflected polynomial of CRC32 */
+static const uint POLYNOMIAL = 0xedb88320;
+
+/* Number of tables for slicing-by-16, first 8 of them are used by slicing-by-8 */
+static const int TABLES_COUNT = 16;
+
+/* Minimal number of bytes which is folded with PCLMULQDQ */
+static const size_t FOLDING_MINIMUM = 64;
+
+/* tables[0] is the classic table, tables[k][i] is CRC of byte i followed by k zero bytes */
+static uint tables[TABLES_COUNT][256];
+
+/* Processor supports PCLMULQDQ */
+static bool pclmulSupported = false;
+
+/* Implementation used by CRC32::compute() */
+static CRC32Method selectedMethod = CRC32_SLICING_BY_16;
+
+/* States of the tables */
+enum {
+  TABLES_EMPTY = 0,
+  TABLES_BUILDING,
+  TABLES_READY
+};
+
+/* State of the tables, they are built by the first call which needs them */
+static volatile uint tablesState = TABLES_EMPTY;
+
+#ifdef VE_CRC32_PCLMUL
+static bool detectPCLMUL() {
+#ifdef _MSC_VER
+  int info[4];
+  __cpuid(info, 1);
+  return (info[2] & (1 << 1)) != 0;
+#else
+  unsigned int eax, ebx, ecx, edx;
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0) {
+    return false;
+  }
+  return (ecx & (1 << 1)) != 0;
+#endif // _MSC_VER
+}
+#endif // VE_CRC32_PCLMUL
+
+/*
+  Builds tables and selects implementation on the first call. The thread which
+  wins the state builds them, other threads wait, so any thread may compute CRC.
+*/
+static void initialize() {
+  if (tablesState == TABLES_READY) {
+    /* Tables are read after the state */
+    orderBarrier();
+    return;
+  }
+
+  if (compareAndSwap(&tablesState, TABLES_EMPTY, TABLES_BUILDING) != TABLES_EMPTY) {
+    while (tablesState != TABLES_READY) {
+      yieldThread();
+    }
+    orderBarrier();
+    return;
+  }
+
+  for (uint i = 0; i < 256; i++) {
+    uint crc = i;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (POLYNOMIAL & (0 - (crc & 1)));
+    }
+    tables[0][i] = crc;
+  }
+
+  for (uint i = 0; i < 256; i++) {
+    for (int k = 1; k < TABLES_COUNT; k++) {
+      tables[k][i] = (tables[k - 1][i] >> 8) ^ tables[0][tables[k - 1][i] & 0xff];
+    }
+  }
+
+#ifdef VE_CRC32_PCLMUL
+  pclmulSupported = detectPCLMUL();
+#endif // VE_CRC32_PCLMUL
+
+  selectedMethod = pclmulSupported ? CRC32_PCLMUL : CRC32_SLICING_BY_16;
+
+  /* Tables are written before the state */
+  memoryBarrier();
+  tablesState = TABLES_READY;
+}
+
+/* Reads little-endian 32-bit word, compilers merge it into one load on x86 */
+static inline uint readWord(const uchar *data) {
+  return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint)data[3] << 24);
+}
+
+/* All update functions take and return inverted CRC */
+static uint updateBytewise(uint crc, const uchar *data, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    crc = (crc >> 8) ^ tables[0][(crc ^ data[i]) & 0xff];
+  }
+  return crc;
+}
+
+static uint updateSlicingBy8(uint crc, const uchar *data, size_t size) {
+  while (size >= 8) {
+    uint one = readWord(data) ^ crc;
+    uint two = readWord(data + 4);
+    crc = tables[7][one & 0xff] ^ tables[6][(one >> 8) & 0xff] ^
+          tables[5][(one >> 16) & 0xff] ^ tables[4][one >> 24] ^
+          tables[3][two & 0xff] ^ tables[2][(two >> 8) & 0xff] ^
+          tables[1][(two >> 16) & 0xff] ^ tables[0][two >> 24];
+    data += 8;
+    size -= 8;
+  }
+
+  return updateBytewise(crc, data, size);
+}
+
+static uint updateSlicingBy16(uint crc, const uchar *data, size_t size) {
+  while (size >= 16) {
+    uint one = readWord(data) ^ crc;
+    uint two = readWord(data + 4);
+    uint three = readWord(data + 8);
+    uint four = readWord(data + 12);
+    crc = tables[15][one & 0xff] ^ tables[14][(one >> 8) & 0xff] ^
+          tables[13][(one >> 16) & 0xff] ^ tables[12][one >> 24] ^
+          tables[11][two & 0xff] ^ tables[10][(two >> 8) & 0xff] ^
+          tables[9][(two >> 16) & 0xff] ^ tables[8][two >> 24] ^
+          tables[7][three & 0xff] ^ tables[6][(three >> 8) & 0xff] ^
+          tables[5][(three >> 16) & 0xff] ^ tables[4][three >> 24] ^
+          tables[3][four & 0xff] ^ tables[2][(four >> 8) & 0xff] ^
+          tables[1][(four >> 16) & 0xff] ^ tables[0][four >> 24];
+    data += 16;
+    size -= 16;
+  }
+
+  return updateBytewise(crc, data, size);
+}
+
+#ifdef VE_CRC32_PCLMUL
+/*
+  Folds 64-byte blocks with carry-less multiplication and reduces the result with
+  Barrett reduction, see "Fast CRC Computation for Generic Polynomials Using
+  PCLMULQDQ Instruction" by Intel. Size must be at least 64 and a multiple of 16.
+  Constants are 64-bit values (x^n mod P, reflected) split into 32-bit halves.
+*/
+VE_TARGET_PCLMUL static uint foldPCLMUL(uint crc, const uchar *data, size_t size) {
+  const __m128i k1k2 = _mm_set_epi32(0x00000001, (int)0xc6e41596, 0x00000001, 0x54442bd4);
+  const __m128i k3k4 = _mm_set_epi32(0x00000000, (int)0xccaa009e, 0x00000001, 0x751997d0);
+  const __m128i k5 = _mm_set_epi32(0x00000000, 0x00000000, 0x00000001, 0x63cd6124);
+  const __m128i poly = _mm_set_epi32(0x00000001, (int)0xf7011641, 0x00000001, (int)0xdb710641);
+  const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+
+  __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+  x1 = _mm_loadu_si128((const __m128i*)(data));
+  x2 = _mm_loadu_si128((const __m128i*)(data + 16));
+  x3 = _mm_loadu_si128((const __m128i*)(data + 32));
+  x4 = _mm_loadu_si128((const __m128i*)(data + 48));
+  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+  data += 64;
+  size -= 64;
+
+  /* Four blocks are folded in parallel to hide latency of multiplication */
+  x0 = k1k2;
+  while (size >= 64) {
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+    x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+    x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+    x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i*)(data)));
+    x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i*)(data + 16)));
+    x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i*)(data + 32)));
+    x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i*)(data + 48)));
+
+    data += 64;
+    size -= 64;
+  }
+
+  /* Fold four blocks into one */
+  x0 = k3k4;
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+  /* Fold remaining 16-byte blocks */
+  while (size >= 16) {
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i*)data)), x5);
+    data += 16;
+    size -= 16;
+  }
+
+  /* Fold 128 bits to 64 bits */
+  x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_and_si128(x1, mask);
+  x1 = _mm_clmulepi64_si128(x1, k5, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  /* Barrett reduction to 32 bits */
+  x2 = _mm_and_si128(x1, mask);
+  x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+  x2 = _mm_and_si128(x2, mask);
+  x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  return (uint)_mm_cvtsi128_si32(_mm_srli_si128(x1, 4));
+}
+#endif // VE_CRC32_PCLMUL
+
+static uint updatePCLMUL(uint crc, const uchar *data, size_t size) {
+#ifdef VE_CRC32_PCLMUL
+  if (size >= FOLDING_MINIMUM) {
+    size_t folded = size & ~(size_t)15;
+    crc = foldPCLMUL(crc, data, folded);
+    data += folded;
+    size -= folded;
+  }
+#endif // VE_CRC32_PCLMUL
+
+  return updateSlicingBy16(crc, data, size);
+}
+
+CRC32::CRC32() {
+  reset();
+}
+
+void CRC32::reset() {
+  value = 0xffffffff;
+}
+
+void CRC32::update(const void *data, size_t size) {
+  value = ~compute(data, size, ~value);
+}
+
+uint CRC32::getValue() {
+  return ~value;
+}
+
+uint CRC32::compute(const void *data, size_t size, uint crc) {
+  initialize();
+  return compute(selectedMethod, data, size, crc);
+}
+
+uint CRC32::compute(CRC32Method method, const void *data, size_t size, uint crc) {
+  initialize();
+  const uchar *bytes = (const uchar*)data;
+  crc = ~crc;
+
+  switch (method) {
+  case CRC32_BYTEWISE:
+    crc = updateBytewise(crc, bytes, size);
+    break;
+
+  case CRC32_SLICING_BY_8:
+    crc = updateSlicingBy8(crc, bytes, size);
+    break;
+
+  case CRC32_SLICING_BY_16:
+    crc = updateSlicingBy16(crc, bytes, size);
+    break;
+
+  case CRC32_PCLMUL:
+    if (!pclmulSupported) {
+      return 0;
+    }
+    crc = updatePCLMUL(crc, bytes, size);
+    break;
+
+  default:
+    return 0;
+  }
+
+  return ~crc;
+}
+
+bool CRC32::isSupported(CRC32Method method) {
+  initialize();
+  return method != CRC32_PCLMUL || pclmulSupported;
+}
+
+CRC32Method CRC32::getMethod() {
+  initialize();
+  return selectedMethod;
+}
+
+}
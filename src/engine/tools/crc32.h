@@ -0,0 +1,97 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_CRC32_H__
+#define __VE_CRC32_H__
+
+#include "common.h"
+
+namespace ve {
+
+/**
+    Implementations of CRC32, the fastest supported one is selected on first use.
+*/
+enum CRC32Method {
+  CRC32_BYTEWISE = 0,   /*!< One table lookup per byte.                                       */
+  CRC32_SLICING_BY_8,   /*!< Eight tables, 8 bytes per iteration.                             */
+  CRC32_SLICING_BY_16,  /*!< Sixteen tables, 16 bytes per iteration.                          */
+  CRC32_PCLMUL          /*!< Carry-less multiplication folding of 64-byte blocks (x86 only).  */
+};
+
+/**
+    Computes CRC32 with the polynomial of zlib, PNG and ZIP (0xEDB88320 reflected).
+    The checksum may be computed at once or updated with consecutive parts of
+    the data:
+
+      uint crc = CRC32::compute(header, headerSize);
+      crc = CRC32::compute(body, bodySize, crc);
+
+    or with an instance which keeps the running value.
+
+    Note that the crc32 instruction of SSE4.2 computes CRC32C (Castagnoli
+    polynomial) and can not be used for this checksum, the accelerated path
+    folds data with PCLMULQDQ instead. It is used when the processor supports
+    it, otherwise slicing-by-16 is used.
+*/
+class CRC32 {
+private:
+  /** Running value, already inverted */
+  uint value;
+
+public:
+  /**
+      Creates checksum of empty data.
+  */
+  CRC32();
+
+  /**
+      Resets checksum to the value of empty data.
+  */
+  void reset();
+
+  /**
+      Appends data to the checksum.
+      @param data - Data to append.
+      @param size - Size of the data in bytes.
+  */
+  void update(const void *data, size_t size);
+
+  /**
+      Returns checksum of all data appended since creation or reset.
+      @return CRC32 of the data.
+  */
+  uint getValue();
+
+  /**
+      Computes checksum of the data.
+      @param data - Data.
+      @param size - Size of the data in bytes.
+      @param crc - Checksum of the preceding data, 0 if the data is the first part.
+      @return CRC32 of the preceding and this data.
+  */
+  static uint compute(const void *data, size_t size, uint crc = 0);
+
+  /**
+      Computes checksum with the given implementation, it is used for testing
+      and benchmarks.
+      @return CRC32 of the data or 0 if method is not supported.
+  */
+  static uint compute(CRC32Method method, const void *data, size_t size, uint crc = 0);
+
+  /**
+      Checks if implementation can be used on this machine.
+      @param method - Implementation.
+      @return true if implementation is supported.
+  */
+  static bool isSupported(CRC32Method method);
+
+  /**
+      Returns implementation used by compute().
+      @return Selected implementation.
+  */
+  static CRC32Method getMethod();
+};
+
+}
+
+#endif // __VE_CRC32_H__
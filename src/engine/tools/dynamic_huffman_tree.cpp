@@ -59,7 +59,7 @@ int DynamicHuffmanTree::getLength(uint symbol) {
     @return INVALID_VALUE if at least any symbol is out of bounds.
 */
 Outcome DynamicHuffmanTree::fill(uint startSymbol, uint count, uint length) {
-  ERROR_IF(startSymbol + count - 1 > lengths.size(), L"Too many symbols", INVALID_VALUE);
+  ERROR_IF(startSymbol + count > lengths.size(), L"Too many symbols", INVALID_VALUE);
 
   for (uint i = 0; i < count; i++) {
     lengths[startSymbol + i] = length;
@@ -174,6 +174,11 @@ Outcome DynamicHuffmanTree::setCode(uint symbol, uint code) {
     @return -1 if there is no symbol with such code and bit length.
 */
 int DynamicHuffmanTree::exists(uint code, uint length) {
+  /* Codes longer than the longest code of the tree do not exist */
+  if (length >= lengthToCode.size()) {
+    return -1;
+  }
+
   uint len = lengthToCode[length].size();
 
   for (uint i = 0; i < len; i++) {
@@ -0,0 +1,130 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include "common.h"
+#include "tools/frame_allocator.h"
+
+namespace ve {
+
+FrameAllocator::FrameAllocator(size_t chunkSize) {
+  this->chunkSize = chunkSize > 0 ? chunkSize : 1;
+  active = 0;
+  frameSize = 0;
+  highWaterMark = 0;
+
+  for (int i = 0; i < 2; i++) {
+    arenas[i].chunk = 0;
+    arenas[i].offset = 0;
+    arenas[i].used = 0;
+  }
+}
+
+FrameAllocator::~FrameAllocator() {
+  release(arenas[0]);
+  release(arenas[1]);
+}
+
+void FrameAllocator::release(Arena &arena) {
+  for (uint i = 0; i < arena.chunks.size(); i++) {
+    ::operator delete(arena.chunks[i]);
+  }
+
+  arena.chunks.clear();
+  arena.sizes.clear();
+  arena.chunk = 0;
+  arena.offset = 0;
+  arena.used = 0;
+}
+
+void FrameAllocator::reset(Arena &arena) {
+  if (arena.chunks.size() > 1) {
+    // The frame did not fit into one chunk, so the next one gets single chunk of the same total size
+    size_t total = 0;
+    for (uint i = 0; i < arena.sizes.size(); i++) {
+      total += arena.sizes[i];
+    }
+
+    release(arena);
+    char *chunk = static_cast<char *>(::operator new(total, std::nothrow));
+    if (chunk != NULL) {
+      arena.chunks.push_back(chunk);
+      arena.sizes.push_back(total);
+    }
+  }
+
+  arena.chunk = 0;
+  arena.offset = 0;
+  arena.used = 0;
+}
+
+void *FrameAllocator::allocate(size_t size, size_t alignment) {
+  Arena &arena = arenas[active];
+
+  while (arena.chunk < arena.chunks.size()) {
+    size_t address = reinterpret_cast<size_t>(arena.chunks[arena.chunk]) + arena.offset;
+    size_t padding = (alignment - address % alignment) % alignment;
+
+    if (arena.offset + padding + size <= arena.sizes[arena.chunk]) {
+      arena.offset += padding + size;
+      arena.used += padding + size;
+      return reinterpret_cast<void *>(address + padding);
+    }
+
+    if (arena.chunk + 1 == arena.chunks.size()) {
+      break;
+    }
+
+    arena.chunk++;
+    arena.offset = 0;
+  }
+
+  size_t newSize = size + alignment > chunkSize ? size + alignment : chunkSize;
+  char *chunk = static_cast<char *>(::operator new(newSize, std::nothrow));
+  if (chunk == NULL) {
+    LOG_ERROR(L"Out of memory for frame allocator");
+    return NULL;
+  }
+
+  arena.chunks.push_back(chunk);
+  arena.sizes.push_back(newSize);
+  arena.chunk = (uint)arena.chunks.size() - 1;
+  arena.offset = 0;
+  return allocate(size, alignment);
+}
+
+void FrameAllocator::swap() {
+  frameSize = arenas[active].used;
+  if (frameSize > highWaterMark) {
+    highWaterMark = frameSize;
+  }
+
+  // Memory of the previous frame is not used anymore
+  active = 1 - active;
+  reset(arenas[active]);
+}
+
+size_t FrameAllocator::getUsedSize() const {
+  return arenas[active].used;
+}
+
+size_t FrameAllocator::getFrameSize() const {
+  return frameSize;
+}
+
+size_t FrameAllocator::getHighWaterMark() const {
+  return highWaterMark;
+}
+
+size_t FrameAllocator::getCapacity() const {
+  size_t total = 0;
+
+  for (int i = 0; i < 2; i++) {
+    for (uint j = 0; j < arenas[i].sizes.size(); j++) {
+      total += arenas[i].sizes[j];
+    }
+  }
+
+  return total;
+}
+
+}
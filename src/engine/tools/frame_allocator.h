@@ -0,0 +1,233 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_FRAME_ALLOCATOR_H__
+#define __VE_FRAME_ALLOCATOR_H__
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "engine/types.h"
+
+namespace ve {
+
+/**
+    Linear allocator for temporary data of a frame: events, vertex arrays, lists of
+    visible objects, etc. Allocation only moves the pointer in the current chunk and
+    nothing is freed separately: the whole memory of a frame is reused at once.
+
+    Allocator is double-buffered: swap() is called by the engine when frame buffers
+    are swapped, and memory allocated during a frame stays valid during the next
+    frame too, so data may be passed from one frame to another. Destructors of
+    objects are not called, so only objects which do not own resources should be
+    created in frame memory. Allocator is not thread-safe and is used on the render
+    thread only.
+
+    Example:
+    @code
+    ActionEvent *event = new (engine->getFrameAllocator()) ActionEvent(BUTTON_PRESS, this);
+    std::vector<float, FrameStlAllocator<float> > vertices(FrameStlAllocator<float>(&engine->getFrameAllocator()));
+    @endcode
+*/
+class FrameAllocator {
+private:
+  /**
+      Memory of one frame. It grows with new chunks when the frame needs
+      more memory and chunks are merged into one on reset.
+  */
+  struct Arena {
+    std::vector<char *> chunks;
+    std::vector<size_t> sizes;
+    /** Index of the chunk which is used now */
+    uint chunk;
+    /** Offset of the free memory in the current chunk */
+    size_t offset;
+    /** Number of bytes allocated in this frame including alignment */
+    size_t used;
+  };
+
+  /** Arenas of the current and the previous frame */
+  Arena arenas[2];
+
+  /** Index of the arena of the current frame */
+  uint active;
+
+  /** Minimal size of chunks */
+  size_t chunkSize;
+
+  /** Number of bytes used by the last finished frame */
+  size_t frameSize;
+
+  /** The largest number of bytes used by one frame */
+  size_t highWaterMark;
+
+  /**
+      Frees chunks of the arena. If arena had several chunks, one chunk of
+      their total size is allocated instead, so the next frames fit into it.
+  */
+  void reset(Arena &arena);
+
+  /**
+      Frees all chunks of the arena.
+  */
+  void release(Arena &arena);
+
+  /**
+      Private copy-constructor.
+  */
+  FrameAllocator(const FrameAllocator &ref);
+
+  /**
+      Private operator =
+  */
+  FrameAllocator &operator = (const FrameAllocator &ref);
+
+public:
+  /**
+      Constructor. Memory is allocated on the first request.
+      @param chunkSize - Minimal size of memory chunks in bytes.
+  */
+  FrameAllocator(size_t chunkSize = 256 * 1024);
+
+  /**
+      Destructor. Frees memory of both frames.
+  */
+  ~FrameAllocator();
+
+  /**
+      Allocates memory which is valid until the end of the next frame.
+      @param size - Size in bytes.
+      @param alignment - Alignment in bytes, it must be a power of two.
+      @return Pointer to memory or NULL if system is out of memory.
+  */
+  void *allocate(size_t size, size_t alignment = 16);
+
+  /**
+      Finishes the current frame: memory of the previous frame is reused for
+      the next one. Engine calls it in onSwapBuffers().
+  */
+  void swap();
+
+  /**
+      Returns number of bytes allocated in the current frame.
+      @return Number of bytes including alignment.
+  */
+  size_t getUsedSize() const;
+
+  /**
+      Returns number of bytes allocated in the last finished frame.
+      @return Number of bytes including alignment.
+  */
+  size_t getFrameSize() const;
+
+  /**
+      Returns the largest number of bytes allocated in one frame.
+      @return High-water mark in bytes.
+  */
+  size_t getHighWaterMark() const;
+
+  /**
+      Returns size of memory reserved for both frames.
+      @return Number of bytes in all chunks.
+  */
+  size_t getCapacity() const;
+};
+
+/**
+    Allocator for STL containers which takes memory from FrameAllocator.
+    Memory is not freed when container releases it, so containers which grow
+    a lot should reserve memory in advance.
+*/
+template <class T>
+class FrameStlAllocator {
+public:
+  typedef T value_type;
+  typedef T *pointer;
+  typedef const T *const_pointer;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+  template <class U>
+  struct rebind {
+    typedef FrameStlAllocator<U> other;
+  };
+
+  /** Frame allocator which provides memory */
+  FrameAllocator *allocator;
+
+  /**
+      Constructor.
+      @param allocator - Frame allocator which provides memory.
+  */
+  explicit FrameStlAllocator(FrameAllocator *allocator) : allocator(allocator) {
+  }
+
+  template <class U>
+  FrameStlAllocator(const FrameStlAllocator<U> &other) : allocator(other.allocator) {
+  }
+
+  pointer address(reference value) const {
+    return &value;
+  }
+
+  const_pointer address(const_reference value) const {
+    return &value;
+  }
+
+  pointer allocate(size_type count, const void * = 0) {
+    void *memory = allocator->allocate(count * sizeof(T));
+    if (memory == NULL) {
+      throw std::bad_alloc();
+    }
+    return static_cast<pointer>(memory);
+  }
+
+  void deallocate(pointer, size_type) {
+  }
+
+  size_type max_size() const {
+    return ((size_type)-1) / sizeof(T);
+  }
+
+  void construct(pointer place, const T &value) {
+    new (place) T(value);
+  }
+
+  void destroy(pointer place) {
+    place->~T();
+  }
+
+  template <class U>
+  bool operator == (const FrameStlAllocator<U> &other) const {
+    return allocator == other.allocator;
+  }
+
+  template <class U>
+  bool operator != (const FrameStlAllocator<U> &other) const {
+    return allocator != other.allocator;
+  }
+};
+
+}
+
+/**
+    Creates object in frame memory: new (allocator) Type(arguments).
+*/
+inline void *operator new(size_t size, ve::FrameAllocator &allocator) {
+  void *memory = allocator.allocate(size);
+  if (memory == NULL) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+/**
+    Called only if constructor of the object in frame memory throws, memory is reused with the frame.
+*/
+inline void operator delete(void *, ve::FrameAllocator &) {
+}
+
+#endif // __VE_FRAME_ALLOCATOR_H__
@@ -0,0 +1,207 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_HASH_MAP_H__
+#define __VE_HASH_MAP_H__
+
+#include <cstddef>
+#include <vector>
+
+#include "engine/types.h"
+
+namespace ve {
+
+/**
+    Mixes bits of the integer value, so close values are spread over the table.
+    @param value - Value to hash.
+    @return Hash value.
+*/
+inline uint hashInteger(unsigned long long value) {
+  value ^= value >> 33;
+  value *= 0xFF51AFD7ED558CCDULL;
+  value ^= value >> 33;
+  value *= 0xC4CEB9FE1A85EC53ULL;
+  value ^= value >> 33;
+  return (uint)value;
+}
+
+/**
+    Hash function for integer keys.
+*/
+template <class Key>
+struct HashFunction {
+  uint operator () (const Key &key) const {
+    return hashInteger((unsigned long long)key);
+  }
+};
+
+/**
+    Hash function for pointer keys.
+*/
+template <class Key>
+struct HashFunction<Key *> {
+  uint operator () (Key *key) const {
+    return hashInteger((unsigned long long)reinterpret_cast<size_t>(key));
+  }
+};
+
+/**
+    Hash table with open addressing and linear probing. Entries lie in one array
+    which is at most half full, so lookups usually touch one cache line. Removal
+    shifts following entries back instead of leaving tombstones. Key and Value
+    must be default-constructible and copyable.
+
+    Pointers returned by find() are invalidated by insert() and remove().
+*/
+template <class Key, class Value, class Hash = HashFunction<Key> >
+class HashMap {
+private:
+  struct Entry {
+    Key key;
+    Value value;
+    bool used;
+
+    Entry() : key(), value(), used(false) {
+    }
+  };
+
+  /** Table, its size is a power of two */
+  std::vector<Entry> entries;
+
+  /** Number of used entries */
+  uint count;
+
+  /** Hash function object */
+  Hash hash;
+
+  /**
+      Returns index of the entry with the key or of the free entry where it should be.
+  */
+  uint getIndex(const Key &key) const {
+    uint mask = (uint)entries.size() - 1;
+    uint index = hash(key) & mask;
+
+    while (entries[index].used && !(entries[index].key == key)) {
+      index = (index + 1) & mask;
+    }
+
+    return index;
+  }
+
+  /**
+      Doubles size of the table and inserts entries again.
+  */
+  void grow() {
+    std::vector<Entry> old(entries.size() * 2);
+    old.swap(entries);
+
+    for (uint i = 0; i < old.size(); i++) {
+      if (old[i].used) {
+        entries[getIndex(old[i].key)] = old[i];
+      }
+    }
+  }
+
+public:
+  /**
+      Constructor.
+      @param capacity - Expected number of entries.
+  */
+  explicit HashMap(uint capacity = 8) {
+    uint size = 16;
+    while (size < capacity * 2) {
+      size *= 2;
+    }
+
+    entries.resize(size);
+    count = 0;
+  }
+
+  /**
+      Inserts entry or replaces value of the existing one.
+      @param key - Key of the entry.
+      @param value - Value of the entry.
+  */
+  void insert(const Key &key, const Value &value) {
+    if ((count + 1) * 2 > entries.size()) {
+      grow();
+    }
+
+    Entry &entry = entries[getIndex(key)];
+    if (!entry.used) {
+      entry.key = key;
+      entry.used = true;
+      count++;
+    }
+    entry.value = value;
+  }
+
+  /**
+      Finds value by the key.
+      @param key - Key of the entry.
+      @return Pointer to the value or NULL if there is no such key.
+  */
+  Value *find(const Key &key) {
+    Entry &entry = entries[getIndex(key)];
+    return entry.used ? &entry.value : NULL;
+  }
+
+  /**
+      Finds value by the key.
+      @param key - Key of the entry.
+      @return Pointer to the value or NULL if there is no such key.
+  */
+  const Value *find(const Key &key) const {
+    const Entry &entry = entries[getIndex(key)];
+    return entry.used ? &entry.value : NULL;
+  }
+
+  /**
+      Removes entry.
+      @param key - Key of the entry.
+      @return 'true' if entry was removed.
+      @return 'false' if there is no such key.
+  */
+  bool remove(const Key &key) {
+    uint mask = (uint)entries.size() - 1;
+    uint hole = getIndex(key);
+    if (!entries[hole].used) {
+      return false;
+    }
+
+    // Entries after the hole move back if the hole lies between their home slot and them
+    for (uint i = (hole + 1) & mask; entries[i].used; i = (i + 1) & mask) {
+      uint home = hash(entries[i].key) & mask;
+      if (((i - home) & mask) >= ((i - hole) & mask)) {
+        entries[hole] = entries[i];
+        hole = i;
+      }
+    }
+
+    entries[hole] = Entry();
+    count--;
+    return true;
+  }
+
+  /**
+      Removes all entries, memory of the table is kept.
+  */
+  void clear() {
+    for (uint i = 0; i < entries.size(); i++) {
+      entries[i] = Entry();
+    }
+    count = 0;
+  }
+
+  /**
+      Returns number of entries.
+      @return Number of keys in the map.
+  */
+  uint getCount() const {
+    return count;
+  }
+};
+
+}
+
+#endif // __VE_HASH_MAP_H__
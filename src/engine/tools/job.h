@@ -0,0 +1,82 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_JOB_H__
+#define __VE_JOB_H__
+
+#include "common.h"
+
+namespace ve {
+
+class JobCounter;
+
+/** Function of a job */
+typedef void (*JobFunction)(void *data);
+
+/**
+    Job which is executed by JobSystem. Job is copied into queues, so data
+    must stay alive until the job is finished.
+*/
+struct Job {
+  /** Function which is called */
+  JobFunction function;
+
+  /** Parameter of the function */
+  void *data;
+
+  /** Counter which is decremented when the job is finished or NULL */
+  JobCounter *counter;
+};
+
+/**
+    Counter of unfinished jobs. It is incremented when a job is run with the
+    counter and decremented when the job is finished, so zero means all jobs
+    are done. Jobs may be run after a counter becomes zero, see
+    JobSystem::runAfter(), such a counter must live until they are started.
+    A counter may be reused when it is zero.
+*/
+class JobCounter {
+private:
+  friend class JobSystem;
+
+  /** Number of unfinished jobs */
+  volatile uint value;
+
+  /**
+      Private copy-constructor.
+  */
+  JobCounter(const JobCounter &ref);
+
+  /**
+      Private operator =
+  */
+  JobCounter &operator = (const JobCounter &ref);
+
+public:
+  /**
+      Constructor.
+  */
+  JobCounter() {
+    value = 0;
+  }
+
+  /**
+      Returns number of unfinished jobs.
+      @return Number of jobs.
+  */
+  uint getValue() {
+    return value;
+  }
+
+  /**
+      Checks if all jobs are finished.
+      @return 'true' if counter is zero.
+  */
+  bool isDone() {
+    return value == 0;
+  }
+};
+
+}
+
+#endif // __VE_JOB_H__
@@ -0,0 +1,438 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifdef VE_LINUX
+#include <unistd.h>
+#endif // VE_LINUX
+
+#include "common.h"
+#include "tools/job_system.h"
+#include "tools/work_stealing_deque.h"
+#include "windows/atomic.h"
+#include "windows/critical_section.h"
+#include "windows/semaphore.h"
+#include "windows/thread_factory.h"
+
+#ifdef VE_WINDOWS
+#define VE_THREAD_LOCAL __declspec(thread)
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+#define VE_THREAD_LOCAL __thread
+#endif // VE_LINUX
+
+namespace ve {
+
+/* Number of failed attempts to take a job before a thread yields, workers sleep after twice as many */
+static const uint SPIN_COUNT = 32;
+
+/* Number of chunks of parallelFor() per thread when grain size is not given */
+static const uint CHUNKS_PER_THREAD = 4;
+
+/* Worker of the calling thread, type of the worker is private */
+static VE_THREAD_LOCAL void *currentWorker = NULL;
+
+/* Chunk of parallelFor() */
+struct ParallelForChunk {
+  ParallelForFunction function;
+  void *data;
+  uint begin;
+  uint end;
+};
+
+JobSystem::JobSystem(uint workersCount, uint dequeCapacity) {
+  /* On a single processor the main thread executes all jobs in wait() */
+  if (workersCount == 0) {
+    uint processors = getProcessorsCount();
+    workersCount = processors > 1 ? processors - 1 : 0;
+  }
+
+  this->workersCount = workersCount;
+  this->dequeCapacity = dequeCapacity != 0 ? dequeCapacity : 1;
+
+  /* The last worker is the main thread */
+  for (uint i = 0; i <= workersCount; i++) {
+    Worker *worker = new Worker();
+    worker->system = this;
+    worker->deque = new WorkStealingDeque(this->dequeCapacity);
+    worker->seed = 2463534242u + i * 7919;
+    workers.push_back(worker);
+  }
+
+  lock = new CriticalSection();
+  injectedCount = 0;
+  continuationsCount = 0;
+  sleepingCount = 0;
+  running = 0;
+  activeThreads = 0;
+  wakeupSemaphore = new Semaphore();
+}
+
+JobSystem::~JobSystem() {
+  stop();
+
+  for (size_t i = 0; i < workers.size(); i++) {
+    delete workers[i]->deque;
+    delete workers[i];
+  }
+
+  delete wakeupSemaphore;
+  delete lock;
+}
+
+Outcome JobSystem::start() {
+  if (running) {
+    return OK;
+  }
+
+  running = 1;
+  currentWorker = workers[workersCount];
+  activeThreads = workersCount;
+  memoryBarrier();
+
+  for (uint i = 0; i < workersCount; i++) {
+    if (ThreadFactory::getInstance()->spawn(workerEntry, workers[i]) != OK) {
+      /* Threads which were started are stopped, others are not counted */
+      for (uint j = i; j < workersCount; j++) {
+        atomicDecrement(&activeThreads);
+      }
+      stop();
+      return ERROR;
+    }
+  }
+
+  return OK;
+}
+
+void JobSystem::stop() {
+  if (!running) {
+    return;
+  }
+
+  running = 0;
+  memoryBarrier();
+
+  wakeupSemaphore->post(workersCount);
+
+  /* Threads can not be joined, so their counter is awaited */
+  while (activeThreads != 0) {
+    yieldThread();
+  }
+
+  if (currentWorker == workers[workersCount]) {
+    currentWorker = NULL;
+  }
+
+  Job job;
+  for (size_t i = 0; i < workers.size(); i++) {
+    while (!workers[i]->deque->isEmpty()) {
+      workers[i]->deque->steal(job);
+    }
+  }
+
+  lock->lock();
+  injected.clear();
+  injectedCount = 0;
+  continuations.clear();
+  continuationsCount = 0;
+  lock->unlock();
+
+  /* Wakeups which were not consumed */
+  while (wakeupSemaphore->tryWait()) {
+  }
+}
+
+void JobSystem::run(JobFunction function, void *data, JobCounter *counter) {
+  if (counter != NULL) {
+    atomicAdd(&counter->value, 1);
+  }
+
+  Job job;
+  job.function = function;
+  job.data = data;
+  job.counter = counter;
+
+  submit(getCurrentWorker(), job);
+  wakeUp(1);
+}
+
+void JobSystem::run(const Job *jobs, uint count, JobCounter *counter) {
+  if (count == 0) {
+    return;
+  }
+
+  if (counter != NULL) {
+    atomicAdd(&counter->value, count);
+  }
+
+  Worker *worker = getCurrentWorker();
+  for (uint i = 0; i < count; i++) {
+    Job job = jobs[i];
+    job.counter = counter;
+    submit(worker, job);
+  }
+
+  wakeUp(count);
+}
+
+void JobSystem::runAfter(JobCounter *dependency, JobFunction function, void *data, JobCounter *counter) {
+  if (counter != NULL) {
+    atomicAdd(&counter->value, 1);
+  }
+
+  Continuation continuation;
+  continuation.dependency = dependency;
+  continuation.job.function = function;
+  continuation.job.data = data;
+  continuation.job.counter = counter;
+
+  /* Count is published before the dependency is checked, so the job which zeroes it sees the continuation */
+  lock->lock();
+  atomicAdd(&continuationsCount, 1);
+  if (dependency->value != 0) {
+    continuations.push_back(continuation);
+    lock->unlock();
+    return;
+  }
+  atomicDecrement(&continuationsCount);
+  lock->unlock();
+
+  submit(getCurrentWorker(), continuation.job);
+  wakeUp(1);
+}
+
+void JobSystem::wait(JobCounter *counter) {
+  Worker *worker = getCurrentWorker();
+  uint idle = 0;
+
+  while (counter->value != 0) {
+    Job job;
+    if (takeJob(worker, job)) {
+      execute(job);
+      idle = 0;
+    } else if (++idle > SPIN_COUNT) {
+      yieldThread();
+    }
+  }
+
+  /* Continuations may not refer to the counter when the caller destroys it */
+  if (continuationsCount != 0) {
+    runContinuations();
+  }
+  memoryBarrier();
+}
+
+void JobSystem::parallelFor(uint begin, uint end, ParallelForFunction function, void *data, uint grainSize) {
+  if (begin >= end) {
+    return;
+  }
+
+  uint count = end - begin;
+  if (grainSize == 0) {
+    grainSize = count / ((workersCount + 1) * CHUNKS_PER_THREAD);
+    if (grainSize == 0) {
+      grainSize = 1;
+    }
+  }
+
+  if (grainSize >= count) {
+    function(begin, end, data);
+    return;
+  }
+
+  uint chunksCount = (count + grainSize - 1) / grainSize;
+  std::vector<ParallelForChunk> chunks(chunksCount);
+  std::vector<Job> jobs(chunksCount);
+
+  for (uint i = 0; i < chunksCount; i++) {
+    chunks[i].function = function;
+    chunks[i].data = data;
+    chunks[i].begin = begin + i * grainSize;
+    chunks[i].end = i + 1 < chunksCount ? chunks[i].begin + grainSize : end;
+    jobs[i].function = parallelForEntry;
+    jobs[i].data = &chunks[i];
+  }
+
+  JobCounter counter;
+  run(&jobs[0], chunksCount, &counter);
+  wait(&counter);
+}
+
+uint JobSystem::getWorkersCount() {
+  return workersCount;
+}
+
+uint JobSystem::getProcessorsCount() {
+#ifdef VE_WINDOWS
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+  return count > 0 ? (uint)count : 1;
+#endif // VE_LINUX
+}
+
+unsigned long JobSystem::workerEntry(void *parameter) {
+  Worker *worker = (Worker*)parameter;
+  worker->system->runWorker(worker);
+  return 0;
+}
+
+void JobSystem::runWorker(Worker *worker) {
+  currentWorker = worker;
+  uint idle = 0;
+
+  while (running) {
+    Job job;
+    if (takeJob(worker, job)) {
+      execute(job);
+      idle = 0;
+      continue;
+    }
+
+    if (++idle < SPIN_COUNT) {
+      continue;
+    } else if (idle < SPIN_COUNT * 2) {
+      yieldThread();
+      continue;
+    }
+
+    /* Jobs are checked after the sleeper is counted, threads which add jobs check the counter after adding */
+    atomicAdd(&sleepingCount, 1);
+    if (running && !hasJobs()) {
+      wakeupSemaphore->wait();
+    }
+    atomicDecrement(&sleepingCount);
+    idle = 0;
+  }
+
+  currentWorker = NULL;
+  memoryBarrier();
+  atomicDecrement(&activeThreads);
+}
+
+JobSystem::Worker *JobSystem::getCurrentWorker() {
+  Worker *worker = (Worker*)currentWorker;
+  return worker != NULL && worker->system == this ? worker : NULL;
+}
+
+bool JobSystem::takeJob(Worker *worker, Job &job) {
+  if (worker != NULL && worker->deque->pop(job)) {
+    return true;
+  }
+
+  /* Victims are tried from a random one, so thieves do not crowd at the same deque */
+  uint count = (uint)workers.size();
+  uint first = 0;
+  if (worker != NULL) {
+    worker->seed ^= worker->seed << 13;
+    worker->seed ^= worker->seed >> 17;
+    worker->seed ^= worker->seed << 5;
+    first = worker->seed % count;
+  }
+
+  for (uint i = 0; i < count; i++) {
+    Worker *victim = workers[(first + i) % count];
+    if (victim != worker && victim->deque->steal(job)) {
+      return true;
+    }
+  }
+
+  if (injectedCount != 0) {
+    lock->lock();
+    if (!injected.empty()) {
+      job = injected.front();
+      injected.pop_front();
+      injectedCount = (uint)injected.size();
+      lock->unlock();
+      return true;
+    }
+    lock->unlock();
+  }
+
+  return false;
+}
+
+bool JobSystem::hasJobs() {
+  if (injectedCount != 0) {
+    return true;
+  }
+
+  for (size_t i = 0; i < workers.size(); i++) {
+    if (!workers[i]->deque->isEmpty()) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void JobSystem::submit(Worker *worker, const Job &job) {
+  if (worker != NULL) {
+    /* Full deque means that there is enough work, so the job is executed at once */
+    if (!worker->deque->push(job)) {
+      execute(job);
+    }
+    return;
+  }
+
+  lock->lock();
+  injected.push_back(job);
+  injectedCount = (uint)injected.size();
+  lock->unlock();
+}
+
+void JobSystem::wakeUp(uint count) {
+  /* Pairs with the check of jobs by a worker which is going to sleep */
+  memoryBarrier();
+
+  uint sleeping = sleepingCount;
+  wakeupSemaphore->post(count < sleeping ? count : sleeping);
+}
+
+void JobSystem::execute(const Job &job) {
+  job.function(job.data);
+
+  if (job.counter != NULL) {
+    finish(job.counter);
+  }
+}
+
+void JobSystem::finish(JobCounter *counter) {
+  if (atomicDecrement(&counter->value) == 0 && continuationsCount != 0) {
+    runContinuations();
+  }
+}
+
+void JobSystem::runContinuations() {
+  std::vector<Job> ready;
+
+  lock->lock();
+  for (size_t i = 0; i < continuations.size();) {
+    if (continuations[i].dependency->value == 0) {
+      ready.push_back(continuations[i].job);
+      continuations[i] = continuations.back();
+      continuations.pop_back();
+      atomicDecrement(&continuationsCount);
+    } else {
+      i++;
+    }
+  }
+  lock->unlock();
+
+  if (!ready.empty()) {
+    Worker *worker = getCurrentWorker();
+    for (size_t i = 0; i < ready.size(); i++) {
+      submit(worker, ready[i]);
+    }
+    wakeUp((uint)ready.size());
+  }
+}
+
+void JobSystem::parallelForEntry(void *data) {
+  ParallelForChunk *chunk = (ParallelForChunk*)data;
+  chunk->function(chunk->begin, chunk->end, chunk->data);
+}
+
+}
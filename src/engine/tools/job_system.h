@@ -0,0 +1,244 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_JOB_SYSTEM_H__
+#define __VE_JOB_SYSTEM_H__
+
+#include <deque>
+#include <vector>
+
+#include "common.h"
+#include "tools/job.h"
+
+namespace ve {
+
+class CriticalSection;
+class Semaphore;
+class WorkStealingDeque;
+
+/** Function which processes the range [begin, end) of parallelFor() */
+typedef void (*ParallelForFunction)(uint begin, uint end, void *data);
+
+/**
+    Work-stealing job system. Every worker thread and the thread which
+    started the system own a deque of jobs. Jobs which are run by a thread go
+    to its deque, the thread takes the newest jobs back, idle threads steal the
+    oldest jobs of other deques and sleep when there is nothing to steal. Other
+    threads may run jobs too, such jobs are queued under a lock.
+
+    Waiting with wait() executes jobs, so the main thread participates and a
+    job may wait for the jobs it has run without blocking a worker.
+*/
+class JobSystem {
+private:
+  /**
+      Thread which executes jobs.
+  */
+  struct Worker {
+    JobSystem *system;
+    WorkStealingDeque *deque;
+
+    /** State of the random generator which chooses victims of steals */
+    uint seed;
+  };
+
+  /** Number of worker threads */
+  uint workersCount;
+
+  /** Capacity of deques */
+  uint dequeCapacity;
+
+  /** Workers, the last one is the thread which started the system */
+  std::vector<Worker*> workers;
+
+  /**
+      Job which is run when its dependency becomes zero.
+  */
+  struct Continuation {
+    JobCounter *dependency;
+    Job job;
+  };
+
+  /** Guards queue of other threads and continuations */
+  CriticalSection *lock;
+
+  /** Jobs of threads which do not own a deque */
+  std::deque<Job> injected;
+
+  /** Number of jobs in the injected queue, it is read without the lock */
+  volatile uint injectedCount;
+
+  /** Jobs which wait for their dependencies */
+  std::vector<Continuation> continuations;
+
+  /** Number of continuations, it is read without the lock */
+  volatile uint continuationsCount;
+
+  /** Number of workers which are going to sleep or sleep */
+  volatile uint sleepingCount;
+
+  /** Zero when workers must exit */
+  volatile int running;
+
+  /** Number of worker threads which have not exited */
+  volatile uint activeThreads;
+
+  /** Semaphore which wakes up sleeping workers */
+  Semaphore *wakeupSemaphore;
+
+  /**
+      Entry point of worker threads.
+  */
+  static unsigned long workerEntry(void *parameter);
+
+  /**
+      Executes jobs until the system is stopped.
+  */
+  void runWorker(Worker *worker);
+
+  /**
+      Returns worker of the calling thread or NULL if the thread does not own a deque of this system.
+  */
+  Worker *getCurrentWorker();
+
+  /**
+      Takes a job: the newest one of the own deque, a stolen one or a queued one.
+      @param worker - Worker of the calling thread or NULL.
+      @param job - Taken job.
+      @return 'false' if there is no job.
+  */
+  bool takeJob(Worker *worker, Job &job);
+
+  /**
+      Checks if there are jobs which may be taken.
+  */
+  bool hasJobs();
+
+  /**
+      Adds job to the deque of the calling thread or to the injected queue.
+  */
+  void submit(Worker *worker, const Job &job);
+
+  /**
+      Wakes up sleeping workers.
+      @param count - Number of jobs which were added.
+  */
+  void wakeUp(uint count);
+
+  /**
+      Executes the job and finishes its counter.
+  */
+  void execute(const Job &job);
+
+  /**
+      Decrements the counter and runs continuations when it becomes zero. The
+      counter is not accessed after the decrement, because a waiting thread
+      may destroy it at once.
+  */
+  void finish(JobCounter *counter);
+
+  /**
+      Runs continuations whose dependencies are zero.
+  */
+  void runContinuations();
+
+  /**
+      Entry of parallelFor() jobs.
+  */
+  static void parallelForEntry(void *data);
+
+  /**
+      Private copy-constructor.
+  */
+  JobSystem(const JobSystem &ref);
+
+  /**
+      Private operator =
+  */
+  JobSystem &operator = (const JobSystem &ref);
+
+public:
+  /**
+      Constructor. Workers are started by start().
+      @param workersCount - Number of worker threads, zero means number of processors - 1.
+      @param dequeCapacity - Maximal number of queued jobs of a thread, a job is executed
+      at once when the deque is full.
+  */
+  JobSystem(uint workersCount = 0, uint dequeCapacity = 4096);
+
+  /**
+      Destructor. Stops the system.
+  */
+  ~JobSystem();
+
+  /**
+      Starts worker threads. The calling thread becomes the main thread of the
+      system, it owns a deque and executes jobs in wait().
+      @return OK if workers were started.
+      @return ERROR if a thread can not be created.
+  */
+  Outcome start();
+
+  /**
+      Stops worker threads, jobs which are not taken are dropped. Must be called by the main thread.
+  */
+  void stop();
+
+  /**
+      Runs job.
+      @param function - Function of the job.
+      @param data - Parameter of the function.
+      @param counter - Counter which is incremented now and decremented when the job is finished or NULL.
+  */
+  void run(JobFunction function, void *data, JobCounter *counter = NULL);
+
+  /**
+      Runs array of jobs, counters of the jobs are ignored.
+      @param jobs - Jobs.
+      @param count - Number of jobs.
+      @param counter - Counter which is incremented by count now and decremented when each job is finished or NULL.
+  */
+  void run(const Job *jobs, uint count, JobCounter *counter = NULL);
+
+  /**
+      Runs job when all jobs of the dependency are finished.
+      @param dependency - Counter of jobs the job depends on.
+      @param function - Function of the job.
+      @param data - Parameter of the function.
+      @param counter - Counter which is incremented now and decremented when the job is finished or NULL.
+  */
+  void runAfter(JobCounter *dependency, JobFunction function, void *data, JobCounter *counter = NULL);
+
+  /**
+      Executes jobs until the counter becomes zero.
+      @param counter - Counter of jobs.
+  */
+  void wait(JobCounter *counter);
+
+  /**
+      Calls function for chunks of the range [begin, end) in parallel and waits for them.
+      @param begin - First index.
+      @param end - Index after the last one.
+      @param function - Function which processes a chunk.
+      @param data - Parameter of the function.
+      @param grainSize - Number of indices of a chunk, zero means that size of
+      chunks is chosen to give every thread several chunks.
+  */
+  void parallelFor(uint begin, uint end, ParallelForFunction function, void *data, uint grainSize = 0);
+
+  /**
+      Returns number of worker threads.
+      @return Number of workers without the main thread.
+  */
+  uint getWorkersCount();
+
+  /**
+      Returns number of processors.
+      @return Number of logical processors.
+  */
+  static uint getProcessorsCount();
+};
+
+}
+
+#endif // __VE_JOB_SYSTEM_H__
@@ -1,10 +1,19 @@
 // Copyright (c) 2017 The Smart Authors.
 // All rights reserved.
 
+#include <map>
+#include <utility>
+
 #include "common.h"
 #include "tools/memory_manager.h"
 
 namespace ve {
+
+/* Number of handle bits which keep index of the slot, the rest keep generation */
+static const uint INDEX_BITS = 24;
+
+static const uint INDEX_MASK = (1u << INDEX_BITS) - 1;
+
 MemoryManager *MemoryManager::instance = NULL;
 
 /**
@@ -20,40 +29,118 @@ MemoryManager* MemoryManager::getInstance() {
 }
 
 MemoryManager::MemoryManager() {
+  freeList = -1;
+  objectCount = 0;
+  freeing = false;
 }
 
 MemoryManager::~MemoryManager() {
   free();
 }
 
-void MemoryManager::registerPointer(void *newPointer) {
-  allocatedObjects.push_back(newPointer);
+MemoryHandle MemoryManager::registerPointer(void *newPointer, Destructor destructor, const char *file, int line) {
+  ERROR_IF(newPointer == NULL || destructor == NULL, L"Null pointer to register", INVALID_MEMORY_HANDLE);
+
+  int index;
+  if (freeList != -1) {
+    index = freeList;
+    freeList = slots[index].next;
+  } else {
+    ERROR_IF(slots.size() > INDEX_MASK, L"Too many registered pointers", INVALID_MEMORY_HANDLE);
+    index = (int)slots.size();
+    slots.push_back(Slot());
+    slots[index].generation = 0;
+  }
+
+  Slot &slot = slots[index];
+  slot.pointer = newPointer;
+  slot.destructor = destructor;
+  slot.file = file;
+  slot.line = line;
+  objectCount++;
+
+  return (slot.generation << INDEX_BITS) | (uint)index;
 }
 
-void MemoryManager::unregisterPointer(void *newPointer) {
-  uint len = allocatedObjects.size();
-  int found = -1;
+int MemoryManager::getSlot(MemoryHandle handle) const {
+  uint index = handle & INDEX_MASK;
 
-  for (uint i = 0; i < len; i++) {
-    if (allocatedObjects[i] == newPointer) {
-      found = i;
-      break;
-    }
+  if (handle == INVALID_MEMORY_HANDLE || index >= slots.size()) {
+    return -1;
   }
 
-  if (found != -1) {
-    allocatedObjects.erase(allocatedObjects.begin() + found);
-  } else {
+  const Slot &slot = slots[index];
+  if (slot.destructor == NULL || (handle >> INDEX_BITS) != (slot.generation & (0xFFFFFFFF >> INDEX_BITS))) {
+    return -1;
+  }
+
+  return (int)index;
+}
+
+void MemoryManager::releaseSlot(int index) {
+  Slot &slot = slots[index];
+  slot.pointer = NULL;
+  slot.destructor = NULL;
+  slot.generation++;
+  slot.next = freeList;
+  freeList = index;
+  objectCount--;
+}
+
+void MemoryManager::unregisterPointer(MemoryHandle handle) {
+  int index = getSlot(handle);
+
+  if (index != -1) {
+    releaseSlot(index);
+  } else if (!freeing) {
+    // Objects which are deleted by free() unregister themselves with stale handles
     LOG_ERROR(L"Strange pointer to unregister");
   }
 }
 
+void *MemoryManager::getPointer(MemoryHandle handle) const {
+  int index = getSlot(handle);
+  return index != -1 ? slots[index].pointer : NULL;
+}
+
+uint MemoryManager::getObjectCount() const {
+  return objectCount;
+}
+
+uint MemoryManager::reportLeaks() const {
+  std::map<std::pair<const char *, int>, uint> sites;
+
+  for (uint i = 0; i < slots.size(); i++) {
+    if (slots[i].destructor != NULL) {
+      sites[std::make_pair(slots[i].file, slots[i].line)]++;
+    }
+  }
+
+  std::map<std::pair<const char *, int>, uint>::const_iterator it;
+  for (it = sites.begin(); it != sites.end(); ++it) {
+    std::wstring file = it->first.first != NULL ? StringTool::AsciiToWide(it->first.first) : L"unknown";
+    Log::getInstance()->warning(StringTool::intToStr(it->second) + L" object(s) registered at " + file +
+      L":" + StringTool::intToStr(it->first.second) + L" are not released");
+  }
+
+  return objectCount;
+}
+
 void MemoryManager::free() {
-  while (!allocatedObjects.empty()) {
-    delete allocatedObjects[0];
+  freeing = true;
+
+  // Destructors may register and unregister other objects, so slots are
+  // released before objects are deleted and indices are used instead of iterators
+  for (uint i = 0; i < slots.size(); i++) {
+    if (slots[i].destructor != NULL) {
+      void *pointer = slots[i].pointer;
+      Destructor destructor = slots[i].destructor;
+      releaseSlot(i);
+      destructor(pointer);
+    }
   }
 
-  allocatedObjects.clear();
+  freeing = false;
 }
 
 }
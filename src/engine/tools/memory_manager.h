@@ -8,8 +8,25 @@
 
 namespace ve {
 
-#define REGISTER_POINTER(x) MemoryManager::getInstance()->registerPointer(x);
-#define UNREGISTER_POINTER(x) MemoryManager::getInstance()->unregisterPointer(x);
+/**
+    Registers object in the memory manager and remembers the call site for leak
+    reports. Evaluates to MemoryHandle which is used to unregister the object.
+*/
+#define REGISTER_POINTER(x) MemoryManager::getInstance()->registerPointer(x, __FILE__, __LINE__)
+
+/**
+    Unregisters object by the handle returned by REGISTER_POINTER.
+*/
+#define UNREGISTER_POINTER(handle) MemoryManager::getInstance()->unregisterPointer(handle)
+
+/**
+    Identifies registered object. Lower bits are index of the slot and higher
+    bits are generation of the slot, so stale handles are detected.
+*/
+typedef unsigned int MemoryHandle;
+
+/** Handle which never identifies an object */
+const MemoryHandle INVALID_MEMORY_HANDLE = 0xFFFFFFFF;
 
 /**
     Memory manager is a very simple class to control
@@ -17,14 +34,45 @@ namespace ve {
     which should be disposed in destructor or free() function.
     Usually it used in classes which are able
     to allocate numerous objects with different types.
+
+    Every object is registered together with the destructor of its static type,
+    so objects are deleted correctly without virtual base. Objects are kept in slots
+    and handles refer to slots, so registration and unregistration take constant time.
 */
 class MemoryManager {
+public:
+  /** Function which deletes object of the known type */
+  typedef void (*Destructor)(void *pointer);
+
 protected:
+  /**
+      Slot of registered object. Free slots have no destructor and are linked
+      into the list with next field.
+  */
+  struct Slot {
+    void *pointer;
+    Destructor destructor;
+    /** Call site which registered the object */
+    const char *file;
+    int line;
+    unsigned int generation;
+    int next;
+  };
+
   /** The only one instance of this class */
   static MemoryManager *instance;
 
-  /** List of allocated objects */
-  std::vector<void*> allocatedObjects;
+  /** Slots of allocated objects */
+  std::vector<Slot> slots;
+
+  /** Index of the first free slot, -1 if there are no free slots */
+  int freeList;
+
+  /** Number of registered objects */
+  unsigned int objectCount;
+
+  /** Objects are being deleted by free(), so their handles are already stale */
+  bool freeing;
 
   /**
     Private constructor. Does nothing.
@@ -41,6 +89,24 @@ protected:
   */
   MemoryManager operator = (MemoryManager &ref);
 
+  /**
+      Returns slot index of the handle or -1 if handle is stale or invalid.
+  */
+  int getSlot(MemoryHandle handle) const;
+
+  /**
+      Returns slot to the free list, handles of the slot become stale.
+  */
+  void releaseSlot(int index);
+
+  /**
+      Deletes object of specified type.
+  */
+  template <class T>
+  static void destroy(void *pointer) {
+    delete static_cast<T *>(pointer);
+  }
+
 public:
   /**
     Returns instance of this singleton class.
@@ -55,15 +121,55 @@ public:
 
   /**
       Register pointer to free in destructor or free() function.
+      The object is deleted as T, so T must be the type it was created with
+      or its base with virtual destructor.
+      @param newPointer - pointer which should be released by this Manager.
+      @param file - Source file which registers the pointer, it is used by leak reports.
+      @param line - Line in the source file.
+      @return Handle to unregister the pointer.
+  */
+  template <class T>
+  MemoryHandle registerPointer(T *newPointer, const char *file = NULL, int line = 0) {
+    return registerPointer(newPointer, &MemoryManager::destroy<T>, file, line);
+  }
+
+  /**
+      Register pointer with the function which deletes it.
       @param newPointer - pointer which should be released by this Manager.
+      @param destructor - Function which deletes the pointer.
+      @param file - Source file which registers the pointer, it is used by leak reports.
+      @param line - Line in the source file.
+      @return Handle to unregister the pointer.
   */
-  virtual void registerPointer(void *newPointer);
+  virtual MemoryHandle registerPointer(void *newPointer, Destructor destructor, const char *file, int line);
 
   /**
       Unregister pointer. It means that this pointer will not be disposed
       during destructor or free() function.
+      @param handle - Handle returned by registerPointer().
+  */
+  virtual void unregisterPointer(MemoryHandle handle);
+
+  /**
+      Returns registered pointer.
+      @param handle - Handle returned by registerPointer().
+      @return Pointer or NULL if handle is stale.
+  */
+  void *getPointer(MemoryHandle handle) const;
+
+  /**
+      Returns number of registered objects.
+      @return Number of objects which will be disposed by free().
+  */
+  unsigned int getObjectCount() const;
+
+  /**
+      Writes registered objects to the log grouped by the call sites which
+      registered them. Call it before free() at shutdown to find objects which
+      were not released by their owners.
+      @return Number of registered objects.
   */
-  virtual void unregisterPointer(void *newPointer);
+  unsigned int reportLeaks() const;
 
   /**
       Free all the pointers it owns.
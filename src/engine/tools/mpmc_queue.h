@@ -0,0 +1,231 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_MPMC_QUEUE_H__
+#define __VE_MPMC_QUEUE_H__
+
+#include "common.h"
+#include "tools/queue_waiters.h"
+#include "windows/atomic.h"
+
+namespace ve {
+
+/**
+    Bounded ring queue for any number of producer and consumer threads.
+    Every slot has a sequence number which tells whether the slot waits for
+    a value or for a reader of the lap, so a thread claims a slot with one
+    compare-and-swap of the index of its side and then fills or empties it
+    without blocking the other side. Blocking calls spin and yield for a while
+    before they sleep. T must be default-constructible and copyable.
+*/
+template <class T>
+class MpmcQueue {
+private:
+  /** Number of failed attempts which spin, then as many attempts yield before a blocking call sleeps */
+  static const uint SPIN_COUNT = 64;
+
+  struct Slot {
+    /** Equals to the index when the slot is free, to the index + 1 when it holds the value */
+    volatile uint sequence;
+
+    T value;
+  };
+
+  /** Ring of slots */
+  Slot *slots;
+
+  /** Capacity - 1, capacity is a power of two */
+  uint mask;
+
+  /** Consumers which wait for a value */
+  QueueWaiters notEmpty;
+
+  /** Producers which wait for a free slot */
+  QueueWaiters notFull;
+
+  char padding0[CACHE_LINE_SIZE];
+
+  /** Index of the next slot for producers */
+  volatile uint enqueuePosition;
+
+  char padding1[CACHE_LINE_SIZE - sizeof(uint)];
+
+  /** Index of the next slot for consumers */
+  volatile uint dequeuePosition;
+
+  char padding2[CACHE_LINE_SIZE - sizeof(uint)];
+
+  /**
+      Private copy-constructor.
+  */
+  MpmcQueue(const MpmcQueue &ref);
+
+  /**
+      Private operator =
+  */
+  MpmcQueue &operator = (const MpmcQueue &ref);
+
+public:
+  /**
+      Constructor.
+      @param capacity - Maximal number of values, it is rounded up to a power of two.
+  */
+  MpmcQueue(uint capacity) {
+    uint size = 2;
+    while (size < capacity) {
+      size *= 2;
+    }
+
+    slots = new Slot[size];
+    for (uint i = 0; i < size; i++) {
+      slots[i].sequence = i;
+    }
+    mask = size - 1;
+    enqueuePosition = 0;
+    dequeuePosition = 0;
+  }
+
+  /**
+      Destructor.
+  */
+  ~MpmcQueue() {
+    delete[] slots;
+  }
+
+  /**
+      Adds value if there is a free slot, may be called by any thread.
+      @param value - Value.
+      @return 'false' if queue is full.
+  */
+  bool tryPush(const T &value) {
+    uint position = enqueuePosition;
+    Slot *slot;
+    for (;;) {
+      slot = &slots[position & mask];
+      uint sequence = slot->sequence;
+      orderBarrier();
+
+      int difference = (int)(sequence - position);
+      if (difference == 0) {
+        uint previous = compareAndSwap(&enqueuePosition, position, position + 1);
+        if (previous == position) {
+          break;
+        }
+        position = previous;
+      } else if (difference < 0) {
+        /* Slot still holds the value of the previous lap */
+        return false;
+      } else {
+        position = enqueuePosition;
+      }
+    }
+
+    slot->value = value;
+    orderBarrier();
+    slot->sequence = position + 1;
+    notEmpty.notify();
+    return true;
+  }
+
+  /**
+      Adds value, waits while queue is full. May be called by any thread.
+      @param value - Value.
+  */
+  void push(const T &value) {
+    for (uint i = 0; !tryPush(value); i++) {
+      if (i < SPIN_COUNT) {
+        cpuPause();
+        continue;
+      } else if (i < SPIN_COUNT * 2) {
+        yieldThread();
+        continue;
+      }
+
+      notFull.prepare();
+      if (tryPush(value)) {
+        notFull.cancel();
+        return;
+      }
+      notFull.wait();
+    }
+  }
+
+  /**
+      Takes the oldest value if there is any, may be called by any thread.
+      @param value - Taken value.
+      @return 'false' if queue is empty.
+  */
+  bool tryPop(T &value) {
+    uint position = dequeuePosition;
+    Slot *slot;
+    for (;;) {
+      slot = &slots[position & mask];
+      uint sequence = slot->sequence;
+      orderBarrier();
+
+      int difference = (int)(sequence - (position + 1));
+      if (difference == 0) {
+        uint previous = compareAndSwap(&dequeuePosition, position, position + 1);
+        if (previous == position) {
+          break;
+        }
+        position = previous;
+      } else if (difference < 0) {
+        /* Producer of the slot has not published the value yet */
+        return false;
+      } else {
+        position = dequeuePosition;
+      }
+    }
+
+    value = slot->value;
+    orderBarrier();
+    slot->sequence = position + mask + 1;
+    notFull.notify();
+    return true;
+  }
+
+  /**
+      Takes the oldest value, waits while queue is empty. May be called by any thread.
+      @param value - Taken value.
+  */
+  void pop(T &value) {
+    for (uint i = 0; !tryPop(value); i++) {
+      if (i < SPIN_COUNT) {
+        cpuPause();
+        continue;
+      } else if (i < SPIN_COUNT * 2) {
+        yieldThread();
+        continue;
+      }
+
+      notEmpty.prepare();
+      if (tryPop(value)) {
+        notEmpty.cancel();
+        return;
+      }
+      notEmpty.wait();
+    }
+  }
+
+  /**
+      Returns number of values, the result is approximate when other threads work with the queue.
+      @return Number of values.
+  */
+  uint getSize() const {
+    int size = (int)(enqueuePosition - dequeuePosition);
+    return size > 0 ? (uint)size : 0;
+  }
+
+  /**
+      Returns capacity.
+      @return Maximal number of values.
+  */
+  uint getCapacity() const {
+    return mask + 1;
+  }
+};
+
+}
+
+#endif // __VE_MPMC_QUEUE_H__
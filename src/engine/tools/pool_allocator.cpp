@@ -0,0 +1,99 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include "common.h"
+#include "tools/pool_allocator.h"
+#include "windows/mutex.h"
+
+namespace ve {
+
+/* Blocks are aligned to this value, it is enough for SSE types */
+static const uint BLOCK_ALIGNMENT = 16;
+
+PoolAllocator::PoolAllocator(uint blockSize, uint chunkBlocks) {
+  if (blockSize < sizeof(void *)) {
+    blockSize = sizeof(void *);
+  }
+
+  this->blockSize = (blockSize + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT;
+  this->chunkBlocks = chunkBlocks > 0 ? chunkBlocks : 1;
+  freeList = NULL;
+  usedCount = 0;
+  lock = new Mutex();
+}
+
+PoolAllocator::~PoolAllocator() {
+  for (uint i = 0; i < chunks.size(); i++) {
+    ::operator delete(chunks[i]);
+  }
+  delete lock;
+}
+
+void PoolAllocator::addChunk() {
+  // Global operator new returns memory aligned for any fundamental type, the
+  // chunk is over-allocated to align the first block manually
+  char *chunk = static_cast<char *>(::operator new(blockSize * chunkBlocks + BLOCK_ALIGNMENT, std::nothrow));
+  if (chunk == NULL) {
+    return;
+  }
+  chunks.push_back(chunk);
+
+  size_t address = reinterpret_cast<size_t>(chunk);
+  char *first = chunk + (BLOCK_ALIGNMENT - address % BLOCK_ALIGNMENT) % BLOCK_ALIGNMENT;
+
+  // Blocks are linked in the order of addresses, so consecutive allocations are adjacent
+  for (uint i = chunkBlocks; i > 0; i--) {
+    void *block = first + (i - 1) * blockSize;
+    *static_cast<void **>(block) = freeList;
+    freeList = block;
+  }
+}
+
+void *PoolAllocator::allocate() {
+  lock->lock();
+  if (freeList == NULL) {
+    addChunk();
+    if (freeList == NULL) {
+      lock->unlock();
+      return NULL;
+    }
+  }
+
+  void *block = freeList;
+  freeList = *static_cast<void **>(block);
+  usedCount++;
+  lock->unlock();
+  return block;
+}
+
+void PoolAllocator::free(void *block) {
+  if (block == NULL) {
+    return;
+  }
+
+  lock->lock();
+  *static_cast<void **>(block) = freeList;
+  freeList = block;
+  usedCount--;
+  lock->unlock();
+}
+
+uint PoolAllocator::getBlockSize() const {
+  return blockSize;
+}
+
+uint PoolAllocator::getUsedCount() const {
+  lock->lock();
+  uint result = usedCount;
+  lock->unlock();
+  return result;
+}
+
+uint PoolAllocator::getCapacity() const {
+  lock->lock();
+  uint result = (uint)chunks.size() * chunkBlocks;
+  lock->unlock();
+  return result;
+}
+
+}
@@ -0,0 +1,161 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_POOL_ALLOCATOR_H__
+#define __VE_POOL_ALLOCATOR_H__
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "engine/types.h"
+
+namespace ve {
+
+class Mutex;
+
+/**
+    Allocator of fixed-size blocks. Blocks are cut from large chunks and freed blocks
+    are linked into the list, so allocation and deallocation take constant time and
+    objects of the same type lie close to each other. Chunks are returned to the
+    system only in destructor. Pool may be used by several threads, allocate() and
+    free() take a mutex which costs one atomic operation without contention.
+*/
+class PoolAllocator {
+private:
+  /** Size of blocks, it is rounded up to keep blocks aligned */
+  uint blockSize;
+
+  /** Number of blocks in every chunk */
+  uint chunkBlocks;
+
+  /** Allocated chunks */
+  std::vector<char *> chunks;
+
+  /** The first free block, every free block keeps pointer to the next one */
+  void *freeList;
+
+  /** Number of allocated blocks */
+  uint usedCount;
+
+  /** Guards the free list and chunks */
+  Mutex *lock;
+
+  /**
+      Allocates new chunk and links its blocks into the free list.
+  */
+  void addChunk();
+
+  /**
+      Private copy-constructor.
+  */
+  PoolAllocator(const PoolAllocator &ref);
+
+  /**
+      Private operator =
+  */
+  PoolAllocator &operator = (const PoolAllocator &ref);
+
+public:
+  /**
+      Constructor. Chunks are allocated on demand.
+      @param blockSize - Size of blocks in bytes.
+      @param chunkBlocks - Number of blocks in every chunk.
+  */
+  PoolAllocator(uint blockSize, uint chunkBlocks = 64);
+
+  /**
+      Destructor. Frees all chunks, blocks which were not freed become invalid.
+  */
+  ~PoolAllocator();
+
+  /**
+      Allocates block.
+      @return Pointer to the block or NULL if system is out of memory.
+  */
+  void *allocate();
+
+  /**
+      Returns block to the pool.
+      @param block - Block returned by allocate(), NULL is ignored.
+  */
+  void free(void *block);
+
+  /**
+      Returns size of blocks.
+      @return Size of blocks in bytes, it may be larger than requested.
+  */
+  uint getBlockSize() const;
+
+  /**
+      Returns number of allocated blocks.
+      @return Number of blocks which were not freed.
+  */
+  uint getUsedCount() const;
+
+  /**
+      Returns number of blocks in all chunks.
+      @return Number of blocks which may be allocated without new chunks.
+  */
+  uint getCapacity() const;
+};
+
+/**
+    Base class which makes objects of derived class T to be allocated from the pool
+    of blocks of sizeof(T). Objects of classes derived from T have different size,
+    so they are allocated with global operator new.
+
+    Example:
+    @code
+    class Texture : public PooledObject<Texture> {
+    ...
+    };
+    @endcode
+*/
+template <class T>
+class PooledObject {
+public:
+  /**
+      Allocates memory for the object from the pool.
+  */
+  static void *operator new(size_t size) {
+    if (size != sizeof(T)) {
+      return ::operator new(size);
+    }
+
+    void *block = getPool().allocate();
+    if (block == NULL) {
+      throw std::bad_alloc();
+    }
+    return block;
+  }
+
+  /**
+      Returns memory of the object to the pool. Size is the size of the dynamic
+      type when destructor is virtual.
+  */
+  static void operator delete(void *block, size_t size) {
+    if (block == NULL) {
+      return;
+    }
+
+    if (size != sizeof(T)) {
+      ::operator delete(block);
+    } else {
+      getPool().free(block);
+    }
+  }
+
+  /**
+      Returns the pool of objects of class T.
+      @return Pool which allocates blocks of sizeof(T).
+  */
+  static PoolAllocator &getPool() {
+    static PoolAllocator pool(sizeof(T));
+    return pool;
+  }
+};
+
+}
+
+#endif // __VE_POOL_ALLOCATOR_H__
@@ -0,0 +1,58 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include "common.h"
+#include "tools/queue_waiters.h"
+#include "windows/atomic.h"
+#include "windows/semaphore.h"
+
+namespace ve {
+
+QueueWaiters::QueueWaiters() {
+  semaphore = new Semaphore();
+  waitingCount = 0;
+}
+
+QueueWaiters::~QueueWaiters() {
+  delete semaphore;
+}
+
+void QueueWaiters::prepare() {
+  /* Increment is a full barrier, so the following check of the queue sees changes of notifiers which missed it */
+  atomicIncrement(&waitingCount);
+}
+
+void QueueWaiters::wait() {
+  semaphore->wait();
+}
+
+void QueueWaiters::cancel() {
+  uint count = waitingCount;
+  while (count != 0) {
+    uint previous = compareAndSwap(&waitingCount, count, count - 1);
+    if (previous == count) {
+      return;
+    }
+    count = previous;
+  }
+
+  /* Registration was claimed by a notifier, its post must be taken, otherwise it wakes up a later waiter for nothing */
+  semaphore->wait();
+}
+
+void QueueWaiters::notify() {
+  /* Pairs with prepare(), the change of the queue is visible before the counter is read */
+  memoryBarrier();
+
+  uint count = waitingCount;
+  while (count != 0) {
+    uint previous = compareAndSwap(&waitingCount, count, count - 1);
+    if (previous == count) {
+      semaphore->post();
+      return;
+    }
+    count = previous;
+  }
+}
+
+}
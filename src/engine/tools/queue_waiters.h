@@ -0,0 +1,72 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_QUEUE_WAITERS_H__
+#define __VE_QUEUE_WAITERS_H__
+
+#include "common.h"
+
+namespace ve {
+
+class Semaphore;
+
+/**
+    Threads which sleep until a queue changes. A thread registers itself,
+    checks the queue once more and only then sleeps, the other side checks
+    the number of registered threads after every change of the queue. Each
+    wakeup claims one registration, so the semaphore never collects posts
+    which nobody waits for.
+*/
+class QueueWaiters {
+private:
+  /** Sleeping threads are released by it */
+  Semaphore *semaphore;
+
+  /** Number of registered threads which were not woken up yet */
+  volatile uint waitingCount;
+
+  /**
+      Private copy-constructor.
+  */
+  QueueWaiters(const QueueWaiters &ref);
+
+  /**
+      Private operator =
+  */
+  QueueWaiters &operator = (const QueueWaiters &ref);
+
+public:
+  /**
+      Constructor.
+  */
+  QueueWaiters();
+
+  /**
+      Destructor.
+  */
+  ~QueueWaiters();
+
+  /**
+      Registers the calling thread, the queue must be checked again after it.
+  */
+  void prepare();
+
+  /**
+      Sleeps until another thread calls notify(), must follow prepare().
+  */
+  void wait();
+
+  /**
+      Unregisters the thread which found what it waited for after prepare().
+  */
+  void cancel();
+
+  /**
+      Wakes up one registered thread if there is any.
+  */
+  void notify();
+};
+
+}
+
+#endif // __VE_QUEUE_WAITERS_H__
@@ -0,0 +1,203 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_SPSC_QUEUE_H__
+#define __VE_SPSC_QUEUE_H__
+
+#include "common.h"
+#include "tools/queue_waiters.h"
+#include "windows/atomic.h"
+
+namespace ve {
+
+/**
+    Bounded ring queue for one producer thread and one consumer thread. Each
+    side writes only its own index and keeps a copy of the other index, so
+    the shared cache line of the other side is read only when the copy says
+    that the queue is full or empty. Blocking calls spin and yield for a while
+    before they sleep. T must be default-constructible and copyable.
+*/
+template <class T>
+class SpscQueue {
+private:
+  /** Number of failed attempts which spin, then as many attempts yield before a blocking call sleeps */
+  static const uint SPIN_COUNT = 64;
+
+  /** Ring of values */
+  T *values;
+
+  /** Capacity - 1, capacity is a power of two */
+  uint mask;
+
+  /** Consumers which wait for a value */
+  QueueWaiters notEmpty;
+
+  /** Producers which wait for a free slot */
+  QueueWaiters notFull;
+
+  char padding0[CACHE_LINE_SIZE];
+
+  /** Index of the next value to pop, it is written only by the consumer */
+  volatile uint head;
+
+  /** Copy of tail which is owned by the consumer */
+  uint cachedTail;
+
+  char padding1[CACHE_LINE_SIZE - 2 * sizeof(uint)];
+
+  /** Index after the last pushed value, it is written only by the producer */
+  volatile uint tail;
+
+  /** Copy of head which is owned by the producer */
+  uint cachedHead;
+
+  char padding2[CACHE_LINE_SIZE - 2 * sizeof(uint)];
+
+  /**
+      Private copy-constructor.
+  */
+  SpscQueue(const SpscQueue &ref);
+
+  /**
+      Private operator =
+  */
+  SpscQueue &operator = (const SpscQueue &ref);
+
+public:
+  /**
+      Constructor.
+      @param capacity - Maximal number of values, it is rounded up to a power of two.
+  */
+  SpscQueue(uint capacity) {
+    uint size = 2;
+    while (size < capacity) {
+      size *= 2;
+    }
+
+    values = new T[size];
+    mask = size - 1;
+    head = 0;
+    cachedTail = 0;
+    tail = 0;
+    cachedHead = 0;
+  }
+
+  /**
+      Destructor.
+  */
+  ~SpscQueue() {
+    delete[] values;
+  }
+
+  /**
+      Adds value if there is a free slot. Must be called only by the producer thread.
+      @param value - Value.
+      @return 'false' if queue is full.
+  */
+  bool tryPush(const T &value) {
+    uint t = tail;
+    if (t - cachedHead > mask) {
+      cachedHead = head;
+      if (t - cachedHead > mask) {
+        return false;
+      }
+
+      /* Slot is written after the consumer has read it */
+      orderBarrier();
+    }
+
+    values[t & mask] = value;
+    orderBarrier();
+    tail = t + 1;
+    notEmpty.notify();
+    return true;
+  }
+
+  /**
+      Adds value, waits while queue is full. Must be called only by the producer thread.
+      @param value - Value.
+  */
+  void push(const T &value) {
+    for (uint i = 0; !tryPush(value); i++) {
+      if (i < SPIN_COUNT) {
+        cpuPause();
+        continue;
+      } else if (i < SPIN_COUNT * 2) {
+        yieldThread();
+        continue;
+      }
+
+      notFull.prepare();
+      if (tryPush(value)) {
+        notFull.cancel();
+        return;
+      }
+      notFull.wait();
+    }
+  }
+
+  /**
+      Takes the oldest value if there is any. Must be called only by the consumer thread.
+      @param value - Taken value.
+      @return 'false' if queue is empty.
+  */
+  bool tryPop(T &value) {
+    uint h = head;
+    if (h == cachedTail) {
+      cachedTail = tail;
+      if (h == cachedTail) {
+        return false;
+      }
+    }
+
+    orderBarrier();
+    value = values[h & mask];
+    orderBarrier();
+    head = h + 1;
+    notFull.notify();
+    return true;
+  }
+
+  /**
+      Takes the oldest value, waits while queue is empty. Must be called only by the consumer thread.
+      @param value - Taken value.
+  */
+  void pop(T &value) {
+    for (uint i = 0; !tryPop(value); i++) {
+      if (i < SPIN_COUNT) {
+        cpuPause();
+        continue;
+      } else if (i < SPIN_COUNT * 2) {
+        yieldThread();
+        continue;
+      }
+
+      notEmpty.prepare();
+      if (tryPop(value)) {
+        notEmpty.cancel();
+        return;
+      }
+      notEmpty.wait();
+    }
+  }
+
+  /**
+      Returns number of values, the result is approximate when other threads work with the queue.
+      @return Number of values.
+  */
+  uint getSize() const {
+    return tail - head;
+  }
+
+  /**
+      Returns capacity.
+      @return Maximal number of values.
+  */
+  uint getCapacity() const {
+    return mask + 1;
+  }
+};
+
+}
+
+#endif // __VE_SPSC_QUEUE_H__
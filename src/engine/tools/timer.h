@@ -15,6 +15,12 @@ namespace ve {
 */
 class Timer {
 public:
+  /**
+      Destructor. Timers are created by TimerFactory and deleted through this class.
+  */
+  virtual ~Timer() {
+  }
+
   /**
       Resets timer.
   */
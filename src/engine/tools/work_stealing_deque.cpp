@@ -0,0 +1,84 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include "common.h"
+#include "tools/work_stealing_deque.h"
+#include "windows/atomic.h"
+
+namespace ve {
+
+WorkStealingDeque::WorkStealingDeque(uint capacity) {
+  uint size = 2;
+  while (size < capacity) {
+    size *= 2;
+  }
+
+  jobs = new Job[size];
+  mask = size - 1;
+  top = 0;
+  bottom = 0;
+}
+
+WorkStealingDeque::~WorkStealingDeque() {
+  delete[] jobs;
+}
+
+bool WorkStealingDeque::push(const Job &job) {
+  uint b = bottom;
+  uint t = top;
+
+  /* Stale top only makes the deque look fuller */
+  if (b - t > mask) {
+    return false;
+  }
+
+  jobs[b & mask] = job;
+  orderBarrier();
+  bottom = b + 1;
+  return true;
+}
+
+bool WorkStealingDeque::pop(Job &job) {
+  uint b = bottom - 1;
+  bottom = b;
+
+  /* Thieves must see the reservation before top is read */
+  memoryBarrier();
+  uint t = top;
+
+  if ((int)(b - t) < 0) {
+    bottom = t;
+    return false;
+  }
+
+  job = jobs[b & mask];
+  if (b != t) {
+    return true;
+  }
+
+  /* The last job is raced with thieves */
+  bool taken = compareAndSwap(&top, t, t + 1) == t;
+  bottom = t + 1;
+  return taken;
+}
+
+bool WorkStealingDeque::steal(Job &job) {
+  uint t = top;
+  memoryBarrier();
+  uint b = bottom;
+  orderBarrier();
+
+  if ((int)(b - t) <= 0) {
+    return false;
+  }
+
+  /* Slot is not overwritten before top passes it, so the copy is valid if the swap succeeds */
+  job = jobs[t & mask];
+  return compareAndSwap(&top, t, t + 1) == t;
+}
+
+bool WorkStealingDeque::isEmpty() {
+  return (int)(bottom - top) <= 0;
+}
+
+}
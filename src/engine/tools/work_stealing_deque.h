@@ -0,0 +1,91 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_WORK_STEALING_DEQUE_H__
+#define __VE_WORK_STEALING_DEQUE_H__
+
+#include "common.h"
+#include "tools/job.h"
+#include "windows/atomic.h"
+
+namespace ve {
+
+/**
+    Bounded Chase-Lev deque of jobs. The owner thread pushes and pops jobs at
+    the bottom without locks, other threads steal the oldest jobs from the
+    top, only the last job and steals are settled with compare-and-swap.
+    Indices wrap around, so the deque never has to be reset.
+*/
+class WorkStealingDeque {
+private:
+  /** Ring of jobs */
+  Job *jobs;
+
+  /** Capacity - 1, capacity is a power of two */
+  uint mask;
+
+  char padding0[CACHE_LINE_SIZE];
+
+  /** Index of the oldest job, it is advanced by thieves and by the owner */
+  volatile uint top;
+
+  char padding1[CACHE_LINE_SIZE - sizeof(uint)];
+
+  /** Index after the newest job, it is written only by the owner */
+  volatile uint bottom;
+
+  char padding2[CACHE_LINE_SIZE - sizeof(uint)];
+
+  /**
+      Private copy-constructor.
+  */
+  WorkStealingDeque(const WorkStealingDeque &ref);
+
+  /**
+      Private operator =
+  */
+  WorkStealingDeque &operator = (const WorkStealingDeque &ref);
+
+public:
+  /**
+      Constructor.
+      @param capacity - Maximal number of jobs, it is rounded up to a power of two.
+  */
+  WorkStealingDeque(uint capacity);
+
+  /**
+      Destructor.
+  */
+  ~WorkStealingDeque();
+
+  /**
+      Adds job to the bottom. Must be called only by the owner thread.
+      @param job - Job.
+      @return 'false' if deque is full.
+  */
+  bool push(const Job &job);
+
+  /**
+      Takes the newest job. Must be called only by the owner thread.
+      @param job - Taken job.
+      @return 'false' if deque is empty.
+  */
+  bool pop(Job &job);
+
+  /**
+      Takes the oldest job, may be called by any thread.
+      @param job - Taken job.
+      @return 'false' if deque is empty or another thread took the job first.
+  */
+  bool steal(Job &job);
+
+  /**
+      Checks if deque seems to be empty, the result is approximate when other threads work with it.
+      @return 'true' if there are no jobs.
+  */
+  bool isEmpty();
+};
+
+}
+
+#endif // __VE_WORK_STEALING_DEQUE_H__
@@ -5,6 +5,7 @@
 #include "ui/ui.h"
 #include "engines/engine.h"
 #include "tools/string_tool.h"
+#include "ui/ui_draw_list.h"
 
 namespace ve {
 
@@ -36,6 +37,7 @@ Border::Border(UIContainer *parent, Vector4f color, int lineWidth) :UIControl(pa
 
 void Border::setLineWidth(int newWidth) {
   lineWidth = newWidth;
+  invalidate();
 }
 
 int Border::getLineWidth() {
@@ -44,6 +46,7 @@ int Border::getLineWidth() {
 
 void Border::setColor(Vector4f newColor) {
   color = newColor;
+  invalidate();
 }
 
 Vector4f Border::getColor() {
@@ -107,6 +110,18 @@ Outcome Border::render() {
   return OK;
 }
 
+Outcome Border::draw(UIDrawList *list) {
+  CHECK_POINTER(list);
+
+  if (!isVisible()) {
+    return OK;
+  }
+
+  list->addBorder(getX(), getY(), getZ(), getWidth(), getHeight(), lineWidth, mask,
+    Vector4f(color[0], color[1], color[2], 1.0f));
+  return OK;
+}
+
 /**
     Sets border mask. Use constants defines in this class to define border mask.
     Only sides defines by this mask will be shown.
@@ -114,6 +129,7 @@ Outcome Border::render() {
 */
 void Border::setMask(uchar newMask) {
   mask = newMask;
+  invalidate();
 }
 
 /**
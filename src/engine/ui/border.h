@@ -76,6 +76,13 @@ public:
   */
   virtual Outcome render();
 
+  /**
+      Appends lines of the border as quads to the draw list.
+      @param list - Draw list of the frame.
+      @return OK if geometry was appended.
+  */
+  virtual Outcome draw(UIDrawList *list);
+
   /**
       Sets line width for this border.
       @param newWidth - new line width for this border.
@@ -5,6 +5,7 @@
 #include "events/system_event.h"
 #include "ui/button.h"
 #include "engines/engine.h"
+#include "ui/ui_draw_list.h"
 
 namespace ve {
 
@@ -86,6 +87,74 @@ Outcome Button::render() {
   return OK;
 }
 
+Outcome Button::draw(UIDrawList *list) {
+  CHECK_POINTER(list);
+
+  if (!isVisible()) {
+    return OK;
+  }
+
+  int width = getWidth();
+  int height = getHeight();
+
+  CHECK_POINTER(baseSprite);
+  baseSprite->setSize(width, height);
+
+  if (onCoverSprite != NULL) {
+    onCoverSprite->setSize(width, height);
+  }
+  if (onPressSprite != NULL) {
+    onPressSprite->setSize(width, height);
+  }
+
+  AbstractSprite *sprite = baseSprite;
+  bool shifted = false;
+
+  if (style == BS_FIXED) {
+    if (pressed == true && onPressSprite != NULL) {
+      sprite = onPressSprite;
+    } else
+      if (isCovered() == true && onCoverSprite != NULL) {
+        sprite = onCoverSprite;
+      }
+  } else
+    if (style == BS_DEFAULT) {
+      if (pressed == true) {
+        shifted = true;
+        if (onPressSprite != NULL) {
+          sprite = onPressSprite;
+        }
+      } else
+        if (isCovered() == true && onCoverSprite != NULL) {
+          sprite = onCoverSprite;
+        }
+    } else {
+      UNIMPLEMENTED();
+    }
+
+  list->pushTranslation(getX(), getY(), getZ());
+  if (shifted) {
+    list->pushTranslation(shiftVector[0], shiftVector[1], shiftVector[2]);
+  }
+
+  ASSERT(sprite->draw(list));
+
+  if (shifted) {
+    list->popTranslation();
+  }
+  list->popTranslation();
+
+  return OK;
+}
+
+void Button::getDrawBounds(float &left, float &top, float &right, float &bottom) {
+  UIControl::getDrawBounds(left, top, right, bottom);
+  left += Maths::min(0.0f, shiftVector[0]);
+  top += Maths::min(0.0f, shiftVector[1]);
+  right += Maths::max(0.0f, shiftVector[0]);
+  bottom += Maths::max(0.0f, shiftVector[1]);
+}
+
 /* Inherited from MouseListener */
 Outcome Button::processMouseEvent(MouseEvent *event) {
   CHECK_RESULT(UIControl::processMouseEvent(event), L"Failed to perform mouse message");
@@ -102,15 +171,17 @@ Outcome Button::processMouseEvent(MouseEvent *event) {
     if (style == BS_FIXED && isCovered()) {
       Outcome result = OK;
       pressed = pressed ^ true;
+      invalidate();
       if (pressed == true) {
-        result = sendActionEvent(new ActionEvent(BUTTON_PRESS, this));
+        result = sendActionEvent(new (engine->getFrameAllocator()) ActionEvent(BUTTON_PRESS, this));
       } else {
-        result = sendActionEvent(new ActionEvent(BUTTON_RELEASE, this));
+        result = sendActionEvent(new (engine->getFrameAllocator()) ActionEvent(BUTTON_RELEASE, this));
       }
       CHECK_RESULT(result, L"Message processing failed");
     } else {
       if (style == BS_DEFAULT && pressed == false && isCovered() == true) {
         pressed = true;
+        invalidate();
       }
     }
     break;
@@ -118,7 +189,8 @@ Outcome Button::processMouseEvent(MouseEvent *event) {
   case MOUSE_RELEASE:
     if (pressed == true && style != BS_FIXED) {
       pressed = false;
-      CHECK_RESULT(sendActionEvent(new ActionEvent(BUTTON_RELEASE, this)), L"Message processing failed");
+      invalidate();
+      CHECK_RESULT(sendActionEvent(new (engine->getFrameAllocator()) ActionEvent(BUTTON_RELEASE, this)), L"Message processing failed");
     }
     break;
   default:
@@ -133,18 +205,21 @@ Outcome Button::processMouseEvent(MouseEvent *event) {
 void Button::release() {
   if (style == BS_FIXED) {
     pressed = false;
+    invalidate();
   }
 }
 
 void Button::press() {
   if (style == BS_FIXED) {
     pressed = true;
+    invalidate();
   }
 }
 
 /* Set functions */
 void Button::setBaseSprite(AbstractSprite *baseSprite) {
   this->baseSprite = baseSprite;
+  invalidate();
 }
 
 AbstractSprite* Button::getBaseSprite() {
@@ -153,10 +228,12 @@ AbstractSprite* Button::getBaseSprite() {
 
 void Button::setOnPressSprite(AbstractSprite *onPressSprite) {
   this->onPressSprite = onPressSprite;
+  invalidate();
 }
 
 void Button::setOnCoverSprite(AbstractSprite *onCoverSprite) {
   this->onCoverSprite = onCoverSprite;
+  invalidate();
 }
 
 void Button::setSprites(AbstractSprite *baseSprite, AbstractSprite *onPressSprite, AbstractSprite *onCoverSprite) {
@@ -168,10 +245,12 @@ void Button::setSprites(AbstractSprite *baseSprite, AbstractSprite *onPressSprit
 
 void Button::setShiftVector(Vector3f newShiftVector) {
   shiftVector = newShiftVector;
+  invalidate();
 }
 
 void Button::setStyle(ButtonStyle newStyle) {
   style = newStyle;
+  invalidate();
 }
 
 /* Get functions */
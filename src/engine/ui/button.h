@@ -95,6 +95,23 @@ public:
   */
   virtual Outcome render();
 
+  /**
+      Appends the sprite of the current button state to the draw list.
+      @param list - Draw list of the frame.
+      @return OK if geometry was appended.
+      @return NULL_POINTER returned if baseSprite was not set.
+  */
+  virtual Outcome draw(UIDrawList *list);
+
+  /**
+      Returns area which is covered by the button including the shift of pressed button.
+      @param left - Receives left bound.
+      @param top - Receives top bound.
+      @param right - Receives right bound.
+      @param bottom - Receives bottom bound.
+  */
+  virtual void getDrawBounds(float &left, float &top, float &right, float &bottom);
+
   /**
       Mouse event processing function. It is used to change button's state.
       ActionEvent is send from this function if it is occurred.
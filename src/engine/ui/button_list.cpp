@@ -105,6 +105,7 @@ Outcome ButtonList::setRightButton(Button *rightButton) {
 
 void ButtonList::setBorder(Border *border) {
   this->border = border;
+  invalidate();
 }
 
 Border* ButtonList::getBorder() {
@@ -113,6 +114,7 @@ Border* ButtonList::getBorder() {
 
 Outcome ButtonList::setBackground(AbstractSprite *backgroundSprite) {
   this->background = backgroundSprite;
+  invalidate();
   return OK;
 }
 
@@ -122,10 +124,12 @@ AbstractSprite* ButtonList::getBackground() {
 
 void ButtonList::setButtonMargin(int newMargin) {
   buttonMargin = newMargin;
+  invalidate();
 }
 
 void ButtonList::setStyle(ButtonListStyle newStyle) {
   style = newStyle;
+  invalidate();
 }
 
 /* get functions */
@@ -4,6 +4,7 @@
 #include "common.h"
 #include "ui/checkbox.h"
 #include "engines/engine.h"
+#include "ui/ui_draw_list.h"
 
 namespace ve {
 
@@ -41,6 +42,25 @@ Outcome Checkbox::render() {
   return OK;
 }
 
+Outcome Checkbox::draw(UIDrawList *list) {
+  CHECK_POINTER(list);
+
+  if (!isVisible()) {
+    return OK;
+  }
+
+  CHECK_POINTER(button);
+  list->pushTranslation(getX(), getY(), getZ());
+  ASSERT(button->draw(list));
+
+  if (label != NULL) {
+    ASSERT(label->draw(list));
+  }
+
+  list->popTranslation();
+  return OK;
+}
+
 /* Inherited from ActionListener */
 Outcome Checkbox::processActionEvent(ActionEvent *event) {
   return OK;
@@ -62,6 +82,7 @@ Outcome Checkbox::setButton(Button *button) {
 
 void Checkbox::setLabel(Label *label) {
   this->label = label;
+  invalidate();
 }
 
 void Checkbox::setChecked(bool value) {
@@ -49,6 +49,14 @@ public:
   */
   virtual Outcome render();
 
+  /**
+      Appends button and label to the draw list.
+      @param list - Draw list of the frame.
+      @return OK if geometry was appended.
+      @return non-OK if error occurred.
+  */
+  virtual Outcome draw(UIDrawList *list);
+
   /**
       Used to handle button messages.
       @return OK everytime.
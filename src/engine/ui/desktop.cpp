@@ -2,16 +2,38 @@
 // All rights reserved.
 
 #include <algorithm>
+#include <math.h>
 
+#include "common.h"
 #include "ui/desktop.h"
 #include "ui/ui_control.h"
+#include "engines/engine.h"
+#include "tools/string_tool.h"
 
 namespace ve {
 
+/* Dirty rectangles are expanded by this number of pixels for borders and antialiasing */
+static const int DIRTY_MARGIN = 2;
+
+/* If there are more rectangles they are merged into one */
+static const uint MAX_DIRTY_RECTS = 32;
+
 Desktop::Desktop(UI *gui) :UIContainer(NULL) {
+  retained = false;
+  cacheBuffer = NULL;
+  cacheTexture = NULL;
+  cacheSprite = NULL;
+  cacheWidth = cacheHeight = 0;
+  fullRedraw = true;
+  redrawnArea = 0;
+  clearBuffersState.vertices = BufferDesc(2, FLOAT, 0, 0, false);
+  batched = false;
+  drawList = NULL;
 }
 
 Desktop::~Desktop() {
+  freeCache();
+  delete drawList;
 }
 
 Outcome Desktop::init() {
@@ -19,11 +41,329 @@ Outcome Desktop::init() {
 }
 
 Outcome Desktop::render() {
+  if (retained) {
+    return renderRetained();
+  }
+
+  return renderObjects(NULL);
+}
+
+Outcome Desktop::renderObjects(const DirtyRect *rect) {
+  if (batched && drawList == NULL) {
+    drawList = new UIDrawList(engine);
+    CHECK_ALLOC(drawList);
+
+    Outcome result = drawList->initialize();
+    if (result != OK) {
+      delete drawList;
+      drawList = NULL;
+      return result;
+    }
+  }
+
+  if (batched) {
+    drawList->clear();
+  }
+
   uint size = getObjectsCount();
   for (uint i = 0; i < size; i++) {
-    ASSERT(getObject(i)->render());
+    AbstractSprite *object = getObject(i);
+
+    if (rect != NULL) {
+      DirtyRect *bounds = drawnBounds.find(object);
+      if (bounds == NULL || bounds->left >= rect->right || rect->left >= bounds->right ||
+        bounds->top >= rect->bottom || rect->top >= bounds->bottom) {
+        continue;
+      }
+    }
+
+    if (batched) {
+      ASSERT(object->draw(drawList));
+    } else {
+      ASSERT(object->render());
+    }
+  }
+
+  if (batched) {
+    ASSERT(drawList->submit());
+  }
+  return OK;
+}
+
+Outcome Desktop::createCache(int width, int height) {
+  cacheWidth = width;
+  cacheHeight = height;
+
+  cacheBuffer = engine->createFrameBuffer();
+  CHECK_POINTER(cacheBuffer);
+  cacheTexture = engine->createTexture(RGBA8, width, height, RGBA8, NULL, false);
+  CHECK_POINTER(cacheTexture);
+
+  ASSERT(cacheBuffer->bind());
+  ASSERT(cacheBuffer->attachTexture2D(cacheTexture, COLOR_ATTACHMENT0));
+  FrameBufferStatus status = engine->checkFrameBufferStatus();
+  ASSERT(cacheBuffer->unbind());
+  ERROR_IF(status != FRAMEBUFFER_COMPLETE
+    , L"Frame buffer status: " + StringTool::intToStr((int)status)
+    , ERROR);
+
+  cacheSprite = new Sprite(engine);
+  CHECK_ALLOC(cacheSprite);
+  cacheSprite->setTexture(cacheTexture);
+  cacheSprite->setSize((float)width, (float)height);
+  return OK;
+}
+
+void Desktop::freeCache() {
+  // Destructors release GPU objects and unregister them in the memory manager,
+  // the sprite and the frame buffer refer to the texture, so they go first
+  delete cacheSprite;
+  delete cacheBuffer;
+  delete cacheTexture;
+  cacheSprite = NULL;
+  cacheBuffer = NULL;
+  cacheTexture = NULL;
+  cacheWidth = cacheHeight = 0;
+}
+
+Desktop::DirtyRect Desktop::getBounds(AbstractSprite *object) {
+  float left, top, right, bottom;
+  object->getDrawBounds(left, top, right, bottom);
+
+  DirtyRect rect;
+  rect.left = std::max(0, (int)floorf(left) - DIRTY_MARGIN);
+  rect.top = std::max(0, (int)floorf(top) - DIRTY_MARGIN);
+  rect.right = std::min(cacheWidth, (int)ceilf(right) + DIRTY_MARGIN);
+  rect.bottom = std::min(cacheHeight, (int)ceilf(bottom) + DIRTY_MARGIN);
+  return rect;
+}
+
+void Desktop::markChanged(AbstractSprite *object) {
+  if (!retained) {
+    return;
+  }
+
+  // Old area is redrawn now, new one is known only when changes are finished
+  DirtyRect *bounds = drawnBounds.find(object);
+  if (bounds != NULL) {
+    dirtyRects.push_back(*bounds);
+  }
+
+  if (std::find(changedObjects.begin(), changedObjects.end(), object) == changedObjects.end()) {
+    changedObjects.push_back(object);
+  }
+}
+
+void Desktop::mergeDirtyRects() {
+  uint i = 0;
+  while (i < dirtyRects.size()) {
+    DirtyRect &rect = dirtyRects[i];
+    if (rect.left >= rect.right || rect.top >= rect.bottom) {
+      rect = dirtyRects.back();
+      dirtyRects.pop_back();
+    } else {
+      i++;
+    }
+  }
+
+  // Overlapping rectangles are united until there are no overlaps
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (uint i = 0; i < dirtyRects.size(); i++) {
+      for (uint j = i + 1; j < dirtyRects.size(); j++) {
+        DirtyRect &a = dirtyRects[i];
+        DirtyRect &b = dirtyRects[j];
+
+        if (a.left <= b.right && b.left <= a.right && a.top <= b.bottom && b.top <= a.bottom) {
+          a.left = std::min(a.left, b.left);
+          a.top = std::min(a.top, b.top);
+          a.right = std::max(a.right, b.right);
+          a.bottom = std::max(a.bottom, b.bottom);
+          b = dirtyRects.back();
+          dirtyRects.pop_back();
+          merged = true;
+          j--;
+        }
+      }
+    }
+  }
+
+  if (dirtyRects.size() > MAX_DIRTY_RECTS) {
+    for (uint i = 1; i < dirtyRects.size(); i++) {
+      dirtyRects[0].left = std::min(dirtyRects[0].left, dirtyRects[i].left);
+      dirtyRects[0].top = std::min(dirtyRects[0].top, dirtyRects[i].top);
+      dirtyRects[0].right = std::max(dirtyRects[0].right, dirtyRects[i].right);
+      dirtyRects[0].bottom = std::max(dirtyRects[0].bottom, dirtyRects[i].bottom);
+    }
+    dirtyRects.resize(1);
+  }
+}
+
+Outcome Desktop::redraw(const DirtyRect &rect) {
+  GPUStateManager *stateManager = engine->getStateManager();
+
+  // Texture has origin in the left-bottom corner
+  ASSERT(stateManager->setScissorState(ScissorState(rect.left, cacheHeight - rect.bottom,
+    rect.right - rect.left, rect.bottom - rect.top)));
+
+  // Rectangle is cleared to transparent color, so the scene is seen through empty areas
+  float left = (float)rect.left;
+  float top = (float)rect.top;
+  float right = (float)rect.right;
+  float bottom = (float)rect.bottom;
+  float vertices[] = { left, top, left, bottom, right, bottom, right, top };
+  clearBuffersState.vertices.data = vertices;
+
+  stateManager->pushStates(ALPHA_TEST_STATE | BLEND_STATE | COLOR_STATE | TEXTURES_STATE | BUFFERS_STATE);
+  ASSERT(stateManager->setAlphaTestState(AlphaTestState()));
+  ASSERT(stateManager->setBlendState(BlendState()));
+  ASSERT(stateManager->setColorState(ColorState(0, 0, 0, 0)));
+  ASSERT(stateManager->setTexturesState(TexturesState()));
+  ASSERT(stateManager->setBuffersState(clearBuffersState));
+  ASSERT(engine->drawPrimitives(QUADS, 0, 4));
+  stateManager->popStates(ALPHA_TEST_STATE | BLEND_STATE | COLOR_STATE | TEXTURES_STATE | BUFFERS_STATE);
+
+  ASSERT(renderObjects(&rect));
+
+  redrawnArea += (rect.right - rect.left) * (rect.bottom - rect.top);
+  return OK;
+}
+
+Outcome Desktop::renderRetained() {
+  GPUStateManager *stateManager = engine->getStateManager();
+  ViewportState viewport = stateManager->getViewportState();
+
+  if (cacheBuffer == NULL || viewport.width != cacheWidth || viewport.height != cacheHeight) {
+    freeCache();
+    ASSERT(createCache(viewport.width, viewport.height));
+    fullRedraw = true;
   }
+
+  redrawnArea = 0;
+
+  if (fullRedraw) {
+    fullRedraw = false;
+    changedObjects.clear();
+    drawnBounds.clear();
+    dirtyRects.clear();
+
+    uint size = getObjectsCount();
+    for (uint i = 0; i < size; i++) {
+      if (getObject(i)->isVisible()) {
+        drawnBounds.insert(getObject(i), getBounds(getObject(i)));
+      }
+    }
+
+    DirtyRect all = { 0, 0, cacheWidth, cacheHeight };
+    dirtyRects.push_back(all);
+  } else {
+    // New areas of changed components
+    for (uint i = 0; i < changedObjects.size(); i++) {
+      AbstractSprite *object = changedObjects[i];
+
+      if (object->isVisible()) {
+        DirtyRect bounds = getBounds(object);
+        drawnBounds.insert(object, bounds);
+        dirtyRects.push_back(bounds);
+      } else {
+        drawnBounds.remove(object);
+      }
+    }
+
+    changedObjects.clear();
+    mergeDirtyRects();
+  }
+
+  if (!dirtyRects.empty()) {
+    stateManager->pushStates(SCISSOR_STATE | DEPTH_TEST_STATE | VIEWPORT_STATE);
+    ASSERT(cacheBuffer->bind());
+    ASSERT(stateManager->setViewportState(ViewportState(0, 0, cacheWidth, cacheHeight)));
+    ASSERT(stateManager->setDepthTestState(DepthTestState()));
+
+    for (uint i = 0; i < dirtyRects.size(); i++) {
+      ASSERT(redraw(dirtyRects[i]));
+    }
+
+    ASSERT(cacheBuffer->unbind());
+    stateManager->popStates(SCISSOR_STATE | DEPTH_TEST_STATE | VIEWPORT_STATE);
+    dirtyRects.clear();
+  }
+
+  ASSERT(cacheSprite->render());
   return OK;
 }
 
-}
\ No newline at end of file
+void Desktop::setRetained(bool value) {
+  if (retained == value) {
+    return;
+  }
+
+  retained = value;
+  fullRedraw = true;
+  changedObjects.clear();
+  dirtyRects.clear();
+  drawnBounds.clear();
+
+  if (!retained) {
+    freeCache();
+  }
+}
+
+bool Desktop::isRetained() {
+  return retained;
+}
+
+void Desktop::setBatched(bool value) {
+  batched = value;
+}
+
+bool Desktop::isBatched() {
+  return batched;
+}
+
+UIDrawList *Desktop::getDrawList() {
+  return drawList;
+}
+
+uint Desktop::getRedrawnArea() {
+  return redrawnArea;
+}
+
+Outcome Desktop::addObject(AbstractSprite *newControl) {
+  ASSERT(UIContainer::addObject(newControl));
+  markChanged(newControl);
+  return OK;
+}
+
+void Desktop::removeObject(AbstractSprite *object) {
+  DirtyRect *bounds = drawnBounds.find(object);
+  if (bounds != NULL) {
+    dirtyRects.push_back(*bounds);
+    drawnBounds.remove(object);
+  }
+
+  std::vector<AbstractSprite *>::iterator it = std::find(changedObjects.begin(), changedObjects.end(), object);
+  if (it != changedObjects.end()) {
+    changedObjects.erase(it);
+  }
+
+  UIContainer::removeObject(object);
+}
+
+Outcome Desktop::clearObjects() {
+  fullRedraw = true;
+  return UIContainer::clearObjects();
+}
+
+void Desktop::onLayoutChange(AbstractSprite *sprite) {
+  UIContainer::onLayoutChange(sprite);
+  markChanged(sprite);
+}
+
+void Desktop::onContentChange(AbstractSprite *sprite) {
+  UIContainer::onContentChange(sprite);
+  markChanged(sprite);
+}
+
+}
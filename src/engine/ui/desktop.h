@@ -8,8 +8,13 @@
 
 #include "engine/ui/ui_container.h"
 #include "engine/sprites/abstract_sprite.h"
+#include "engine/sprites/sprite.h"
 #include "engine/events/key_listener.h"
 #include "engine/events/mouse_listener.h"
+#include "engine/buffers/frame_buffer.h"
+#include "engine/states/buffer_state.h"
+#include "engine/tools/hash_map.h"
+#include "engine/ui/ui_draw_list.h"
 
 namespace ve {
 
@@ -18,8 +23,109 @@ class UI;
 /**
   Desktop is a set of Sprite objects. It represent an easy way to switch
   different menu screens in the game.
+
+  In retained mode desktop keeps rendered components in an off-screen texture.
+  Components report changes of their properties, their old and new areas are
+  collected as dirty rectangles and only these rectangles are redrawn into the
+  texture with scissor test. Then the texture is drawn on the screen with one quad.
+  Retained mode expects the usual UI camera: one unit is one pixel and (0, 0) is
+  the left-upper corner of the viewport. Components are drawn in the order of adding
+  without depth buffer.
+
+  In batched mode components append their geometry to UIDrawList and the whole
+  desktop is rendered with a few draw calls. Both modes may be combined.
 */
 class Desktop : public UIContainer {
+private:
+  /**
+      Rectangle of the screen in pixels, right and bottom bounds are excluded.
+  */
+  struct DirtyRect {
+    int left;
+    int top;
+    int right;
+    int bottom;
+  };
+
+  /** Flag of retained mode */
+  bool retained;
+
+  /** Off-screen buffer with rendered components */
+  FrameBuffer *cacheBuffer;
+
+  /** Color attachment of the off-screen buffer */
+  Texture *cacheTexture;
+
+  /** Sprite which draws the texture on the screen */
+  Sprite *cacheSprite;
+
+  /** Size of the off-screen buffer */
+  int cacheWidth, cacheHeight;
+
+  /** Areas which components cover in the off-screen texture */
+  HashMap<AbstractSprite *, DirtyRect> drawnBounds;
+
+  /** Components which were changed since the last rendering */
+  std::vector<AbstractSprite *> changedObjects;
+
+  /** Areas of the texture to redraw */
+  std::vector<DirtyRect> dirtyRects;
+
+  /** Whole texture should be redrawn */
+  bool fullRedraw;
+
+  /** Number of pixels redrawn by the last render() call */
+  uint redrawnArea;
+
+  /** Buffers state to clear dirty rectangles */
+  BuffersState clearBuffersState;
+
+  /** Flag of batched mode */
+  bool batched;
+
+  /** Draw list for batched mode, it is created on the first rendering */
+  UIDrawList *drawList;
+
+  /**
+      Creates off-screen buffer of the given size.
+  */
+  Outcome createCache(int width, int height);
+
+  /**
+      Frees off-screen buffer.
+  */
+  void freeCache();
+
+  /**
+      Returns rectangle which the component covers, it is clamped to the texture.
+  */
+  DirtyRect getBounds(AbstractSprite *object);
+
+  /**
+      Remembers that the component should be redrawn.
+  */
+  void markChanged(AbstractSprite *object);
+
+  /**
+      Merges overlapping dirty rectangles.
+  */
+  void mergeDirtyRects();
+
+  /**
+      Renders visible components, only ones which intersect the rectangle if it is set.
+  */
+  Outcome renderObjects(const DirtyRect *rect);
+
+  /**
+      Redraws components which intersect the rectangle.
+  */
+  Outcome redraw(const DirtyRect &rect);
+
+  /**
+      Renders texture in retained mode.
+  */
+  Outcome renderRetained();
+
 protected:
   int id;
 
@@ -48,8 +154,77 @@ public:
     @return non-OK if error occurred.
   */
   virtual Outcome render();
+
+  /**
+    Enables or disables retained mode. Off-screen texture is created on the
+    next rendering and is freed when the mode is disabled.
+    @param value - 'true' to enable retained mode.
+  */
+  void setRetained(bool value);
+
+  /**
+    Checks if retained mode is enabled.
+    @return 'true' if retained mode is enabled.
+  */
+  bool isRetained();
+
+  /**
+    Enables or disables batched mode. Draw list is created on the next rendering.
+    @param value - 'true' to render components through the draw list.
+  */
+  void setBatched(bool value);
+
+  /**
+    Checks if batched mode is enabled.
+    @return 'true' if batched mode is enabled.
+  */
+  bool isBatched();
+
+  /**
+    Returns draw list of batched mode.
+    @return Draw list or NULL if desktop was not rendered in batched mode yet.
+  */
+  UIDrawList *getDrawList();
+
+  /**
+    Returns area which was redrawn by the last render() call in retained mode.
+    @return Number of redrawn pixels, 0 if nothing was changed.
+  */
+  uint getRedrawnArea();
+
+  /**
+    Adds component and marks its area to be redrawn.
+    @param newControl - Control to add to this desktop.
+    @return OK if pointer is not NULL.
+    @return NULL_POINTER if pointer is NULL.
+  */
+  virtual Outcome addObject(AbstractSprite *newControl);
+
+  /**
+    Removes component and marks its area to be redrawn.
+    @param object - Object to remove.
+  */
+  virtual void removeObject(AbstractSprite *object);
+
+  /**
+    Removes all components, the whole desktop is redrawn.
+    @return OK everytime.
+  */
+  virtual Outcome clearObjects();
+
+  /**
+    Marks old and new areas of the component to be redrawn.
+    @param sprite - Component which was moved or resized.
+  */
+  virtual void onLayoutChange(AbstractSprite *sprite);
+
+  /**
+    Marks area of the component to be redrawn.
+    @param sprite - Component which was changed.
+  */
+  virtual void onContentChange(AbstractSprite *sprite);
 };
 
 }
 
-#endif // __VE_DESKTOP_H__
\ No newline at end of file
+#endif // __VE_DESKTOP_H__
@@ -5,6 +5,7 @@
 #include "ui/editbox.h"
 #include "tools/string_tool.h"
 #include "engines/engine.h"
+#include "ui/ui_draw_list.h"
 
 namespace ve {
 
@@ -50,11 +51,43 @@ Outcome Editbox::render() {
   return OK;
 }
 
+Outcome Editbox::draw(UIDrawList *list) {
+  CHECK_POINTER(list);
+
+  if (!isVisible()) {
+    return OK;
+  }
+
+  list->pushTranslation(getX(), getY(), getZ());
+
+  if (isActive == true && activeBackground != NULL) {
+    activeBackground->setSize(getWidth(), getHeight());
+    ASSERT(activeBackground->draw(list));
+  } else {
+    if (background != NULL) {
+      background->setSize(getWidth(), getHeight());
+      ASSERT(background->draw(list));
+    }
+  }
+
+  if (label->getFont() != NULL) {
+    list->pushClipRect(0, 0, getWidth(), getHeight());
+    list->pushTranslation(5, (getHeight() - label->getFont()->getHeight()) / 2, 0);
+    ASSERT(label->draw(list));
+    list->popTranslation();
+    list->popClipRect();
+  }
+
+  list->popTranslation();
+  return OK;
+}
+
 Outcome Editbox::processMouseEvent(MouseEvent *event) {
   CHECK_RESULT(UIControl::processMouseEvent(event), L"Mouse event processing failed");
 
-  if (event->getType() == MOUSE_PRESS) {
+  if (event->getType() == MOUSE_PRESS && isActive != isCovered()) {
     isActive = isCovered();
+    invalidate();
   }
 
   return OK;
@@ -82,6 +115,7 @@ Outcome Editbox::processKeyEvent(KeyEvent *event) {
 
 void Editbox::setBackgroundSprite(AbstractSprite *background) {
   this->background = background;
+  invalidate();
 }
 
 AbstractSprite* Editbox::getBackgroundSprite() {
@@ -90,6 +124,7 @@ AbstractSprite* Editbox::getBackgroundSprite() {
 
 void Editbox::setActiveBackgroundSprite(AbstractSprite *activeBackground) {
   this->activeBackground = activeBackground;
+  invalidate();
 }
 
 AbstractSprite* Editbox::getActiveBackgroundSprite() {
@@ -62,6 +62,15 @@ public:
   */
   virtual Outcome render();
 
+  /**
+      Appends background and text to the draw list. Text is clipped by the
+      area of the component.
+      @param list - Draw list of the frame.
+      @return OK if geometry was appended.
+      @return non-OK if error occurred.
+  */
+  virtual Outcome draw(UIDrawList *list);
+
   /**
       Handles mouse events. Here, Editbox decides when it is
       active or not-active. After every mouse press message it
@@ -9,6 +9,7 @@
 #include "events/system_event.h"
 #include "events/mouse_event.h"
 #include "engines/engine.h"
+#include "ui/ui_draw_list.h"
 
 namespace ve {
 
@@ -69,6 +70,51 @@ Outcome Form::render() {
   return OK;
 }
 
+Outcome Form::draw(UIDrawList *list) {
+  CHECK_POINTER(list);
+
+  if (!isVisible()) {
+    return OK;
+  }
+
+  ERROR_IF(captionSprite == NULL && backgroundSprite == NULL && border == NULL,
+    L"Nothing to render. Is this an intend?", ERROR);
+
+  int width = getWidth();
+  int height = getHeight();
+
+  list->pushTranslation(getX(), getY(), getZ());
+
+  if (captionSprite != NULL) {
+    captionSprite->setSize(width, 20); ///FIXME: Define caption size
+    ASSERT(captionSprite->draw(list));
+  }
+
+  if (backgroundSprite != NULL) {
+    backgroundSprite->setSize(width, height - 20);
+    list->pushTranslation(0, 20, 0); ///FIXME: Define caption size
+    ASSERT(backgroundSprite->draw(list));
+    list->popTranslation();
+  }
+
+  if (border != NULL) {
+    border->setSize(width, height);
+    ASSERT(border->draw(list));
+  }
+
+  list->pushTranslation(0, 20, 0); /// FIXME: Caption size
+  list->pushClipRect(0, 0, width, height - 20);
+  int len = getObjectsCount();
+  for (int i = 0; i < len; i++) {
+    ASSERT(getObject(i)->draw(list));
+  }
+  list->popClipRect();
+  list->popTranslation();
+
+  list->popTranslation();
+  return OK;
+}
+
 /* Inherited from MouseListener */
 Outcome Form::processMouseEvent(MouseEvent *event) {
   int x = event->getX();
@@ -118,10 +164,12 @@ Outcome Form::processMouseEvent(MouseEvent *event) {
 /* Set functions */
 void Form::setBackground(AbstractSprite* background) {
   backgroundSprite = background;
+  invalidate();
 }
 
 void Form::setCaption(AbstractSprite* caption) {
   captionSprite = caption;
+  invalidate();
 }
 
 bool Form::onCanMove(int x, int y) {
@@ -138,6 +186,7 @@ AbstractSprite* Form::getBackgroundSprite() {
 
 void Form::setBorder(Border *border) {
   this->border = border;
+  invalidate();
 }
 
 void Form::setMovable(bool isEnabled) {
@@ -67,6 +67,15 @@ public:
   */
   virtual Outcome render();
 
+  /**
+      Appends caption, background, border and components to the draw list.
+      Components are clipped by the client area.
+      @param list - Draw list of the frame.
+      @return OK if geometry was appended.
+      @return non-OK if error occurred.
+  */
+  virtual Outcome draw(UIDrawList *list);
+
   /**
       Process mouse events, form movements, generates mouse messages for
       interface components inside this form.
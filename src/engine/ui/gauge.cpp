@@ -5,6 +5,7 @@
 #include "engines/engine.h"
 #include "ui/gauge.h"
 #include "ui/ui.h"
+#include "ui/ui_draw_list.h"
 
 namespace ve {
 
@@ -94,8 +95,54 @@ Outcome Gauge::render() {
   return OK;
 }
 
+Outcome Gauge::draw(UIDrawList *list) {
+  CHECK_POINTER(list);
+
+  if (!isVisible()) {
+    return OK;
+  }
+
+  ERROR_IF(background == NULL && bar == NULL, L"Nothing to render", ERROR);
+
+  list->pushTranslation(getX(), getY(), getZ());
+  if (background != NULL) {
+    background->setSize(getWidth(), getHeight());
+    ASSERT(background->draw(list));
+  }
+
+  if (bar != NULL) {
+    /* Apply texture coords interpolation, draw list copies them at once */
+    float t = (float)(value - GAUGE_MIN) / (GAUGE_MAX - GAUGE_MIN);
+
+    Vector2f startCoords1 = bar->getTexCoords(firstBasisVector.first);
+    Vector2f endCoords1 = bar->getTexCoords(firstBasisVector.second);
+    bar->setTexCoords(firstBasisVector.second, startCoords1 + (endCoords1 - startCoords1) * t);
+
+    Vector2f startCoords2 = bar->getTexCoords(secondBasisVector.first);
+    Vector2f endCoords2 = bar->getTexCoords(secondBasisVector.second);
+    bar->setTexCoords(secondBasisVector.second, startCoords2 + (endCoords2 - startCoords2) * t);
+
+    bar->setSize(t * getWidth(), getHeight());
+    Outcome result = bar->draw(list);
+
+    /* Restore texture coordinates */
+    bar->setTexCoords(firstBasisVector.second, endCoords1);
+    bar->setTexCoords(secondBasisVector.second, endCoords2);
+    ASSERT(result);
+  }
+
+  if (labelEnabled) {
+    label->setText(StringTool::intToStr((int)(100.0 * ((float)value - GAUGE_MIN) / (GAUGE_MAX - GAUGE_MIN))) + L" %");
+    ASSERT(label->draw(list));
+  }
+
+  list->popTranslation();
+  return OK;
+}
+
 void Gauge::setBackgroundSprite(AbstractSprite *backgroundSprite) {
   background = backgroundSprite;
+  invalidate();
 }
 
 AbstractSprite* Gauge::getBackgroundSprite() {
@@ -104,6 +151,7 @@ AbstractSprite* Gauge::getBackgroundSprite() {
 
 void Gauge::setBarSprite(Sprite *barSprite) {
   bar = barSprite;
+  invalidate();
 }
 
 Sprite* Gauge::getBarSprite() {
@@ -116,11 +164,13 @@ Label* Gauge::getLabel() {
 
 void Gauge::setLabel(bool isEnabled) {
   labelEnabled = isEnabled;
+  invalidate();
 }
 
 void Gauge::setValue(int newValue) {
   value = newValue;
   normalize();
+  invalidate();
 }
 
 int Gauge::getValue() {
@@ -136,6 +186,7 @@ void Gauge::setBasisVector(uint index, pair<int, int> texCoordsPair) {
     } else {
       LOG_ERROR(L"Index " + StringTool::intToStr(index) + L" is out of bounds");
     }
+  invalidate();
 }
 
 pair<int, int> Gauge::getBasisVector(uint index) {
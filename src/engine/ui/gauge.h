@@ -66,6 +66,14 @@ public:
   */
   virtual Outcome render();
 
+  /**
+      Appends background, bar and label to the draw list.
+      @param list - Draw list of the frame.
+      @return OK if geometry was appended.
+      @return NULL_POINTER may be returned if Label is used, but font is not set.
+  */
+  virtual Outcome draw(UIDrawList *list);
+
   /**
       Sets background sprite for this gauge. Passing NULL
       will disable background sprite rendering.
@@ -4,6 +4,7 @@
 #include "common.h"
 #include "ui/label.h"
 #include "engines/engine.h"
+#include "ui/ui_draw_list.h"
 
 namespace ve {
 
@@ -51,21 +52,62 @@ Outcome Label::render() {
   return OK;
 }
 
+Outcome Label::draw(UIDrawList *list) {
+  CHECK_POINTER(list);
+
+  if (!isVisible()) {
+    return OK;
+  }
+
+  CHECK_POINTER(font);
+  uint firstLetter = 0;
+  uint len = text.length();
+
+  if (lengthBound != 0) {
+    while (len > 0 && font->getTextWidth(text.substr(firstLetter, len)) > (uint)lengthBound) {
+      firstLetter++;
+      len--;
+    }
+  }
+
+  return list->addText(font, getX(), getY(), getZ(), text.substr(firstLetter, len), color);
+}
+
 /* set functions */
 void Label::setText(std::wstring newText) {
-  text = newText;
+  if (text != newText) {
+    text = newText;
+    invalidate();
+  }
 }
 
 void Label::setColor(Vector4f newColor) {
   color = newColor;
+  invalidate();
 }
 
 void Label::setFont(Font* newFont) {
   font = newFont;
+  invalidate();
 }
 
 void Label::setLengthBound(uint length) {
   lengthBound = length;
+  invalidate();
+}
+
+void Label::getDrawBounds(float &left, float &top, float &right, float &bottom) {
+  UIControl::getDrawBounds(left, top, right, bottom);
+
+  // Text is not limited by the size of the label, it is drawn from the position
+  // and may lie above or below it depending on the font
+  if (font != NULL) {
+    float y = top;
+    float height = (float)font->getHeight();
+    right = Maths::max(right, left + (float)font->getTextWidth(text) + font->getWidth());
+    top = Maths::min(top, y - height);
+    bottom = Maths::max(bottom, y + 2 * height);
+  }
 }
 
 /* get functions */
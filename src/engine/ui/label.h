@@ -55,6 +55,23 @@ public:
   */
   virtual Outcome render();
 
+  /**
+      Appends text of the label to the draw list.
+      @param list - Draw list of the frame.
+      @return OK if text was appended.
+      @return non-OK if font is not set or symbols can not be cached.
+  */
+  virtual Outcome draw(UIDrawList *list);
+
+  /**
+      Returns area which is covered by the text of this label.
+      @param left - Receives left bound.
+      @param top - Receives top bound.
+      @param right - Receives right bound.
+      @param bottom - Receives bottom bound.
+  */
+  virtual void getDrawBounds(float &left, float &top, float &right, float &bottom);
+
   /**
       Sets text for this label.
       @param newText - new text for this label.
@@ -3,6 +3,7 @@
 
 #include "ui/slot.h"
 #include "ui/slot_item.h"
+#include "ui/ui_draw_list.h"
 
 namespace ve {
 
@@ -21,6 +22,7 @@ Slot::~Slot() {
 
 void Slot::setSprite(AbstractSprite *sprite) {
   this->sprite = sprite;
+  invalidate();
 }
 
 bool Slot::isAvaialble() {
@@ -41,6 +43,7 @@ void Slot::assign(SlotItem *item) {
   }
 
   this->item = item;
+  invalidate();
 }
 
 Outcome Slot::render() {
@@ -52,4 +55,14 @@ Outcome Slot::render() {
   return sprite->render();
 }
 
+Outcome Slot::draw(UIDrawList *list) {
+  CHECK_POINTER(list);
+  CHECK_POINTER(sprite);
+
+  sprite->setPosition(getPosition());
+  sprite->setSize(getWidth(), getHeight());
+
+  return sprite->draw(list);
+}
+
 }
\ No newline at end of file
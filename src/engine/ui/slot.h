@@ -71,6 +71,14 @@ public:
       @return non-OK if error occurred.
   */
   virtual Outcome render();
+
+  /**
+      Appends sprite to the draw list.
+      @param list - Draw list of the frame.
+      @return OK if geometry was appended.
+      @return non-OK if error occurred.
+  */
+  virtual Outcome draw(UIDrawList *list);
 };
 
 }
@@ -5,6 +5,7 @@
 #include <limits>
 
 #include "ui/slot_item.h"
+#include "ui/ui_draw_list.h"
 
 namespace ve {
 
@@ -25,6 +26,7 @@ SlotItem::~SlotItem() {
 
 void SlotItem::setSprite(AbstractSprite *sprite) {
   this->sprite = sprite;
+  invalidate();
 }
 
 Outcome SlotItem::setSlot(Slot *slot) {
@@ -74,6 +76,19 @@ Outcome SlotItem::render() {
   return OK;
 }
 
+Outcome SlotItem::draw(UIDrawList *list) {
+  CHECK_POINTER(list);
+  CHECK_POINTER(sprite);
+
+  if (currentSlot != NULL) {
+    sprite->setPosition(getPosition());
+    sprite->setSize(getWidth(), getHeight());
+    return sprite->draw(list);
+  }
+
+  return OK;
+}
+
 Outcome SlotItem::processMouseEvent(MouseEvent *event) {
   ASSERT(UIControl::processMouseEvent(event));
 
@@ -94,6 +94,14 @@ public:
   */
   virtual Outcome render();
 
+  /**
+    Appends sprite to the draw list.
+    @param list - Draw list of the frame.
+    @return OK if geometry was appended.
+    @return non-OK if error occurred.
+  */
+  virtual Outcome draw(UIDrawList *list);
+
   /**
    Handles mouse events to implement drag & drop functionality.
    @param event - mouse event to process.
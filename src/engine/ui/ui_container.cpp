@@ -2,13 +2,28 @@
 // All rights reserved.
 
 #include <algorithm>
+#include <math.h>
 
 #include "common.h"
+#include "math/maths.h"
 #include "ui/ui_container.h"
 
 namespace ve {
 
+/* Limit of grid columns and rows */
+static const uint MAX_GRID_SIDE = 32;
+
 UIContainer::UIContainer(UIContainer *parent) :UIControl(parent) {
+  gridX = gridY = 0;
+  cellWidth = cellHeight = 1;
+  columns = rows = 0;
+  layoutChanged = true;
+}
+
+UIContainer::~UIContainer() {
+  for (uint i = 0; i < objects.size(); i++) {
+    objects[i]->setLayoutListener(NULL);
+  }
 }
 
 Outcome UIContainer::addObject(AbstractSprite *newControl) {
@@ -16,6 +31,8 @@ Outcome UIContainer::addObject(AbstractSprite *newControl) {
   objects.push_back(newControl);
   addMouseListener(newControl);
   addKeyListener(newControl);
+  newControl->setLayoutListener(this);
+  layoutChanged = true;
   return OK;
 }
 
@@ -23,15 +40,29 @@ void UIContainer::removeObject(AbstractSprite *object) {
   std::vector<AbstractSprite*>::iterator it = std::find(objects.begin(), objects.end(), object);
   if (it != objects.end()) {
     objects.erase(it);
+    object->setLayoutListener(NULL);
   }
+
+  it = std::find(hoveredObjects.begin(), hoveredObjects.end(), object);
+  if (it != hoveredObjects.end()) {
+    hoveredObjects.erase(it);
+  }
+
   removeMouseListener(object);
   removeKeyListener(object);
+  layoutChanged = true;
 }
 
 Outcome UIContainer::clearObjects() {
+  for (uint i = 0; i < objects.size(); i++) {
+    objects[i]->setLayoutListener(NULL);
+  }
+
   objects.clear();
+  hoveredObjects.clear();
   clearMouseListeners();
   clearKeyListeners();
+  layoutChanged = true;
   return OK;
 }
 
@@ -44,6 +75,100 @@ AbstractSprite* UIContainer::getObject(uint index) {
   return objects[index];
 }
 
+void UIContainer::onLayoutChange(AbstractSprite *) {
+  layoutChanged = true;
+  invalidate();
+}
+
+void UIContainer::onContentChange(AbstractSprite *) {
+  invalidate();
+}
+
+void UIContainer::getCells(float left, float top, float right, float bottom, uint &firstColumn,
+  uint &firstRow, uint &lastColumn, uint &lastRow) {
+  float maxColumn = (float)columns - 1;
+  float maxRow = (float)rows - 1;
+
+  firstColumn = (uint)Maths::max(0.0f, Maths::min(maxColumn, floorf((left - gridX) / cellWidth)));
+  lastColumn = (uint)Maths::max(0.0f, Maths::min(maxColumn, floorf((right - gridX) / cellWidth)));
+  firstRow = (uint)Maths::max(0.0f, Maths::min(maxRow, floorf((top - gridY) / cellHeight)));
+  lastRow = (uint)Maths::max(0.0f, Maths::min(maxRow, floorf((bottom - gridY) / cellHeight)));
+}
+
+void UIContainer::buildGrid() {
+  layoutChanged = false;
+  cellObjects.clear();
+  cellStarts.clear();
+  columns = rows = 0;
+
+  uint count = objects.size();
+  if (count == 0) {
+    return;
+  }
+
+  float right = objects[0]->getX() + objects[0]->getWidth();
+  float bottom = objects[0]->getY() + objects[0]->getHeight();
+  gridX = objects[0]->getX();
+  gridY = objects[0]->getY();
+
+  for (uint i = 1; i < count; i++) {
+    gridX = Maths::min(gridX, objects[i]->getX());
+    gridY = Maths::min(gridY, objects[i]->getY());
+    right = Maths::max(right, objects[i]->getX() + objects[i]->getWidth());
+    bottom = Maths::max(bottom, objects[i]->getY() + objects[i]->getHeight());
+  }
+
+  // About one object per cell
+  columns = rows = std::min(MAX_GRID_SIDE, (uint)ceilf(sqrtf((float)count)));
+  cellWidth = Maths::max(1.0f, (right - gridX) / columns);
+  cellHeight = Maths::max(1.0f, (bottom - gridY) / rows);
+
+  // Objects are counted for every cell and then written to their places
+  cellStarts.assign(columns * rows + 1, 0);
+  uint firstColumn, firstRow, lastColumn, lastRow;
+
+  for (uint i = 0; i < count; i++) {
+    AbstractSprite *object = objects[i];
+    getCells(object->getX(), object->getY(), object->getX() + object->getWidth(),
+      object->getY() + object->getHeight(), firstColumn, firstRow, lastColumn, lastRow);
+
+    for (uint row = firstRow; row <= lastRow; row++) {
+      for (uint column = firstColumn; column <= lastColumn; column++) {
+        cellStarts[row * columns + column + 1]++;
+      }
+    }
+  }
+
+  for (uint i = 1; i < cellStarts.size(); i++) {
+    cellStarts[i] += cellStarts[i - 1];
+  }
+
+  std::vector<uint> offsets(cellStarts.begin(), cellStarts.end() - 1);
+  cellObjects.resize(cellStarts.back());
+
+  for (uint i = 0; i < count; i++) {
+    AbstractSprite *object = objects[i];
+    getCells(object->getX(), object->getY(), object->getX() + object->getWidth(),
+      object->getY() + object->getHeight(), firstColumn, firstRow, lastColumn, lastRow);
+
+    for (uint row = firstRow; row <= lastRow; row++) {
+      for (uint column = firstColumn; column <= lastColumn; column++) {
+        cellObjects[offsets[row * columns + column]++] = i;
+      }
+    }
+  }
+}
+
+bool UIContainer::contains(AbstractSprite *object, int x, int y) {
+  return x >= object->getX() && x <= object->getX() + object->getWidth() &&
+    y >= object->getY() && y <= object->getY() + object->getHeight();
+}
+
+Outcome UIContainer::sendHoverEvent(AbstractSprite *object, SystemEventType type, int x, int y) {
+  MouseEvent event(type, (MouseButton)0, x, y, x - (int)object->getX(), y - (int)object->getY());
+  return object->processMouseEvent(&event);
+}
+
 Outcome UIContainer::processMouseEvent(MouseEvent *event) {
   ASSERT(UIControl::processMouseEvent(event));
 
@@ -52,26 +177,44 @@ Outcome UIContainer::processMouseEvent(MouseEvent *event) {
   {
     int x = ((MouseEvent*)event)->getX();
     int y = ((MouseEvent*)event)->getY();
-    uint len = objects.size();
-
-    for (uint i = 0; i < len; i++) {
-      AbstractSprite *iControl = objects[i];
-
-      if (x >= iControl->getX() && x <= iControl->getX() + iControl->getWidth() &&
-        y >= iControl->getY() && y <= iControl->getY() + iControl->getHeight()) {
-        if (!iControl->isCovered()) {
-          MouseEvent *me = new MouseEvent(MOUSE_ENTER, (MouseButton)0, x, y, x - (int)iControl->getX(),
-            y - (int)iControl->getY());
-          ASSERT(iControl->processMouseEvent(me));
-          delete me;
-        }
-      } else {
+
+    // Objects which are not under the mouse anymore
+    for (uint i = 0; i < hoveredObjects.size();) {
+      AbstractSprite *iControl = hoveredObjects[i];
+
+      if (!contains(iControl, x, y)) {
+        hoveredObjects[i] = hoveredObjects.back();
+        hoveredObjects.pop_back();
         if (iControl->isCovered()) {
-          MouseEvent *me = new MouseEvent(MOUSE_LEAVE, (MouseButton)0, x, y, x - (int)iControl->getX(),
-            y - (int)iControl->getY());
-          ASSERT(iControl->processMouseEvent(me));
-          delete me;
+          ASSERT(sendHoverEvent(iControl, MOUSE_LEAVE, x, y));
         }
+      } else {
+        i++;
+      }
+    }
+
+    if (layoutChanged) {
+      buildGrid();
+    }
+
+    if (columns == 0 || x < gridX || y < gridY || x > gridX + cellWidth * columns ||
+      y > gridY + cellHeight * rows) {
+      break;
+    }
+
+    // Only objects of the cell under the mouse may be entered
+    uint column, row, lastColumn, lastRow;
+    getCells((float)x, (float)y, (float)x, (float)y, column, row, lastColumn, lastRow);
+    uint cell = row * columns + column;
+
+    for (uint i = cellStarts[cell]; i < cellStarts[cell + 1]; i++) {
+      AbstractSprite *iControl = objects[cellObjects[i]];
+
+      // Objects which got MOUSE_ENTER already are skipped, covered flag is not set by every control
+      if (contains(iControl, x, y) && !iControl->isCovered() &&
+        std::find(hoveredObjects.begin(), hoveredObjects.end(), iControl) == hoveredObjects.end()) {
+        hoveredObjects.push_back(iControl);
+        ASSERT(sendHoverEvent(iControl, MOUSE_ENTER, x, y));
       }
     }
   }
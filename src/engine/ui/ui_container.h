@@ -10,16 +10,66 @@
 #include "engine/ui/ui_control.h"
 #include "engine/events/mouse_event_source.h"
 #include "engine/events/key_event_source.h"
+#include "engine/events/layout_listener.h"
 
 namespace ve {
 
 /**
     Vector-based class-container for interface components.
+
+    To find components under the mouse, rectangles of components are put into
+    cells of a uniform grid, so only components of one cell are tested. The grid
+    is rebuilt on the next mouse motion after any component was added, removed,
+    moved or resized. Components under the mouse are cached to send MOUSE_LEAVE
+    events without testing all components.
 */
-class UIContainer : public UIControl, public MouseEventsSource, public KeyEventsSource {
+class UIContainer : public UIControl, public MouseEventsSource, public KeyEventsSource, public LayoutListener {
 private:
   std::vector<AbstractSprite*> objects;
 
+  /** Indices of objects of every cell, objects of cell i start at cellStarts[i] */
+  std::vector<uint> cellObjects;
+
+  /** Start of every cell in cellObjects, the last element is the end of the last cell */
+  std::vector<uint> cellStarts;
+
+  /** Left-upper corner of the grid */
+  float gridX, gridY;
+
+  /** Size of one cell */
+  float cellWidth, cellHeight;
+
+  /** Number of grid columns and rows */
+  uint columns, rows;
+
+  /** Grid should be rebuilt before the next hit-test */
+  bool layoutChanged;
+
+  /** Objects under the mouse, they got MOUSE_ENTER event but not MOUSE_LEAVE */
+  std::vector<AbstractSprite*> hoveredObjects;
+
+  /**
+      Puts objects into cells of the grid.
+  */
+  void buildGrid();
+
+  /**
+      Returns range of cells covered by the rectangle, the range is clamped to the grid.
+  */
+  void getCells(float left, float top, float right, float bottom, uint &firstColumn,
+    uint &firstRow, uint &lastColumn, uint &lastRow);
+
+  /**
+      Checks if point is inside of the object.
+  */
+  static bool contains(AbstractSprite *object, int x, int y);
+
+  /**
+      Sends MOUSE_ENTER or MOUSE_LEAVE event to the object. Event lives on the stack,
+      so listeners should not keep pointer to it.
+  */
+  static Outcome sendHoverEvent(AbstractSprite *object, SystemEventType type, int x, int y);
+
 public:
   /**
       UIContainer constructor.
@@ -27,6 +77,12 @@ public:
   */
   UIContainer(UIContainer *parent);
 
+  /**
+      Destructor. Components stop sending layout changes to this container, so
+      deleted components should be removed from it before.
+  */
+  virtual ~UIContainer();
+
   /**
       Adds interface control to this container.
       @param newControl - Control to add to this container.
@@ -76,6 +132,19 @@ Sends the given key event across all the object of this container.
 @return non-OK if error occurred.
   */
   virtual Outcome processKeyEvent(KeyEvent *event);
+
+  /**
+      Marks the grid of components to be rebuilt. Container is invalidated,
+      because its look is changed too.
+      @param sprite - Component which was moved or resized.
+  */
+  virtual void onLayoutChange(AbstractSprite *sprite);
+
+  /**
+      Invalidates container, because its component should be redrawn.
+      @param sprite - Component which was changed.
+  */
+  virtual void onContentChange(AbstractSprite *sprite);
 };
 
 }
@@ -0,0 +1,355 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <algorithm>
+#include <stddef.h>
+
+#include "common.h"
+#include "ui/ui_draw_list.h"
+#include "ui/border.h"
+#include "engines/engine.h"
+#include "fonts/font.h"
+#include "fonts/font_cache.h"
+#include "buffers/video_buffer.h"
+#include "sprites/abstract_sprite.h"
+#include "states/gpu_state_manager.h"
+
+namespace ve {
+
+/* States which are set for batched geometry */
+static const uint GEOMETRY_STATES = ALPHA_TEST_STATE | BLEND_STATE | COLOR_STATE | TEXTURES_STATE | BUFFERS_STATE;
+
+UIDrawList::UIDrawList(Engine *engine) :atlas(engine) {
+  this->engine = engine;
+  vertexBuffer = NULL;
+  drawCalls = 0;
+
+  uint stride = sizeof(Vertex);
+  buffersState.vertices = BufferDesc(3, FLOAT, stride, NULL, true);
+  buffersState.vertices.offset = offsetof(Vertex, x);
+  buffersState.texCoords = BufferDesc(2, FLOAT, stride, NULL, true);
+  buffersState.texCoords.offset = offsetof(Vertex, u);
+  buffersState.colors = BufferDesc(4, UNSIGNED_BYTE, stride, NULL, true);
+  buffersState.colors.offset = offsetof(Vertex, color);
+
+  translations.push_back(Vector3f(0, 0, 0));
+}
+
+UIDrawList::~UIDrawList() {
+  delete vertexBuffer;
+}
+
+Outcome UIDrawList::initialize() {
+  CHECK_POINTER(engine);
+
+  vertexBuffer = engine->createVideoBuffer(VERTEX_ARRAY);
+  CHECK_POINTER(vertexBuffer);
+
+  buffersState.vertices.data = vertexBuffer;
+  buffersState.texCoords.data = vertexBuffer;
+  buffersState.colors.data = vertexBuffer;
+
+  return atlas.initialize();
+}
+
+void UIDrawList::clear() {
+  vertices.clear();
+  batches.clear();
+  clipRects.clear();
+  clipStack.clear();
+  translations.resize(1);
+}
+
+void UIDrawList::pushTranslation(float x, float y, float z) {
+  translations.push_back(translations.back() + Vector3f(x, y, z));
+}
+
+void UIDrawList::popTranslation() {
+  if (translations.size() > 1) {
+    translations.pop_back();
+  }
+}
+
+void UIDrawList::pushClipRect(float x, float y, float width, float height) {
+  const Vector3f &translation = translations.back();
+  ClipRect rect;
+  rect.x = (int)(x + translation[0]);
+  rect.y = (int)(y + translation[1]);
+  rect.width = std::max(0, (int)width);
+  rect.height = std::max(0, (int)height);
+
+  int clip = getClip();
+  if (clip >= 0) {
+    const ClipRect &outer = clipRects[clip];
+    int right = std::min(rect.x + rect.width, outer.x + outer.width);
+    int bottom = std::min(rect.y + rect.height, outer.y + outer.height);
+    rect.x = std::max(rect.x, outer.x);
+    rect.y = std::max(rect.y, outer.y);
+    rect.width = std::max(0, right - rect.x);
+    rect.height = std::max(0, bottom - rect.y);
+  }
+
+  clipRects.push_back(rect);
+  clipStack.push_back((int)clipRects.size() - 1);
+}
+
+void UIDrawList::popClipRect() {
+  if (!clipStack.empty()) {
+    clipStack.pop_back();
+  }
+}
+
+int UIDrawList::getClip() {
+  return clipStack.empty() ? -1 : clipStack.back();
+}
+
+uint UIDrawList::addVertices(Texture *texture, uint count) {
+  int clip = getClip();
+  uint first = vertices.size();
+
+  if (batches.empty() || batches.back().object != NULL || batches.back().texture != texture ||
+    batches.back().clip != clip) {
+    Batch batch;
+    batch.texture = texture;
+    batch.object = NULL;
+    batch.clip = clip;
+    batch.first = first;
+    batch.count = 0;
+    batches.push_back(batch);
+  }
+
+  batches.back().count += count;
+  vertices.resize(first + count);
+  return first;
+}
+
+void UIDrawList::setVertex(uint index, float x, float y, float z, float u, float v, const Vector4f &color) {
+  const Vector3f &translation = translations.back();
+  Vertex &vertex = vertices[index];
+
+  vertex.x = x + translation[0];
+  vertex.y = y + translation[1];
+  vertex.z = z + translation[2];
+  vertex.u = u;
+  vertex.v = v;
+
+  for (int i = 0; i < 4; i++) {
+    float component = std::min(1.0f, std::max(0.0f, color[i]));
+    vertex.color[i] = (uchar)(component * 255.0f + 0.5f);
+  }
+}
+
+void UIDrawList::addRect(float x, float y, float z, float width, float height, const Vector4f &color) {
+  const AtlasRegion &white = atlas.getWhiteRegion();
+  addImage(x, y, z, width, height, white, color);
+}
+
+void UIDrawList::addImage(float x, float y, float z, float width, float height, const AtlasRegion &region,
+  const Vector4f &color) {
+  uint first = addVertices(atlas.getTexture(), 4);
+
+  setVertex(first + 0, x, y, z, region.u0, region.v0, color);
+  setVertex(first + 1, x, y + height, z, region.u0, region.v1, color);
+  setVertex(first + 2, x + width, y + height, z, region.u1, region.v1, color);
+  setVertex(first + 3, x + width, y, z, region.u1, region.v0, color);
+}
+
+void UIDrawList::addQuad(Texture *texture, const float positions[12], const Vector2f texCoords[4],
+  const Vector4f &color) {
+  if (texture == NULL) {
+    const AtlasRegion &white = atlas.getWhiteRegion();
+    uint first = addVertices(atlas.getTexture(), 4);
+
+    for (uint i = 0; i < 4; i++) {
+      setVertex(first + i, positions[3 * i], positions[3 * i + 1], positions[3 * i + 2], white.u0, white.v0, color);
+    }
+    return;
+  }
+
+  uint first = addVertices(texture, 4);
+  for (uint i = 0; i < 4; i++) {
+    setVertex(first + i, positions[3 * i], positions[3 * i + 1], positions[3 * i + 2],
+      texCoords[i][0], texCoords[i][1], color);
+  }
+}
+
+void UIDrawList::addBorder(float x, float y, float z, float width, float height, float lineWidth, uchar mask,
+  const Vector4f &color) {
+  float half = lineWidth / 2;
+
+  if (mask & Border::UP) {
+    addRect(x - half, y - half, z, width + lineWidth, lineWidth, color);
+  }
+
+  if (mask & Border::DOWN) {
+    addRect(x - half, y + height - half, z, width + lineWidth, lineWidth, color);
+  }
+
+  /* Vertical lines do not cover corners twice if horizontal ones are drawn */
+  float top = (mask & Border::UP) ? y + half : y - half;
+  float bottom = (mask & Border::DOWN) ? y + height - half : y + height + half;
+
+  if (mask & Border::LEFT) {
+    addRect(x - half, top, z, lineWidth, bottom - top, color);
+  }
+
+  if (mask & Border::RIGHT) {
+    addRect(x + width - half, top, z, lineWidth, bottom - top, color);
+  }
+}
+
+Outcome UIDrawList::addText(Font *font, float x, float y, float z, const std::wstring &text, const Vector4f &color) {
+  CHECK_POINTER(font);
+
+  if (text.empty()) {
+    return OK;
+  }
+
+  ASSERT(font->cacheString(text));
+
+  FontCache *cache = font->getCache();
+  cache->getStringQuads(text, textVertices, textTexCoords);
+
+  uint count = text.length() * 4;
+  uint first = addVertices(cache->getTexture(), count);
+
+  for (uint i = 0; i < count; i++) {
+    setVertex(first + i, x + textVertices[3 * i], y + textVertices[3 * i + 1], z + textVertices[3 * i + 2],
+      textTexCoords[2 * i], textTexCoords[2 * i + 1], color);
+  }
+
+  return OK;
+}
+
+void UIDrawList::addObject(AbstractSprite *object) {
+  Batch batch;
+  batch.texture = NULL;
+  batch.object = object;
+  batch.translation = translations.back();
+  batch.clip = getClip();
+  batch.first = vertices.size();
+  batch.count = 0;
+  batches.push_back(batch);
+}
+
+Outcome UIDrawList::applyClip(int clip, const ScissorState &base, const ViewportState &viewport) {
+  GPUStateManager *stateManager = engine->getStateManager();
+
+  if (clip < 0) {
+    return stateManager->setScissorState(base);
+  }
+
+  /* Scissor box has origin in the left-bottom corner of the window */
+  const ClipRect &rect = clipRects[clip];
+  int left = viewport.x + rect.x;
+  int bottom = viewport.y + viewport.height - (rect.y + rect.height);
+  int right = left + rect.width;
+  int top = bottom + rect.height;
+
+  if (base.isEnabled) {
+    left = std::max(left, base.x);
+    bottom = std::max(bottom, base.y);
+    right = std::min(right, base.x + base.width);
+    top = std::min(top, base.y + base.height);
+  }
+
+  return stateManager->setScissorState(ScissorState(left, bottom, std::max(0, right - left), std::max(0, top - bottom)));
+}
+
+Outcome UIDrawList::submit() {
+  drawCalls = 0;
+
+  if (batches.empty()) {
+    return OK;
+  }
+
+  CHECK_POINTER(vertexBuffer);
+  GPUStateManager *stateManager = engine->getStateManager();
+
+  ASSERT(atlas.update());
+  if (!vertices.empty()) {
+    ASSERT(vertexBuffer->update(&vertices[0], vertices.size() * sizeof(Vertex), STREAM_DRAW));
+  }
+
+  stateManager->pushStates(SCISSOR_STATE);
+  bool geometryStates = false;
+  Outcome result = drawBatches(stateManager->getScissorState(), stateManager->getViewportState(),
+    geometryStates);
+
+  /* Color array changes the current color, so color state is restored too. States
+     are popped on errors as well, so the stack of states stays balanced */
+  if (geometryStates) {
+    stateManager->popStates(GEOMETRY_STATES);
+  }
+
+  stateManager->popStates(SCISSOR_STATE);
+  return result;
+}
+
+Outcome UIDrawList::drawBatches(const ScissorState &base, const ViewportState &viewport, bool &geometryStates) {
+  GPUStateManager *stateManager = engine->getStateManager();
+  Texture *texture = NULL;
+  int clip = -2;
+
+  for (uint i = 0; i < batches.size(); i++) {
+    const Batch &batch = batches[i];
+
+    if (batch.clip != clip) {
+      ASSERT(applyClip(batch.clip, base, viewport));
+      clip = batch.clip;
+    }
+
+    if (batch.object != NULL) {
+      /* Object sets its own states, so it gets the states which were before submit() */
+      if (geometryStates) {
+        stateManager->popStates(GEOMETRY_STATES);
+        geometryStates = false;
+      }
+
+      ASSERT(engine->beginTransform());
+      ASSERT(engine->translate(batch.translation[0], batch.translation[1], batch.translation[2]));
+      ASSERT(batch.object->render());
+      ASSERT(engine->endTransform());
+      drawCalls++;
+      continue;
+    }
+
+    if (!geometryStates) {
+      stateManager->pushStates(GEOMETRY_STATES);
+      geometryStates = true;
+      ASSERT(stateManager->setBuffersState(buffersState));
+      ASSERT(stateManager->setAlphaTestState(AlphaTestState(true, GREATER, 0)));
+      ASSERT(stateManager->setBlendState(BlendState(SRC_ALPHA, ONE_MINUS_SRC_ALPHA)));
+      ASSERT(stateManager->setColorState(ColorState(1, 1, 1, 1)));
+      texture = NULL;
+    }
+
+    if (texture != batch.texture) {
+      ASSERT(stateManager->setTexturesState(TexturesState(batch.texture, TextureEnvMode(MODULATE))));
+      texture = batch.texture;
+    }
+
+    ASSERT(engine->drawPrimitives(QUADS, batch.first, batch.count));
+    drawCalls++;
+  }
+
+  return OK;
+}
+
+TextureAtlas *UIDrawList::getAtlas() {
+  return &atlas;
+}
+
+uint UIDrawList::getBatchesCount() {
+  return batches.size();
+}
+
+uint UIDrawList::getVerticesCount() {
+  return vertices.size();
+}
+
+uint UIDrawList::getDrawCallsCount() {
+  return drawCalls;
+}
+
+}
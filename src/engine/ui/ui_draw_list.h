@@ -0,0 +1,329 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_UI_DRAW_LIST_H__
+#define __VE_UI_DRAW_LIST_H__
+
+#include <string>
+#include <vector>
+
+#include "engine/common.h"
+#include "engine/math/vector2f.h"
+#include "engine/math/vector3f.h"
+#include "engine/math/vector4f.h"
+#include "engine/textures/texture_atlas.h"
+#include "engine/states/buffer_state.h"
+
+namespace ve {
+
+class Engine;
+class Font;
+class Texture;
+class VideoBuffer;
+class AbstractSprite;
+struct ScissorState;
+struct ViewportState;
+
+/**
+    UIDrawList collects geometry of interface components during a frame and
+    renders it with a few draw calls. Components append quads, borders and text
+    instead of rendering themselves, all vertices are stored in one streaming
+    video buffer and consecutive geometry with the same texture and clipping
+    rectangle becomes one batch. Solid geometry and images of the atlas share
+    one texture, text uses the cache-texture of its font.
+
+    Translations and clipping rectangles work like nested transformations of
+    the immediate rendering: they are pushed by containers and applied to all
+    geometry appended by children. Clipping is done with the scissor test, so
+    list expects the usual UI camera: one unit is one pixel and (0, 0) is the
+    left-upper corner of the viewport.
+
+    Components which can not be batched are added with addObject(), they are
+    rendered in their turn with the usual render() call.
+
+    Example:
+    @code
+    drawList->clear();
+    for (uint i = 0; i < count; i++) {
+      ASSERT(objects[i]->draw(drawList));
+    }
+    ASSERT(drawList->submit());
+    @endcode
+*/
+class UIDrawList {
+private:
+  /**
+      Vertex of the streaming buffer.
+  */
+  struct Vertex {
+    float x, y, z;
+    float u, v;
+    uchar color[4];
+  };
+
+  /**
+      Rectangle of the screen in pixels.
+  */
+  struct ClipRect {
+    int x;
+    int y;
+    int width;
+    int height;
+  };
+
+  /**
+      Range of vertices rendered by one draw call or an object rendered immediately.
+  */
+  struct Batch {
+    /** Texture of the geometry */
+    Texture *texture;
+
+    /** Object to render immediately or NULL for geometry */
+    AbstractSprite *object;
+
+    /** Translation of the object */
+    Vector3f translation;
+
+    /** Index of the clipping rectangle or -1 */
+    int clip;
+
+    /** First vertex of the batch */
+    uint first;
+
+    /** Number of vertices in the batch */
+    uint count;
+  };
+
+  /** Engine which renders the list */
+  Engine *engine;
+
+  /** Atlas for solid geometry and small images */
+  TextureAtlas atlas;
+
+  /** Streaming buffer for vertices */
+  VideoBuffer *vertexBuffer;
+
+  /** Vertices of the frame */
+  std::vector<Vertex> vertices;
+
+  /** Batches of the frame */
+  std::vector<Batch> batches;
+
+  /** Clipping rectangles used in the frame */
+  std::vector<ClipRect> clipRects;
+
+  /** Stack of indices of clipping rectangles */
+  std::vector<int> clipStack;
+
+  /** Stack of translations */
+  std::vector<Vector3f> translations;
+
+  /** Temporary arrays for text quads */
+  std::vector<float> textVertices;
+  std::vector<float> textTexCoords;
+
+  /** Buffers state with interleaved vertex data */
+  BuffersState buffersState;
+
+  /** Number of draw calls made by the last submit() */
+  uint drawCalls;
+
+  /**
+      Private copy-constructor.
+  */
+  UIDrawList(const UIDrawList &ref);
+
+  /**
+      Private operator =
+  */
+  UIDrawList &operator = (const UIDrawList &ref);
+
+  /**
+      Reserves vertices for geometry with the given texture. New batch is
+      started if texture or clipping rectangle differs from the last batch.
+      @return Index of the first reserved vertex.
+  */
+  uint addVertices(Texture *texture, uint count);
+
+  /**
+      Fills vertex with translated position, texture coordinates and color.
+  */
+  void setVertex(uint index, float x, float y, float z, float u, float v, const Vector4f &color);
+
+  /**
+      Returns the current clipping rectangle.
+      @return Index of the rectangle or -1 if geometry is not clipped.
+  */
+  int getClip();
+
+  /**
+      Sets scissor state for the clipping rectangle.
+      @param clip - Index of the rectangle or -1.
+      @param base - Scissor state which was set before submit().
+      @param viewport - Viewport the UI camera maps pixels to.
+  */
+  Outcome applyClip(int clip, const ScissorState &base, const ViewportState &viewport);
+
+  /**
+      Draws batches for submit(), states pushed by it are popped by submit()
+      even if drawing fails.
+      @param base - Scissor state which was set before submit().
+      @param viewport - Viewport the UI camera maps pixels to.
+      @param geometryStates - Set to 'true' while geometry states are pushed.
+  */
+  Outcome drawBatches(const ScissorState &base, const ViewportState &viewport, bool &geometryStates);
+
+public:
+  /**
+      Constructor. Resources are created by initialize().
+      @param engine - Engine which renders the list.
+  */
+  UIDrawList(Engine *engine);
+
+  /**
+      Destructor. Frees the video buffer and the atlas.
+  */
+  ~UIDrawList();
+
+  /**
+      Creates the video buffer and the atlas.
+      @return OK if resources were created.
+      @return non-OK if engine error occurred.
+  */
+  Outcome initialize();
+
+  /**
+      Removes all geometry, it should be called before components are drawn.
+  */
+  void clear();
+
+  /**
+      Moves all following geometry, translations are summed up.
+      @param x - X offset.
+      @param y - Y offset.
+      @param z - Z offset.
+  */
+  void pushTranslation(float x, float y, float z);
+
+  /**
+      Restores translation which was before the last pushTranslation() call.
+  */
+  void popTranslation();
+
+  /**
+      Clips all following geometry by the rectangle. The rectangle is moved by
+      the current translation and intersected with the current clipping rectangle.
+      @param x - X coordinate of the left-upper corner.
+      @param y - Y coordinate of the left-upper corner.
+      @param width - Width of the rectangle.
+      @param height - Height of the rectangle.
+  */
+  void pushClipRect(float x, float y, float width, float height);
+
+  /**
+      Restores clipping rectangle which was before the last pushClipRect() call.
+  */
+  void popClipRect();
+
+  /**
+      Appends rectangle filled with a color.
+      @param x - X coordinate of the left-upper corner.
+      @param y - Y coordinate of the left-upper corner.
+      @param z - Z coordinate of the rectangle.
+      @param width - Width of the rectangle.
+      @param height - Height of the rectangle.
+      @param color - Color of the rectangle.
+  */
+  void addRect(float x, float y, float z, float width, float height, const Vector4f &color);
+
+  /**
+      Appends rectangle with an image from the atlas.
+      @param x - X coordinate of the left-upper corner.
+      @param y - Y coordinate of the left-upper corner.
+      @param z - Z coordinate of the rectangle.
+      @param width - Width of the rectangle.
+      @param height - Height of the rectangle.
+      @param region - Image in the atlas, its first row is at the top.
+      @param color - Color which is multiplied by the image.
+  */
+  void addImage(float x, float y, float z, float width, float height, const AtlasRegion &region,
+    const Vector4f &color);
+
+  /**
+      Appends textured quad.
+      @param texture - Texture of the quad or NULL for solid quad.
+      @param positions - Coordinates of four vertices, three for each one.
+      @param texCoords - Texture coordinates of the vertices.
+      @param color - Color which is multiplied by the texture.
+  */
+  void addQuad(Texture *texture, const float positions[12], const Vector2f texCoords[4], const Vector4f &color);
+
+  /**
+      Appends frame of the rectangle. Lines are centered at the sides of the rectangle.
+      @param x - X coordinate of the left-upper corner.
+      @param y - Y coordinate of the left-upper corner.
+      @param z - Z coordinate of the frame.
+      @param width - Width of the rectangle.
+      @param height - Height of the rectangle.
+      @param lineWidth - Width of the lines.
+      @param mask - Sides to draw, combination of Border::LEFT, UP, RIGHT and DOWN.
+      @param color - Color of the lines.
+  */
+  void addBorder(float x, float y, float z, float width, float height, float lineWidth, uchar mask,
+    const Vector4f &color);
+
+  /**
+      Appends text. Symbols are put into the font cache if it is needed.
+      @param font - Font of the text.
+      @param x - X coordinate of the left-upper corner of the first symbol.
+      @param y - Y coordinate of the left-upper corner of the first symbol.
+      @param z - Z coordinate of the text.
+      @param text - Text to render.
+      @param color - Color of the text.
+      @return OK if text was appended.
+      @return non-OK if symbols can not be cached.
+  */
+  Outcome addText(Font *font, float x, float y, float z, const std::wstring &text, const Vector4f &color);
+
+  /**
+      Appends object which is rendered immediately with the current translation
+      and clipping rectangle.
+      @param object - Object to render.
+  */
+  void addObject(AbstractSprite *object);
+
+  /**
+      Renders collected geometry. List is not cleared, so it may be rendered again.
+      @return OK if rendering succeeded.
+      @return non-OK if engine error occurred.
+  */
+  Outcome submit();
+
+  /**
+      Returns atlas of the list, images may be added to it.
+      @return Atlas for images.
+  */
+  TextureAtlas *getAtlas();
+
+  /**
+      Returns number of batches collected in the list.
+      @return Number of batches.
+  */
+  uint getBatchesCount();
+
+  /**
+      Returns number of vertices collected in the list.
+      @return Number of vertices.
+  */
+  uint getVerticesCount();
+
+  /**
+      Returns number of draw calls made by the last submit() call.
+      @return Number of draw calls including immediately rendered objects.
+  */
+  uint getDrawCallsCount();
+};
+
+}
+
+#endif // __VE_UI_DRAW_LIST_H__
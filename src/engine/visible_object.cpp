@@ -9,6 +9,9 @@ VisibleObject::VisibleObject() {
   visible = true;
 }
 
+VisibleObject::~VisibleObject() {
+}
+
 void VisibleObject::setVisible(bool value) {
   visible = value;
 }
@@ -17,4 +20,12 @@ bool VisibleObject::isVisible() {
   return visible;
 }
 
+void VisibleObject::setBounds(const BoundingBox &newBounds) {
+  bounds = newBounds;
+}
+
+const BoundingBox &VisibleObject::getBounds() const {
+  return bounds;
+}
+
 }
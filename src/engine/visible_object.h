@@ -5,18 +5,22 @@
 #define __VE_VISIBLE_OBJECT_H__
 
 #include "common.h"
+#include "math/bounding_box.h"
 
 namespace ve {
 
 /**
-    Should be based class for all renderable objects. It has only one field which defines
-    if this object is visible or not.
+    Should be based class for all renderable objects. It has visibility flag and
+    world space bounding box which is used by spatial structures for culling and picking.
 */
 class VisibleObject :public Object {
 private:
   /** Visibility flag. */
   bool visible;
 
+  /** Bounding box in world coordinates. */
+  BoundingBox bounds;
+
 public:
   /**
       Default constructor.
@@ -24,6 +28,11 @@ public:
   */
   VisibleObject();
 
+  /**
+      Destructor.
+  */
+  virtual ~VisibleObject();
+
   /**
       Sets visibility flag.
       If this flag is set to 'true' then object
@@ -31,13 +40,26 @@ public:
       In case of 'false' render() function must return OK
       and do no rendering.
   */
-  void setVisible(bool value);
+  virtual void setVisible(bool value);
 
   /**
       Checks if this object is visible.
       @return 'true' if it is visible and 'false' if not.
   */
   bool isVisible();
+
+  /**
+      Sets bounding box of this object. Spatial structures which contain
+      this object must be updated after that.
+      @param newBounds - Bounding box in world coordinates.
+  */
+  void setBounds(const BoundingBox &newBounds);
+
+  /**
+      Returns bounding box of this object.
+      @return Bounding box in world coordinates.
+  */
+  const BoundingBox &getBounds() const;
 };
 
 }
@@ -0,0 +1,158 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_ATOMIC_H__
+#define __VE_ATOMIC_H__
+
+#ifdef VE_WINDOWS
+#include <intrin.h>
+#endif // VE_WINDOWS
+
+#ifdef VE_LINUX
+#include <sched.h>
+#endif // VE_LINUX
+
+#include "common.h"
+
+namespace ve {
+
+/** Size of a cache line, values which are written by different threads are kept in different lines */
+static const uint CACHE_LINE_SIZE = 64;
+
+/* Read-modify-write operations work with 32-bit values and they are full memory barriers */
+
+/**
+    Adds value atomically.
+    @param value - Value to change.
+    @param addend - Number to add.
+    @return New value.
+*/
+inline uint atomicAdd(volatile uint *value, uint addend) {
+#ifdef VE_WINDOWS
+  return (uint)InterlockedExchangeAdd((volatile LONG*)value, (LONG)addend) + addend;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  return __sync_add_and_fetch(value, addend);
+#endif // VE_LINUX
+}
+
+/**
+    Increments value atomically.
+    @param value - Value to change.
+    @return New value.
+*/
+inline uint atomicIncrement(volatile uint *value) {
+#ifdef VE_WINDOWS
+  return (uint)InterlockedIncrement((volatile LONG*)value);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  return __sync_add_and_fetch(value, 1);
+#endif // VE_LINUX
+}
+
+/**
+    Decrements value atomically.
+    @param value - Value to change.
+    @return New value.
+*/
+inline uint atomicDecrement(volatile uint *value) {
+#ifdef VE_WINDOWS
+  return (uint)InterlockedDecrement((volatile LONG*)value);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  return __sync_sub_and_fetch(value, 1);
+#endif // VE_LINUX
+}
+
+/**
+    Replaces value atomically.
+    @param value - Value to change.
+    @param desired - New value.
+    @return Previous value.
+*/
+inline uint atomicExchange(volatile uint *value, uint desired) {
+#ifdef VE_WINDOWS
+  return (uint)InterlockedExchange((volatile LONG*)value, (LONG)desired);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  /* Test-and-set is only an acquire barrier by itself */
+  __sync_synchronize();
+  return __sync_lock_test_and_set(value, desired);
+#endif // VE_LINUX
+}
+
+/**
+    Replaces value if it is equal to the expected one.
+    @param value - Value to change.
+    @param expected - Expected value.
+    @param desired - New value.
+    @return Previous value, the swap succeeded if it is equal to expected.
+*/
+inline uint compareAndSwap(volatile uint *value, uint expected, uint desired) {
+#ifdef VE_WINDOWS
+  return (uint)InterlockedCompareExchange((volatile LONG*)value, (LONG)desired, (LONG)expected);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  return __sync_val_compare_and_swap(value, expected, desired);
+#endif // VE_LINUX
+}
+
+/**
+    Full memory barrier.
+*/
+inline void memoryBarrier() {
+#ifdef VE_WINDOWS
+  MemoryBarrier();
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  __sync_synchronize();
+#endif // VE_LINUX
+}
+
+/**
+    Keeps order of stores and order of loads. It is enough to publish data
+    with a store of a flag and to read data after a load of the flag. x86
+    processors reorder neither of them, so only the compiler is restricted.
+*/
+inline void orderBarrier() {
+#ifdef VE_WINDOWS
+  _ReadWriteBarrier();
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+#if defined(__i386__) || defined(__x86_64__)
+  __asm__ __volatile__("" ::: "memory");
+#else
+  __sync_synchronize();
+#endif
+#endif // VE_LINUX
+}
+
+/**
+    Hints processor that the thread spins, so a sibling hyper-thread gets resources.
+*/
+inline void cpuPause() {
+#ifdef VE_WINDOWS
+  YieldProcessor();
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+#if defined(__i386__) || defined(__x86_64__)
+  __asm__ __volatile__("pause");
+#endif
+#endif // VE_LINUX
+}
+
+/**
+    Gives rest of the time slice to other threads.
+*/
+inline void yieldThread() {
+#ifdef VE_WINDOWS
+  SwitchToThread();
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  sched_yield();
+#endif // VE_LINUX
+}
+
+}
+
+#endif // __VE_ATOMIC_H__
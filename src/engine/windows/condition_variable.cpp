@@ -0,0 +1,76 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifdef VE_LINUX
+#include <errno.h>
+#include <time.h>
+#endif // VE_LINUX
+
+#include "common.h"
+#include "windows/condition_variable.h"
+#include "windows/critical_section.h"
+
+namespace ve {
+
+ConditionVariable::ConditionVariable() {
+#ifdef VE_WINDOWS
+  InitializeConditionVariable(&condition);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  pthread_cond_init(&condition, NULL);
+#endif // VE_LINUX
+}
+
+ConditionVariable::~ConditionVariable() {
+#ifdef VE_LINUX
+  pthread_cond_destroy(&condition);
+#endif // VE_LINUX
+}
+
+void ConditionVariable::wait(CriticalSection *criticalSection) {
+#ifdef VE_WINDOWS
+  SleepConditionVariableCS(&condition, &criticalSection->criticalSection, INFINITE);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  pthread_cond_wait(&condition, &criticalSection->mutex);
+#endif // VE_LINUX
+}
+
+bool ConditionVariable::wait(CriticalSection *criticalSection, uint timeout) {
+#ifdef VE_WINDOWS
+  return SleepConditionVariableCS(&condition, &criticalSection->criticalSection, timeout) != 0;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  /* Deadline is absolute time of the realtime clock */
+  struct timespec deadline;
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_sec += timeout / 1000;
+  deadline.tv_nsec += (timeout % 1000) * 1000000L;
+  if (deadline.tv_nsec >= 1000000000L) {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000L;
+  }
+
+  return pthread_cond_timedwait(&condition, &criticalSection->mutex, &deadline) != ETIMEDOUT;
+#endif // VE_LINUX
+}
+
+void ConditionVariable::notifyOne() {
+#ifdef VE_WINDOWS
+  WakeConditionVariable(&condition);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  pthread_cond_signal(&condition);
+#endif // VE_LINUX
+}
+
+void ConditionVariable::notifyAll() {
+#ifdef VE_WINDOWS
+  WakeAllConditionVariable(&condition);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  pthread_cond_broadcast(&condition);
+#endif // VE_LINUX
+}
+
+}
@@ -0,0 +1,74 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_CONDITION_VARIABLE_H__
+#define __VE_CONDITION_VARIABLE_H__
+
+#include "common.h"
+
+namespace ve {
+
+class CriticalSection;
+
+/**
+    Condition variable which is used with a locked CriticalSection. Waits
+    may wake up spuriously, so the condition must be checked in a loop.
+*/
+class ConditionVariable {
+private:
+#ifdef VE_WINDOWS
+  CONDITION_VARIABLE condition;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  pthread_cond_t condition;
+#endif // VE_LINUX
+
+  /**
+      Private copy-constructor.
+  */
+  ConditionVariable(const ConditionVariable &ref);
+
+  /**
+      Private operator =
+  */
+  ConditionVariable &operator = (const ConditionVariable &ref);
+
+public:
+  /**
+      Constructor.
+  */
+  ConditionVariable();
+
+  /**
+      Destructor.
+  */
+  ~ConditionVariable();
+
+  /**
+      Unlocks critical section, waits for a notification and locks it again.
+      @param criticalSection - Critical section which is locked by the thread.
+  */
+  void wait(CriticalSection *criticalSection);
+
+  /**
+      Unlocks critical section, waits for a notification or time out and locks it again.
+      @param criticalSection - Critical section which is locked by the thread.
+      @param timeout - Maximal time to wait in milliseconds.
+      @return 'false' if time is out.
+  */
+  bool wait(CriticalSection *criticalSection, uint timeout);
+
+  /**
+      Wakes up one waiting thread.
+  */
+  void notifyOne();
+
+  /**
+      Wakes up all waiting threads.
+  */
+  void notifyAll();
+};
+
+}
+
+#endif // __VE_CONDITION_VARIABLE_H__
@@ -14,6 +14,8 @@ namespace ve {
 */
 class CriticalSection {
 private:
+  friend class ConditionVariable;
+
 #ifdef VE_WINDOWS
   CRITICAL_SECTION criticalSection;
 #endif // VE_WINDOWS
@@ -0,0 +1,98 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include "common.h"
+#include "windows/condition_variable.h"
+#include "windows/critical_section.h"
+#include "windows/event.h"
+
+namespace ve {
+
+Event::Event(bool manualReset, bool signaled) {
+#ifdef VE_WINDOWS
+  event = CreateEvent(NULL, manualReset ? TRUE : FALSE, signaled ? TRUE : FALSE, NULL);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  lock = new CriticalSection();
+  condition = new ConditionVariable();
+  this->signaled = signaled;
+  this->manualReset = manualReset;
+#endif // VE_LINUX
+}
+
+Event::~Event() {
+#ifdef VE_WINDOWS
+  CloseHandle(event);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  delete condition;
+  delete lock;
+#endif // VE_LINUX
+}
+
+void Event::set() {
+#ifdef VE_WINDOWS
+  SetEvent(event);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  lock->lock();
+  signaled = true;
+  if (manualReset) {
+    condition->notifyAll();
+  } else {
+    condition->notifyOne();
+  }
+  lock->unlock();
+#endif // VE_LINUX
+}
+
+void Event::reset() {
+#ifdef VE_WINDOWS
+  ResetEvent(event);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  lock->lock();
+  signaled = false;
+  lock->unlock();
+#endif // VE_LINUX
+}
+
+void Event::wait() {
+#ifdef VE_WINDOWS
+  WaitForSingleObject(event, INFINITE);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  lock->lock();
+  while (!signaled) {
+    condition->wait(lock);
+  }
+  if (!manualReset) {
+    signaled = false;
+  }
+  lock->unlock();
+#endif // VE_LINUX
+}
+
+bool Event::wait(uint timeout) {
+#ifdef VE_WINDOWS
+  return WaitForSingleObject(event, timeout) == WAIT_OBJECT_0;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  lock->lock();
+  /* Spurious wakeups restart the whole timeout, it is only an upper bound of waiting */
+  while (!signaled) {
+    if (!condition->wait(lock, timeout)) {
+      break;
+    }
+  }
+
+  bool result = signaled;
+  if (signaled && !manualReset) {
+    signaled = false;
+  }
+  lock->unlock();
+  return result;
+#endif // VE_LINUX
+}
+
+}
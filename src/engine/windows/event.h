@@ -0,0 +1,86 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_EVENT_H__
+#define __VE_EVENT_H__
+
+#include "common.h"
+
+namespace ve {
+
+class ConditionVariable;
+class CriticalSection;
+
+/**
+    Event which threads wait for. Auto-reset event releases one waiting
+    thread and becomes non-signaled, manual-reset event releases all threads
+    until it is reset.
+*/
+class Event {
+private:
+#ifdef VE_WINDOWS
+  HANDLE event;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  /** Guards the state */
+  CriticalSection *lock;
+
+  /** Notifies waiting threads */
+  ConditionVariable *condition;
+
+  /** Event is signaled */
+  bool signaled;
+
+  /** Event stays signaled when a thread is released */
+  bool manualReset;
+#endif // VE_LINUX
+
+  /**
+      Private copy-constructor.
+  */
+  Event(const Event &ref);
+
+  /**
+      Private operator =
+  */
+  Event &operator = (const Event &ref);
+
+public:
+  /**
+      Constructor.
+      @param manualReset - Event stays signaled until reset() is called.
+      @param signaled - Initial state.
+  */
+  Event(bool manualReset = false, bool signaled = false);
+
+  /**
+      Destructor.
+  */
+  ~Event();
+
+  /**
+      Signals event.
+  */
+  void set();
+
+  /**
+      Makes event non-signaled.
+  */
+  void reset();
+
+  /**
+      Waits until event is signaled.
+  */
+  void wait();
+
+  /**
+      Waits until event is signaled or time is out.
+      @param timeout - Maximal time to wait in milliseconds.
+      @return 'false' if time is out.
+  */
+  bool wait(uint timeout);
+};
+
+}
+
+#endif // __VE_EVENT_H__
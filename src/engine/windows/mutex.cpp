@@ -0,0 +1,94 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifdef VE_LINUX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // VE_LINUX
+
+#include "common.h"
+#include "windows/atomic.h"
+#include "windows/mutex.h"
+
+namespace ve {
+
+#ifdef VE_LINUX
+/* Sleeps while the value is equal to the expected one */
+static inline void futexWait(volatile uint *value, uint expected) {
+  syscall(SYS_futex, value, FUTEX_WAIT_PRIVATE, expected, NULL, NULL, 0);
+}
+
+/* Wakes up one thread which sleeps on the value */
+static inline void futexWake(volatile uint *value) {
+  syscall(SYS_futex, value, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+#endif // VE_LINUX
+
+Mutex::Mutex(uint spinCount) {
+  state = 0;
+  this->spinCount = spinCount;
+
+#ifdef VE_WINDOWS
+  semaphore = CreateSemaphore(NULL, 0, 0x7fffffff, NULL);
+#endif // VE_WINDOWS
+}
+
+Mutex::~Mutex() {
+#ifdef VE_WINDOWS
+  CloseHandle(semaphore);
+#endif // VE_WINDOWS
+}
+
+bool Mutex::tryLock() {
+  return compareAndSwap(&state, 0, 1) == 0;
+}
+
+void Mutex::lock() {
+  /* Spinning reads the state, so the cache line is not written until the mutex is free */
+  for (uint i = 0; i < spinCount; i++) {
+    if (state == 0 && compareAndSwap(&state, 0, 1) == 0) {
+      return;
+    }
+    cpuPause();
+  }
+
+#ifdef VE_WINDOWS
+  /* The thread is counted, the owner releases the semaphore when it unlocks */
+  if (atomicIncrement(&state) > 1) {
+    WaitForSingleObject(semaphore, INFINITE);
+  }
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  /* Mutex is marked as contended, so the owner wakes up a waiter when it unlocks */
+  uint previous = compareAndSwap(&state, 0, 1);
+  if (previous == 0) {
+    return;
+  }
+
+  if (previous != 2) {
+    previous = atomicExchange(&state, 2);
+  }
+
+  while (previous != 0) {
+    futexWait(&state, 2);
+    previous = atomicExchange(&state, 2);
+  }
+#endif // VE_LINUX
+}
+
+void Mutex::unlock() {
+#ifdef VE_WINDOWS
+  if (atomicDecrement(&state) > 0) {
+    ReleaseSemaphore(semaphore, 1, NULL);
+  }
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  if (atomicDecrement(&state) != 0) {
+    state = 0;
+    futexWake(&state);
+  }
+#endif // VE_LINUX
+}
+
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_MUTEX_H__
+#define __VE_MUTEX_H__
+
+#include "common.h"
+
+namespace ve {
+
+/**
+    Mutex which spins for a while before the thread is parked, so short
+    critical sections are entered without system calls. Uncontended lock
+    and unlock are one atomic operation each. On Linux the thread is parked
+    with futex, on Windows with a semaphore which is used only when threads
+    really wait. The mutex is not recursive.
+*/
+class Mutex {
+private:
+  /**
+      State: 0 - unlocked, 1 - locked, on Linux 2 - locked and there may be
+      waiters. On Windows it is the number of threads which own or wait for
+      the mutex.
+  */
+  volatile uint state;
+
+  /** Number of attempts to take the mutex before the thread is parked */
+  uint spinCount;
+
+#ifdef VE_WINDOWS
+  /** Semaphore which parks waiting threads */
+  HANDLE semaphore;
+#endif // VE_WINDOWS
+
+  /**
+      Private copy-constructor.
+  */
+  Mutex(const Mutex &ref);
+
+  /**
+      Private operator =
+  */
+  Mutex &operator = (const Mutex &ref);
+
+public:
+  /**
+      Constructor.
+      @param spinCount - Number of attempts to take the mutex before the thread is parked.
+  */
+  Mutex(uint spinCount = 100);
+
+  /**
+      Destructor.
+  */
+  ~Mutex();
+
+  /**
+      Locks mutex.
+  */
+  void lock();
+
+  /**
+      Tries to lock mutex without waiting.
+      @return 'true' if mutex was locked.
+  */
+  bool tryLock();
+
+  /**
+      Unlocks mutex.
+  */
+  void unlock();
+};
+
+}
+
+#endif // __VE_MUTEX_H__
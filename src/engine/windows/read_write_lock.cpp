@@ -0,0 +1,60 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include "common.h"
+#include "windows/read_write_lock.h"
+
+namespace ve {
+
+ReadWriteLock::ReadWriteLock() {
+#ifdef VE_WINDOWS
+  InitializeSRWLock(&lock);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  pthread_rwlock_init(&lock, NULL);
+#endif // VE_LINUX
+}
+
+ReadWriteLock::~ReadWriteLock() {
+#ifdef VE_LINUX
+  pthread_rwlock_destroy(&lock);
+#endif // VE_LINUX
+}
+
+void ReadWriteLock::lockRead() {
+#ifdef VE_WINDOWS
+  AcquireSRWLockShared(&lock);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  pthread_rwlock_rdlock(&lock);
+#endif // VE_LINUX
+}
+
+void ReadWriteLock::unlockRead() {
+#ifdef VE_WINDOWS
+  ReleaseSRWLockShared(&lock);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  pthread_rwlock_unlock(&lock);
+#endif // VE_LINUX
+}
+
+void ReadWriteLock::lockWrite() {
+#ifdef VE_WINDOWS
+  AcquireSRWLockExclusive(&lock);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  pthread_rwlock_wrlock(&lock);
+#endif // VE_LINUX
+}
+
+void ReadWriteLock::unlockWrite() {
+#ifdef VE_WINDOWS
+  ReleaseSRWLockExclusive(&lock);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  pthread_rwlock_unlock(&lock);
+#endif // VE_LINUX
+}
+
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_READ_WRITE_LOCK_H__
+#define __VE_READ_WRITE_LOCK_H__
+
+#include "common.h"
+
+namespace ve {
+
+/**
+    Lock which is shared by readers and exclusive for a writer, it suits data
+    which is read often and changed rarely. The lock is not recursive and a
+    read lock can not be upgraded to a write lock.
+*/
+class ReadWriteLock {
+private:
+#ifdef VE_WINDOWS
+  SRWLOCK lock;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  pthread_rwlock_t lock;
+#endif // VE_LINUX
+
+  /**
+      Private copy-constructor.
+  */
+  ReadWriteLock(const ReadWriteLock &ref);
+
+  /**
+      Private operator =
+  */
+  ReadWriteLock &operator = (const ReadWriteLock &ref);
+
+public:
+  /**
+      Constructor.
+  */
+  ReadWriteLock();
+
+  /**
+      Destructor.
+  */
+  ~ReadWriteLock();
+
+  /**
+      Locks for reading, other readers may hold the lock at the same time.
+  */
+  void lockRead();
+
+  /**
+      Unlocks after reading.
+  */
+  void unlockRead();
+
+  /**
+      Locks for writing, the thread is the only owner.
+  */
+  void lockWrite();
+
+  /**
+      Unlocks after writing.
+  */
+  void unlockWrite();
+};
+
+}
+
+#endif // __VE_READ_WRITE_LOCK_H__
@@ -0,0 +1,88 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifdef VE_LINUX
+#include <errno.h>
+#include <time.h>
+#endif // VE_LINUX
+
+#include "common.h"
+#include "windows/semaphore.h"
+
+namespace ve {
+
+Semaphore::Semaphore(uint count) {
+#ifdef VE_WINDOWS
+  semaphore = CreateSemaphore(NULL, (LONG)count, 0x7fffffff, NULL);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  sem_init(&semaphore, 0, count);
+#endif // VE_LINUX
+}
+
+Semaphore::~Semaphore() {
+#ifdef VE_WINDOWS
+  CloseHandle(semaphore);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  sem_destroy(&semaphore);
+#endif // VE_LINUX
+}
+
+void Semaphore::post(uint count) {
+  if (count == 0) {
+    return;
+  }
+
+#ifdef VE_WINDOWS
+  ReleaseSemaphore(semaphore, (LONG)count, NULL);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  for (uint i = 0; i < count; i++) {
+    sem_post(&semaphore);
+  }
+#endif // VE_LINUX
+}
+
+void Semaphore::wait() {
+#ifdef VE_WINDOWS
+  WaitForSingleObject(semaphore, INFINITE);
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  while (sem_wait(&semaphore) != 0 && errno == EINTR) {
+  }
+#endif // VE_LINUX
+}
+
+bool Semaphore::wait(uint timeout) {
+#ifdef VE_WINDOWS
+  return WaitForSingleObject(semaphore, timeout) == WAIT_OBJECT_0;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  /* Deadline is absolute time of the realtime clock */
+  struct timespec deadline;
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_sec += timeout / 1000;
+  deadline.tv_nsec += (timeout % 1000) * 1000000L;
+  if (deadline.tv_nsec >= 1000000000L) {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000L;
+  }
+
+  int result;
+  while ((result = sem_timedwait(&semaphore, &deadline)) != 0 && errno == EINTR) {
+  }
+  return result == 0;
+#endif // VE_LINUX
+}
+
+bool Semaphore::tryWait() {
+#ifdef VE_WINDOWS
+  return WaitForSingleObject(semaphore, 0) == WAIT_OBJECT_0;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  return sem_trywait(&semaphore) == 0;
+#endif // VE_LINUX
+}
+
+}
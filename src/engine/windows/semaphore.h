@@ -0,0 +1,76 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_SEMAPHORE_H__
+#define __VE_SEMAPHORE_H__
+
+#ifdef VE_LINUX
+#include <semaphore.h>
+#endif // VE_LINUX
+
+#include "common.h"
+
+namespace ve {
+
+/**
+    Counting semaphore.
+*/
+class Semaphore {
+private:
+#ifdef VE_WINDOWS
+  HANDLE semaphore;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  sem_t semaphore;
+#endif // VE_LINUX
+
+  /**
+      Private copy-constructor.
+  */
+  Semaphore(const Semaphore &ref);
+
+  /**
+      Private operator =
+  */
+  Semaphore &operator = (const Semaphore &ref);
+
+public:
+  /**
+      Constructor.
+      @param count - Initial count.
+  */
+  Semaphore(uint count = 0);
+
+  /**
+      Destructor.
+  */
+  ~Semaphore();
+
+  /**
+      Increments count and wakes up waiting threads.
+      @param count - Number to add.
+  */
+  void post(uint count = 1);
+
+  /**
+      Waits until count is positive and decrements it.
+  */
+  void wait();
+
+  /**
+      Waits until count is positive or time is out and decrements it.
+      @param timeout - Maximal time to wait in milliseconds.
+      @return 'false' if time is out.
+  */
+  bool wait(uint timeout);
+
+  /**
+      Decrements count if it is positive.
+      @return 'false' if count is zero.
+  */
+  bool tryWait();
+};
+
+}
+
+#endif // __VE_SEMAPHORE_H__
@@ -15,9 +15,14 @@ Window::Window(WindowSystem *windowSystem) {
   time(&lastMoment);
   framesCount = 0;
   fps = 0;
+
+  // Register pointer in the memory manager
+  memoryHandle = REGISTER_POINTER(this);
 }
 
 Window::~Window() {
+  // Unregister pointer in the memory manager
+  UNREGISTER_POINTER(memoryHandle);
   engine->freeWindow(this);
 }
 
@@ -122,4 +127,12 @@ bool Window::hasAvailableEvent() {
   return engine->hasAvailableEvent(this);
 }
 
+uint Window::pollEvents(SystemEvent **buffer, uint max) {
+  return engine->pollEvents(this, buffer, max);
+}
+
+bool Window::waitEvent(int timeout) {
+  return engine->waitEvent(this, timeout);
+}
+
 }
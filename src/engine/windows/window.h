@@ -49,6 +49,9 @@ private:
   int framesCount;
   float fps;
 
+  /** Handle of the window in the memory manager */
+  MemoryHandle memoryHandle;
+
 public:
   /**
       Constructor.
@@ -59,7 +62,8 @@ public:
   Window(WindowSystem *windowSystem);
 
   /**
-      Destructor. Frees allocated resource by calling WindowSystem::freeWindow() function.
+      Destructor. Frees allocated resource by calling WindowSystem::freeWindow() function
+      and unregisters the window in the memory manager.
   */
   virtual ~Window();
 
@@ -175,6 +179,24 @@ public:
 @return 'false' if there are no available events for this window.
   */
   virtual bool hasAvailableEvent();
+
+  /**
+      Takes all available events of this window without blocking. Consecutive
+      mouse motion events may be merged into the last one.
+      @param buffer - Array that receives pointers to events.
+      @param max - Size of the array.
+      @return Number of events written to the buffer.
+  */
+  virtual uint pollEvents(SystemEvent **buffer, uint max);
+
+  /**
+      Waits until there is an event for this window or the timeout expires.
+      Render loop may sleep till the next frame this way instead of spinning.
+      @param timeout - Time to wait in milliseconds: 0 only checks the queue,
+      negative value waits without limit.
+      @return 'true' if there is an available event for this window.
+  */
+  virtual bool waitEvent(int timeout);
 };
 
 }
@@ -4,14 +4,58 @@
 #include <ctime>
 
 #include "common.h"
+#include "windows/event.h"
 #include "windows/window_system.h"
 
 namespace ve {
 
+/* Interval in milliseconds between checks of the queue in the default waitEvent() */
+static const int WAIT_CHECK_INTERVAL = 1;
+
 WindowSystem::WindowSystem() {
+  wakeupEvent = new Event();
 }
 
 WindowSystem::~WindowSystem() {
+  delete wakeupEvent;
+}
+
+uint WindowSystem::pollEvents(Window *window, SystemEvent **buffer, uint max) {
+  CHECK_POINTER_EX(buffer, 0);
+  uint count = 0;
+
+  while (count < max && hasAvailableEvent(window)) {
+    SystemEvent *event = getNextEvent(window);
+    if (event != NULL) {
+      buffer[count++] = event;
+    }
+  }
+
+  return count;
+}
+
+bool WindowSystem::waitEvent(Window *window, int timeout) {
+  /* Sleeping time is counted by intervals, so the timeout is approximate */
+  while (!hasAvailableEvent(window)) {
+    if (timeout == 0) {
+      return false;
+    }
+
+    int interval = timeout > 0 && timeout < WAIT_CHECK_INTERVAL ? timeout : WAIT_CHECK_INTERVAL;
+    if (wakeupEvent->wait(interval)) {
+      return false;
+    }
+
+    if (timeout > 0) {
+      timeout -= interval;
+    }
+  }
+
+  return true;
+}
+
+void WindowSystem::wakeUp() {
+  wakeupEvent->set();
 }
 
 }
@@ -18,6 +18,7 @@
 namespace ve {
 
 class Engine;
+class Event;
 
 /**
   Defines screen mode that may be set at the current display
@@ -43,6 +44,10 @@ struct ScreenMode {
     create fonts registered in the system.
 */
 class WindowSystem : public MouseEventsSource, public KeyEventsSource {
+private:
+  /** Interrupts the default waitEvent() */
+  Event *wakeupEvent;
+
 public:
   /**
       Default constructor. Creates memory manager.
@@ -167,6 +172,36 @@ and width, height parameters will be ignored.
   */
   virtual bool hasAvailableEvent(Window *window) = 0;
 
+  /**
+      Takes all available events of the window without blocking. Default
+      implementation calls getNextEvent() while there are events, window systems
+      override it to deliver events without allocations and to coalesce mouse motion.
+      @param window - Event queue of this window will be checked.
+      @param buffer - Array that receives pointers to events.
+      @param max - Size of the array.
+      @return Number of events written to the buffer, 0 if there are no events.
+  */
+  virtual uint pollEvents(Window *window, SystemEvent **buffer, uint max);
+
+  /**
+      Waits until there is an event for the window, the timeout expires or
+      wakeUp() is called. Default implementation checks the queue every
+      millisecond and sleeps between checks, window systems override it to
+      sleep on their event source.
+      @param window - Event queue of this window will be checked.
+      @param timeout - Time to wait in milliseconds: 0 only checks the queue,
+      negative value waits without limit.
+      @return 'true' if there is an available event for the window.
+      @return 'false' if the timeout expired or the wait was interrupted by wakeUp().
+  */
+  virtual bool waitEvent(Window *window, int timeout);
+
+  /**
+      Interrupts waitEvent(), so the render loop may react on work which
+      came from other threads. It may be called from any thread.
+  */
+  virtual void wakeUp();
+
   /**
       Sets window caption.
       @param window - Window to set caption for.
@@ -108,8 +108,6 @@ Window* WindowsSystem::createWindow(const std::wstring & windowName, int x, int
   Window *window = new Window(this);
   registerWindow(window, hWnd, hDC, hGLRC);
 
-  REGISTER_POINTER(window);
-
   ERROR_IF(WinMessagePump::getInstance()->start(hWnd) != OK, L"Failed to create message pump", NULL);
 
   return window;
@@ -132,7 +130,6 @@ Font* WindowsSystem::createFont(Engine *engine, FontDescriptor *desc) {
   }
 
   WinFont *newWinFont = new WinFont(this, engine, hFont);
-  REGISTER_POINTER(newWinFont);
 
   return newWinFont;
 }
@@ -5,6 +5,12 @@
 
 #include "engine/common.h"
 
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/select.h>
+#include <time.h>
+#include <unistd.h>
+
 #include <X11/X.h>
 #include <X11/keysym.h>
 #include <X11/extensions/xf86vmode.h>
@@ -24,6 +30,22 @@ XWindowSystem::XWindowSystem() {
   /* Open a connection to the X server */
   dpy = XOpenDisplay(NULL);
   LOG_IF(dpy == NULL, L"Could not open display");
+  eventIndex = 0;
+
+  if (pipe(wakeupPipe) == 0) {
+    fcntl(wakeupPipe[0], F_SETFL, fcntl(wakeupPipe[0], F_GETFL) | O_NONBLOCK);
+    fcntl(wakeupPipe[1], F_SETFL, fcntl(wakeupPipe[1], F_GETFL) | O_NONBLOCK);
+  } else {
+    LOG_ERROR(L"Could not create wakeup pipe");
+    wakeupPipe[0] = wakeupPipe[1] = -1;
+  }
+}
+
+XWindowSystem::~XWindowSystem() {
+  if (wakeupPipe[0] != -1) {
+    close(wakeupPipe[0]);
+    close(wakeupPipe[1]);
+  }
 }
 
 bool XWindowSystem::isOpenGLSupported() {
@@ -34,26 +56,65 @@ bool XWindowSystem::isOpenGLSupported() {
 }
 
 Outcome XWindowSystem::registerWindow(Window* window, XID id) {
-  WindowInfo wi;
-
-  wi.window = window;
-  wi.id = id;
+  CHECK_POINTER(window);
 
-  winInfo.push_back(wi);
+  windowsById.insert(id, window);
+  idsByWindow.insert(window, id);
+  eventsById.insert(id, std::deque<XEvent>());
   return OK;
 }
 
+void XWindowSystem::unregisterWindow(XID id) {
+  Window *window = getWindow(id);
+  if (window != NULL) {
+    idsByWindow.remove(window);
+  }
+
+  windowsById.remove(id);
+  eventsById.remove(id);
+}
+
 XID XWindowSystem::getWindowXID(Window *window) {
   CHECK_POINTER_EX(window, 0);
 
-  uint len = winInfo.size();
-  for (uint i = 0; i < len; i++) {
-    if (winInfo[i].window == window) {
-      return winInfo[i].id;
-    }
+  XID *id = idsByWindow.find(window);
+  return id != NULL ? *id : 0;
+}
+
+Window *XWindowSystem::getWindow(XID id) {
+  Window **window = windowsById.find(id);
+  return window != NULL ? *window : NULL;
+}
+
+std::deque<XEvent> &XWindowSystem::getEventQueue(XID id) {
+  std::deque<XEvent> *events = eventsById.find(id);
+  return events != NULL ? *events : otherEvents;
+}
+
+void XWindowSystem::routeEvents() {
+  // XPending flushes the output buffer and reads the connection, then every
+  // queued event is moved to its window in one pass
+  int count = XPending(dpy);
+  for (int i = 0; i < count; i++) {
+    XEvent event;
+    XNextEvent(dpy, &event);
+    getEventQueue(event.xany.window).push_back(event);
+  }
+}
+
+bool XWindowSystem::takeEvent(XID id, XEvent &event) {
+  std::deque<XEvent> *events = eventsById.find(id);
+  if (events == NULL || events->empty()) {
+    events = &otherEvents;
+  }
+
+  if (events->empty()) {
+    return false;
   }
 
-  return 0;
+  event = events->front();
+  events->pop_front();
+  return true;
 }
 
 Window* XWindowSystem::createWindow(const std::wstring & windowName, int x, int y,
@@ -132,7 +193,6 @@ Window* XWindowSystem::createWindow(const std::wstring & windowName, int x, int
   ERROR_IF(wnd_Name == None, L"Atom is None", NULL);
   XSetWMProtocols(dpy, winId, &wnd_DestroyAtom, 1);
 
-  REGISTER_POINTER(window);
   return window;
 }
 
@@ -146,7 +206,6 @@ Font* XWindowSystem::createFont(Engine *engine, FontDescriptor *desc) {
 
   XFont* newXFont = new XFont(this, engine, font);
   CHECK_ALLOC_EX(newXFont, NULL);
-  REGISTER_POINTER(newXFont);
   return newXFont;
 }
 
@@ -200,6 +259,7 @@ Outcome XWindowSystem::show(Window *window) {
 
 Outcome XWindowSystem::freeWindow(Window *window) {
   CHECK_POINTER(window);
+  unregisterWindow(getWindowXID(window));
   return OK;
 }
 
@@ -252,55 +312,186 @@ Outcome XWindowSystem::setScreenResolution(ScreenMode mode) {
   return result;
 }
 
-/**
-    Returns the next window system event if there is any. If there are
-    no events function blocks waits till next event happens.
-@param window - Message queue of this window will be checked.
-    @return Window system event.
-    @return NULL is event is not supported.
-*/
-SystemEvent* XWindowSystem::getNextEvent(Window *window) {
-  XEvent event;
+SystemEvent* XWindowSystem::translateEvent(XEvent &event) {
   KeySym     keySym;
   const int BUFFER_SIZE = 10;
   char       buffer[BUFFER_SIZE];
+  EventSlot &slot = eventRing[eventIndex];
 
-  XNextEvent(dpy, &event);
   switch (event.type) {
   case DestroyNotify:
-    return new WindowEvent(WINDOW_CLOSE, 0, 0);
+    // X window does not exist anymore, its identifier may be reused by the server
+    unregisterWindow(event.xdestroywindow.window);
+    slot.window = WindowEvent(WINDOW_CLOSE, 0, 0);
     break;
 
   case ClientMessage:
-    if (event.xclient.message_type == wnd_Protocols &&
-      event.xclient.data.l[0] == wnd_DestroyAtom) {
-      XDestroyWindow(dpy, event.xany.window);
-      return new WindowEvent(WINDOW_CLOSE, 0, 0);
+    if (event.xclient.message_type != wnd_Protocols ||
+      (Atom)event.xclient.data.l[0] != wnd_DestroyAtom) {
+      return NULL;
     }
+    XDestroyWindow(dpy, event.xany.window);
+    slot.window = WindowEvent(WINDOW_CLOSE, 0, 0);
     break;
 
   case KeyPress:
     XLookupString((XKeyPressedEvent *)&event, buffer, BUFFER_SIZE, &keySym, NULL);
-    return new KeyEvent(KEY_PRESS, KeysCodec::LinuxToEE(keySym));
+    slot.key = KeyEvent(KEY_PRESS, KeysCodec::LinuxToEE(keySym));
+    break;
 
   case KeyRelease:
     XLookupString((XKeyReleasedEvent *)&event, buffer, BUFFER_SIZE, &keySym, NULL);
-    return new KeyEvent(KEY_RELEASE, KeysCodec::LinuxToEE(keySym));
+    slot.key = KeyEvent(KEY_RELEASE, KeysCodec::LinuxToEE(keySym));
+    break;
 
   case MotionNotify:
-    return new MouseEvent(MOUSE_MOTION, LEFT_BUTTON, event.xmotion.x, event.xmotion.y, event.xmotion.x, event.xmotion.y);
+    slot.mouse = MouseEvent(MOUSE_MOTION, LEFT_BUTTON, event.xmotion.x, event.xmotion.y, event.xmotion.x, event.xmotion.y);
+    break;
 
   case ButtonPress:
-    return new MouseEvent(MOUSE_PRESS, (MouseButton)event.xbutton.button, event.xmotion.x, event.xmotion.y, event.xmotion.x, event.xmotion.y);
+    slot.mouse = MouseEvent(MOUSE_PRESS, (MouseButton)event.xbutton.button, event.xbutton.x, event.xbutton.y, event.xbutton.x, event.xbutton.y);
+    break;
 
   case ButtonRelease:
-    return new MouseEvent(MOUSE_RELEASE, (MouseButton)event.xbutton.button, event.xmotion.x, event.xmotion.y, event.xmotion.x, event.xmotion.y);
+    slot.mouse = MouseEvent(MOUSE_RELEASE, (MouseButton)event.xbutton.button, event.xbutton.x, event.xbutton.y, event.xbutton.x, event.xbutton.y);
+    break;
 
   case Expose:
-    return new WindowEvent(WINDOW_RESIZE, event.xexpose.width, event.xexpose.height);
+    slot.window = WindowEvent(WINDOW_RESIZE, event.xexpose.width, event.xexpose.height);
+    break;
+
+  default:
+    return NULL;
   }
 
-  return NULL;
+  eventIndex = (eventIndex + 1) % EVENT_RING_SIZE;
+
+  switch (event.type) {
+  case KeyPress:
+  case KeyRelease:
+    return &slot.key;
+
+  case MotionNotify:
+  case ButtonPress:
+  case ButtonRelease:
+    return &slot.mouse;
+
+  default:
+    return &slot.window;
+  }
+}
+
+/**
+    Returns the next window system event if there is any. If there are
+    no events function blocks waits till next event happens.
+@param window - Message queue of this window will be checked.
+    @return Window system event.
+    @return NULL is event is not supported.
+*/
+SystemEvent* XWindowSystem::getNextEvent(Window *window) {
+  CHECK_POINTER_EX(dpy, NULL);
+  XID id = getWindowXID(window);
+  XEvent event;
+
+  while (!takeEvent(id, event)) {
+    // Blocks till the next event of any window and routes it
+    XNextEvent(dpy, &event);
+    getEventQueue(event.xany.window).push_back(event);
+  }
+
+  return translateEvent(event);
+}
+
+uint XWindowSystem::pollEvents(Window *window, SystemEvent **buffer, uint max) {
+  CHECK_POINTER_EX(buffer, 0);
+  CHECK_POINTER_EX(dpy, 0);
+  XID id = getWindowXID(window);
+  XEvent event;
+  uint count = 0;
+
+  if (max > EVENT_RING_SIZE) {
+    max = EVENT_RING_SIZE;
+  }
+
+  // Events of other windows stay in their queues
+  routeEvents();
+
+  while (count < max && takeEvent(id, event)) {
+    if (event.type == MotionNotify && count > 0 && buffer[count - 1]->getType() == MOUSE_MOTION) {
+      // Previous event is a motion from this batch, so it is stored in the ring and is updated in place
+      MouseEvent *motion = static_cast<MouseEvent *>(buffer[count - 1]);
+      *motion = MouseEvent(MOUSE_MOTION, LEFT_BUTTON, event.xmotion.x, event.xmotion.y, event.xmotion.x, event.xmotion.y);
+      continue;
+    }
+
+    SystemEvent *systemEvent = translateEvent(event);
+    if (systemEvent != NULL) {
+      buffer[count++] = systemEvent;
+    }
+  }
+
+  return count;
+}
+
+/**
+    Returns milliseconds of the monotonic clock.
+*/
+static long long getMilliseconds() {
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (long long)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+bool XWindowSystem::waitEvent(Window *window, int timeout) {
+  CHECK_POINTER_EX(dpy, false);
+  long long deadline = getMilliseconds() + timeout;
+  int connection = ConnectionNumber(dpy);
+
+  // hasAvailableEvent() routes events which are already read from the connection, so
+  // they are not missed by select()
+  while (!hasAvailableEvent(window)) {
+    long long remaining = timeout < 0 ? -1 : deadline - getMilliseconds();
+    if (timeout >= 0 && remaining <= 0) {
+      return false;
+    }
+
+    fd_set descriptors;
+    FD_ZERO(&descriptors);
+    FD_SET(connection, &descriptors);
+    int maxDescriptor = connection;
+    if (wakeupPipe[0] != -1) {
+      FD_SET(wakeupPipe[0], &descriptors);
+      maxDescriptor = wakeupPipe[0] > maxDescriptor ? wakeupPipe[0] : maxDescriptor;
+    }
+
+    timeval wait;
+    wait.tv_sec = (long)(remaining / 1000);
+    wait.tv_usec = (long)(remaining % 1000) * 1000;
+
+    int result = select(maxDescriptor + 1, &descriptors, NULL, NULL, timeout < 0 ? NULL : &wait);
+    if (result < 0 && errno != EINTR) {
+      LOG_ERROR(L"select() failed while waiting for events");
+      return false;
+    }
+
+    if (result > 0 && wakeupPipe[0] != -1 && FD_ISSET(wakeupPipe[0], &descriptors)) {
+      char data[64];
+      while (read(wakeupPipe[0], data, sizeof(data)) > 0) {
+      }
+      return hasAvailableEvent(window);
+    }
+  }
+
+  return true;
+}
+
+void XWindowSystem::wakeUp() {
+  if (wakeupPipe[1] != -1) {
+    // Pipe is non-blocking, if it is full the waiting thread is woken up anyway
+    char data = 0;
+    ssize_t written = write(wakeupPipe[1], &data, 1);
+    (void)written;
+  }
 }
 
 /**
@@ -310,7 +501,11 @@ SystemEvent* XWindowSystem::getNextEvent(Window *window) {
 @return 'false' if there are no available events for the window.
 */
 bool XWindowSystem::hasAvailableEvent(Window *window) {
-  return XPending(dpy) > 0;
+  CHECK_POINTER_EX(dpy, false);
+  routeEvents();
+
+  std::deque<XEvent> *events = eventsById.find(getWindowXID(window));
+  return (events != NULL && !events->empty()) || !otherEvents.empty();
 }
 
 /* set functions */
@@ -6,6 +6,7 @@
 #ifndef __VE_X_WINDOW_SYSTEM_H__
 #define __VE_X_WINDOW_SYSTEM_H__
 
+#include <deque>
 #include <vector>
 
 #include <X11/X.h>
@@ -14,6 +15,10 @@
 #include "common.h"
 #include "windows/window_system.h"
 #include "fonts/font.h"
+#include "events/key_event.h"
+#include "events/mouse_event.h"
+#include "events/window_event.h"
+#include "tools/hash_map.h"
 
 namespace ve {
 
@@ -23,37 +28,104 @@ namespace ve {
 class XWindowSystem : public WindowSystem {
 private:
 
-  /**
-      Structure that contains system specific data associated with
-      Window class pointer.
-  */
-  struct WindowInfo {
-    Window* window;
-    XID id;
-  };
-
   Display *dpy;
-  std::vector<WindowInfo> winInfo;
+
+  /** Windows by X window identifiers, it routes X events to windows */
+  HashMap<XID, Window *> windowsById;
+
+  /** X window identifiers by windows */
+  HashMap<Window *, XID> idsByWindow;
+
+  /** X events which were taken from the Xlib queue, by X window identifiers of registered windows */
+  HashMap<XID, std::deque<XEvent> > eventsById;
+
+  /** X events of X windows which are not registered here, any window takes them */
+  std::deque<XEvent> otherEvents;
   Atom wnd_DestroyAtom;
   Atom wnd_Protocols;
   Atom wnd_Name;
 
+  /** Number of preallocated events, events are reused in a ring */
+  static const uint EVENT_RING_SIZE = 256;
+
+  /**
+      Preallocated event of any kind, only one member is used at a time.
+  */
+  struct EventSlot {
+    KeyEvent key;
+    MouseEvent mouse;
+    WindowEvent window;
+
+    EventSlot() : key(KEY_PRESS), mouse(MOUSE_MOTION), window(WINDOW_RESIZE) {
+    }
+  };
+
+  /** Ring of events returned by getNextEvent() and pollEvents() */
+  EventSlot eventRing[EVENT_RING_SIZE];
+
+  /** Index of the next slot in the ring */
+  uint eventIndex;
+
+  /** Pipe which interrupts waitEvent(), read end is polled with X connection */
+  int wakeupPipe[2];
+
+  /**
+      Converts X event to the engine event stored in the next slot of the ring.
+      @return Engine event or NULL if X event is not supported.
+  */
+  SystemEvent *translateEvent(XEvent &event);
+
   /**
       Returns XID by Window class.
   */
   XID getWindowXID(Window *window);
 
+  /**
+      Returns window by X window identifier.
+      @return Window or NULL if the identifier is not registered.
+  */
+  Window *getWindow(XID id);
+
   /**
       Registers (Window*, XID) pair.
   */
   Outcome registerWindow(Window* window, XID id);
 
+  /**
+      Removes window from the maps and drops its pending X events.
+  */
+  void unregisterWindow(XID id);
+
+  /**
+      Returns queue of pending X events of X window.
+      @return Queue of the registered window or queue of other windows.
+  */
+  std::deque<XEvent> &getEventQueue(XID id);
+
+  /**
+      Moves all X events from the Xlib queue to the queues of their windows, so the
+      Xlib queue is read once instead of being searched for every window.
+  */
+  void routeEvents();
+
+  /**
+      Takes the oldest pending X event of X window, events of not registered
+      X windows are taken when the window has none.
+      @return 'false' if there are no pending events.
+  */
+  bool takeEvent(XID id, XEvent &event);
+
 public:
   /**
       Default constructor. Creates memory manager.
   */
   XWindowSystem();
 
+  /**
+      Destructor. Closes the wakeup pipe.
+  */
+  virtual ~XWindowSystem();
+
   /**
       Checks if OpenGL is supported on this system.
       @return 'true' is supported.
@@ -158,7 +230,9 @@ and width, height parameters will be ignored.
 
   /**
       Returns the next window system event if there is any. If there are
-      no events function blocks waits till next event happens.
+      no events function blocks waits till next event happens. Events are not
+      allocated: they are taken from the ring of EVENT_RING_SIZE objects and stay
+      valid until the ring wraps around, so they must not be deleted.
 @param window - Message queue of this window will be checked.
       @return Window system event.
       @return NULL is event is not supported.
@@ -173,6 +247,34 @@ and width, height parameters will be ignored.
   */
   virtual bool hasAvailableEvent(Window *window);
 
+  /**
+      Takes all pending X events without blocking. Consecutive mouse motion events
+      are merged into one with the latest position, so a frame gets one motion event
+      between presses and releases. Events are taken from the ring like in
+      getNextEvent(), max is limited by EVENT_RING_SIZE.
+      @param window - Event queue of this window will be checked.
+      @param buffer - Array that receives pointers to events.
+      @param max - Size of the array.
+      @return Number of events written to the buffer.
+  */
+  virtual uint pollEvents(Window *window, SystemEvent **buffer, uint max);
+
+  /**
+      Waits for X events with select() on the connection of the display and the
+      wakeup pipe, so the thread sleeps until input, the timeout or wakeUp().
+      @param window - Event queue of this window will be checked.
+      @param timeout - Time to wait in milliseconds: 0 only checks the queue,
+      negative value waits without limit.
+      @return 'true' if there is an available event for the window.
+      @return 'false' if the timeout expired or the wait was interrupted by wakeUp().
+  */
+  virtual bool waitEvent(Window *window, int timeout);
+
+  /**
+      Interrupts waitEvent() by writing to the wakeup pipe. It may be called from any thread.
+  */
+  virtual void wakeUp();
+
   /**
       Sets window caption.
       @param window - Window to set caption for.
@@ -9,14 +9,26 @@
 
 namespace ve {
 
+/* Result of decodeSymbol() for a code which is not in the tree */
+static const uint INVALID_SYMBOL = 0xFFFFFFFF;
+
+/* Maximal length of Huffman code in deflate stream */
+static const uint MAX_CODE_LENGTH = 15;
+
 ZLib::ZLib() {
+  position = 0;
+  exhausted = false;
 }
 
 uchar ZLib::getBit(std::vector<uchar> &source) {
   uint byteNo = (position / 8);
   uchar bitNo = (position % 8);
 
-  ERROR_IF(byteNo >= source.size(), L"Buffer size exceeded", 0);
+  /* Flag stays set, so deflate() stops at the next check instead of decoding zero bits forever */
+  if (byteNo >= source.size()) {
+    exhausted = true;
+    return 0;
+  }
   uchar value = (source[byteNo] & (1 << bitNo)) ? 1 : 0;
 
   position++;
@@ -113,22 +125,26 @@ void ZLib::repeat(std::vector<uchar> &data, uint repLength, uint repDistance) {
     @param source - File to get bytes from.
     @param tree - Huffman tree to use for decoding.
     @return Next decoded from a stream symbol.
+    @return INVALID_SYMBOL if the code is not in the tree or the stream ended.
 */
 uint ZLib::decodeSymbol(std::vector<uchar> &source, DynamicHuffmanTree *tree) {
   uint dataCode = 0;
   uint bits = 0;
+  int symbol;
 
   do {
     dataCode = (dataCode << 1) | getBit(source);
     bits++;
 
-    ERROR_IF(bits > 32, L"It seems that this is an infinite loop :(", 0)
-  } while (tree->exists(dataCode, bits) == -1);
+    ERROR_IF(exhausted, L"Buffer size exceeded", INVALID_SYMBOL);
+    ERROR_IF(bits > MAX_CODE_LENGTH, L"Wrong Huffman code", INVALID_SYMBOL);
+    symbol = tree->exists(dataCode, bits);
+  } while (symbol == -1);
 
-    return tree->exists(dataCode, bits);
+  return (uint)symbol;
 }
 
-Outcome ZLib::deflate(std::vector<uchar> &data, std::vector<uchar> &sourceData) {
+Outcome ZLib::deflate(std::vector<uchar> &data, std::vector<uchar> &sourceData, size_t limit) {
   /*
 
       5 Bits: HLIT, # of Literal/Length codes - 257 (257 - 286)
@@ -170,6 +186,7 @@ Outcome ZLib::deflate(std::vector<uchar> &data, std::vector<uchar> &sourceData)
 
   /*  Initialize buffer position */
   position = 0;
+  exhausted = false;
 
   CMF = getLSBvalue(sourceData, 8);
   compressionMethod = CMF & 0x0F;
@@ -200,6 +217,9 @@ Outcome ZLib::deflate(std::vector<uchar> &data, std::vector<uchar> &sourceData)
     blockType = getBit(sourceData);
     blockType = blockType | (getBit(sourceData) << 1);
 
+    ERROR_IF(exhausted, L"Buffer size exceeded", ERROR);
+    ERROR_IF(blockType == BLOCK_RESERD, L"Reserved block type", ERROR);
+
     if (blockType == BLOCK_NO_COMPRESSION) {
       FAIL(L"Block without compression", ERROR);
     } else {
@@ -248,13 +268,14 @@ Outcome ZLib::deflate(std::vector<uchar> &data, std::vector<uchar> &sourceData)
               break;
 
             default:
-              LOG_ERROR(L"Wrong symbol decoded");
+              FAIL(L"Wrong symbol decoded", ERROR);
             }
 
             /* Repeat length */
             ASSERT(literalTree.fill(curLiteral, extraLength, fillCode));
             curLiteral = curLiteral + extraLength;
           }
+          ERROR_IF(exhausted, L"Buffer size exceeded", ERROR);
         } while (curLiteral < HLIT);
 
         /* Decode distance codes */
@@ -289,12 +310,13 @@ Outcome ZLib::deflate(std::vector<uchar> &data, std::vector<uchar> &sourceData)
               break;
 
             default:
-              LOG_ERROR(L"Wrong symbol decoded");
+              FAIL(L"Wrong symbol decoded", ERROR);
             }
 
             ASSERT(distanceTree.fill(curDistance, extraLength, fillCode));
             curDistance = curDistance + extraLength;
           }
+          ERROR_IF(exhausted, L"Buffer size exceeded", ERROR);
         } while (curDistance < HDIST);
 
         /* Make Huffman table for lengths   */
@@ -344,8 +366,10 @@ Outcome ZLib::deflate(std::vector<uchar> &data, std::vector<uchar> &sourceData)
       do {
         /* Decode byte from stream */
         decodedSymbol = decodeSymbol(sourceData, &literalTree);
+        ERROR_IF(decodedSymbol > 285, L"Wrong literal/length code", ERROR);
         if (decodedSymbol < 256) {
           /* If it is literal code and there is a spare place in buffer */
+          ERROR_IF(data.size() >= limit, L"Uncompressed data is too large", ERROR);
           data.push_back(decodedSymbol);
         } else {
           if (decodedSymbol > 256) {
@@ -353,15 +377,20 @@ Outcome ZLib::deflate(std::vector<uchar> &data, std::vector<uchar> &sourceData)
             repLength = getLength(sourceData, decodedSymbol);
             if (blockType == BLOCK_FIXED_HUFFMAN) {
               repDistance = getMSBvalue(sourceData, 5);
-              repDistance = getDistance(sourceData, repDistance);
             } else {
               /* Decode distance code */
               repDistance = decodeSymbol(sourceData, &distanceTree);
-              repDistance = getDistance(sourceData, repDistance);
             }
+            ERROR_IF(repDistance > 29, L"Wrong distance code", ERROR);
+            repDistance = getDistance(sourceData, repDistance);
+
+            /* Corrupted stream must not reference bytes before the output */
+            ERROR_IF(repDistance == 0 || repDistance > data.size(), L"Wrong distance of repeat command", ERROR);
+            ERROR_IF(repLength > limit - data.size(), L"Uncompressed data is too large", ERROR);
             repeat(data, repLength, repDistance);
           }
         }
+        ERROR_IF(exhausted, L"Buffer size exceeded", ERROR);
       } while (decodedSymbol != 256);
     }
 
@@ -17,6 +17,9 @@
 #define MAX_LITERAL_NUMBER    286
 #define MAX_DISTANCE_NUMBER   32
 
+// Output of deflate() is not limited
+#define ZLIB_NO_LIMIT         ((size_t)-1)
+
 // Block types
 #define BLOCK_NO_COMPRESSION  0
 #define BLOCK_FIXED_HUFFMAN   1
@@ -34,6 +37,7 @@ namespace ve {
 class ZLib {
 private:
   uint position;                                                             // Position in buffer (bits)
+  bool exhausted;                                                            // Bits past the end of the buffer were requested
 
   uchar getBit(std::vector<uchar> &source);                                  // Get bit from source stream
   uchar getByte(std::vector<uchar> &source);
@@ -48,6 +52,7 @@ private:
       @param source - File to get bytes from.
       @param tree - Huffman tree to use for decoding.
       @return Next decoded from a stream symbol.
+      @return 0xFFFFFFFF (INVALID_SYMBOL) if the code is not in the tree or the stream ended.
   */
   uint decodeSymbol(std::vector<uchar> &source, DynamicHuffmanTree *tree);
 
@@ -62,8 +67,11 @@ public:
       the 'data' array.
       @param data - Uncompressed data.
       @param sourceData - Source file to uncompress.
+      @param limit - Maximal size of uncompressed data, stream which produces more is corrupted.
+      @return OK if data was uncompressed.
+      @return ERROR if stream is truncated or corrupted.
   */
-  Outcome deflate(std::vector<uchar> &data, std::vector<uchar> &sourceData);
+  Outcome deflate(std::vector<uchar> &data, std::vector<uchar> &sourceData, size_t limit = ZLIB_NO_LIMIT);
 };
 
 }
@@ -0,0 +1,207 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include "common.h"
+#include "zlib/zlib.h"
+#include "zlib/zlib_compressor.h"
+
+namespace ve {
+
+/* Size of the sliding window */
+static const size_t WINDOW_SIZE = 32768;
+
+/* Shortest and longest match of deflate */
+static const uint MIN_MATCH = 3;
+static const uint MAX_MATCH = 258;
+
+/* Number of entries of the hash of three bytes */
+static const uint HASH_SIZE = 1 << 15;
+
+/* Symbol which ends a block */
+static const uint END_OF_BLOCK = 256;
+
+/* Base lengths and extra bits of length symbols 257 - 285 */
+static const ushort lengthBase[29] = {
+  3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+  35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uchar lengthExtra[29] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+  3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+/* Base distances and extra bits of distance codes 0 - 29 */
+static const ushort distanceBase[30] = {
+  1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+  257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uchar distanceExtra[30] = {
+  0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+  7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+static inline uint hashBytes(const uchar *data) {
+  return ((data[0] << 10) ^ (data[1] << 5) ^ data[2]) & (HASH_SIZE - 1);
+}
+
+ZLibCompressor::ZLibCompressor(uint chainLimit) {
+  output = NULL;
+  bitBuffer = 0;
+  bitCount = 0;
+  this->chainLimit = chainLimit != 0 ? chainLimit : 1;
+}
+
+void ZLibCompressor::putBits(uint value, uint count) {
+  bitBuffer |= value << bitCount;
+  bitCount += count;
+
+  while (bitCount >= 8) {
+    output->push_back((uchar)bitBuffer);
+    bitBuffer >>= 8;
+    bitCount -= 8;
+  }
+}
+
+void ZLibCompressor::putCode(uint code, uint length) {
+  uint reversed = 0;
+  for (uint i = 0; i < length; i++) {
+    reversed = (reversed << 1) | ((code >> i) & 1);
+  }
+  putBits(reversed, length);
+}
+
+void ZLibCompressor::putSymbol(uint symbol) {
+  if (symbol <= 143) {
+    putCode(48 + symbol, 8);
+  } else if (symbol <= 255) {
+    putCode(400 + (symbol - 144), 9);
+  } else if (symbol <= 279) {
+    putCode(symbol - 256, 7);
+  } else {
+    putCode(192 + (symbol - 280), 8);
+  }
+}
+
+void ZLibCompressor::putMatch(uint length, uint distance) {
+  uint code = 28;
+  while (lengthBase[code] > length) {
+    code--;
+  }
+  putSymbol(257 + code);
+  putBits(length - lengthBase[code], lengthExtra[code]);
+
+  code = 29;
+  while (distanceBase[code] > distance) {
+    code--;
+  }
+  putCode(code, 5);
+  putBits(distance - distanceBase[code], distanceExtra[code]);
+}
+
+void ZLibCompressor::flushBits() {
+  if (bitCount != 0) {
+    output->push_back((uchar)bitBuffer);
+  }
+  bitBuffer = 0;
+  bitCount = 0;
+}
+
+Outcome ZLibCompressor::compress(const uchar *source, size_t size, std::vector<uchar> &data) {
+  ERROR_IF(source == NULL && size != 0, L"Source is NULL", INVALID_VALUE);
+
+  data.clear();
+  data.reserve(size / 2 + 64);
+  output = &data;
+  bitBuffer = 0;
+  bitCount = 0;
+
+  /* Deflate with 32K window and default level, header is a multiple of 31 */
+  data.push_back(0x78);
+  data.push_back(0x9c);
+
+  /* Whole data is one final block with fixed codes */
+  putBits(1, 1);
+  putBits(BLOCK_FIXED_HUFFMAN, 2);
+
+  /* head holds the last position + 1 of every hash, previous keeps chains of the window */
+  std::vector<size_t> head(HASH_SIZE, 0);
+  std::vector<size_t> previous(WINDOW_SIZE, 0);
+
+  size_t position = 0;
+  while (position < size) {
+    uint bestLength = 0;
+    size_t bestDistance = 0;
+
+    if (size - position >= MIN_MATCH) {
+      uint hash = hashBytes(source + position);
+      size_t candidate = head[hash];
+      uint limit = size - position < MAX_MATCH ? (uint)(size - position) : MAX_MATCH;
+
+      for (uint chain = 0; chain < chainLimit && candidate != 0; chain++) {
+        size_t match = candidate - 1;
+        if (position - match > WINDOW_SIZE) {
+          break;
+        }
+
+        if (source[match + bestLength] == source[position + bestLength]) {
+          uint length = 0;
+          while (length < limit && source[match + length] == source[position + length]) {
+            length++;
+          }
+
+          if (length > bestLength) {
+            bestLength = length;
+            bestDistance = position - match;
+            if (length == limit) {
+              break;
+            }
+          }
+        }
+
+        size_t next = previous[match & (WINDOW_SIZE - 1)];
+        if (next >= candidate) {
+          break;
+        }
+        candidate = next;
+      }
+    }
+
+    uint step = 1;
+    if (bestLength >= MIN_MATCH) {
+      putMatch(bestLength, (uint)bestDistance);
+      step = bestLength;
+    } else {
+      putSymbol(source[position]);
+    }
+
+    /* Every position of the match is inserted into the chains */
+    for (uint i = 0; i < step; i++, position++) {
+      if (size - position >= MIN_MATCH) {
+        uint hash = hashBytes(source + position);
+        previous[position & (WINDOW_SIZE - 1)] = head[hash];
+        head[hash] = position + 1;
+      }
+    }
+  }
+
+  putSymbol(END_OF_BLOCK);
+  flushBits();
+
+  /* Adler-32 of the uncompressed data, most significant byte first */
+  uint a = 1;
+  uint b = 0;
+  for (size_t i = 0; i < size; i++) {
+    a = (a + source[i]) % 65521;
+    b = (b + a) % 65521;
+  }
+  uint adler32 = (b << 16) | a;
+  data.push_back((uchar)(adler32 >> 24));
+  data.push_back((uchar)(adler32 >> 16));
+  data.push_back((uchar)(adler32 >> 8));
+  data.push_back((uchar)adler32);
+
+  output = NULL;
+  return OK;
+}
+
+}
@@ -0,0 +1,77 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#ifndef __VE_ZLIB_COMPRESSOR_H__
+#define __VE_ZLIB_COMPRESSOR_H__
+
+#include <vector>
+
+#include "engine/common.h"
+
+namespace ve {
+
+/**
+    Compresses data into a zlib stream which ZLib decompresses. Matches are
+    found with hash chains in a 32K window and coded with the fixed Huffman
+    codes of deflate, so the compressor is small and predictable. It is used
+    by offline tools like the pack builder, not at run time.
+*/
+class ZLibCompressor {
+private:
+  /** Output stream */
+  std::vector<uchar> *output;
+
+  /** Bits which were not written to the output, LSB first */
+  uint bitBuffer;
+
+  /** Number of bits in the buffer */
+  uint bitCount;
+
+  /** Maximal number of positions checked for every match */
+  uint chainLimit;
+
+  /**
+      Writes value LSB first.
+  */
+  void putBits(uint value, uint count);
+
+  /**
+      Writes Huffman code, codes are stored MSB first.
+  */
+  void putCode(uint code, uint length);
+
+  /**
+      Writes fixed Huffman code of a literal/length symbol.
+  */
+  void putSymbol(uint symbol);
+
+  /**
+      Writes <length, distance> pair.
+  */
+  void putMatch(uint length, uint distance);
+
+  /**
+      Writes incomplete byte.
+  */
+  void flushBits();
+
+public:
+  /**
+      Constructor.
+      @param chainLimit - Number of candidates checked for every match, more is slower and smaller.
+  */
+  ZLibCompressor(uint chainLimit = 64);
+
+  /**
+      Compresses data.
+      @param source - Data to compress.
+      @param size - Size of the data in bytes.
+      @param data - Zlib stream, previous content is replaced.
+      @return OK if data was compressed.
+  */
+  Outcome compress(const uchar *source, size_t size, std::vector<uchar> &data);
+};
+
+}
+
+#endif // __VE_ZLIB_COMPRESSOR_H__
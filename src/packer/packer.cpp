@@ -0,0 +1,140 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef VE_LINUX
+#include <dirent.h>
+#include <sys/stat.h>
+#endif // VE_LINUX
+
+#include "engine/common.h"
+#include "engine/io/buffered_output_stream.h"
+#include "engine/io/file_output_stream.h"
+#include "engine/io/mapped_file_input_stream.h"
+#include "engine/io/pack_writer.h"
+
+using namespace ve;
+
+/* Collects paths of all files of the directory, paths are relative to the root */
+bool listFiles(const std::string &root, const std::string &directory, std::vector<std::string> &files) {
+#ifdef VE_LINUX
+  std::string path = directory.empty() ? root : root + "/" + directory;
+  DIR *dir = opendir(path.c_str());
+  if (dir == NULL) {
+    fprintf(stderr, "Directory can not be opened: %s\n", path.c_str());
+    return false;
+  }
+
+  bool result = true;
+  struct dirent *item;
+  while (result && (item = readdir(dir)) != NULL) {
+    if (strcmp(item->d_name, ".") == 0 || strcmp(item->d_name, "..") == 0) {
+      continue;
+    }
+
+    std::string name = directory.empty() ? item->d_name : directory + "/" + item->d_name;
+    struct stat st;
+    if (stat((root + "/" + name).c_str(), &st) != 0) {
+      fprintf(stderr, "File can not be accessed: %s\n", name.c_str());
+      result = false;
+    } else if (S_ISDIR(st.st_mode)) {
+      result = listFiles(root, name, files);
+    } else if (S_ISREG(st.st_mode)) {
+      files.push_back(name);
+    }
+  }
+
+  closedir(dir);
+  return result;
+#endif // VE_LINUX
+#ifdef VE_WINDOWS
+  std::string pattern = (directory.empty() ? root : root + "\\" + directory) + "\\*";
+  WIN32_FIND_DATAA item;
+  HANDLE find = FindFirstFileA(pattern.c_str(), &item);
+  if (find == INVALID_HANDLE_VALUE) {
+    fprintf(stderr, "Directory can not be opened: %s\n", pattern.c_str());
+    return false;
+  }
+
+  bool result = true;
+  do {
+    if (strcmp(item.cFileName, ".") == 0 || strcmp(item.cFileName, "..") == 0) {
+      continue;
+    }
+
+    std::string name = directory.empty() ? item.cFileName : directory + "/" + item.cFileName;
+    if (item.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+      result = listFiles(root, name, files);
+    } else {
+      files.push_back(name);
+    }
+  } while (result && FindNextFileA(find, &item));
+
+  FindClose(find);
+  return result;
+#endif // VE_WINDOWS
+}
+
+int main(int argc, char *argv[]) {
+  bool compress = true;
+  std::vector<std::string> arguments;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--store") == 0) {
+      compress = false;
+    } else {
+      arguments.push_back(argv[i]);
+    }
+  }
+
+  if (arguments.size() != 2) {
+    printf("usage: packer <directory> <archive> [--store]\n");
+    printf("  --store - entries are not compressed\n");
+    return 1;
+  }
+
+  const std::string &root = arguments[0];
+  const std::string &archive = arguments[1];
+
+  std::vector<std::string> files;
+  if (!listFiles(root, "", files)) {
+    return 1;
+  }
+
+  FILE *file = fopen(archive.c_str(), "wb");
+  if (file == NULL) {
+    fprintf(stderr, "Archive can not be created: %s\n", archive.c_str());
+    return 1;
+  }
+
+  FileOutputStream stream(file);
+  BufferedOutputStream buffered(&stream);
+  PackWriter writer(&buffered);
+
+  size_t originalSize = 0;
+  for (size_t i = 0; i < files.size(); i++) {
+    MappedFileInputStream input(root + "/" + files[i]);
+    if (!input.isOpened()) {
+      fprintf(stderr, "File can not be read: %s\n", files[i].c_str());
+      return 1;
+    }
+
+    if (writer.add(files[i], input.getData(), input.getSize(), compress) != OK) {
+      fprintf(stderr, "File can not be added: %s\n", files[i].c_str());
+      return 1;
+    }
+    originalSize += input.getSize();
+  }
+
+  if (writer.finish() != OK) {
+    fprintf(stderr, "Archive can not be written: %s\n", archive.c_str());
+    return 1;
+  }
+
+  printf("%u files, %u bytes packed into %u bytes\n", writer.getEntriesCount(), (uint)originalSize,
+    (uint)writer.getSize());
+  return 0;
+}
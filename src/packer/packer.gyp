@@ -0,0 +1,27 @@
+# Copyright (c) 2017 The Smart Authors.
+# All rights reserved.
+
+{
+  'targets': [
+    {
+      'target_name': 'packer',
+      'type': 'executable',
+      'dependencies': [
+        '../engine/engine.gyp:*',
+      ],
+      'include_dirs': [
+        './',
+        '../',
+        '../../',
+      ],
+      'sources': [
+        'packer.cpp',
+      ],
+      'msvs_settings': {
+        'VCLinkerTool': {
+          'SubSystem': '1',  # /SUBSYSTEM:CONSOLE
+        },
+      },
+    },
+  ],
+}
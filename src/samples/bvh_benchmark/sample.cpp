@@ -0,0 +1,242 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <cstdio>
+#include <vector>
+
+#include "engine/math/maths.h"
+#include "engine/spatial/bounding_volume_hierarchy.h"
+#include "engine/tools/timer_factory.h"
+
+using namespace ve;
+
+/* Size of the cube objects are scattered in */
+const float worldSize = 1000.0f;
+
+/* Number of every kind of queries */
+const int queries = 1000;
+
+/* Timer which is shared by all measurements */
+Timer *timer = NULL;
+
+/* Returns random point in the world */
+Vector3f randomPoint() {
+  return Vector3f((Maths::randomf() - 0.5f) * worldSize, (Maths::randomf() - 0.5f) * worldSize,
+    (Maths::randomf() - 0.5f) * worldSize);
+}
+
+/* Sets random box bounds around the center */
+void place(VisibleObject &object, const Vector3f &center) {
+  BoundingBox bounds;
+  float size = 1.0f + Maths::randomf() * 4.0f;
+  bounds.setup(center - Vector3f(size, size, size) * 0.5f, size, size, size);
+  object.setBounds(bounds);
+}
+
+/* Brute force box overlap test */
+bool overlaps(const BoundingBox &a, const BoundingBox &b) {
+  Vector3f aMin = a.getCorner(), aMax = aMin + a.getSize();
+  Vector3f bMin = b.getCorner(), bMax = bMin + b.getSize();
+  for (int k = 0; k < 3; k++) {
+    if (aMin[k] > bMax[k] || bMin[k] > aMax[k]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Brute force slab test, returns distance to the box or -1 */
+float rayDistance(const BoundingBox &box, const Vector3f &origin, const Vector3f &direction, float maxDistance) {
+  Vector3f low = box.getCorner(), high = low + box.getSize();
+  float enter = 0, leave = maxDistance;
+  for (int k = 0; k < 3; k++) {
+    float inverse = 1.0f / direction[k];
+    float t0 = (low[k] - origin[k]) * inverse, t1 = (high[k] - origin[k]) * inverse;
+    enter = Maths::max(enter, Maths::min(t0, t1));
+    leave = Maths::min(leave, Maths::max(t0, t1));
+  }
+  return enter <= leave ? enter : -1;
+}
+
+/* Prints measured time */
+void report(const char *name, uint elapsed, uint operations, const char *details) {
+  printf("  %-24s %9.2f ms %10.2f us/op  %s\n", name, (float)elapsed, elapsed * 1000.0f / operations, details);
+}
+
+void benchmark(uint count) {
+  std::vector<VisibleObject> objects(count);
+  std::vector<VisibleObject *> pointers(count);
+  std::vector<int> proxies(count);
+  std::vector<VisibleObject *> result;
+  BoundingVolumeHierarchy tree;
+  char details[128];
+  uint elapsed, reference, found, expected;
+
+  for (uint i = 0; i < count; i++) {
+    place(objects[i], randomPoint());
+    pointers[i] = &objects[i];
+  }
+
+  printf("%u objects:\n", count);
+
+  /* 1. Construction */
+  timer->reset();
+  for (uint i = 0; i < count; i++) {
+    proxies[i] = tree.insert(pointers[i]);
+  }
+  elapsed = timer->getElapsedTime();
+  sprintf(details, "height %u, SAH cost %.1f", tree.getHeight(), tree.getCost());
+  report("insert", elapsed, count, details);
+
+  timer->reset();
+  tree.build(pointers, proxies);
+  elapsed = timer->getElapsedTime();
+  sprintf(details, "height %u, SAH cost %.1f", tree.getHeight(), tree.getCost());
+  report("build (SAH)", elapsed, count, details);
+
+  /* 2. Updates: every object moves a bit, some of them jump far away */
+  for (uint i = 0; i < count; i++) {
+    Vector3f center = objects[i].getBounds().getCorner();
+    if (i % 100 == 0) {
+      center = randomPoint();
+    } else {
+      center += Vector3f(Maths::randomf() - 0.5f, Maths::randomf() - 0.5f, Maths::randomf() - 0.5f) * 4.0f;
+    }
+    place(objects[i], center);
+  }
+
+  timer->reset();
+  for (uint i = 0; i < count; i++) {
+    tree.update(proxies[i]);
+  }
+  elapsed = timer->getElapsedTime();
+  sprintf(details, "height %u, SAH cost %.1f", tree.getHeight(), tree.getCost());
+  report("update", elapsed, count, details);
+
+  for (uint i = 0; i < count; i++) {
+    Vector3f center = objects[i].getBounds().getCorner();
+    center += Vector3f(Maths::randomf() - 0.5f, Maths::randomf() - 0.5f, Maths::randomf() - 0.5f) * 4.0f;
+    place(objects[i], center);
+  }
+
+  timer->reset();
+  tree.refit();
+  elapsed = timer->getElapsedTime();
+  sprintf(details, "height %u, SAH cost %.1f", tree.getHeight(), tree.getCost());
+  report("refit", elapsed, count, details);
+
+  /* 3. Box queries */
+  std::vector<BoundingBox> boxes(queries);
+  for (int i = 0; i < queries; i++) {
+    boxes[i].setup(randomPoint(), 50.0f, 50.0f, 50.0f);
+  }
+
+  timer->reset();
+  found = 0;
+  for (int i = 0; i < queries; i++) {
+    result.clear();
+    tree.query(boxes[i], result);
+    found += (uint)result.size();
+  }
+  elapsed = timer->getElapsedTime();
+
+  timer->reset();
+  expected = 0;
+  for (int i = 0; i < queries; i++) {
+    for (uint j = 0; j < count; j++) {
+      if (overlaps(boxes[i], objects[j].getBounds())) {
+        expected++;
+      }
+    }
+  }
+  reference = timer->getElapsedTime();
+  sprintf(details, "found %u (brute force %u, %.2f us/op)", found, expected, reference * 1000.0f / queries);
+  report("box query", elapsed, queries, details);
+
+  /* 4. Frustum queries, camera in the center looks in different directions */
+  std::vector<Frustum> frustums(queries);
+  Matrix4f projection = Matrix4f::getPerspectiveMatrix(60.0f, 4.0f / 3.0f, 0.1f, worldSize / 4.0f);
+  for (int i = 0; i < queries; i++) {
+    Vector3f position = randomPoint() * 0.5f;
+    frustums[i].update(Matrix4f::getLookAtMatrix(position, position + randomPoint(), Vector3f(0, 0, 1)), projection);
+  }
+
+  /* Brute force is slow, so it checks only the first tenth of queries */
+  uint checked = 0;
+  timer->reset();
+  found = 0;
+  for (int i = 0; i < queries; i++) {
+    result.clear();
+    tree.query(frustums[i], result);
+    found += (uint)result.size();
+    if (i < queries / 10) {
+      checked += (uint)result.size();
+    }
+  }
+  elapsed = timer->getElapsedTime();
+
+  timer->reset();
+  expected = 0;
+  for (int i = 0; i < queries / 10; i++) {
+    for (uint j = 0; j < count; j++) {
+      if (frustums[i].isVisible(objects[j].getBounds())) {
+        expected++;
+      }
+    }
+  }
+  reference = timer->getElapsedTime();
+  sprintf(details, "found %u, first tenth %u (brute force %u, %.2f us/op)", found, checked, expected,
+    reference * 1000.0f / (queries / 10));
+  report("frustum query", elapsed, queries, details);
+
+  /* 5. Ray casts from random points in random directions */
+  std::vector<Vector3f> origins(queries), directions(queries);
+  for (int i = 0; i < queries; i++) {
+    origins[i] = randomPoint();
+    directions[i] = randomPoint();
+    directions[i].norm();
+  }
+
+  timer->reset();
+  found = 0;
+  float distanceSum = 0;
+  for (int i = 0; i < queries; i++) {
+    float distance;
+    if (tree.rayCast(origins[i], directions[i], worldSize, &distance) != NULL) {
+      found++;
+      distanceSum += distance;
+    }
+  }
+  elapsed = timer->getElapsedTime();
+
+  timer->reset();
+  expected = 0;
+  float expectedSum = 0;
+  for (int i = 0; i < queries; i++) {
+    float closest = worldSize + 1;
+    for (uint j = 0; j < count; j++) {
+      float distance = rayDistance(objects[j].getBounds(), origins[i], directions[i], worldSize);
+      if (distance >= 0 && distance < closest) {
+        closest = distance;
+      }
+    }
+    if (closest <= worldSize) {
+      expected++;
+      expectedSum += closest;
+    }
+  }
+  reference = timer->getElapsedTime();
+  sprintf(details, "hits %u, distance sum %.1f (brute force %u, %.1f, %.2f us/op)",
+    found, distanceSum, expected, expectedSum, reference * 1000.0f / queries);
+  report("ray cast", elapsed, queries, details);
+}
+
+int main() {
+  timer = TimerFactory::createTimer();
+
+  benchmark(10000);
+  benchmark(100000);
+
+  delete timer;
+  return 0;
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#ifdef VE_LINUX
+#include <time.h>
+#endif // VE_LINUX
+
+#include "engine/common.h"
+#include "engine/io/file.h"
+#include "engine/io/file_output_stream.h"
+#include "engine/tools/crc32.h"
+
+using namespace ve;
+
+/* File which is hashed by File::getCRC32() */
+const std::string fileName("crc32_benchmark.bin");
+
+/* Number of bytes hashed by every test */
+const size_t totalSize = 256 * 1024 * 1024;
+
+/* Size of the file test */
+const size_t fileSize = 64 * 1024 * 1024;
+
+/* Names of the implementations */
+const char *methodNames[] = {"bytewise", "slicing-by-8", "slicing-by-16", "pclmul"};
+
+/* Returns time in milliseconds, timer of the engine has only millisecond resolution */
+double now() {
+#ifdef VE_WINDOWS
+  LARGE_INTEGER frequency, counter;
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&counter);
+  return counter.QuadPart * 1000.0 / frequency.QuadPart;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec * 1000.0 + time.tv_nsec / 1000000.0;
+#endif // VE_LINUX
+}
+
+/* Hashes totalSize bytes in blocks of the given size and prints throughput */
+void blockTest(CRC32Method method, const std::vector<uchar> &data, size_t blockSize) {
+  size_t blocks = data.size() / blockSize;
+  size_t repeats = totalSize / (blocks * blockSize);
+  uint crc = 0;
+
+  double start = now();
+  for (size_t r = 0; r < repeats; r++) {
+    for (size_t i = 0; i < blocks; i++) {
+      crc = CRC32::compute(method, &data[i * blockSize], blockSize, crc);
+    }
+  }
+  double elapsed = now() - start;
+
+  double bytes = (double)(repeats * blocks * blockSize);
+  printf("  %-14s %8u B blocks %8.2f GB/s  crc %08x\n", methodNames[method], (uint)blockSize,
+    bytes / (1024.0 * 1024.0 * 1024.0) / (elapsed / 1000.0), crc);
+}
+
+int main() {
+  /* Data fits into L2 cache, so the tests measure computation and not memory */
+  std::vector<uchar> data(256 * 1024);
+  srand(1);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = (uchar)rand();
+  }
+
+  printf("selected: %s, check value of \"123456789\": %08x (must be cbf43926)\n",
+    methodNames[CRC32::getMethod()], CRC32::compute("123456789", 9));
+
+  const size_t blockSizes[] = {64, 1024, 64 * 1024};
+  for (size_t b = 0; b < sizeof(blockSizes) / sizeof(blockSizes[0]); b++) {
+    printf("blocks of %u bytes:\n", (uint)blockSizes[b]);
+    for (int method = CRC32_BYTEWISE; method <= CRC32_PCLMUL; method++) {
+      if (CRC32::isSupported((CRC32Method)method)) {
+        blockTest((CRC32Method)method, data, blockSizes[b]);
+      }
+    }
+  }
+
+  /* Hash of a file includes reading it from the page cache */
+  FileOutputStream file(fileName);
+  for (size_t written = 0; written < fileSize; written += data.size()) {
+    file.write((char*)&data[0], 0, (int)data.size());
+  }
+  file.close();
+
+  File(fileName).getCRC32();
+  double start = now();
+  uint crc = (uint)File(fileName).getCRC32();
+  double elapsed = now() - start;
+  printf("File::getCRC32, %u MB:   %8.2f GB/s  crc %08x\n", (uint)(fileSize / (1024 * 1024)),
+    fileSize / (1024.0 * 1024.0 * 1024.0) / (elapsed / 1000.0), crc);
+
+  remove(fileName.c_str());
+  return 0;
+}
@@ -0,0 +1,125 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <cstdio>
+#include <vector>
+
+#include "engine/math/bounding_box.h"
+#include "engine/math/frustum.h"
+#include "engine/math/frustum_culler.h"
+#include "engine/math/maths.h"
+#include "engine/tools/timer_factory.h"
+
+using namespace ve;
+
+/* Size of the cube objects are scattered in */
+const float worldSize = 1000.0f;
+
+/* Objects are generated in clusters, so neighbours in arrays are close like in sorted scenes */
+const uint clusterSize = 64;
+const float clusterRadius = 20.0f;
+
+/* Number of object tests for every measured variant, it defines number of passes */
+const uint tests = 4000000;
+
+/* Number of culling passes for current number of objects */
+int passes = 1;
+
+/* Prints time per pass and per object for measured and reference code */
+void report(const char *name, uint elapsed, uint reference, uint objects, uint visible) {
+  printf("  %-30s %8.2f ms/pass %6.2f ns/object  visible %7u  (x%.2f)\n", name,
+    (float)elapsed / passes, elapsed * 1e6f / passes / objects, visible,
+    elapsed > 0 ? (float)reference / elapsed : 0.0f);
+}
+
+void benchmark(Timer *timer, const Frustum &frustum, uint count) {
+  std::vector<float> x(count), y(count), z(count);
+  std::vector<float> extentX(count), extentY(count), extentZ(count), radius(count);
+  std::vector<BoundingBox> boxes(count);
+  std::vector<uint> indices(count);
+  std::vector<uint> mask((count + 31) / 32);
+  FrustumCuller culler;
+  uint elapsed, reference, visible = 0, expected = 0;
+
+  Vector3f cluster;
+  for (uint i = 0; i < count; i++) {
+    if (i % clusterSize == 0) {
+      cluster = Vector3f((Maths::randomf() - 0.5f) * worldSize, (Maths::randomf() - 0.5f) * worldSize,
+        (Maths::randomf() - 0.5f) * worldSize);
+    }
+
+    x[i] = cluster[0] + (Maths::randomf() - 0.5f) * clusterRadius;
+    y[i] = cluster[1] + (Maths::randomf() - 0.5f) * clusterRadius;
+    z[i] = cluster[2] + (Maths::randomf() - 0.5f) * clusterRadius;
+    extentX[i] = 0.5f + Maths::randomf() * 2.0f;
+    extentY[i] = 0.5f + Maths::randomf() * 2.0f;
+    extentZ[i] = 0.5f + Maths::randomf() * 2.0f;
+    radius[i] = sqrt(extentX[i] * extentX[i] + extentY[i] * extentY[i] + extentZ[i] * extentZ[i]);
+
+    Vector3f corner(x[i] - extentX[i], y[i] - extentY[i], z[i] - extentZ[i]);
+    boxes[i].setup(corner, 2.0f * extentX[i], 2.0f * extentY[i], 2.0f * extentZ[i]);
+  }
+
+  culler.setFrustum(frustum);
+  passes = Maths::max(1, (int)(tests / count));
+  printf("%u objects, %d passes:\n", count, passes);
+
+  /* Reference: Frustum::isVisible(), eight corners against six planes per object */
+  timer->reset();
+  for (int pass = 0; pass < passes; pass++) {
+    expected = 0;
+    for (uint i = 0; i < count; i++) {
+      if (frustum.isVisible(boxes[i])) {
+        expected++;
+      }
+    }
+  }
+  reference = timer->getElapsedTime();
+  report("Frustum::isVisible", reference, reference, count, expected);
+
+  culler.setCoherency(false);
+  timer->reset();
+  for (int pass = 0; pass < passes; pass++) {
+    visible = culler.cullBoxes(&x[0], &y[0], &z[0], &extentX[0], &extentY[0], &extentZ[0], count, &indices[0]);
+  }
+  elapsed = timer->getElapsedTime();
+  report("boxes, index list", elapsed, reference, count, visible);
+
+  timer->reset();
+  for (int pass = 0; pass < passes; pass++) {
+    visible = culler.cullBoxesMask(&x[0], &y[0], &z[0], &extentX[0], &extentY[0], &extentZ[0], count, &mask[0]);
+  }
+  elapsed = timer->getElapsedTime();
+  report("boxes, bitmask", elapsed, reference, count, visible);
+
+  culler.setCoherency(true);
+  timer->reset();
+  for (int pass = 0; pass < passes; pass++) {
+    visible = culler.cullBoxes(&x[0], &y[0], &z[0], &extentX[0], &extentY[0], &extentZ[0], count, &indices[0]);
+  }
+  elapsed = timer->getElapsedTime();
+  report("boxes, index list, coherency", elapsed, reference, count, visible);
+
+  timer->reset();
+  for (int pass = 0; pass < passes; pass++) {
+    visible = culler.cullSpheres(&x[0], &y[0], &z[0], &radius[0], count, &indices[0]);
+  }
+  elapsed = timer->getElapsedTime();
+  report("spheres, index list, coherency", elapsed, reference, count, visible);
+}
+
+int main() {
+  Timer *timer = TimerFactory::createTimer();
+  Vector3f position(0.0f, 0.0f, 0.0f), target(1.0f, 0.0f, 0.0f), up(0.0f, 0.0f, 1.0f);
+  Frustum frustum(Matrix4f::getLookAtMatrix(position, target, up),
+    Matrix4f::getPerspectiveMatrix(60.0f, 4.0f / 3.0f, 0.1f, worldSize / 2.0f));
+
+  printf("SSE2 kernels: %s\n\n", MathKernel::isAccelerated() ? "enabled" : "disabled");
+
+  benchmark(timer, frustum, 10000);
+  benchmark(timer, frustum, 100000);
+  benchmark(timer, frustum, 1000000);
+
+  delete timer;
+  return 0;
+}
@@ -75,6 +75,10 @@ int main() {
   Label *fpsLabel = gui->createLabel(gui->getActiveDesktop(), L"", WHITE);
   fpsLabel->setFont(font);
 
+  /* Controls append their geometry to one draw list, press 'B' to compare with immediate rendering */
+  Desktop *desktop = gui->getActiveDesktop();
+  desktop->setBatched(true);
+
   /* Create slots */
   std::vector<Slot*> slots;
   float x = 70;
@@ -123,19 +127,23 @@ int main() {
         finish = true;
       }
 
+      if (ev != NULL && ev->getType() == KEY_PRESS && ((KeyEvent*)ev)->getKeyCode() == 'b') {
+        desktop->setBatched(!desktop->isBatched());
+      }
+
       gui->processMessage(ev);
     }
 
     /* Clear back buffer color & depth buffer */
     ASSERT(engine->clear(ClearFlag(COLOR | DEPTH)));
 
-    for (ve::uint i = 0; i < slots.size(); i++) {
-      ASSERT(slots[i]->render());
-    }
+    /* Slots are components of the desktop, so they are rendered with it */
     ASSERT(gui->render());
 
-    /* Compute FPS (average value for 5 seconds) */
-    fpsLabel->setText(L"FPS: " + StringTool::floatToStr(win->getFPS(), 2));
+    /* Compute FPS (average value for 5 seconds) and show number of draw calls */
+    fpsLabel->setText(L"FPS: " + StringTool::floatToStr(win->getFPS(), 2) +
+      (desktop->isBatched() ? L", batched: " : L", immediate: ") +
+      StringTool::intToStr(engine->getBatchesCount()) + L" draw calls");
 
     /* Swap frame and back buffers */
     win->swap();
@@ -0,0 +1,216 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string.h>
+#include <vector>
+
+#ifdef VE_LINUX
+#include <time.h>
+#endif // VE_LINUX
+
+#include "engine/common.h"
+#include "engine/io/file_input_stream.h"
+#include "engine/io/file_output_stream.h"
+#include "engine/io/io_listener.h"
+#include "engine/io/io_service.h"
+#include "engine/windows/atomic.h"
+
+using namespace ve;
+
+/* File which is read by every test */
+const std::string fileName("io_benchmark.bin");
+
+/* Size of the file */
+const size_t fileSize = 64 * 1024 * 1024;
+
+/* Size of one request */
+const size_t blockSize = 256 * 1024;
+
+/* Number of requests which read the whole file */
+const uint blocksCount = fileSize / blockSize;
+
+/* Returns time in milliseconds, timer of the engine has only millisecond resolution */
+double now() {
+#ifdef VE_WINDOWS
+  LARGE_INTEGER frequency, counter;
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&counter);
+  return counter.QuadPart * 1000.0 / frequency.QuadPart;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec * 1000.0 + time.tv_nsec / 1000000.0;
+#endif // VE_LINUX
+}
+
+/* Compares received blocks with the data of the file and counts requests by status */
+class BlockChecker : public IOListener {
+public:
+  const std::vector<uchar> *data;
+  uint counts[IO_CANCELLED + 1];
+  uint corrupted;
+
+  BlockChecker(const std::vector<uchar> *data) {
+    this->data = data;
+    memset(counts, 0, sizeof(counts));
+    corrupted = 0;
+  }
+
+  virtual void processIORequest(IORequest *request) {
+    counts[request->status]++;
+    if (request->status == IO_COMPLETED && (request->data.size() != blockSize ||
+      memcmp(&request->data[0], &(*data)[request->offset], blockSize) != 0)) {
+      corrupted++;
+    }
+  }
+
+  uint getTotal() {
+    uint total = 0;
+    for (int i = 0; i <= IO_CANCELLED; i++) {
+      total += counts[i];
+    }
+    return total;
+  }
+};
+
+/* Reads the file in blocks on the calling thread, the way resources were loaded before */
+void blockingTest() {
+  std::vector<char> block(blockSize);
+
+  double start = now();
+  FileInputStream input(fileName);
+  for (uint i = 0; i < blocksCount; i++) {
+    input.read(&block[0], 0, (int)blockSize);
+  }
+  input.close();
+  double elapsed = now() - start;
+
+  printf("  %-30s %8.1f ms %8.2f GB/s %8.1f ms\n", "blocking FileInputStream", elapsed,
+    fileSize / (1024.0 * 1024.0 * 1024.0) / (elapsed / 1000.0), elapsed);
+}
+
+/*
+  Queues all blocks in random order, dispatches them as a frame loop would and prints
+  times. Time of the caller includes listeners, which compare the data with the file.
+*/
+void serviceTest(const char *name, IOService *service, const std::vector<uchar> &data) {
+  if (service->start() != OK) {
+    printf("  %-30s could not start I/O threads\n", name);
+    return;
+  }
+
+  BlockChecker checker(&data);
+  std::vector<uint> order(blocksCount);
+  for (uint i = 0; i < blocksCount; i++) {
+    order[i] = i;
+  }
+  for (uint i = blocksCount - 1; i > 0; i--) {
+    std::swap(order[i], order[rand() % (i + 1)]);
+  }
+
+  /* Time of the calling thread is the time the render loop would lose */
+  double start = now();
+  for (uint i = 0; i < blocksCount; i++) {
+    service->read(fileName, order[i] * blockSize, blockSize, &checker, (IOPriority)(i % IO_PRIORITIES_COUNT));
+  }
+  double queued = now() - start;
+
+  double dispatching = 0.0;
+  while (checker.getTotal() < blocksCount) {
+    double dispatchStart = now();
+    service->dispatch();
+    dispatching += now() - dispatchStart;
+    yieldThread();
+  }
+  double elapsed = now() - start;
+  service->stop();
+
+  printf("  %-30s %8.1f ms %8.2f GB/s %8.1f ms", name, elapsed,
+    fileSize / (1024.0 * 1024.0 * 1024.0) / (elapsed / 1000.0), queued + dispatching);
+  if (checker.counts[IO_COMPLETED] != blocksCount || checker.corrupted != 0) {
+    printf("  %u of %u blocks are wrong", blocksCount - checker.counts[IO_COMPLETED] + checker.corrupted,
+      blocksCount);
+  }
+  printf("\n");
+}
+
+/* Cancels half of the requests and stops the service while reads run, every request must reach its listener once */
+void cancelTest(const char *name, IOService *service, const std::vector<uchar> &data) {
+  if (service->start() != OK) {
+    return;
+  }
+
+  BlockChecker checker(&data);
+  std::vector<IORequestId> ids;
+  for (uint i = 0; i < blocksCount; i++) {
+    ids.push_back(service->read(fileName, i * blockSize, blockSize, &checker));
+  }
+  for (uint i = 0; i < blocksCount; i += 2) {
+    service->cancel(ids[i]);
+  }
+
+  /* Some requests are read, some are running and the rest are queued when the service stops */
+  while (service->getPendingCount() > blocksCount / 4) {
+    yieldThread();
+  }
+  service->stop();
+  service->dispatch();
+
+  printf("  %-30s completed %3u  cancelled %3u  failed %3u  %s\n", name, checker.counts[IO_COMPLETED],
+    checker.counts[IO_CANCELLED], checker.counts[IO_FAILED],
+    checker.getTotal() == blocksCount && checker.corrupted == 0 ? "ok" : "WRONG");
+}
+
+int main() {
+  std::vector<uchar> data(fileSize);
+  srand(1);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = (uchar)rand();
+  }
+
+  FileOutputStream file(fileName);
+  file.write((char*)&data[0], 0, (int)data.size());
+  file.close();
+
+  /* File was just written, so the tests read the page cache and measure overhead of the service */
+  printf("reading %u blocks of %u KB, %u MB:\n", blocksCount, (uint)(blockSize / 1024),
+    (uint)(fileSize / (1024 * 1024)));
+  printf("  %-30s %11s %13s %11s\n", "", "total", "throughput", "caller");
+  blockingTest();
+
+  const uint threadCounts[] = {1, 2, 4};
+  for (uint i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); i++) {
+    char label[64];
+    sprintf(label, "IOService, pool of %u", threadCounts[i]);
+    IOService service(threadCounts[i], 32, false);
+    serviceTest(label, &service, data);
+  }
+
+  const uint queueDepths[] = {1, 8, 32};
+  for (uint i = 0; i < sizeof(queueDepths) / sizeof(queueDepths[0]); i++) {
+    IOService service(2, queueDepths[i], true);
+    if (service.start() != OK || !service.isRingUsed()) {
+      printf("  io_uring is not available\n");
+      break;
+    }
+    service.stop();
+
+    char label[64];
+    sprintf(label, "IOService, io_uring, depth %u", queueDepths[i]);
+    serviceTest(label, &service, data);
+  }
+
+  printf("cancellation:\n");
+  IOService pool(2, 32, false);
+  cancelTest("thread pool", &pool, data);
+  IOService ring(2, 32, true);
+  cancelTest("io_uring", &ring, data);
+
+  remove(fileName.c_str());
+  return 0;
+}
@@ -0,0 +1,240 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+
+#ifdef VE_LINUX
+#include <sched.h>
+#include <time.h>
+#endif // VE_LINUX
+
+#include "engine/common.h"
+#include "engine/tools/job_system.h"
+#include "engine/windows/critical_section.h"
+#include "engine/windows/thread_factory.h"
+
+using namespace ve;
+
+/* Number of jobs of the scheduling tests */
+const uint jobsCount = 1000000;
+
+/* Number of elements of the parallelFor() test */
+const uint elementsCount = 16 * 1024 * 1024;
+
+/* Argument of the recursive test, it spawns about 2.7 million jobs */
+const uint fibonacciArgument = 30;
+
+/* Job system of the recursive test */
+JobSystem *jobSystem = NULL;
+
+/* Returns time in milliseconds, timer of the engine has only millisecond resolution */
+double now() {
+#ifdef VE_WINDOWS
+  LARGE_INTEGER frequency, counter;
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&counter);
+  return counter.QuadPart * 1000.0 / frequency.QuadPart;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec * 1000.0 + time.tv_nsec / 1000000.0;
+#endif // VE_LINUX
+}
+
+void yieldThread() {
+#ifdef VE_WINDOWS
+  SwitchToThread();
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  sched_yield();
+#endif // VE_LINUX
+}
+
+/* Job which does nothing, so the tests measure scheduling */
+void emptyJob(void *data) {
+  (*(volatile uint*)data)++;
+}
+
+/* Job of the recursive test, it runs jobs for both halves and waits for them */
+struct FibonacciTask {
+  uint argument;
+  uint result;
+};
+
+void fibonacciJob(void *data) {
+  FibonacciTask *task = (FibonacciTask*)data;
+  if (task->argument < 2) {
+    task->result = task->argument;
+    return;
+  }
+
+  FibonacciTask first = {task->argument - 1, 0};
+  FibonacciTask second = {task->argument - 2, 0};
+  JobCounter counter;
+  jobSystem->run(fibonacciJob, &first, &counter);
+  jobSystem->run(fibonacciJob, &second, &counter);
+  jobSystem->wait(&counter);
+  task->result = first.result + second.result;
+}
+
+/* Chunk of the parallelFor() test */
+void scaleRange(uint begin, uint end, void *data) {
+  float *values = (float*)data;
+  for (uint i = begin; i < end; i++) {
+    values[i] = values[i] * 0.5f + 1.0f;
+  }
+}
+
+/* Pool which takes jobs from one queue under CriticalSection, the way threads were used before */
+struct LockedPool {
+  CriticalSection lock;
+  std::deque<Job> queue;
+  volatile uint pending;
+  volatile int running;
+  volatile uint activeThreads;
+};
+
+unsigned long lockedWorker(void *parameter) {
+  LockedPool *pool = (LockedPool*)parameter;
+
+  while (pool->running) {
+    Job job;
+    bool taken = false;
+
+    pool->lock.lock();
+    if (!pool->queue.empty()) {
+      job = pool->queue.front();
+      pool->queue.pop_front();
+      taken = true;
+    }
+    pool->lock.unlock();
+
+    if (!taken) {
+      yieldThread();
+      continue;
+    }
+
+    job.function(job.data);
+    pool->lock.lock();
+    pool->pending--;
+    pool->lock.unlock();
+  }
+
+  pool->lock.lock();
+  pool->activeThreads--;
+  pool->lock.unlock();
+  return 0;
+}
+
+void lockedPoolTest(uint workersCount) {
+  LockedPool pool;
+  pool.pending = 0;
+  pool.running = 1;
+  pool.activeThreads = workersCount;
+  for (uint i = 0; i < workersCount; i++) {
+    ThreadFactory::getInstance()->spawn(lockedWorker, &pool);
+  }
+
+  volatile uint value = 0;
+  Job job;
+  job.function = emptyJob;
+  job.data = (void*)&value;
+  job.counter = NULL;
+
+  double start = now();
+  for (uint i = 0; i < jobsCount; i++) {
+    pool.lock.lock();
+    pool.queue.push_back(job);
+    pool.pending++;
+    pool.lock.unlock();
+  }
+  while (pool.pending != 0) {
+    yieldThread();
+  }
+  double elapsed = now() - start;
+  printf("  locked queue, run + wait:    %8.1f ns/job\n", elapsed * 1000000.0 / jobsCount);
+
+  pool.running = 0;
+  while (pool.activeThreads != 0) {
+    yieldThread();
+  }
+}
+
+void jobSystemTests(uint workersCount) {
+  JobSystem system(workersCount);
+  jobSystem = &system;
+  system.start();
+
+  /* Jobs are run one by one */
+  volatile uint value = 0;
+  JobCounter counter;
+  double start = now();
+  for (uint i = 0; i < jobsCount; i++) {
+    system.run(emptyJob, (void*)&value, &counter);
+  }
+  system.wait(&counter);
+  double elapsed = now() - start;
+  printf("  job system, run + wait:      %8.1f ns/job\n", elapsed * 1000000.0 / jobsCount);
+
+  /* Jobs are run in batches */
+  std::vector<Job> jobs(1024);
+  for (size_t i = 0; i < jobs.size(); i++) {
+    jobs[i].function = emptyJob;
+    jobs[i].data = (void*)&value;
+  }
+  start = now();
+  for (uint i = 0; i < jobsCount; i += (uint)jobs.size()) {
+    system.run(&jobs[0], (uint)jobs.size(), &counter);
+  }
+  system.wait(&counter);
+  elapsed = now() - start;
+  printf("  job system, batches of %u:  %8.1f ns/job\n", (uint)jobs.size(), elapsed * 1000000.0 / jobsCount);
+
+  /* fib(n) is computed with 2 * fib(n + 1) - 1 jobs */
+  uint a = 1, b = 1;
+  for (uint i = 1; i <= fibonacciArgument; i++) {
+    uint c = a + b;
+    a = b;
+    b = c;
+  }
+  uint spawned = 2 * a - 1;
+
+  /* Every job runs two jobs and waits for them, so most jobs are stolen or popped back */
+  FibonacciTask task = {fibonacciArgument, 0};
+  start = now();
+  system.run(fibonacciJob, &task, &counter);
+  system.wait(&counter);
+  elapsed = now() - start;
+  printf("  job system, recursive:       %8.1f ns/job  (fib(%u) = %u)\n", elapsed * 1000000.0 / spawned,
+    fibonacciArgument, task.result);
+
+  lockedPoolTest(workersCount);
+
+  /* parallelFor() is compared with a loop */
+  std::vector<float> values(elementsCount, 1.0f);
+  start = now();
+  scaleRange(0, elementsCount, &values[0]);
+  double serial = now() - start;
+  start = now();
+  system.parallelFor(0, elementsCount, scaleRange, &values[0]);
+  elapsed = now() - start;
+  printf("  parallelFor, %u M floats:    %8.2f ms, loop %.2f ms\n", elementsCount / (1024 * 1024), elapsed, serial);
+
+  system.stop();
+}
+
+int main() {
+  uint processors = JobSystem::getProcessorsCount();
+  printf("processors: %u\n", processors);
+
+  for (uint workers = 1; workers < processors * 2 && workers <= 16; workers *= 2) {
+    printf("workers: %u + main thread\n", workers);
+    jobSystemTests(workers);
+  }
+
+  return 0;
+}
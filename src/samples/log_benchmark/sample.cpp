@@ -0,0 +1,169 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#ifdef VE_LINUX
+#include <sched.h>
+#include <time.h>
+#endif // VE_LINUX
+
+#include "engine/common.h"
+#include "engine/io/file_output_stream.h"
+#include "engine/logs/log.h"
+#include "engine/windows/critical_section.h"
+#include "engine/windows/thread_factory.h"
+
+using namespace ve;
+
+/* Number of messages logged by every thread */
+const int messages = 20000;
+
+/* Number of threads in the multi-threaded runs */
+const int threads = 4;
+
+/* Capacity of the asynchronous queue */
+const uint capacity = 1024;
+
+/* Guards the number of finished threads */
+CriticalSection counterLock;
+
+/* Number of finished threads of the current run */
+volatile int finishedThreads = 0;
+
+/* Threads start logging when it is set, so they log at the same time */
+volatile int startFlag = 0;
+
+/* Latencies of one thread in microseconds */
+struct Worker {
+  std::vector<double> latencies;
+};
+
+/* Returns time in microseconds, timer of the engine has only millisecond resolution */
+double now() {
+#ifdef VE_WINDOWS
+  LARGE_INTEGER frequency, counter;
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&counter);
+  return counter.QuadPart * 1000000.0 / frequency.QuadPart;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec * 1000000.0 + time.tv_nsec / 1000.0;
+#endif // VE_LINUX
+}
+
+void yield() {
+#ifdef VE_WINDOWS
+  SwitchToThread();
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  sched_yield();
+#endif // VE_LINUX
+}
+
+/* Logs messages and measures time each call takes on this thread */
+unsigned long workerEntry(void *parameter) {
+  Worker *worker = (Worker*)parameter;
+  worker->latencies.resize(messages);
+
+  while (!startFlag) {
+    yield();
+  }
+
+  for (int i = 0; i < messages; i++) {
+    double start = now();
+    LOG_ERROR(L"Benchmark message");
+    worker->latencies[i] = now() - start;
+  }
+
+  counterLock.lock();
+  finishedThreads++;
+  counterLock.unlock();
+  return 0;
+}
+
+/* Returns number of finished threads */
+int getFinishedThreads() {
+  counterLock.lock();
+  int result = finishedThreads;
+  counterLock.unlock();
+  return result;
+}
+
+/* Runs threads and prints latency percentiles */
+void benchmark(const char *name, int count) {
+  std::vector<Worker> workers(count);
+  finishedThreads = 0;
+  startFlag = 0;
+  uint dropped = Log::getInstance()->getDroppedCount();
+
+  for (int i = 0; i < count; i++) {
+    if (ThreadFactory::getInstance()->spawn(workerEntry, &workers[i]) != OK) {
+      printf("  %-24s failed to start threads\n", name);
+      return;
+    }
+  }
+
+  double start = now();
+  startFlag = 1;
+  while (getFinishedThreads() < count) {
+    yield();
+  }
+  double logged = now() - start;
+
+  /* Time until the background thread writes everything is not seen by callers */
+  Log::getInstance()->flush();
+  double written = now() - start;
+
+  std::vector<double> latencies;
+  for (int i = 0; i < count; i++) {
+    latencies.insert(latencies.end(), workers[i].latencies.begin(), workers[i].latencies.end());
+  }
+  std::sort(latencies.begin(), latencies.end());
+
+  double sum = 0;
+  for (uint i = 0; i < latencies.size(); i++) {
+    sum += latencies[i];
+  }
+
+  uint size = latencies.size();
+  printf("  %-24s avg %7.2f  p50 %7.2f  p99 %8.2f  p99.9 %8.2f  max %9.2f us  logged %7.1f ms  written %7.1f ms  dropped %u\n",
+    name, sum / size, latencies[size / 2], latencies[size * 99 / 100], latencies[size * 999 / 1000],
+    latencies[size - 1], logged / 1000.0, written / 1000.0, Log::getInstance()->getDroppedCount() - dropped);
+}
+
+/* Runs single- and multi-threaded benchmarks for the current mode of the log */
+void benchmarkMode(const char *mode) {
+  char name[64];
+
+  sprintf(name, "%s, 1 thread", mode);
+  benchmark(name, 1);
+
+  sprintf(name, "%s, %d threads", mode, threads);
+  benchmark(name, threads);
+}
+
+int main() {
+  Log *log = Log::getInstance();
+  log->clearStreams();
+  log->addOutputStream(new FileOutputStream(std::string("log_benchmark.txt")));
+
+  printf("%d messages per thread, latency of a log call on the calling thread:\n", messages);
+
+  benchmarkMode("sync");
+
+  if (log->enableAsync(capacity, LOG_DROP) == OK) {
+    benchmarkMode("async, drop");
+  }
+
+  if (log->enableAsync(capacity, LOG_BLOCK) == OK) {
+    benchmarkMode("async, block");
+  }
+
+  log->disableAsync();
+  return 0;
+}
@@ -0,0 +1,263 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <cstdio>
+
+#include "engine/math/batch_transform.h"
+#include "engine/math/maths.h"
+#include "engine/math/matrix4f.h"
+#include "engine/tools/timer_factory.h"
+
+using namespace ve;
+
+/* Number of iterations for every measured operation */
+const int iterations = 10000000;
+
+/* Number of elements in batches, batch operations are repeated to get the same number of operations */
+const int batchSize = 10000;
+
+/* Accumulator which keeps compiler from throwing measured code away */
+float sink = 0;
+
+/* Implementation of Matrix4f multiplication before SSE kernels were added */
+Matrix4f legacyMultiply(const Matrix4f &A, const Matrix4f &B) {
+  Matrix4f result;
+
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      result[i][j] = 0;
+
+      for (int k = 0; k < 4; k++) {
+        result[i][j] = result[i][j] + A[i][k] * B[k][j];
+      }
+    }
+  }
+
+  return result;
+}
+
+/* Implementation of Matrix4f * Vector4f before SSE kernels were added */
+Vector4f legacyTransform(const Matrix4f &m, const Vector4f &a) {
+  Vector4f result;
+
+  for (int i = 0; i < 4; i++) {
+    result[i] = m[i][0] * a[0] + m[i][1] * a[1] + m[i][2] * a[2] + m[i][3] * a[3];
+  }
+
+  return result;
+}
+
+/* Prints time per operation for measured and reference (if any) code */
+void report(const char *name, uint elapsed, uint reference) {
+  if (reference == 0) {
+    printf("%-24s %8.2f ns/op\n", name, elapsed * 1e6 / iterations);
+    return;
+  }
+
+  printf("%-24s %8.2f ns/op  (legacy %8.2f ns/op, x%.2f)\n", name,
+    elapsed * 1e6 / iterations, reference * 1e6 / iterations,
+    elapsed > 0 ? (float)reference / elapsed : 0.0f);
+}
+
+int main() {
+  Timer *timer = TimerFactory::createTimer();
+  Matrix4f a = Matrix4f::getYawPitchRollMatrix(0.3f, 0.2f, 0.1f);
+  Matrix4f b = Matrix4f::getYawPitchRollMatrix(0.1f, 0.5f, 0.7f);
+  Matrix4f c;
+  Vector4f v(1.0f, 2.0f, 3.0f, 1.0f);
+  Vector4f u;
+  uint elapsed, reference;
+
+  a.translate(Vector4f(1.0f, 2.0f, 3.0f, 0.0f));
+
+  printf("SSE2 kernels: %s\n\n", MathKernel::isAccelerated() ? "enabled" : "disabled");
+
+  /* 1. Matrix multiplication */
+  timer->reset();
+  for (int i = 0; i < iterations; i++) {
+    c = legacyMultiply(a, b);
+    b[0][0] = c[0][0] * 1e-3f;
+  }
+  reference = timer->getElapsedTime();
+  sink += c[1][1];
+
+  timer->reset();
+  for (int i = 0; i < iterations; i++) {
+    c = a * b;
+    b[0][0] = c[0][0] * 1e-3f;
+  }
+  elapsed = timer->getElapsedTime();
+  sink += c[1][1];
+  report("Matrix4f * Matrix4f", elapsed, reference);
+
+  /* 2. Vector transformation */
+  timer->reset();
+  for (int i = 0; i < iterations; i++) {
+    u = legacyTransform(a, v);
+    v[0] = u[0] * 1e-3f;
+  }
+  reference = timer->getElapsedTime();
+  sink += u[1];
+
+  timer->reset();
+  for (int i = 0; i < iterations; i++) {
+    u = a * v;
+    v[0] = u[0] * 1e-3f;
+  }
+  elapsed = timer->getElapsedTime();
+  sink += u[1];
+  report("Matrix4f * Vector4f", elapsed, reference);
+
+  /* 3. Transposition */
+  timer->reset();
+  for (int i = 0; i < iterations; i++) {
+    MathKernel::transposeScalar(c.getRaw(), c.getRaw());
+  }
+  reference = timer->getElapsedTime();
+
+  timer->reset();
+  for (int i = 0; i < iterations; i++) {
+    c.transpose();
+  }
+  elapsed = timer->getElapsedTime();
+  sink += c[0][1];
+  report("transpose", elapsed, reference);
+
+  /* 4. General and affine inversion, scalar cofactor expansion is used as a reference */
+  timer->reset();
+  for (int i = 0; i < iterations; i++) {
+    c = a;
+    MathKernel::inverseScalar(c.getRaw(), c.getRaw());
+    sink += c[0][3];
+  }
+  reference = timer->getElapsedTime();
+
+  timer->reset();
+  for (int i = 0; i < iterations; i++) {
+    c = a;
+    c.inverse();
+    sink += c[0][3];
+  }
+  elapsed = timer->getElapsedTime();
+  report("inverse", elapsed, reference);
+
+  timer->reset();
+  for (int i = 0; i < iterations; i++) {
+    c = a;
+    c.affineInverse();
+    sink += c[0][3];
+  }
+  elapsed = timer->getElapsedTime();
+  report("affineInverse", elapsed, reference);
+
+  /* 5. Vector operations */
+  Vector4f p(0.1f, 0.2f, 0.3f, 0.4f);
+  timer->reset();
+  for (int i = 0; i < iterations; i++) {
+    sink += p[0] * v[0] + p[1] * v[1] + p[2] * v[2] + p[3] * v[3];
+    p[0] += 1e-7f;
+  }
+  reference = timer->getElapsedTime();
+
+  timer->reset();
+  for (int i = 0; i < iterations; i++) {
+    sink += Maths::dot(p, v);
+    p[0] += 1e-7f;
+  }
+  elapsed = timer->getElapsedTime();
+  report("Vector4f dot", elapsed, reference);
+
+  Vector3f x(1.0f, 2.0f, 3.0f), y(3.0f, 2.0f, 1.0f);
+  timer->reset();
+  for (int i = 0; i < iterations; i++) {
+    y = Maths::cross(x, y);
+    y.norm();
+  }
+  elapsed = timer->getElapsedTime();
+  sink += y[0];
+  report("Vector3f cross + norm", elapsed, 0);
+
+  /* 6. Batch transformations, element by element Matrix4f * Vector4f is used as a reference */
+  const int batches = iterations / batchSize;
+  float *points = new float[batchSize * 3];
+  float *transformed = new float[batchSize * 3];
+  float *px = new float[batchSize];
+  float *py = new float[batchSize];
+  float *pz = new float[batchSize];
+  Matrix4f *locals = new Matrix4f[batchSize];
+  Matrix4f *worlds = new Matrix4f[batchSize];
+
+  for (int i = 0; i < batchSize; i++) {
+    points[3 * i] = px[i] = Maths::randomf();
+    points[3 * i + 1] = py[i] = Maths::randomf();
+    points[3 * i + 2] = pz[i] = Maths::randomf();
+    locals[i] = Matrix4f::getYawPitchRollMatrix(px[i], py[i], pz[i]);
+  }
+
+  timer->reset();
+  for (int n = 0; n < batches; n++) {
+    for (int i = 0; i < batchSize; i++) {
+      u = a * Vector4f(points[3 * i], points[3 * i + 1], points[3 * i + 2], 1.0f);
+      transformed[3 * i] = u[0];
+      transformed[3 * i + 1] = u[1];
+      transformed[3 * i + 2] = u[2];
+    }
+    sink += transformed[n % batchSize];
+  }
+  reference = timer->getElapsedTime();
+
+  timer->reset();
+  for (int n = 0; n < batches; n++) {
+    BatchTransform::transformPoints(a, points, 0, transformed, 0, batchSize);
+    sink += transformed[n % batchSize];
+  }
+  elapsed = timer->getElapsedTime();
+  report("transformPoints (AoS)", elapsed, reference);
+
+  timer->reset();
+  for (int n = 0; n < batches; n++) {
+    BatchTransform::transformPoints(a, px, py, pz, transformed, transformed + batchSize,
+      transformed + 2 * batchSize, batchSize);
+    sink += transformed[n % batchSize];
+  }
+  elapsed = timer->getElapsedTime();
+  report("transformPoints (SoA)", elapsed, reference);
+
+  timer->reset();
+  for (int n = 0; n < batches; n++) {
+    BatchTransform::transformNormals(a, points, 0, transformed, 0, batchSize, true);
+    sink += transformed[n % batchSize];
+  }
+  elapsed = timer->getElapsedTime();
+  report("transformNormals (AoS)", elapsed, 0);
+
+  timer->reset();
+  for (int n = 0; n < batches; n++) {
+    for (int i = 0; i < batchSize; i++) {
+      worlds[i] = a * locals[i];
+    }
+    sink += worlds[n % batchSize][0][0];
+  }
+  reference = timer->getElapsedTime();
+
+  timer->reset();
+  for (int n = 0; n < batches; n++) {
+    BatchTransform::multiplyMatrices(a, locals, worlds, batchSize);
+    sink += worlds[n % batchSize][0][0];
+  }
+  elapsed = timer->getElapsedTime();
+  report("multiplyMatrices", elapsed, reference);
+
+  delete[] points;
+  delete[] transformed;
+  delete[] px;
+  delete[] py;
+  delete[] pz;
+  delete[] locals;
+  delete[] worlds;
+
+  printf("\n(checksum %f)\n", sink);
+
+  delete timer;
+  return 0;
+}
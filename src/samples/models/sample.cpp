@@ -5,6 +5,7 @@
 #include "engine/engines/gl_engine.h"
 #include "engine/cameras/camera.h"
 #include "engine/loaders/3ds_loader.h"
+#include "engine/math/maths.h"
 
 using namespace ve;
 
@@ -57,9 +58,19 @@ int main() {
   /* 4. Create loader for 3ds models format and load model */
   _3dsLoader *loader = new _3dsLoader();
   CHECK_RESULT(loader->loadFromFile(std::string("../../data/elf.3ds")), L"Loading failed");
+
+  /* 5. Generate four simplified levels for every mesh, each one with half of faces */
+  std::vector<Mesh*> meshes = loader->getMeshList();
+  for (uint i = 0; i < meshes.size(); i++) {
+    CHECK_RESULT(meshes[i]->generateLODs(4, 0.5f), L"LOD generation failed");
+  }
+
   Model *model = new Model(engine);
   CHECK_RESULT(model->update(loader->getMeshList()), L"Update failed");
 
+  /* Levels of detail which were rendered last time, they belong to this instance of the model */
+  std::vector<uint> levels(model->getMeshesCount(), 0);
+
   bool finish = false;
   while (!finish) {
     while (win->hasAvailableEvent()) {
@@ -93,7 +104,12 @@ int main() {
       ASSERT(engine->beginTransform());
       ASSERT(engine->rotate(angle, 0.0, 0.0, 1.0));
       ASSERT(engine->translate(-center[0], -center[1], -center[2]));
-      ASSERT(model->renderMesh(i));
+
+      /* The same transformation is passed to the model to choose level of detail */
+      Matrix4f translation;
+      translation.translate(Vector4f(-center[0], -center[1], -center[2], 0.0f));
+      Matrix4f transform = Matrix4f::zRotateMatrix(-angle * Maths::PI / 180.0) * translation;
+      ASSERT(model->renderMesh(i, camera, transform, levels[i]));
       ASSERT(engine->endTransform());
     }
     ASSERT(stateManager->enableDepthOffset(LINE, false));
@@ -0,0 +1,298 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <vector>
+
+#ifdef VE_LINUX
+#include <time.h>
+#endif // VE_LINUX
+
+#include "engine/common.h"
+#include "engine/tools/mpmc_queue.h"
+#include "engine/tools/spsc_queue.h"
+#include "engine/windows/atomic.h"
+#include "engine/windows/critical_section.h"
+#include "engine/windows/semaphore.h"
+#include "engine/windows/thread_factory.h"
+
+using namespace ve;
+
+/* Number of values which pass the queue in every throughput test */
+const uint valuesCount = 2000000;
+
+/* Number of round trips of the latency tests */
+const uint roundTrips = 100000;
+
+/* Capacity of the queues */
+const uint capacity = 1024;
+
+/* Value which stops a consumer */
+const uint stopValue = 0xFFFFFFFF;
+
+/* Number of finished threads of the current run */
+volatile uint finishedThreads = 0;
+
+/* Threads start when it is set, so they work with the queue at the same time */
+volatile uint startFlag = 0;
+
+/* Sum of consumed values, it is checked after the run */
+volatile uint consumedSum = 0;
+
+/* Returns time in milliseconds, timer of the engine has only millisecond resolution */
+double now() {
+#ifdef VE_WINDOWS
+  LARGE_INTEGER frequency, counter;
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&counter);
+  return counter.QuadPart * 1000.0 / frequency.QuadPart;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec * 1000.0 + time.tv_nsec / 1000000.0;
+#endif // VE_LINUX
+}
+
+/* Queue under CriticalSection with a semaphore for each side, the way threads exchanged data before */
+class LockedQueue {
+private:
+  CriticalSection lock;
+  std::deque<uint> values;
+  Semaphore freeSlots;
+  Semaphore usedSlots;
+
+public:
+  LockedQueue(uint capacity) : freeSlots(capacity) {
+  }
+
+  void push(const uint &value) {
+    freeSlots.wait();
+    lock.lock();
+    values.push_back(value);
+    lock.unlock();
+    usedSlots.post();
+  }
+
+  void pop(uint &value) {
+    usedSlots.wait();
+    lock.lock();
+    value = values.front();
+    values.pop_front();
+    lock.unlock();
+    freeSlots.post();
+  }
+
+  bool tryPush(const uint &value) {
+    if (!freeSlots.tryWait()) {
+      return false;
+    }
+    lock.lock();
+    values.push_back(value);
+    lock.unlock();
+    usedSlots.post();
+    return true;
+  }
+
+  bool tryPop(uint &value) {
+    if (!usedSlots.tryWait()) {
+      return false;
+    }
+    lock.lock();
+    value = values.front();
+    values.pop_front();
+    lock.unlock();
+    freeSlots.post();
+    return true;
+  }
+};
+
+/* Work of one producer or consumer thread */
+template <class Queue>
+struct Task {
+  Queue *queue;
+  uint count;
+  bool blocking;
+};
+
+template <class Queue> unsigned long producerEntry(void *parameter) {
+  Task<Queue> *task = (Task<Queue>*)parameter;
+  while (!startFlag) {
+    yieldThread();
+  }
+
+  for (uint i = 1; i <= task->count; i++) {
+    if (task->blocking) {
+      task->queue->push(i);
+    } else {
+      while (!task->queue->tryPush(i)) {
+        yieldThread();
+      }
+    }
+  }
+
+  atomicIncrement(&finishedThreads);
+  return 0;
+}
+
+template <class Queue> unsigned long consumerEntry(void *parameter) {
+  Task<Queue> *task = (Task<Queue>*)parameter;
+  uint sum = 0;
+
+  for (;;) {
+    uint value;
+    if (task->blocking) {
+      task->queue->pop(value);
+    } else if (!task->queue->tryPop(value)) {
+      yieldThread();
+      continue;
+    }
+
+    if (value == stopValue) {
+      break;
+    }
+    sum += value;
+  }
+
+  atomicAdd(&consumedSum, sum);
+  atomicIncrement(&finishedThreads);
+  return 0;
+}
+
+/* Passes values from producers to consumers and returns nanoseconds per value */
+template <class Queue>
+double throughput(Queue *queue, uint producers, uint consumers, bool blocking) {
+  finishedThreads = 0;
+  startFlag = 0;
+  consumedSum = 0;
+
+  Task<Queue> producerTask = {queue, valuesCount / producers, blocking};
+  Task<Queue> consumerTask = {queue, 0, blocking};
+  for (uint i = 0; i < consumers; i++) {
+    ThreadFactory::getInstance()->spawn(consumerEntry<Queue>, &consumerTask);
+  }
+  for (uint i = 0; i < producers; i++) {
+    ThreadFactory::getInstance()->spawn(producerEntry<Queue>, &producerTask);
+  }
+
+  double start = now();
+  startFlag = 1;
+  while (finishedThreads < producers) {
+    yieldThread();
+  }
+  for (uint i = 0; i < consumers; i++) {
+    queue->push(stopValue);
+  }
+  while (finishedThreads < producers + consumers) {
+    yieldThread();
+  }
+  double elapsed = now() - start;
+
+  /* Sum wraps around the same way in both computations */
+  uint count = producerTask.count;
+  uint expected = (uint)((unsigned long long)count * (count + 1) / 2) * producers;
+  if (consumedSum != expected) {
+    printf("  values were lost or duplicated\n");
+  }
+  return elapsed * 1000000.0 / (producerTask.count * producers);
+}
+
+/* Queues of the latency test, the echo thread pops pings and pushes them back as pongs */
+template <class Queue>
+struct RoundTrip {
+  Queue *ping;
+  Queue *pong;
+  bool blocking;
+};
+
+template <class Queue> unsigned long echoEntry(void *parameter) {
+  RoundTrip<Queue> *trip = (RoundTrip<Queue>*)parameter;
+  for (uint i = 0; i < roundTrips; i++) {
+    uint value;
+    if (trip->blocking) {
+      trip->ping->pop(value);
+      trip->pong->push(value);
+    } else {
+      while (!trip->ping->tryPop(value)) {
+        yieldThread();
+      }
+      while (!trip->pong->tryPush(value)) {
+        yieldThread();
+      }
+    }
+  }
+
+  atomicIncrement(&finishedThreads);
+  return 0;
+}
+
+/* Sends a value to another thread and back, prints percentiles of the round trip time */
+template <class Queue>
+void latency(const char *name, bool blocking) {
+  Queue ping(capacity), pong(capacity);
+  RoundTrip<Queue> trip = {&ping, &pong, blocking};
+  finishedThreads = 0;
+  ThreadFactory::getInstance()->spawn(echoEntry<Queue>, &trip);
+
+  std::vector<double> times(roundTrips);
+  for (uint i = 0; i < roundTrips; i++) {
+    double start = now();
+    uint value = i;
+    if (blocking) {
+      ping.push(value);
+      pong.pop(value);
+    } else {
+      while (!ping.tryPush(value)) {
+        yieldThread();
+      }
+      while (!pong.tryPop(value)) {
+        yieldThread();
+      }
+    }
+    times[i] = (now() - start) * 1000.0;
+  }
+  while (finishedThreads < 1) {
+    yieldThread();
+  }
+
+  std::sort(times.begin(), times.end());
+  printf("  %-26s p50 %8.2f  p99 %8.2f  max %9.2f us\n", name, times[roundTrips / 2],
+    times[roundTrips * 99 / 100], times[roundTrips - 1]);
+}
+
+int main() {
+  printf("throughput, %u values, ns per value:\n", valuesCount);
+  printf("  %-22s %12s %12s %12s\n", "producers x consumers", "SpscQueue", "MpmcQueue", "locked deque");
+  for (int blocking = 1; blocking >= 0; blocking--) {
+    printf(" %s calls:\n", blocking ? "blocking" : "non-blocking");
+    for (uint producers = 1; producers <= 4; producers *= 2) {
+      for (uint consumers = 1; consumers <= 4; consumers *= 2) {
+        MpmcQueue<uint> mpmc(capacity);
+        LockedQueue locked(capacity);
+        double mpmcTime = throughput(&mpmc, producers, consumers, blocking != 0);
+        double lockedTime = throughput(&locked, producers, consumers, blocking != 0);
+
+        /* SpscQueue has only one producer and one consumer */
+        if (producers == 1 && consumers == 1) {
+          SpscQueue<uint> spsc(capacity);
+          double spscTime = throughput(&spsc, producers, consumers, blocking != 0);
+          printf("  %-22s %12.1f %12.1f %12.1f\n", "1 x 1", spscTime, mpmcTime, lockedTime);
+        } else {
+          char label[32];
+          sprintf(label, "%u x %u", producers, consumers);
+          printf("  %-22s %12s %12.1f %12.1f\n", label, "-", mpmcTime, lockedTime);
+        }
+      }
+    }
+  }
+
+  printf("round trip latency between two threads, %u round trips:\n", roundTrips);
+  latency<SpscQueue<uint> >("SpscQueue, blocking", true);
+  latency<SpscQueue<uint> >("SpscQueue, non-blocking", false);
+  latency<MpmcQueue<uint> >("MpmcQueue, blocking", true);
+  latency<MpmcQueue<uint> >("MpmcQueue, non-blocking", false);
+  latency<LockedQueue>("locked deque, blocking", true);
+  return 0;
+}
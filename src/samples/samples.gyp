@@ -3,6 +3,66 @@
 
 {
   'targets': [
+    {
+      'target_name': 'bvh_benchmark',
+      'type': 'executable',
+      'dependencies': [
+        '../engine/engine.gyp:*',
+      ],
+      'include_dirs': [
+        './',
+        '../',
+        '../../',
+      ],
+      'sources': [
+        'bvh_benchmark/sample.cpp',
+      ],
+      'msvs_settings': {
+        'VCLinkerTool': {
+          'SubSystem': '1',  # /SUBSYSTEM:CONSOLE
+        },
+      },
+    }, 
+    {
+      'target_name': 'crc32_benchmark',
+      'type': 'executable',
+      'dependencies': [
+        '../engine/engine.gyp:*',
+      ],
+      'include_dirs': [
+        './',
+        '../',
+        '../../',
+      ],
+      'sources': [
+        'crc32_benchmark/sample.cpp',
+      ],
+      'msvs_settings': {
+        'VCLinkerTool': {
+          'SubSystem': '1',  # /SUBSYSTEM:CONSOLE
+        },
+      },
+    }, 
+    {
+      'target_name': 'culling_benchmark',
+      'type': 'executable',
+      'dependencies': [
+        '../engine/engine.gyp:*',
+      ],
+      'include_dirs': [
+        './',
+        '../',
+        '../../',
+      ],
+      'sources': [
+        'culling_benchmark/sample.cpp',
+      ],
+      'msvs_settings': {
+        'VCLinkerTool': {
+          'SubSystem': '1',  # /SUBSYSTEM:CONSOLE
+        },
+      },
+    }, 
     {
       'target_name': 'device_caps',
       'type': 'executable',
@@ -63,6 +123,86 @@
         },
       },
     }, 
+    {
+      'target_name': 'io_benchmark',
+      'type': 'executable',
+      'dependencies': [
+        '../engine/engine.gyp:*',
+      ],
+      'include_dirs': [
+        './',
+        '../',
+        '../../',
+      ],
+      'sources': [
+        'io_benchmark/sample.cpp',
+      ],
+      'msvs_settings': {
+        'VCLinkerTool': {
+          'SubSystem': '1',  # /SUBSYSTEM:CONSOLE
+        },
+      },
+    }, 
+    {
+      'target_name': 'job_benchmark',
+      'type': 'executable',
+      'dependencies': [
+        '../engine/engine.gyp:*',
+      ],
+      'include_dirs': [
+        './',
+        '../',
+        '../../',
+      ],
+      'sources': [
+        'job_benchmark/sample.cpp',
+      ],
+      'msvs_settings': {
+        'VCLinkerTool': {
+          'SubSystem': '1',  # /SUBSYSTEM:CONSOLE
+        },
+      },
+    }, 
+    {
+      'target_name': 'log_benchmark',
+      'type': 'executable',
+      'dependencies': [
+        '../engine/engine.gyp:*',
+      ],
+      'include_dirs': [
+        './',
+        '../',
+        '../../',
+      ],
+      'sources': [
+        'log_benchmark/sample.cpp',
+      ],
+      'msvs_settings': {
+        'VCLinkerTool': {
+          'SubSystem': '1',  # /SUBSYSTEM:CONSOLE
+        },
+      },
+    }, 
+    {
+      'target_name': 'math_benchmark',
+      'type': 'executable',
+      'dependencies': [
+        '../engine/engine.gyp:*',
+      ],
+      'include_dirs': [
+        './',
+        '../',
+        '../../',
+      ],
+      'sources': [
+        'math_benchmark/sample.cpp',
+      ],
+      'msvs_settings': {
+        'VCLinkerTool': {
+          'SubSystem': '1',  # /SUBSYSTEM:CONSOLE
+        },
+      },
+    }, 
     {
       'target_name': 'models',
       'type': 'executable',
@@ -103,6 +243,26 @@
         },
       },
     }, 
+    {
+      'target_name': 'queue_benchmark',
+      'type': 'executable',
+      'dependencies': [
+        '../engine/engine.gyp:*',
+      ],
+      'include_dirs': [
+        './',
+        '../',
+        '../../',
+      ],
+      'sources': [
+        'queue_benchmark/sample.cpp',
+      ],
+      'msvs_settings': {
+        'VCLinkerTool': {
+          'SubSystem': '1',  # /SUBSYSTEM:CONSOLE
+        },
+      },
+    }, 
     {
       'target_name': 'screen_modes',
       'type': 'executable',
@@ -163,6 +323,26 @@
         },
       },
     }, 
+    {
+      'target_name': 'spatial_benchmark',
+      'type': 'executable',
+      'dependencies': [
+        '../engine/engine.gyp:*',
+      ],
+      'include_dirs': [
+        './',
+        '../',
+        '../../',
+      ],
+      'sources': [
+        'spatial_benchmark/sample.cpp',
+      ],
+      'msvs_settings': {
+        'VCLinkerTool': {
+          'SubSystem': '1',  # /SUBSYSTEM:CONSOLE
+        },
+      },
+    }, 
     {
       'target_name': 'splatting',
       'type': 'executable',
@@ -243,6 +423,46 @@
         },
       },
     },
+    {
+      'target_name': 'stream_benchmark',
+      'type': 'executable',
+      'dependencies': [
+        '../engine/engine.gyp:*',
+      ],
+      'include_dirs': [
+        './',
+        '../',
+        '../../',
+      ],
+      'sources': [
+        'stream_benchmark/sample.cpp',
+      ],
+      'msvs_settings': {
+        'VCLinkerTool': {
+          'SubSystem': '1',  # /SUBSYSTEM:CONSOLE
+        },
+      },
+    },
+    {
+      'target_name': 'sync_benchmark',
+      'type': 'executable',
+      'dependencies': [
+        '../engine/engine.gyp:*',
+      ],
+      'include_dirs': [
+        './',
+        '../',
+        '../../',
+      ],
+      'sources': [
+        'sync_benchmark/sample.cpp',
+      ],
+      'msvs_settings': {
+        'VCLinkerTool': {
+          'SubSystem': '1',  # /SUBSYSTEM:CONSOLE
+        },
+      },
+    }, 
     {
       'target_name': 'tiling',
       'type': 'executable',
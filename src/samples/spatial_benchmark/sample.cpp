@@ -0,0 +1,359 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "engine/math/maths.h"
+#include "engine/spatial/bounding_volume_hierarchy.h"
+#include "engine/spatial/hash_grid.h"
+#include "engine/spatial/loose_octree.h"
+#include "engine/tools/timer_factory.h"
+
+using namespace ve;
+
+/* Size of the cube objects are scattered in */
+const float worldSize = 1000.0f;
+
+/* Number of point, box, ray and nearest neighbours queries */
+const int queries = 1000;
+
+/* Number of frustum queries */
+const int frustumQueries = 100;
+
+/* Number of neighbours to find */
+const uint neighbours = 16;
+
+/* Timer which is shared by all measurements */
+Timer *timer = NULL;
+
+/* Returns random point in the world */
+Vector3f randomPoint() {
+  return Vector3f((Maths::randomf() - 0.5f) * worldSize, (Maths::randomf() - 0.5f) * worldSize,
+    (Maths::randomf() - 0.5f) * worldSize);
+}
+
+/* Sets random box bounds around the center */
+void place(VisibleObject &object, const Vector3f &center) {
+  BoundingBox bounds;
+  float size = 1.0f + Maths::randomf() * 4.0f;
+  bounds.setup(center - Vector3f(size, size, size) * 0.5f, size, size, size);
+  object.setBounds(bounds);
+}
+
+/* Brute force point test */
+bool contains(const BoundingBox &box, const Vector3f &point) {
+  Vector3f low = box.getCorner(), high = low + box.getSize();
+  for (int k = 0; k < 3; k++) {
+    if (point[k] < low[k] || point[k] > high[k]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Brute force box overlap test */
+bool overlaps(const BoundingBox &a, const BoundingBox &b) {
+  Vector3f aMin = a.getCorner(), aMax = aMin + a.getSize();
+  Vector3f bMin = b.getCorner(), bMax = bMin + b.getSize();
+  for (int k = 0; k < 3; k++) {
+    if (aMin[k] > bMax[k] || bMin[k] > aMax[k]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Brute force slab test, returns distance to the box or -1 */
+float rayDistance(const BoundingBox &box, const Vector3f &origin, const Vector3f &direction, float maxDistance) {
+  Vector3f low = box.getCorner(), high = low + box.getSize();
+  float enter = 0, leave = maxDistance;
+  for (int k = 0; k < 3; k++) {
+    float inverse = 1.0f / direction[k];
+    float t0 = (low[k] - origin[k]) * inverse, t1 = (high[k] - origin[k]) * inverse;
+    enter = Maths::max(enter, Maths::min(t0, t1));
+    leave = Maths::min(leave, Maths::max(t0, t1));
+  }
+  return enter <= leave ? enter : -1;
+}
+
+/* Squared distance from the point to the box */
+float squaredDistance(const BoundingBox &box, const Vector3f &point) {
+  Vector3f low = box.getCorner(), high = low + box.getSize();
+  float distance = 0;
+  for (int k = 0; k < 3; k++) {
+    float delta = Maths::max(Maths::max(low[k] - point[k], point[k] - high[k]), 0.0f);
+    distance += delta * delta;
+  }
+  return distance;
+}
+
+/* Queries which are run against every structure */
+struct Queries {
+  std::vector<Vector3f> points;
+  std::vector<BoundingBox> boxes;
+  std::vector<Frustum> frustums;
+  std::vector<Vector3f> origins;
+  std::vector<Vector3f> directions;
+  std::vector<Vector3f> centers;
+};
+
+/* Results of queries, they must be the same for every structure */
+struct Results {
+  uint points;
+  uint boxes;
+  uint frustums;
+  uint hits;
+  float distances;
+  float neighbours;
+};
+
+/* Prints measured time */
+void report(const char *name, uint elapsed, uint operations, const char *details) {
+  printf("    %-16s %9.2f ms %10.2f us/op  %s\n", name, (float)elapsed, elapsed * 1000.0f / operations, details);
+}
+
+/* Runs all queries with brute force iteration */
+Results bruteForce(const std::vector<VisibleObject> &objects, const Queries &set) {
+  Results results;
+  char details[128];
+  uint elapsed;
+
+  printf("  brute force:\n");
+
+  timer->reset();
+  results.points = 0;
+  for (int i = 0; i < queries; i++) {
+    for (uint j = 0; j < objects.size(); j++) {
+      results.points += contains(objects[j].getBounds(), set.points[i]) ? 1 : 0;
+    }
+  }
+  elapsed = timer->getElapsedTime();
+  sprintf(details, "found %u", results.points);
+  report("point", elapsed, queries, details);
+
+  timer->reset();
+  results.boxes = 0;
+  for (int i = 0; i < queries; i++) {
+    for (uint j = 0; j < objects.size(); j++) {
+      results.boxes += overlaps(set.boxes[i], objects[j].getBounds()) ? 1 : 0;
+    }
+  }
+  elapsed = timer->getElapsedTime();
+  sprintf(details, "found %u", results.boxes);
+  report("box", elapsed, queries, details);
+
+  timer->reset();
+  results.frustums = 0;
+  for (int i = 0; i < frustumQueries; i++) {
+    for (uint j = 0; j < objects.size(); j++) {
+      results.frustums += set.frustums[i].isVisible(objects[j].getBounds()) ? 1 : 0;
+    }
+  }
+  elapsed = timer->getElapsedTime();
+  sprintf(details, "found %u", results.frustums);
+  report("frustum", elapsed, frustumQueries, details);
+
+  timer->reset();
+  results.hits = 0;
+  results.distances = 0;
+  for (int i = 0; i < queries; i++) {
+    float closest = worldSize + 1;
+    for (uint j = 0; j < objects.size(); j++) {
+      float distance = rayDistance(objects[j].getBounds(), set.origins[i], set.directions[i], worldSize);
+      if (distance >= 0 && distance < closest) {
+        closest = distance;
+      }
+    }
+    if (closest <= worldSize) {
+      results.hits++;
+      results.distances += closest;
+    }
+  }
+  elapsed = timer->getElapsedTime();
+  sprintf(details, "hits %u, distance sum %.1f", results.hits, results.distances);
+  report("ray", elapsed, queries, details);
+
+  timer->reset();
+  results.neighbours = 0;
+  std::vector<float> distances(objects.size());
+  for (int i = 0; i < queries; i++) {
+    for (uint j = 0; j < objects.size(); j++) {
+      distances[j] = squaredDistance(objects[j].getBounds(), set.centers[i]);
+    }
+    std::nth_element(distances.begin(), distances.begin() + neighbours, distances.end());
+    for (uint j = 0; j < neighbours; j++) {
+      results.neighbours += distances[j];
+    }
+  }
+  elapsed = timer->getElapsedTime();
+  sprintf(details, "squared distance sum %.1f", results.neighbours);
+  report("nearest", elapsed, queries, details);
+
+  return results;
+}
+
+/* Fills structure, moves objects and runs all queries */
+void benchmark(const char *name, SpatialIndex &index, std::vector<VisibleObject> &objects,
+               const Queries &set, const Results &expected) {
+  std::vector<int> proxies(objects.size());
+  std::vector<VisibleObject *> result;
+  char details[128];
+  uint elapsed;
+
+  printf("  %s:\n", name);
+
+  timer->reset();
+  for (uint i = 0; i < objects.size(); i++) {
+    proxies[i] = index.insert(&objects[i]);
+  }
+  elapsed = timer->getElapsedTime();
+  report("insert", elapsed, (uint)objects.size(), "");
+
+  // Objects move a bit and return back, so every structure answers the same queries
+  std::vector<BoundingBox> bounds(objects.size());
+  for (uint i = 0; i < objects.size(); i++) {
+    bounds[i] = objects[i].getBounds();
+    place(objects[i], bounds[i].getCorner() +
+      Vector3f(Maths::randomf() - 0.5f, Maths::randomf() - 0.5f, Maths::randomf() - 0.5f) * 4.0f);
+  }
+
+  timer->reset();
+  for (uint i = 0; i < objects.size(); i++) {
+    index.update(proxies[i]);
+  }
+  elapsed = timer->getElapsedTime();
+  report("update", elapsed, (uint)objects.size(), "");
+
+  for (uint i = 0; i < objects.size(); i++) {
+    objects[i].setBounds(bounds[i]);
+    index.update(proxies[i]);
+  }
+
+  timer->reset();
+  uint found = 0;
+  for (int i = 0; i < queries; i++) {
+    result.clear();
+    index.query(set.points[i], result);
+    found += (uint)result.size();
+  }
+  elapsed = timer->getElapsedTime();
+  sprintf(details, "found %u%s", found, found == expected.points ? "" : " MISMATCH");
+  report("point", elapsed, queries, details);
+
+  timer->reset();
+  found = 0;
+  for (int i = 0; i < queries; i++) {
+    result.clear();
+    index.query(set.boxes[i], result);
+    found += (uint)result.size();
+  }
+  elapsed = timer->getElapsedTime();
+  sprintf(details, "found %u%s", found, found == expected.boxes ? "" : " MISMATCH");
+  report("box", elapsed, queries, details);
+
+  timer->reset();
+  found = 0;
+  for (int i = 0; i < frustumQueries; i++) {
+    result.clear();
+    index.query(set.frustums[i], result);
+    found += (uint)result.size();
+  }
+  elapsed = timer->getElapsedTime();
+  sprintf(details, "found %u%s", found, found == expected.frustums ? "" : " MISMATCH");
+  report("frustum", elapsed, frustumQueries, details);
+
+  timer->reset();
+  found = 0;
+  float distances = 0;
+  for (int i = 0; i < queries; i++) {
+    float distance;
+    if (index.rayCast(set.origins[i], set.directions[i], worldSize, &distance) != NULL) {
+      found++;
+      distances += distance;
+    }
+  }
+  elapsed = timer->getElapsedTime();
+  sprintf(details, "hits %u, distance sum %.1f%s", found, distances,
+    found == expected.hits ? "" : " MISMATCH");
+  report("ray", elapsed, queries, details);
+
+  timer->reset();
+  float sum = 0;
+  for (int i = 0; i < queries; i++) {
+    result.clear();
+    index.findNearest(set.centers[i], neighbours, result);
+    for (uint j = 0; j < result.size(); j++) {
+      sum += squaredDistance(result[j]->getBounds(), set.centers[i]);
+    }
+  }
+  elapsed = timer->getElapsedTime();
+  sprintf(details, "squared distance sum %.1f%s", sum,
+    Maths::abs(sum - expected.neighbours) <= 1e-3f * expected.neighbours ? "" : " MISMATCH");
+  report("nearest", elapsed, queries, details);
+}
+
+void benchmark(uint count) {
+  std::vector<VisibleObject> objects(count);
+  for (uint i = 0; i < count; i++) {
+    place(objects[i], randomPoint());
+  }
+
+  Queries set;
+  Matrix4f projection = Matrix4f::getPerspectiveMatrix(60.0f, 4.0f / 3.0f, 0.1f, worldSize / 4.0f);
+  for (int i = 0; i < queries; i++) {
+    // Points are taken inside of objects, otherwise nearly all point queries are empty
+    const BoundingBox &bounds = objects[Maths::random((int)count)].getBounds();
+    set.points.push_back(bounds.getCorner() + bounds.getSize() * Maths::randomf());
+
+    BoundingBox box;
+    box.setup(randomPoint(), 50.0f, 50.0f, 50.0f);
+    set.boxes.push_back(box);
+
+    Vector3f direction = randomPoint();
+    direction.norm();
+    set.origins.push_back(randomPoint());
+    set.directions.push_back(direction);
+    set.centers.push_back(randomPoint());
+  }
+
+  for (int i = 0; i < frustumQueries; i++) {
+    Vector3f position = randomPoint() * 0.5f;
+    set.frustums.push_back(Frustum(Matrix4f::getLookAtMatrix(position, position + randomPoint(),
+      Vector3f(0, 0, 1)), projection));
+  }
+
+  printf("%u objects:\n", count);
+  Results expected = bruteForce(objects, set);
+
+  BoundingBox world;
+  world.setup(Vector3f(-0.5f, -0.5f, -0.5f) * worldSize, worldSize, worldSize, worldSize);
+
+  BoundingVolumeHierarchy tree;
+  benchmark("bounding volume hierarchy", tree, objects, set, expected);
+
+  LooseOctree octree(world, 8);
+  benchmark("loose octree", octree, objects, set, expected);
+  printf("    %u nodes\n", octree.getNodeCount());
+
+  // Cell size of the grid is a trade-off between the number of cells and objects per cell
+  float cellSizes[] = { 10.0f, 40.0f };
+  for (int i = 0; i < 2; i++) {
+    char name[64];
+    HashGrid grid(cellSizes[i]);
+    sprintf(name, "hash grid, cell %.0f", cellSizes[i]);
+    benchmark(name, grid, objects, set, expected);
+    printf("    %u cells\n", grid.getCellCount());
+  }
+}
+
+int main() {
+  timer = TimerFactory::createTimer();
+
+  benchmark(10000);
+  benchmark(100000);
+
+  delete timer;
+  return 0;
+}
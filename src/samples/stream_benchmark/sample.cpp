@@ -0,0 +1,204 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#ifdef VE_LINUX
+#include <time.h>
+#endif // VE_LINUX
+
+#include "engine/common.h"
+#include "engine/io/buffered_input_stream.h"
+#include "engine/io/buffered_output_stream.h"
+#include "engine/io/data_input_stream.h"
+#include "engine/io/data_ouput_stream.h"
+#include "engine/io/file_input_stream.h"
+#include "engine/io/file_output_stream.h"
+
+using namespace ve;
+
+/* File the benchmark writes and reads */
+const std::string fileName("stream_benchmark.bin");
+
+/* Number of bytes written and read by every test */
+const uint dataSize = 16 * 1024 * 1024;
+
+/* Number of 32-bit values in the data */
+const uint valuesCount = dataSize / 4;
+
+/* Returns time in milliseconds, timer of the engine has only millisecond resolution */
+double now() {
+#ifdef VE_WINDOWS
+  LARGE_INTEGER frequency, counter;
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&counter);
+  return counter.QuadPart * 1000.0 / frequency.QuadPart;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec * 1000.0 + time.tv_nsec / 1000000.0;
+#endif // VE_LINUX
+}
+
+/* Prints throughput of a test */
+void report(const char *name, double start, uint checksum) {
+  double elapsed = now() - start;
+  printf("  %-40s %8.1f ms %8.1f MB/s  checksum %08x\n", name, elapsed,
+    dataSize / (1024.0 * 1024.0) / (elapsed / 1000.0), checksum);
+}
+
+/* Mixes value into the checksum */
+uint mix(uint checksum, uint value) {
+  return checksum * 31 + value;
+}
+
+void writeTests(const std::vector<int> &values) {
+  printf("write:\n");
+
+  {
+    double start = now();
+    FileOutputStream file(fileName);
+    const char *bytes = (const char*)&values[0];
+    for (uint i = 0; i < dataSize; i++) {
+      file.write(bytes[i]);
+    }
+    file.close();
+    report("FileOutputStream, byte per call", start, 0);
+  }
+
+  {
+    double start = now();
+    FileOutputStream file(fileName);
+    BufferedOutputStream stream(&file);
+    const char *bytes = (const char*)&values[0];
+    for (uint i = 0; i < dataSize; i++) {
+      stream.write(bytes[i]);
+    }
+    stream.close();
+    report("BufferedOutputStream, byte per call", start, 0);
+  }
+
+  {
+    double start = now();
+    FileOutputStream file(fileName);
+    DataOutputStream data(&file, BIG_ENDIAN_ORDER);
+    for (uint i = 0; i < valuesCount; i++) {
+      data.writeInt32(values[i]);
+    }
+    file.close();
+    report("DataOutputStream unbuffered, int32 BE", start, 0);
+  }
+
+  {
+    double start = now();
+    FileOutputStream file(fileName);
+    BufferedOutputStream stream(&file);
+    DataOutputStream data(&stream, BIG_ENDIAN_ORDER);
+    for (uint i = 0; i < valuesCount; i++) {
+      data.writeInt32(values[i]);
+    }
+    stream.close();
+    report("DataOutputStream buffered, int32 BE", start, 0);
+  }
+
+  {
+    double start = now();
+    FileOutputStream file(fileName);
+    BufferedOutputStream stream(&file);
+    DataOutputStream data(&stream, BIG_ENDIAN_ORDER);
+    data.writeInt32Array(&values[0], valuesCount);
+    stream.close();
+    report("DataOutputStream buffered, int32 BE array", start, 0);
+  }
+}
+
+void readTests() {
+  printf("read (big-endian int32 file):\n");
+
+  {
+    double start = now();
+    FileInputStream file(fileName);
+    uint checksum = 0;
+    for (uint i = 0; i < dataSize; i++) {
+      checksum = mix(checksum, (uchar)file.read());
+    }
+    report("FileInputStream, byte per call", start, checksum);
+  }
+
+  {
+    double start = now();
+    FileInputStream file(fileName);
+    BufferedInputStream stream(&file);
+    uint checksum = 0;
+    for (uint i = 0; i < dataSize; i++) {
+      checksum = mix(checksum, (uchar)stream.read());
+    }
+    report("BufferedInputStream, byte per call", start, checksum);
+  }
+
+  {
+    double start = now();
+    FileInputStream file(fileName);
+    BufferedInputStream stream(&file);
+    uint checksum = 0;
+    const uchar *block;
+    while ((block = stream.peek(1)) != NULL) {
+      size_t count = stream.getBuffered();
+      for (size_t i = 0; i < count; i++) {
+        checksum = mix(checksum, block[i]);
+      }
+      stream.consume(count);
+    }
+    report("BufferedInputStream, peek/consume", start, checksum);
+  }
+
+  {
+    double start = now();
+    FileInputStream file(fileName);
+    BufferedInputStream stream(&file);
+    DataInputStream data(&stream, BIG_ENDIAN_ORDER);
+    uint checksum = 0;
+    for (uint i = 0; i < valuesCount; i++) {
+      int value = 0;
+      data.readInt32(value);
+      checksum = mix(checksum, value);
+    }
+    report("DataInputStream, int32 BE", start, checksum);
+  }
+
+  {
+    double start = now();
+    FileInputStream file(fileName);
+    BufferedInputStream stream(&file);
+    DataInputStream data(&stream, BIG_ENDIAN_ORDER);
+    std::vector<int> values(valuesCount);
+    data.readInt32Array(&values[0], valuesCount);
+    uint checksum = 0;
+    for (uint i = 0; i < valuesCount; i++) {
+      checksum = mix(checksum, values[i]);
+    }
+    report("DataInputStream, int32 BE array", start, checksum);
+  }
+}
+
+int main() {
+  std::vector<int> values(valuesCount);
+  for (uint i = 0; i < valuesCount; i++) {
+    values[i] = (int)(i * 2654435761u);
+  }
+
+  uint checksum = 0;
+  for (uint i = 0; i < valuesCount; i++) {
+    checksum = mix(checksum, values[i]);
+  }
+
+  printf("%u MB, checksum of int32 values %08x\n", dataSize / (1024 * 1024), checksum);
+  writeTests(values);
+  readTests();
+
+  remove(fileName.c_str());
+  return 0;
+}
@@ -0,0 +1,275 @@
+// Copyright (c) 2017 The Smart Authors.
+// All rights reserved.
+
+#include <cstdio>
+#include <vector>
+
+#ifdef VE_LINUX
+#include <time.h>
+#endif // VE_LINUX
+
+#include "engine/common.h"
+#include "engine/windows/atomic.h"
+#include "engine/windows/condition_variable.h"
+#include "engine/windows/critical_section.h"
+#include "engine/windows/event.h"
+#include "engine/windows/mutex.h"
+#include "engine/windows/read_write_lock.h"
+#include "engine/windows/semaphore.h"
+#include "engine/windows/thread_factory.h"
+
+using namespace ve;
+
+/* Number of lock operations of every thread */
+const uint operations = 1000000;
+
+/* Number of round trips of the ping-pong tests */
+const uint roundTrips = 100000;
+
+/* Size of the table which readers sum in the read-heavy test */
+const uint tableSize = 64;
+
+/* One of this many operations of the read-heavy test is a write */
+const uint writePeriod = 20;
+
+/* Number of finished threads of the current run */
+volatile uint finishedThreads = 0;
+
+/* Threads start when it is set, so they contend from the first operation */
+volatile uint startFlag = 0;
+
+/* Data which is guarded by the tested lock */
+volatile uint sharedCounter = 0;
+volatile uint table[tableSize];
+
+/* Returns time in milliseconds, timer of the engine has only millisecond resolution */
+double now() {
+#ifdef VE_WINDOWS
+  LARGE_INTEGER frequency, counter;
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&counter);
+  return counter.QuadPart * 1000.0 / frequency.QuadPart;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec * 1000.0 + time.tv_nsec / 1000000.0;
+#endif // VE_LINUX
+}
+
+/* Adapters give the tested locks the same interface */
+struct CriticalSectionLock {
+  CriticalSection lock;
+  void lockRead() { lock.lock(); }
+  void unlockRead() { lock.unlock(); }
+  void lockWrite() { lock.lock(); }
+  void unlockWrite() { lock.unlock(); }
+};
+
+struct MutexLock {
+  Mutex lock;
+  void lockRead() { lock.lock(); }
+  void unlockRead() { lock.unlock(); }
+  void lockWrite() { lock.lock(); }
+  void unlockWrite() { lock.unlock(); }
+};
+
+struct ReadWriteLockLock {
+  ReadWriteLock lock;
+  void lockRead() { lock.lockRead(); }
+  void unlockRead() { lock.unlockRead(); }
+  void lockWrite() { lock.lockWrite(); }
+  void unlockWrite() { lock.unlockWrite(); }
+};
+
+/* Increments the counter under the lock, the critical section is as short as possible */
+template <class Lock> unsigned long counterEntry(void *parameter) {
+  Lock *lock = (Lock*)parameter;
+  while (!startFlag) {
+    yieldThread();
+  }
+
+  for (uint i = 0; i < operations; i++) {
+    lock->lockWrite();
+    sharedCounter = sharedCounter + 1;
+    lock->unlockWrite();
+  }
+
+  atomicIncrement(&finishedThreads);
+  return 0;
+}
+
+/* Increments the counter without a lock */
+unsigned long atomicEntry(void *) {
+  while (!startFlag) {
+    yieldThread();
+  }
+
+  for (uint i = 0; i < operations; i++) {
+    atomicIncrement(&sharedCounter);
+  }
+
+  atomicIncrement(&finishedThreads);
+  return 0;
+}
+
+/* Sums the table under a read lock and sometimes changes it under a write lock */
+template <class Lock> unsigned long readerEntry(void *parameter) {
+  Lock *lock = (Lock*)parameter;
+  while (!startFlag) {
+    yieldThread();
+  }
+
+  uint sum = 0;
+  for (uint i = 0; i < operations; i++) {
+    if (i % writePeriod == 0) {
+      lock->lockWrite();
+      table[i % tableSize]++;
+      lock->unlockWrite();
+    } else {
+      lock->lockRead();
+      for (uint j = 0; j < tableSize; j++) {
+        sum += table[j];
+      }
+      lock->unlockRead();
+    }
+  }
+
+  /* Sum is published, so the compiler does not remove the reads */
+  atomicAdd(&sharedCounter, sum & 1);
+  atomicIncrement(&finishedThreads);
+  return 0;
+}
+
+/* Runs threads with the entry and returns nanoseconds per operation of one thread */
+double run(ThreadEntry entry, void *parameter, uint threadsCount) {
+  finishedThreads = 0;
+  startFlag = 0;
+  sharedCounter = 0;
+  for (uint i = 0; i < threadsCount; i++) {
+    if (ThreadFactory::getInstance()->spawn(entry, parameter) != OK) {
+      printf("  failed to start threads\n");
+      return 0;
+    }
+  }
+
+  double start = now();
+  startFlag = 1;
+  while (finishedThreads < threadsCount) {
+    yieldThread();
+  }
+  return (now() - start) * 1000000.0 / ((double)operations * threadsCount);
+}
+
+/* Round trips of the ping-pong tests, the main thread pings and the other thread answers */
+Semaphore pingSemaphore, pongSemaphore;
+Event pingEvent, pongEvent;
+CriticalSection pingLock;
+ConditionVariable pingCondition;
+volatile uint pingTurn = 0;
+
+unsigned long semaphoreEntry(void *) {
+  for (uint i = 0; i < roundTrips; i++) {
+    pingSemaphore.wait();
+    pongSemaphore.post();
+  }
+  atomicIncrement(&finishedThreads);
+  return 0;
+}
+
+unsigned long eventEntry(void *) {
+  for (uint i = 0; i < roundTrips; i++) {
+    pingEvent.wait();
+    pongEvent.set();
+  }
+  atomicIncrement(&finishedThreads);
+  return 0;
+}
+
+unsigned long conditionEntry(void *) {
+  pingLock.lock();
+  for (uint i = 0; i < roundTrips; i++) {
+    while (pingTurn != 1) {
+      pingCondition.wait(&pingLock);
+    }
+    pingTurn = 0;
+    pingCondition.notifyOne();
+  }
+  pingLock.unlock();
+  atomicIncrement(&finishedThreads);
+  return 0;
+}
+
+void pingPongTests() {
+  printf("ping-pong between two threads, %u round trips:\n", roundTrips);
+
+  finishedThreads = 0;
+  ThreadFactory::getInstance()->spawn(semaphoreEntry, NULL);
+  double start = now();
+  for (uint i = 0; i < roundTrips; i++) {
+    pingSemaphore.post();
+    pongSemaphore.wait();
+  }
+  printf("  %-20s %8.2f us/round trip\n", "Semaphore", (now() - start) * 1000.0 / roundTrips);
+  while (finishedThreads < 1) {
+    yieldThread();
+  }
+
+  finishedThreads = 0;
+  ThreadFactory::getInstance()->spawn(eventEntry, NULL);
+  start = now();
+  for (uint i = 0; i < roundTrips; i++) {
+    pingEvent.set();
+    pongEvent.wait();
+  }
+  printf("  %-20s %8.2f us/round trip\n", "Event", (now() - start) * 1000.0 / roundTrips);
+  while (finishedThreads < 1) {
+    yieldThread();
+  }
+
+  finishedThreads = 0;
+  ThreadFactory::getInstance()->spawn(conditionEntry, NULL);
+  start = now();
+  pingLock.lock();
+  for (uint i = 0; i < roundTrips; i++) {
+    pingTurn = 1;
+    pingCondition.notifyOne();
+    while (pingTurn != 0) {
+      pingCondition.wait(&pingLock);
+    }
+  }
+  pingLock.unlock();
+  printf("  %-20s %8.2f us/round trip\n", "ConditionVariable", (now() - start) * 1000.0 / roundTrips);
+  while (finishedThreads < 1) {
+    yieldThread();
+  }
+}
+
+int main() {
+  CriticalSectionLock criticalSection;
+  MutexLock mutex;
+  ReadWriteLockLock readWriteLock;
+
+  printf("shared counter, %u increments per thread, ns per increment:\n", operations);
+  printf("  %-8s %16s %10s %14s %10s\n", "threads", "CriticalSection", "Mutex", "ReadWriteLock", "atomic");
+  for (uint threads = 1; threads <= 8; threads *= 2) {
+    double criticalSectionTime = run(counterEntry<CriticalSectionLock>, &criticalSection, threads);
+    double mutexTime = run(counterEntry<MutexLock>, &mutex, threads);
+    double readWriteLockTime = run(counterEntry<ReadWriteLockLock>, &readWriteLock, threads);
+    double atomicTime = run(atomicEntry, NULL, threads);
+    printf("  %-8u %16.1f %10.1f %14.1f %10.1f\n", threads, criticalSectionTime, mutexTime, readWriteLockTime,
+      atomicTime);
+  }
+
+  printf("read-heavy table, 1 write per %u operations, ns per operation:\n", writePeriod);
+  printf("  %-8s %16s %10s %14s\n", "threads", "CriticalSection", "Mutex", "ReadWriteLock");
+  for (uint threads = 1; threads <= 8; threads *= 2) {
+    double criticalSectionTime = run(readerEntry<CriticalSectionLock>, &criticalSection, threads);
+    double mutexTime = run(readerEntry<MutexLock>, &mutex, threads);
+    double readWriteLockTime = run(readerEntry<ReadWriteLockLock>, &readWriteLock, threads);
+    printf("  %-8u %16.1f %10.1f %14.1f\n", threads, criticalSectionTime, mutexTime, readWriteLockTime);
+  }
+
+  pingPongTests();
+  return 0;
+}
@@ -1,11 +1,21 @@
 // Copyright (c) 2017 The Smart Authors.
 // All rights reserved.
 
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <vector>
+
+#ifdef VE_LINUX
+#include <time.h>
+#endif // VE_LINUX
+
 #include "engine/windows/window_system_factory.h"
 #include "engine/engines/gl_engine.h"
 #include "engine/cameras/ortho_camera.h"
 #include "engine/ui/ui.h"
 #include "engine/tools/string_tool.h"
+#include "engine/tools/timer_factory.h"
 #include "engine/events/window_event.h"
 
 using namespace ve;
@@ -21,7 +31,89 @@ WindowSystem  *xwin = NULL;
 ve::Window    *win = NULL;
 GLEngine      *engine = NULL;
 
-int main() {
+/* Returns time in milliseconds, timer of the engine has only millisecond resolution */
+double now() {
+#ifdef VE_WINDOWS
+  LARGE_INTEGER frequency, counter;
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&counter);
+  return counter.QuadPart * 1000.0 / frequency.QuadPart;
+#endif // VE_WINDOWS
+#ifdef VE_LINUX
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec * 1000.0 + time.tv_nsec / 1000000.0;
+#endif // VE_LINUX
+}
+
+/**
+  Stress case: many windows poll their events every frame. Each window gets only
+  events of its own X window, lookup of the window by X identifier takes constant
+  time, so the time of the frame does not depend on the number of windows much.
+  Move mouse over windows to produce events, close any window to finish.
+*/
+int runStress(int windowCount) {
+  const int STRESS_WIDTH = 160;
+  const int STRESS_HEIGHT = 120;
+  const uint MAX_EVENTS = 64;
+  const uint REPORT_TIME = 2000;
+  SystemEvent *events[MAX_EVENTS];
+  std::vector<ve::Window *> windows;
+
+  xwin = WindowSystemFactory::createWindowSystem();
+  for (int i = 0; i < windowCount; i++) {
+    ve::Window *window = xwin->createWindow(L"Stress " + StringTool::intToStr(i),
+      (i % 8) * STRESS_WIDTH, (i / 8) * STRESS_HEIGHT, STRESS_WIDTH, STRESS_HEIGHT);
+    CHECK_POINTER(window);
+    windows.push_back(window);
+  }
+
+  Timer *reportTimer = TimerFactory::createTimer();
+  uint frames = 0;
+  uint eventTotal = 0;
+  double pollTime = 0.0;
+
+  bool finish = false;
+  while (!finish) {
+    // Polling of a frame takes less than a millisecond, so it is measured with the fine clock
+    double pollStart = now();
+    for (uint w = 0; w < windows.size(); w++) {
+      uint eventCount = windows[w]->pollEvents(events, MAX_EVENTS);
+      eventTotal += eventCount;
+      for (uint i = 0; i < eventCount; i++) {
+        if (events[i]->getType() == WINDOW_CLOSE) {
+          finish = true;
+        }
+      }
+    }
+    pollTime += now() - pollStart;
+
+    for (uint w = 0; w < windows.size(); w++) {
+      xwin->swap(windows[w]);
+    }
+    frames++;
+
+    if (reportTimer->getElapsedTime() >= REPORT_TIME) {
+      printf("%d windows: %u frames, %u events, %.3f ms of polling per frame\n", windowCount, frames,
+        eventTotal, pollTime / frames);
+      reportTimer->reset();
+      frames = eventTotal = 0;
+      pollTime = 0.0;
+    }
+  }
+
+  delete reportTimer;
+  delete xwin;
+
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  /* Run "xsystem --stress [count]" to check many windows */
+  if (argc > 1 && strcmp(argv[1], "--stress") == 0) {
+    return runStress(argc > 2 ? atoi(argv[2]) : 64);
+  }
+
   /* The first class to be created */
   /* Create window system class. It is key point to access window functions */
   xwin = WindowSystemFactory::createWindowSystem();
@@ -85,10 +177,34 @@ int main() {
   winSizeLabel->setFont(font);
   winSizeLabel->setPosition(Vector3f(0, 80, 0.3f));
 
+  Label *redrawLabel = gui->createLabel(desktop, L"Redrawn pixels: -", WHITE);
+  redrawLabel->setFont(font);
+  redrawLabel->setPosition(Vector3f(0, 100, 0.3f));
+
+  /* Only changed labels are redrawn into the cached desktop texture */
+  desktop->setRetained(true);
+
+  /* Events of a frame are taken at once, motion events are merged */
+  const uint MAX_EVENTS = 64;
+  SystemEvent *events[MAX_EVENTS];
+
+  /* Frame time for 60 FPS, the loop sleeps till the next frame or input */
+  const int FRAME_TIME = 16;
+  Timer *frameTimer = TimerFactory::createTimer();
+
   bool finish = false;
   while (!finish) {
-    while (win->hasAvailableEvent()) {
-      SystemEvent *ev = win->getNextEvent();
+    int elapsed = (int)frameTimer->getElapsedTime();
+    if (elapsed < FRAME_TIME) {
+      win->waitEvent(FRAME_TIME - elapsed);
+    }
+
+    /* Frame starts here, so the next wait lasts the rest of the frame after rendering */
+    frameTimer->reset();
+
+    uint eventCount = win->pollEvents(events, MAX_EVENTS);
+    for (uint i = 0; i < eventCount; i++) {
+      SystemEvent *ev = events[i];
       if (ev != NULL) {
         MouseEvent *me = NULL;
         KeyEvent *ke = NULL;
@@ -148,12 +264,14 @@ int main() {
 
     /* Show labels */
     ASSERT(gui->render());
+    redrawLabel->setText(L"Redrawn pixels: " + StringTool::intToStr((int)desktop->getRedrawnArea()));
 
     /* Swap frame and back buffers */
     CHECK_RESULT(win->swap(), L"Swap failed");
   }
 
   /* Free memory */
+  delete frameTimer;
   delete engine;
   delete xwin;
 